@@ -24,6 +24,10 @@ static const int NUM_JOYBTNS = 4;
 static byte kb[NUM_CONTROLS][NUM_KEYBOARDS];
 static byte joyBtn[NUM_JOYBTNS];
 
+// replays: what GetControls reports instead of the devices, while forcing
+static bool forcing = false;
+static byte forcedControls, forcedTaps;
+
 static byte GetJoyState();
 
 void InitControls(void)
@@ -45,16 +49,31 @@ void InitControls(void)
 }
 
 byte GetControls() {
+	if (forcing)
+		return forcedControls;
 	return keyState | GetJoyState() | SoftJoystickState();
 }
 
 byte GetTaps() {
+	if (forcing) {
+		byte result = forcedTaps;
+		forcedTaps = 0;
+		return result;
+	}
 	GetJoyState();  // Updates keyTap.
 	byte result = keyTap;
 	keyTap = 0;
 	return result | SoftJoystickTaps();
 }
 
+void ForceControls(int c) {
+	forcing = (c >= 0);
+	if (!forcing)
+		return;  // keep the last forced state, so taps carry on from it next time
+	forcedTaps |= c & ~forcedControls;
+	forcedControls = c;
+}
+
 byte GetArrows() {
 	return arrowState;
 }
@@ -22,6 +22,9 @@ void InitControls();
 // Get controls which are currently held. Union of all keyboards and joysticks.
 byte GetControls();
 byte GetTaps();  // Tapped since last GetTaps().
+// Make GetControls() report c, and GetTaps() whatever c newly presses,
+// ignoring the devices. For replays. -1 goes back to the devices.
+void ForceControls(int c);
 
 // Get arrow keys (non-mappable) which are currently held. Return=B1.
 byte GetArrows();
@@ -1,6 +1,8 @@
 #include "hamworld.h"
 #include "log.h"
 #include <string.h>
+#include <algorithm>
+#include <stdexcept>
 
 namespace hamworld {
 
@@ -77,7 +79,7 @@ bool read_varint(std::istream& i, size_t* id)
 		ch = i.get();
 		if (!i)
 			return false;
-		*id += (ch & 127) << shift;
+		*id += (size_t) (ch & 127) << shift;
 		shift += 7;
 	} while (ch & 128);
 	return true;
@@ -102,11 +104,55 @@ void Section::write_varint(size_t id)
 	hamworld::write_varint(stream, id);
 }
 
+void Section::write_svarint(int number)
+{
+	// zigzag encoding, so small negative numbers stay small
+	hamworld::write_varint(stream, ((unsigned int) number << 1) ^ (unsigned int) (number >> 31));
+}
+
 void Section::write_string(string_view s)
 {
 	hamworld::write_string(stream, s);
 }
 
+void Section::write_packed(const void* data, size_t len)
+{
+	const byte* src = (const byte*) data;
+	hamworld::write_varint(stream, len);
+
+	// Chunks are a varint header, with the low bit set for a run of one
+	// repeated byte and clear for that many literal bytes.
+	size_t pos = 0;
+	while (pos < len)
+	{
+		size_t run = 1;
+		while (pos + run < len && src[pos + run] == src[pos])
+			++run;
+
+		if (run >= 3)
+		{
+			hamworld::write_varint(stream, (run << 1) | 1);
+			stream.put(src[pos]);
+			pos += run;
+			continue;
+		}
+
+		size_t lit = run;
+		while (pos + lit < len)
+		{
+			size_t next = 1;
+			while (next < 3 && pos + lit + next < len && src[pos + lit + next] == src[pos + lit])
+				++next;
+			if (next >= 3)
+				break;
+			lit += next;
+		}
+		hamworld::write_varint(stream, lit << 1);
+		stream.write((const char*) &src[pos], lit);
+		pos += lit;
+	}
+}
+
 size_t Section::read_varint()
 {
 	size_t result;
@@ -117,6 +163,49 @@ size_t Section::read_varint()
 	return result;
 }
 
+int Section::read_svarint()
+{
+	unsigned int result = (unsigned int) read_varint();
+	return (int) (result >> 1) ^ -(int) (result & 1);
+}
+
+void Section::read_packed(void* data, size_t len)
+{
+	byte* dst = (byte*) data;
+	size_t total = read_varint();
+	size_t pos = 0;
+
+	while (pos < total)
+	{
+		size_t header = read_varint();
+		size_t count = header >> 1;
+		if (count == 0 || count > total - pos)
+			throw std::runtime_error("error in Section::read_packed");
+
+		if (header & 1)
+		{
+			int ch = stream.get();
+			if (pos < len)
+				memset(&dst[pos], ch, std::min(count, len - pos));
+		}
+		else
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				int ch = stream.get();
+				if (pos + i < len)
+					dst[pos + i] = ch;
+			}
+		}
+		pos += count;
+	}
+
+	if (!stream)
+		throw std::runtime_error("error in Section::read_packed");
+	if (total < len)
+		memset(&dst[total], 0, len - total);
+}
+
 bool Section::read_string(Buffer buffer)
 {
 	return hamworld::read_string(stream, buffer);
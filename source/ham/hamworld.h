@@ -45,10 +45,16 @@ public:
 	std::stringstream stream;
 
 	void write_varint(size_t number);
+	void write_svarint(int number);
 	void write_string(string_view s);
+	// Run-length packed block of bytes, for sparse arrays of flags/counters.
+	void write_packed(const void* data, size_t len);
 
 	size_t read_varint();
+	int read_svarint();
 	bool read_string(Buffer buffer);
+	// Unpack into `data`, truncating or zero-filling to `len` bytes.
+	void read_packed(void* data, size_t len);
 
 	virtual std::string save();
 };
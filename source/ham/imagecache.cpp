@@ -0,0 +1,260 @@
+#include "imagecache.h"
+#include "log.h"
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <string>
+#include <deque>
+#include <unordered_map>
+#include <algorithm>
+
+#ifdef SDL_UNPREFIXED
+	#include <SDL_image.h>
+	#include <SDL_thread.h>
+	#include <SDL_mutex.h>
+#else  // SDL_UNPREFIXED
+	#include <SDL2/SDL_image.h>
+	#include <SDL2/SDL_thread.h>
+	#include <SDL2/SDL_mutex.h>
+#endif  // SDL_UNPREFIXED
+
+// One worker thread does the preloading.  Everything below is guarded by
+// lock, except the decoding itself: whoever marks an entry DECODING does it
+// unlocked and then publishes the result, and anyone else wanting that image
+// waits on decoded.  Images are handed out as shared_ptrs, so one being
+// blitted survives being evicted.
+enum imageState_t {
+	IMG_QUEUED,
+	IMG_DECODING,
+	IMG_READY,
+};
+
+struct imageEntry_t {
+	imageState_t state;
+	std::shared_ptr<const cachedImage_t> img;
+	size_t bytes;
+	time_t mtime;
+	off_t fileSize;
+	unsigned lastUse;
+};
+
+static std::unordered_map<std::string, imageEntry_t> cache;
+static std::deque<std::string> queue;
+static size_t cacheBytes;
+static size_t budget = 16 * 1024 * 1024;
+static unsigned useClock;
+
+static SDL_mutex *lock;
+static SDL_cond *decoded, *wakeWorker;
+static SDL_Thread *worker;
+static bool workerFailed, quitting;
+
+// size and date of the file, false if they can't be had (inside an Android
+// package, say), in which case the file is taken never to change
+static bool FileStamp(const char *name, time_t *mtime, off_t *fileSize) {
+	struct stat st;
+
+	if (stat(name, &st) != 0)
+		return false;
+	*mtime = st.st_mtime;
+	*fileSize = st.st_size;
+	return true;
+}
+
+static std::shared_ptr<cachedImage_t> Decode(const char *name) {
+	SDL_Surface *b = IMG_Load(name);
+	if (!b) {
+		LogError("%s: %s", name, SDL_GetError());
+		return nullptr;
+	}
+
+	std::shared_ptr<cachedImage_t> img = std::make_shared<cachedImage_t>();
+	img->width = b->w;
+	img->height = b->h;
+	img->numColors = 0;
+	if (b->format->palette) {
+		img->numColors = std::min(256, b->format->palette->ncolors);
+		for (int i = 0; i < img->numColors; i++) {
+			img->pal[i].r = b->format->palette->colors[i].r;
+			img->pal[i].g = b->format->palette->colors[i].g;
+			img->pal[i].b = b->format->palette->colors[i].b;
+			img->pal[i].a = 255;
+		}
+	}
+
+	img->pixels.resize((size_t)b->w * b->h);
+	SDL_LockSurface(b);
+	for (int i = 0; i < b->h; i++)
+		memcpy(&img->pixels[(size_t)i * b->w], &((byte *)b->pixels)[b->pitch * i], b->w);
+	SDL_UnlockSurface(b);
+	SDL_FreeSurface(b);
+	return img;
+}
+
+// drop the least recently used images until the cache fits, lock held
+static void Trim() {
+	while (cacheBytes > budget) {
+		auto oldest = cache.end();
+		for (auto it = cache.begin(); it != cache.end(); ++it)
+			if (it->second.state == IMG_READY && (oldest == cache.end() || it->second.lastUse < oldest->second.lastUse))
+				oldest = it;
+		if (oldest == cache.end() || oldest->second.lastUse == useClock)
+			return;  // never the one just used
+		cacheBytes -= oldest->second.bytes;
+		cache.erase(oldest);
+	}
+}
+
+// decode the entry the caller marked DECODING and publish it, lock not held
+static std::shared_ptr<const cachedImage_t> Finish(const std::string &name) {
+	time_t mtime = 0;
+	off_t fileSize = 0;
+	FileStamp(name.c_str(), &mtime, &fileSize);
+	std::shared_ptr<const cachedImage_t> img = Decode(name.c_str());
+
+	SDL_LockMutex(lock);
+	auto it = cache.find(name);
+	if (it != cache.end()) {
+		if (img) {
+			it->second.state = IMG_READY;
+			it->second.img = img;
+			it->second.bytes = sizeof(cachedImage_t) + img->pixels.size();
+			it->second.mtime = mtime;
+			it->second.fileSize = fileSize;
+			it->second.lastUse = ++useClock;
+			cacheBytes += it->second.bytes;
+			Trim();
+		} else {
+			cache.erase(it);  // so the next try reports it again
+		}
+	}
+	SDL_CondBroadcast(decoded);
+	SDL_UnlockMutex(lock);
+	return img;
+}
+
+static void Init() {
+	if (!lock) {
+		lock = SDL_CreateMutex();
+		decoded = SDL_CreateCond();
+		wakeWorker = SDL_CreateCond();
+	}
+}
+
+std::shared_ptr<const cachedImage_t> GetImage(const char *name) {
+	std::string key = name;
+	time_t mtime;
+	off_t fileSize;
+	bool stamped = FileStamp(name, &mtime, &fileSize);
+
+	Init();
+	SDL_LockMutex(lock);
+	while (true) {
+		auto it = cache.find(key);
+		if (it == cache.end()) {
+			imageEntry_t e = {};
+			e.state = IMG_DECODING;
+			cache.emplace(key, e);
+			break;
+		}
+		if (it->second.state == IMG_QUEUED) {
+			it->second.state = IMG_DECODING;  // the worker will skip it
+			break;
+		}
+		if (it->second.state == IMG_DECODING) {
+			SDL_CondWait(decoded, lock);
+			continue;
+		}
+		if (stamped && (it->second.mtime != mtime || it->second.fileSize != fileSize)) {
+			// changed on disk since
+			cacheBytes -= it->second.bytes;
+			cache.erase(it);
+			continue;
+		}
+		it->second.lastUse = ++useClock;
+		std::shared_ptr<const cachedImage_t> img = it->second.img;
+		SDL_UnlockMutex(lock);
+		return img;
+	}
+	SDL_UnlockMutex(lock);
+	return Finish(key);
+}
+
+static int SDLCALL WorkerThread(void *) {
+	SDL_LockMutex(lock);
+	while (!quitting) {
+		if (queue.empty()) {
+			SDL_CondWait(wakeWorker, lock);
+			continue;
+		}
+		std::string name = queue.front();
+		queue.pop_front();
+		auto it = cache.find(name);
+		if (it == cache.end() || it->second.state != IMG_QUEUED)
+			continue;  // someone got to it first
+		it->second.state = IMG_DECODING;
+		SDL_UnlockMutex(lock);
+		Finish(name);
+		SDL_LockMutex(lock);
+	}
+	SDL_UnlockMutex(lock);
+	return 0;
+}
+
+static void StopWorker() {
+	SDL_LockMutex(lock);
+	quitting = true;
+	SDL_CondSignal(wakeWorker);
+	SDL_UnlockMutex(lock);
+	SDL_WaitThread(worker, nullptr);
+	worker = nullptr;
+}
+
+void PreloadImage(const char *name) {
+	std::string key = name;
+
+	Init();
+	if (!worker) {
+		if (workerFailed || !lock)
+			return;
+		worker = SDL_CreateThread(WorkerThread, "ImageCache", nullptr);
+		if (!worker) {
+			workerFailed = true;  // no threads here, GetImage will load it
+			return;
+		}
+		atexit(StopWorker);
+	}
+
+	SDL_LockMutex(lock);
+	if (cache.find(key) == cache.end()) {
+		imageEntry_t e = {};
+		e.state = IMG_QUEUED;
+		cache.emplace(key, e);
+		queue.push_back(key);
+		SDL_CondSignal(wakeWorker);
+	}
+	SDL_UnlockMutex(lock);
+}
+
+void ImageCacheSetBudget(size_t bytes) {
+	Init();
+	SDL_LockMutex(lock);
+	budget = bytes;
+	Trim();
+	SDL_UnlockMutex(lock);
+}
+
+void ImageCacheFlush() {
+	Init();
+	SDL_LockMutex(lock);
+	for (auto it = cache.begin(); it != cache.end();) {
+		if (it->second.state == IMG_DECODING) {
+			++it;
+		} else {
+			cacheBytes -= it->second.bytes;
+			it = cache.erase(it);
+		}
+	}
+	queue.clear();
+	SDL_UnlockMutex(lock);
+}
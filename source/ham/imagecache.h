@@ -0,0 +1,34 @@
+#ifndef IMAGECACHE_H
+#define IMAGECACHE_H
+
+#include "mgldraw.h"
+#include <memory>
+#include <vector>
+
+// Decoded images, kept by file name so a screen that's entered over and over
+// doesn't go back to the disk and the decoder every time.  Each is the first
+// width bytes of each row of the 8-bit image, packed, and its palette.  A
+// cached image is checked against the file's size and date before it's used,
+// so editing a picture and loading it again gets the new one.  The least
+// recently used go when the cache is over its budget.
+
+struct cachedImage_t {
+	int width, height;
+	int numColors;  // 0 if the file had no palette
+	RGB pal[256];
+	std::vector<byte> pixels;  // width * height
+};
+
+// The decoded image, from the cache if it's there and still current.  If it
+// isn't, it's decoded now, or waited on if PreloadImage has it underway.
+// NULL (and logged) if it won't load.
+std::shared_ptr<const cachedImage_t> GetImage(const char *name);
+
+// Start decoding an image in the background, for a screen about to be shown.
+// Does nothing where there are no threads; GetImage will load it then.
+void PreloadImage(const char *name);
+
+void ImageCacheSetBudget(size_t bytes);  // default 16 MB
+void ImageCacheFlush();  // forget everything that isn't being decoded
+
+#endif  // IMAGECACHE_H
@@ -2,11 +2,97 @@
 #include "mgldraw.h"
 #include "appdata.h"
 #include <stdio.h>
+#include <vector>
 
 MGLDraw *fontmgl;
 // this is a sort of palette translation table for the font
 byte fontPal[256];
 
+// Glyph spans: each row of each character, as the runs of opaque pixels in it,
+// so drawing skips the transparent ones without looking at them.  They're built
+// when the font loads, and kept off to the side since mfont_t is the file format.
+struct fontSpan_t
+{
+	byte start, len;
+};
+
+struct fontSpans_t
+{
+	const mfont_t *font;
+	const byte *data;	// what they were built from
+	std::vector<int> rowFirst;	// numChars*height+1 indices into span
+	std::vector<fontSpan_t> span;
+};
+
+static std::vector<fontSpans_t> fontSpans;
+static fontSpans_t *lastSpans;
+
+static void BuildSpans(fontSpans_t *fs, const mfont_t *font)
+{
+	const byte *src;
+	fontSpan_t sp;
+	int c, j, i, w;
+
+	fs->font = font;
+	fs->data = font->data;
+	fs->rowFirst.clear();
+	fs->span.clear();
+	for (c = 0; c < font->numChars; c++)
+	{
+		w = *font->chars[c];
+		src = font->chars[c] + 1;
+		for (j = 0; j < font->height; j++, src += w)
+		{
+			fs->rowFirst.push_back((int)fs->span.size());
+			for (i = 0; i < w; )
+			{
+				if (!src[i])
+				{
+					i++;
+					continue;
+				}
+				sp.start = (byte)i;
+				while (i < w && src[i])
+					i++;
+				sp.len = (byte)(i - sp.start);
+				fs->span.push_back(sp);
+			}
+		}
+	}
+	fs->rowFirst.push_back((int)fs->span.size());
+}
+
+static const fontSpans_t *FontSpans(const mfont_t *font)
+{
+	size_t i;
+
+	if (lastSpans && lastSpans->font == font && lastSpans->data == font->data)
+		return lastSpans;
+
+	for (i = 0; i < fontSpans.size(); i++)
+		if (fontSpans[i].font == font)
+			break;
+	if (i == fontSpans.size())
+		fontSpans.emplace_back();
+	lastSpans = &fontSpans[i];
+	if (lastSpans->data != font->data || lastSpans->font != font)
+		BuildSpans(lastSpans, font);
+	return lastSpans;
+}
+
+static void FreeSpans(const mfont_t *font)
+{
+	size_t i;
+
+	lastSpans = NULL;
+	for (i = 0; i < fontSpans.size(); i++)
+		if (fontSpans[i].font == font)
+		{
+			fontSpans.erase(fontSpans.begin() + i);
+			return;
+		}
+}
+
 void FontInit(MGLDraw *mgl)
 {
 	int i;
@@ -19,10 +105,13 @@ void FontInit(MGLDraw *mgl)
 
 void FontExit(void)
 {
+	fontSpans.clear();
+	lastSpans = NULL;
 }
 
 void FontFree(mfont_t *font)
 {
+	FreeSpans(font);
 	if (font->data)
 		free(font->data);
 }
@@ -53,6 +142,7 @@ int FontLoad(const char *fname, mfont_t *font)
 	font->chars[0] = font->data;
 	for (int i = 1; i < font->numChars; i++)
 		font->chars[i] = font->chars[i - 1] + 1 + ((*font->chars[i - 1]) * font->height);
+	FontSpans(font);
 
 	return FONT_OK;
 }
@@ -76,471 +166,219 @@ int FontSave(char *fname, mfont_t *font)
 	return FONT_OK;
 }
 
-static void FontPrintChar(int x, int y, dword c, mfont_t *font)
+// Calls op(dst, src) for every opaque pixel of the character that lands inside
+// minX <= x < maxX, minY <= y < maxY.  The per-mode functions below are just ops.
+template<class Op>
+static void FontBlitChar(int x, int y, dword c, const mfont_t *font, int minX, int minY, int maxX, int maxY, Op op)
 {
-	byte *dst, *src;
-	int scrWidth, scrHeight, chrWidth;
-	int i, j;
+	const fontSpans_t *fs;
+	const fontSpan_t *sp, *end;
+	const byte *src;
+	byte *dst;
+	int pitch, chrWidth;
+	int j, a, b;
 
-	scrWidth = fontmgl->GetWidth();
-	scrHeight = fontmgl->GetHeight();
-	dst = fontmgl->GetScreen() + x + y*scrWidth;
-
-	if (c < font->firstChar || c >= (font->firstChar + font->numChars))
+	if (c < font->firstChar || c >= (dword)(font->firstChar + font->numChars))
 		return; // unprintable
 
 	c -= font->firstChar;
 
+	fs = FontSpans(font);
+	pitch = fontmgl->GetWidth();
 	chrWidth = *(font->chars[c]);
 	src = font->chars[c] + 1;
+	dst = fontmgl->GetScreen() + x + y*pitch;
+	sp = fs->span.data() + fs->rowFirst[c*font->height];
 	for (j = 0; j < font->height; j++)
 	{
-		for (i = 0; i < (*font->chars[c]); i++)
+		end = fs->span.data() + fs->rowFirst[c*font->height + j + 1];
+		if (y + j >= minY && y + j < maxY)
 		{
-			if (*src && (x >= 0) && (x < scrWidth) && (y >= 0) && (y < scrHeight))
-				*dst = fontPal[*src];
-			dst++;
-			src++;
-			x++;
+			for (; sp < end; sp++)
+			{
+				a = sp->start;
+				b = a + sp->len;
+				if (x + a < minX)
+					a = minX - x;
+				if (x + b > maxX)
+					b = maxX - x;
+				for (; a < b; a++)
+					op(dst[a], src[a]);
+			}
 		}
-		y++;
-		x -= chrWidth;
-		dst += (scrWidth - chrWidth);
+		sp = end;
+		src += chrWidth;
+		dst += pitch;
 	}
 }
 
-static void FontPrintCharDark(int x, int y, dword c, mfont_t *font)
+static void FontPrintChar(int x, int y, dword c, mfont_t *font)
 {
-	byte *dst,*src;
-	int scrWidth,scrHeight,chrWidth;
-	int i,j;
-	int b1,b2;
-
-	scrWidth=fontmgl->GetWidth();
-	scrHeight=fontmgl->GetHeight();
-	dst=fontmgl->GetScreen()+x+y*scrWidth;
-
-	if(c<font->firstChar || c>=(font->firstChar+font->numChars))
-		return; // unprintable
-
-	c -= font->firstChar;
+	FontBlitChar(x, y, c, font, 0, 0, fontmgl->GetWidth(), fontmgl->GetHeight(), [](byte &dst, byte src)
+	{
+		dst = fontPal[src];
+	});
+}
 
-	chrWidth=*(font->chars[c]);
-	src=font->chars[c]+1;
-	for(j=0;j<font->height;j++)
+static void FontPrintCharDark(int x, int y, dword c, mfont_t *font)
+{
+	FontBlitChar(x, y, c, font, 1, 1, fontmgl->GetWidth(), fontmgl->GetHeight(), [](byte &dst, byte src)
 	{
-		for(i=0;i<(*font->chars[c]);i++)
+		int b1,b2;
+
+		b2=(fontPal[src]&31);
+		if(b2>0)
 		{
-			if(*src && (x>0) && (x<scrWidth) && (y>0) && (y<scrHeight))
-			{
-				b2=(fontPal[*src]&31);
-				if(b2>0)
-				{
-					b1=((*dst)&31);
-					if(b1>b2)
-						b1-=b2;
-					else
-						b1=0;
-					*dst=((*dst)&(~31))+b1;
-				}
-			}
-			dst++;
-			src++;
-			x++;
+			b1=(dst&31);
+			if(b1>b2)
+				b1-=b2;
+			else
+				b1=0;
+			dst=(dst&(~31))+b1;
 		}
-		y++;
-		x-=chrWidth;
-		dst+=(scrWidth-chrWidth);
-	}
+	});
 }
 
 static void FontPrintCharDark2(int x, int y, dword c, byte howdark, mfont_t *font)
 {
-	byte *dst,*src;
-	int scrWidth,scrHeight,chrWidth;
-	int i,j;
-	int b1,b2;
-
-	scrWidth=fontmgl->GetWidth();
-	scrHeight=fontmgl->GetHeight();
-	dst=fontmgl->GetScreen()+x+y*scrWidth;
-
-	if(c<font->firstChar || c>=(font->firstChar+font->numChars))
-		return; // unprintable
-
-	c -= font->firstChar;
-
-	chrWidth=*(font->chars[c]);
-	src=font->chars[c]+1;
-	for(j=0;j<font->height;j++)
+	FontBlitChar(x, y, c, font, 1, 1, fontmgl->GetWidth(), fontmgl->GetHeight(), [howdark](byte &dst, byte src)
 	{
-		for(i=0;i<(*font->chars[c]);i++)
+		int b1,b2;
+
+		b2=(fontPal[src]&31);
+		if(b2>howdark)
+			b2-=howdark;
+		else
+			b2=0;
+		if(b2>0)
 		{
-			if(*src && (x>0) && (x<scrWidth) && (y>0) && (y<scrHeight))
-			{
-				b2=(fontPal[*src]&31);
-				if(b2>howdark)
-					b2-=howdark;
-				else
-					b2=0;
-				if(b2>0)
-				{
-					b1=((*dst)&31);
-					if(b1>b2)
-						b1-=b2;
-					else
-						b1=0;
-					*dst=((*dst)&(~31))+b1;
-				}
-			}
-			dst++;
-			src++;
-			x++;
+			b1=(dst&31);
+			if(b1>b2)
+				b1-=b2;
+			else
+				b1=0;
+			dst=(dst&(~31))+b1;
 		}
-		y++;
-		x-=chrWidth;
-		dst+=(scrWidth-chrWidth);
-	}
+	});
 }
 
 static void FontPrintCharColor(int x, int y, dword c, byte color, char bright, mfont_t *font)
 {
-	byte *dst, *src;
-	int scrWidth, scrHeight, chrWidth;
-	int i, j;
-
-	scrWidth = fontmgl->GetWidth();
-	scrHeight = fontmgl->GetHeight();
-	dst = fontmgl->GetScreen() + x + y*scrWidth;
-
-	if (c < font->firstChar || c >= (font->firstChar + font->numChars))
-		return; // unprintable
-
-	c -= font->firstChar;
-
-	chrWidth = *(font->chars[c]);
-	src = font->chars[c] + 1;
 	color *= 32;
-	for (j = 0; j < font->height; j++)
+	FontBlitChar(x, y, c, font, 0, 0, fontmgl->GetWidth(), fontmgl->GetHeight(), [color, bright](byte &dst, byte src)
 	{
-		for (i = 0; i < (*font->chars[c]); i++)
+		byte b = (src + bright);
+		if((b&(~31))!=(src&(~31)))
 		{
-			if (*src && (x >= 0) && (x < scrWidth) && (y >= 0) && (y < scrHeight))
-			{
-				byte b = (*src + bright);
-				if((b&(~31))!=((*src)&(~31)))
-				{
-					if(bright>0)
-						b=31;
-					else
-						b=0;
-				}
-				*dst=(b&31)+color;
-			}
-			dst++;
-			src++;
-			x++;
+			if(bright>0)
+				b=31;
+			else
+				b=0;
 		}
-		y++;
-		x -= chrWidth;
-		dst += (scrWidth - chrWidth);
-	}
+		dst=(b&31)+color;
+	});
 }
 
 static void FontPrintCharBright(int x, int y, dword c, char bright, mfont_t *font)
 {
-	byte *dst, *src;
-	int scrWidth, scrHeight, chrWidth;
-	int i, j;
-
-	scrWidth = fontmgl->GetWidth();
-	scrHeight = fontmgl->GetHeight();
-	dst = fontmgl->GetScreen() + x + y*scrWidth;
-
-	if (c < font->firstChar || c >= (font->firstChar + font->numChars))
-		return; // unprintable
-
-	c -= font->firstChar;
-
-	chrWidth = *(font->chars[c]);
-	src = font->chars[c] + 1;
-
-	for (j = 0; j < font->height; j++)
+	FontBlitChar(x, y, c, font, 0, 0, fontmgl->GetWidth(), fontmgl->GetHeight(), [bright](byte &dst, byte src)
 	{
-		for (i = 0; i < (*font->chars[c]); i++)
+		dst = src + bright;
+		if ((dst & (~31)) != (src & (~31)))
 		{
-			if (*src && (x >= 0) && (x < scrWidth) && (y >= 0) && (y < scrHeight))
-			{
-				*dst = *src + bright;
-				if ((*dst & (~31)) != (*src & (~31)))
-				{
-					if (bright > 0)
-						*dst = *src | 31;
-					else
-						*dst = *src & (~31);
-				}
-			}
-			dst++;
-			src++;
-			x++;
+			if (bright > 0)
+				dst = src | 31;
+			else
+				dst = src & (~31);
 		}
-		y++;
-		x -= chrWidth;
-		dst += (scrWidth - chrWidth);
-	}
+	});
 }
 
 static void FontPrintCharSolid(int x, int y, byte c, mfont_t *font, byte color)
 {
-	byte *dst, *src;
-	int scrWidth, scrHeight, chrWidth;
-	int i, j;
-
-	scrWidth = fontmgl->GetWidth();
-	scrHeight = fontmgl->GetHeight();
-	dst = fontmgl->GetScreen() + x + y*scrWidth;
-
-	if (c < font->firstChar || c >= (font->firstChar + font->numChars))
-		return; // unprintable
-
-	c -= font->firstChar;
-
-	chrWidth = *(font->chars[c]);
-	src = font->chars[c] + 1;
-	for (j = 0; j < font->height; j++)
+	FontBlitChar(x, y, c, font, 0, 0, fontmgl->GetWidth(), fontmgl->GetHeight(), [color](byte &dst, byte)
 	{
-		for (i = 0; i < (*font->chars[c]); i++)
-		{
-			if (*src && (x >= 0) && (x < scrWidth) && (y >= 0) && (y < scrHeight))
-				*dst = color;
-			dst++;
-			src++;
-			x++;
-		}
-		y++;
-		x -= chrWidth;
-		dst += (scrWidth - chrWidth);
-	}
+		dst = color;
+	});
 }
 
 static void FontPrintCharGlow(int x, int y, dword c, int bright, mfont_t *font)
 {
-	byte *dst,*src;
-	int scrWidth,scrHeight,chrWidth;
-	int i,j;
-
-	scrWidth=fontmgl->GetWidth();
-	scrHeight=fontmgl->GetHeight();
-	dst=fontmgl->GetScreen()+x+y*scrWidth;
-
-	if(c<font->firstChar || c>=(font->firstChar+font->numChars))
-		return; // unprintable
-
-	c -= font->firstChar;
-
-	chrWidth=*(font->chars[c]);
-	src=font->chars[c]+1;
-	for(j=0;j<font->height;j++)
+	FontBlitChar(x, y, c, font, 1, 1, fontmgl->GetWidth(), fontmgl->GetHeight(), [bright](byte &dst, byte src)
 	{
-		for(i=0;i<(*font->chars[c]);i++)
+		int b2=(fontPal[src]&31)+bright;
+		if(b2>0)
 		{
-			if(*src && (x>0) && (x<scrWidth) && (y>0) && (y<scrHeight))
-			{
-				int b2=(fontPal[*src]&31)+bright;
-				if(b2>0)
-				{
-					int b1=((*dst)&31)+b2;
-					if(b1>31)
-						b1=31;
-					*dst=((*dst)&(~31))+b1;
-				}
-			}
-			dst++;
-			src++;
-			x++;
+			int b1=(dst&31)+b2;
+			if(b1>31)
+				b1=31;
+			dst=(dst&(~31))+b1;
 		}
-		y++;
-		x-=chrWidth;
-		dst+=(scrWidth-chrWidth);
-	}
+	});
 }
 
 static void FontPrintCharBrightGlow(int x, int y, dword c, char brt, mfont_t *font)
 {
-	byte *dst,*src,b;
-	int scrWidth,scrHeight,chrWidth;
-	int i,j;
-
-	scrWidth=fontmgl->GetWidth();
-	scrHeight=fontmgl->GetHeight();
-	dst=fontmgl->GetScreen()+x+y*scrWidth;
-
-	if(c<font->firstChar || c>=(font->firstChar+font->numChars))
-		return; // unprintable
-
-	c -= font->firstChar;
-
-	chrWidth=*(font->chars[c]);
-	src=font->chars[c]+1;
-	for(j=0;j<font->height;j++)
+	FontBlitChar(x, y, c, font, 1, 1, fontmgl->GetWidth(), fontmgl->GetHeight(), [brt](byte &dst, byte src)
 	{
-		for(i=0;i<(*font->chars[c]);i++)
+		byte b;
+
+		if((src&31)+brt>0)
 		{
-			if(*src && (x>0) && (x<scrWidth) && (y>0) && (y<scrHeight) &&
-				(((*src)&31)+brt>0))
+			b=dst+(src&31)+brt;
+			if((b&(~31))!=(dst&(~31)))
+				dst=(dst&(~31))+31;
+			else
 			{
-
-				b=*dst+((*src)&31)+brt;
-				if((b&(~31))!=((*dst)&(~31)))
-					*dst=((*dst)&(~31))+31;
-				else
-				{
-					if(b>*dst)	// don't plot it if it would darken
-						*dst=b;
-				}
+				if(b>dst)	// don't plot it if it would darken
+					dst=b;
 			}
-			dst++;
-			src++;
-			x++;
 		}
-		y++;
-		x-=chrWidth;
-		dst+=(scrWidth-chrWidth);
-	}
+	});
 }
 
-static void FontPrintCharUnGlow(int x, int y, dword c, mfont_t *font)
+static void FontPrintCharUnGlowLimited(int x, int y, int maxX, dword c, mfont_t *font)
 {
-	byte *dst,*src;
-	int scrWidth,scrHeight,chrWidth;
-	int i,j;
-	int b1,b2;
-
-	scrWidth=fontmgl->GetWidth();
-	scrHeight=fontmgl->GetHeight();
-	dst=fontmgl->GetScreen()+x+y*scrWidth;
-
-	if(c<font->firstChar || c>=(font->firstChar+font->numChars))
-		return; // unprintable
-
-	c -= font->firstChar;
-
-	chrWidth=*(font->chars[c]);
-	src=font->chars[c]+1;
-	for(j=0;j<font->height;j++)
+	FontBlitChar(x, y, c, font, 0, 0, maxX, fontmgl->GetHeight(), [](byte &dst, byte src)
 	{
-		for(i=0;i<(*font->chars[c]);i++)
+		int b1,b2;
+
+		b2=(fontPal[src]&31);
+		if(b2>0)
 		{
-			if(*src && (x>=0) && (x<scrWidth) && (y>=0) && (y<scrHeight))
-			{
-				b2=(fontPal[*src]&31);
-				if(b2>0)
-				{
-					b1=((*dst)&31)-b2;
-					if(b1<0)
-						b1=0;
-					*dst=((*dst)&(~31))+b1;
-				}
-			}
-			dst++;
-			src++;
-			x++;
+			b1=(dst&31)-b2;
+			if(b1<0)
+				b1=0;
+			dst=(dst&(~31))+b1;
 		}
-		y++;
-		x-=chrWidth;
-		dst+=(scrWidth-chrWidth);
-	}
+	});
 }
 
-static void FontPrintCharUnGlowLimited(int x, int y, int maxX, dword c, mfont_t *font)
+static void FontPrintCharUnGlow(int x, int y, dword c, mfont_t *font)
 {
-	byte *dst,*src;
-	int scrWidth,scrHeight,chrWidth;
-	int i,j;
-	int b1,b2;
-
-	scrWidth=fontmgl->GetWidth();
-	scrHeight=fontmgl->GetHeight();
-	dst=fontmgl->GetScreen()+x+y*scrWidth;
-
-	if(c<font->firstChar || c>=(font->firstChar+font->numChars))
-		return; // unprintable
-
-	c -= font->firstChar;
-
-	chrWidth=*(font->chars[c]);
-	src=font->chars[c]+1;
-	for(j=0;j<font->height;j++)
-	{
-		for(i=0;i<(*font->chars[c]);i++)
-		{
-			if(*src && (x>=0) && (x<maxX) && (y>=0) && (y<scrHeight))
-			{
-				b2=(fontPal[*src]&31);
-				if(b2>0)
-				{
-					b1=((*dst)&31)-b2;
-					if(b1<0)
-						b1=0;
-					*dst=((*dst)&(~31))+b1;
-				}
-			}
-			dst++;
-			src++;
-			x++;
-		}
-		y++;
-		x-=chrWidth;
-		dst+=(scrWidth-chrWidth);
-	}
+	FontPrintCharUnGlowLimited(x, y, fontmgl->GetWidth(), c, font);
 }
 
 static void FontPrintCharGlowLimited(int x, int y, int maxX, dword c, mfont_t *font,int bright)
 {
-	byte *dst,*src;
-	int scrWidth,scrHeight,chrWidth;
-	int i,j;
-	int v;
-
-	scrWidth=fontmgl->GetWidth();
-	scrHeight=fontmgl->GetHeight();
-	dst=fontmgl->GetScreen()+x+y*scrWidth;
-
 	if(maxX>639)
 		maxX=639;
 
-	if(c<font->firstChar || c>=(font->firstChar+font->numChars))
-		return; // unprintable
-
-	c -= font->firstChar;
-
-	chrWidth=*(font->chars[c]);
-	src=font->chars[c]+1;
-	for(j=0;j<font->height;j++)
+	FontBlitChar(x, y, c, font, 0, 0, maxX, fontmgl->GetHeight(), [bright](byte &dst, byte src)
 	{
-		for(i=0;i<(*font->chars[c]);i++)
+		int v;
+
+		v=src&31;
+		v+=bright;
+		if(v>0)
 		{
-			if((*src>0) && (x>=0) && (x<maxX) && (y>=0) && (y<scrHeight))
-			{
-				v=(*src)&31;
-				v+=bright;
-				if(v>0)
-				{
-					v+=(*dst)&31;
-					if(v>31)
-						*dst=((*dst)&(~31))+31;
-					else
-						*dst=((*dst)&(~31))+v;
-				}
-			}
-			dst++;
-			src++;
-			x++;
+			v+=dst&31;
+			if(v>31)
+				dst=(dst&(~31))+31;
+			else
+				dst=(dst&(~31))+v;
 		}
-		y++;
-		x-=chrWidth;
-		dst+=(scrWidth-chrWidth);
-	}
+	});
 }
 
 static byte CharWidth(dword c, mfont_t *font)
@@ -1,6 +1,7 @@
 #include "jamulsound.h"
 #include "hammusic.h"
 #include "log.h"
+#include "perf.h"
 #include <stdio.h>
 
 #ifdef SDL_UNPREFIXED
@@ -20,6 +21,7 @@ extern SDL_RWops* SoundLoadOverride(int num);
 typedef struct soundList_t
 {
 	Mix_Chunk *sample;
+	dword lastUse;
 } soundList_t;
 
 typedef struct schannel_t
@@ -38,6 +40,23 @@ static int bufferCount;
 static soundList_t *soundList;
 static schannel_t *schannel;
 
+// Decoded sounds stay loaded until the purge, unless together they're over
+// chunkBudget, in which case the least recently played that aren't playing
+// go.  Sounds kept compressed (custom OGGs) are decoded again when next needed.
+static size_t chunkBytes;
+static size_t chunkBudget = 32 * 1024 * 1024;
+static dword playClock;
+
+static int LoadedSounds()
+{
+	int i, n = 0;
+
+	for (i = 0; i < bufferCount; i++)
+		if (soundList[i].sample)
+			n++;
+	return n;
+}
+
 bool JamulSoundInit(int numBuffers)
 {
 	int i;
@@ -63,7 +82,11 @@ bool JamulSoundInit(int numBuffers)
 	soundList = new soundList_t[bufferCount];
 	schannel = new schannel_t[NUM_SOUNDS+1];
 	for(i=0;i<bufferCount;i++)
+	{
 		soundList[i].sample=NULL;
+		soundList[i].lastUse=0;
+	}
+	chunkBytes=0;
 	for(i=0;i<NUM_SOUNDS;i++)
 	{
 		schannel[i].priority=0;
@@ -71,6 +94,7 @@ bool JamulSoundInit(int numBuffers)
 		schannel[i].voice=-1;
 	}
 	sndVolume=128;
+	PerfWatch("sounds loaded", LoadedSounds);
 	return true;
 }
 
@@ -108,6 +132,48 @@ void JamulSoundUpdate(void)
 	}
 }
 
+static bool SoundPlaying(int which)
+{
+	int i;
+
+	for(i=0;i<NUM_SOUNDS;i++)
+		if(schannel[i].soundNum==which && Mix_Playing(schannel[i].voice))
+			return true;
+	return false;
+}
+
+static void FreeSample(int which)
+{
+	chunkBytes-=soundList[which].sample->alen;
+	Mix_FreeChunk(soundList[which].sample);
+	soundList[which].sample=NULL;
+}
+
+// make room under the budget, keeping the sound about to be played
+static void TrimSounds(int keep)
+{
+	int i,oldest;
+
+	while(chunkBytes>chunkBudget)
+	{
+		oldest=-1;
+		for(i=0;i<bufferCount;i++)
+			if(i!=keep && soundList[i].sample && (oldest==-1 || soundList[i].lastUse<soundList[oldest].lastUse) &&
+				!SoundPlaying(i))
+				oldest=i;
+		if(oldest==-1)
+			return;
+		FreeSample(oldest);
+	}
+}
+
+void JamulSoundSetBudget(size_t bytes)
+{
+	chunkBudget=bytes;
+	if(soundIsOn)
+		TrimSounds(-1);
+}
+
 bool JamulSoundPlay(int which,long pan,long vol,int playFlags,int priority)
 {
 	char s[32];
@@ -142,7 +208,10 @@ bool JamulSoundPlay(int which,long pan,long vol,int playFlags,int priority)
 			LogError("LoadWAV(%d): %s", which, Mix_GetError());
 			return 0;
 		}
+		chunkBytes+=soundList[which].sample->alen;
+		TrimSounds(which);
 	}
+	soundList[which].lastUse=++playClock;
 
 	if(playFlags&SND_ONE)
 	{
@@ -258,10 +327,7 @@ void JamulSoundPurge(void)
 	for(i=0;i<bufferCount;i++)
 	{
 		if(soundList[i].sample)
-		{
-			Mix_FreeChunk(soundList[i].sample);
-			soundList[i].sample=NULL;
-		}
+			FreeSample(i);
 	}
 }
 
@@ -2,6 +2,7 @@
 #define JAMULSOUND_H
 
 #include "jamultypes.h"
+#include <stddef.h>
 
 // external fun sound playing flags for everyone to use
 enum {
@@ -31,6 +32,8 @@ void JamulSoundUpdate(void);
 
 // call this to wipe the sounds from memory
 void JamulSoundPurge(void);
+// most bytes of decoded sound to keep between purges, 32 MB to start with
+void JamulSoundSetBudget(size_t bytes);
 
 // call this a lot, it plays sounds
 void GoPlaySound(int num, long pan, long vol, int flags, int priority);
@@ -37,6 +37,30 @@ count structures:
 
 // Helper shenanigans for C stuff
 
+// The palette is 8 hues of 32 brightnesses, hue in the top 3 bits.  Changing a
+// colour's brightness is one lookup, lightTab[(byte)bright][color], so a blit
+// picks its row once instead of clamping every pixel.
+static byte lightTab[256][256];
+
+static struct lightTabInit_t
+{
+	lightTabInit_t()
+	{
+		int b, c;
+		byte value;
+
+		for (b = 0; b < 256; b++)
+			for (c = 0; c < 256; c++)
+			{
+				// the same byte arithmetic as always, wraparound included
+				value = (c & 31) + b;
+				if (value > 128) value = 0; // since byte is unsigned...
+				else if (value > 31) value = 31;
+				lightTab[b][c] = (c & ~31) | value;
+			}
+	}
+} lightTabInit;
+
 byte SprModifyColor(byte color, byte hue)
 {
 	return (hue << 5) | (color & 31);
@@ -49,27 +73,29 @@ byte SprGetColor(byte color)
 
 byte SprModifyLight(byte color, char bright)
 {
-	byte value = (color & 31) + bright;
-	if (value > 128) value = 0; // since byte is unsigned...
-	else if (value > 31) value = 31;
-	return (color & ~31) | value;
+	return lightTab[(byte)bright][color];
+}
+
+const byte *SprLightTable(char bright)
+{
+	return lightTab[(byte)bright];
 }
 
 byte SprModifyGhost(byte src, byte dst, char bright)
 {
 	if (src >> 5 == 0)
 	{
-		return SprModifyLight(dst, src);
+		return lightTab[src][dst];
 	}
 	else
 	{
-		return SprModifyLight(src, bright);
+		return lightTab[(byte)bright][src];
 	}
 }
 
 byte SprModifyGlow(byte src, byte dst, char bright)
 {
-	return SprModifyLight(src, (dst & 31) + bright);
+	return lightTab[(byte)((dst & 31) + bright)][src];
 }
 
 static int constrainX=0,constrainY=0,constrainX2=639,constrainY2=479;
@@ -149,6 +175,11 @@ void sprite_t::GetCoords(int x,int y,int *rx,int *ry,int *rx2,int *ry2)
 	*ry2=*ry+height;
 }
 
+dword sprite_t::GetDataSize(void)
+{
+	return size;
+}
+
 void sprite_t::Draw(int x, int y, MGLDraw *mgl)
 {
 	byte *src, *dst, b, skip;
@@ -259,6 +290,7 @@ void sprite_t::DrawBright(int x, int y, MGLDraw *mgl, char bright)
 	int srcx, srcy;
 	byte noDraw;
 	int i;
+	const byte *light;
 
 	if (bright == 0)
 	{ // don't waste time!
@@ -271,6 +303,7 @@ void sprite_t::DrawBright(int x, int y, MGLDraw *mgl, char bright)
 	if (x > constrainX2 || y > constrainY2)
 		return; // whole sprite is offscreen
 
+	light = SprLightTable(bright);
 	pitch = mgl->GetWidth();
 	src = data;
 	dst = mgl->GetScreen() + x + y*pitch;
@@ -314,7 +347,7 @@ void sprite_t::DrawBright(int x, int y, MGLDraw *mgl, char bright)
 					skip = (b - (constrainX2 - srcx)) - 1;
 					if (!noDraw)
 						for (i = 0; i < b - skip; ++i)
-							dst[i] = SprModifyLight(src[i], bright);
+							dst[i] = light[src[i]];
 					src += b;
 					srcx += b;
 					dst += b;
@@ -323,7 +356,7 @@ void sprite_t::DrawBright(int x, int y, MGLDraw *mgl, char bright)
 				{
 					if (!noDraw)
 						for (i = 0; i < b; ++i)
-							dst[i] = SprModifyLight(src[i], bright);
+							dst[i] = light[src[i]];
 					src += b;
 					srcx += b;
 					dst += b;
@@ -335,7 +368,7 @@ void sprite_t::DrawBright(int x, int y, MGLDraw *mgl, char bright)
 				skip = (srcx - (constrainX2 - b)) - 1;
 				if (!noDraw)
 					for (i = 0; i < b - skip; ++i)
-						dst[i] = SprModifyLight(src[i], bright);
+						dst[i] = light[src[i]];
 				src += b;
 				srcx += b;
 				dst += b;
@@ -345,7 +378,7 @@ void sprite_t::DrawBright(int x, int y, MGLDraw *mgl, char bright)
 				// do it all!
 				if (!noDraw)
 					for (i = 0; i < b; ++i)
-						dst[i] = SprModifyLight(src[i], bright);
+						dst[i] = light[src[i]];
 				srcx += b;
 				src += b;
 				dst += b;
@@ -374,12 +407,16 @@ void sprite_t::DrawColored(int x, int y, MGLDraw *mgl, byte color, char bright)
 	int srcx, srcy;
 	byte noDraw;
 	int i;
+	const byte *light;
+	byte hue;
 
 	x -= ofsx;
 	y -= ofsy;
 	if (x > constrainX2 || y > constrainY2)
 		return; // whole sprite is offscreen
 
+	light = SprLightTable(bright);
+	hue = color << 5;
 	pitch = mgl->GetWidth();
 	src = data;
 	dst = mgl->GetScreen() + x + y*pitch;
@@ -423,7 +460,7 @@ void sprite_t::DrawColored(int x, int y, MGLDraw *mgl, byte color, char bright)
 					skip = (b - (constrainX2 - srcx)) - 1;
 					if (!noDraw)
 						for (i = 0; i < b - skip; ++i)
-							dst[i] = SprModifyLight(SprModifyColor(src[i], color), bright);
+							dst[i] = light[hue | (src[i] & 31)];
 					src += b;
 					srcx += b;
 					dst += b;
@@ -432,7 +469,7 @@ void sprite_t::DrawColored(int x, int y, MGLDraw *mgl, byte color, char bright)
 				{
 					if (!noDraw)
 						for (i = 0; i < b; ++i)
-							dst[i] = SprModifyLight(SprModifyColor(src[i], color), bright);
+							dst[i] = light[hue | (src[i] & 31)];
 					src += b;
 					srcx += b;
 					dst += b;
@@ -444,7 +481,7 @@ void sprite_t::DrawColored(int x, int y, MGLDraw *mgl, byte color, char bright)
 				skip = (srcx - (constrainX2 - b)) - 1;
 				if (!noDraw)
 					for (i = 0; i < b - skip; ++i)
-						dst[i] = SprModifyLight(SprModifyColor(src[i], color), bright);
+						dst[i] = light[hue | (src[i] & 31)];
 				src += b;
 				srcx += b;
 				dst += b;
@@ -454,7 +491,7 @@ void sprite_t::DrawColored(int x, int y, MGLDraw *mgl, byte color, char bright)
 				// do it all!
 				if (!noDraw)
 					for (i = 0; i < b; ++i)
-						dst[i] = SprModifyLight(SprModifyColor(src[i], color), bright);
+						dst[i] = light[hue | (src[i] & 31)];
 				srcx += b;
 				src += b;
 				dst += b;
@@ -480,12 +517,16 @@ void sprite_t::DrawOffColor(int x, int y, MGLDraw *mgl, byte fromColor, byte toC
 	int srcx, srcy;
 	byte noDraw;
 	int i;
+	const byte *light;
+	byte hue;
 
 	x -= ofsx;
 	y -= ofsy;
 	if (x > constrainX2 || y > constrainY2)
 		return; // whole sprite is offscreen
 
+	light = SprLightTable(bright);
+	hue = toColor << 5;
 	pitch = mgl->GetWidth();
 	src = data;
 	dst = mgl->GetScreen() + x + y*pitch;
@@ -529,7 +570,7 @@ void sprite_t::DrawOffColor(int x, int y, MGLDraw *mgl, byte fromColor, byte toC
 					skip = (b - (constrainX2 - srcx)) - 1;
 					if (!noDraw)
 						for (i = 0; i < b - skip; ++i)
-							dst[i] = SprModifyLight(SprGetColor(src[i]) == fromColor ? SprModifyColor(src[i], toColor) : src[i], bright);
+							dst[i] = light[SprGetColor(src[i]) == fromColor ? hue | (src[i] & 31) : src[i]];
 					src += b;
 					srcx += b;
 					dst += b;
@@ -538,7 +579,7 @@ void sprite_t::DrawOffColor(int x, int y, MGLDraw *mgl, byte fromColor, byte toC
 				{
 					if (!noDraw)
 						for (i = 0; i < b; ++i)
-							dst[i] = SprModifyLight(SprGetColor(src[i]) == fromColor ? SprModifyColor(src[i], toColor) : src[i], bright);
+							dst[i] = light[SprGetColor(src[i]) == fromColor ? hue | (src[i] & 31) : src[i]];
 					src += b;
 					srcx += b;
 					dst += b;
@@ -550,7 +591,7 @@ void sprite_t::DrawOffColor(int x, int y, MGLDraw *mgl, byte fromColor, byte toC
 				skip = (srcx - (constrainX2 - b)) - 1;
 				if (!noDraw)
 					for (i = 0; i < b - skip; ++i)
-						dst[i] = SprModifyLight(SprGetColor(src[i]) == fromColor ? SprModifyColor(src[i], toColor) : src[i], bright);
+						dst[i] = light[SprGetColor(src[i]) == fromColor ? hue | (src[i] & 31) : src[i]];
 				src += b;
 				srcx += b;
 				dst += b;
@@ -560,7 +601,7 @@ void sprite_t::DrawOffColor(int x, int y, MGLDraw *mgl, byte fromColor, byte toC
 				// do it all!
 				if (!noDraw)
 					for (i = 0; i < b; ++i)
-						dst[i] = SprModifyLight(SprGetColor(src[i]) == fromColor ? SprModifyColor(src[i], toColor) : src[i], bright);
+						dst[i] = light[SprGetColor(src[i]) == fromColor ? hue | (src[i] & 31) : src[i]];
 				srcx += b;
 				src += b;
 				dst += b;
@@ -805,12 +846,14 @@ void sprite_t::DrawShadow(int x, int y, MGLDraw *mgl)
 	byte noDraw;
 	byte alternate;
 	int i;
+	const byte *dark;
 
 	x -= ofsx + height / 2;
 	y -= ofsy / 2;
 	if (x > constrainX2 || y > constrainY2)
 		return; // whole sprite is offscreen
 
+	dark = SprLightTable(-4);
 	pitch = mgl->GetWidth();
 	src = data;
 	dst = mgl->GetScreen() + x + y*pitch;
@@ -858,7 +901,7 @@ void sprite_t::DrawShadow(int x, int y, MGLDraw *mgl)
 					skip = (b - (constrainX2 - srcx)) - 1;
 					if (!noDraw && alternate)
 						for (i = 0; i < b - skip; ++i)
-							dst[i] = SprModifyLight(dst[i], -4);
+							dst[i] = dark[dst[i]];
 					src += b;
 					srcx += b;
 					dst += b;
@@ -867,7 +910,7 @@ void sprite_t::DrawShadow(int x, int y, MGLDraw *mgl)
 				{
 					if (!noDraw && alternate)
 						for (i = 0; i < b; ++i)
-							dst[i] = SprModifyLight(dst[i], -4);
+							dst[i] = dark[dst[i]];
 					src += b;
 					srcx += b;
 					dst += b;
@@ -879,7 +922,7 @@ void sprite_t::DrawShadow(int x, int y, MGLDraw *mgl)
 				skip = (srcx - (constrainX2 - b)) - 1;
 				if (!noDraw && alternate)
 					for (i = 0; i < b - skip; ++i)
-						dst[i] = SprModifyLight(dst[i], -4);
+						dst[i] = dark[dst[i]];
 				src += b;
 				srcx += b;
 				dst += b;
@@ -889,7 +932,7 @@ void sprite_t::DrawShadow(int x, int y, MGLDraw *mgl)
 				// do it all!
 				if (!noDraw && alternate)
 					for (i = 0; i < b; ++i)
-						dst[i] = SprModifyLight(dst[i], -4);
+						dst[i] = dark[dst[i]];
 				srcx += b;
 				src += b;
 				dst += b;
@@ -1068,6 +1111,20 @@ word sprite_set_t::GetCount(void)
 	return count;
 }
 
+dword sprite_set_t::GetMemSize(void)
+{
+	dword total;
+	int i;
+
+	if(!spr)
+		return 0;
+	total=sizeof(sprite_t *)*count;
+	for(i=0;i<count;i++)
+		if(spr[i])
+			total+=sizeof(sprite_t)+spr[i]->GetDataSize();
+	return total;
+}
+
 void SetSpriteConstraints(int x,int y,int x2,int y2)
 {
 	constrainX=x;
@@ -31,6 +31,7 @@ public:
 	// this makes half-height tilted black shadows (they darken by 4)
 	void DrawShadow(int x, int y, MGLDraw *mgl);
 	void GetCoords(int x, int y, int *rx, int *ry, int *rx2, int *ry2);
+	dword GetDataSize();
 
 	word width;
 	word height;
@@ -53,6 +54,7 @@ public:
 	bool Load(const char *fname);
 	sprite_t *GetSprite(int which);
 	word GetCount();
+	dword GetMemSize();	// bytes held, sprites and all
 protected:
 	void Free();
 
@@ -63,4 +65,13 @@ protected:
 void NewComputerSpriteFix(const char *fname);
 void SetSpriteConstraints(int x, int y, int x2, int y2);
 
+// Palette helpers: 8 hues of 32 brightnesses, hue in the top 3 bits
+byte SprModifyColor(byte color, byte hue);
+byte SprGetColor(byte color);
+byte SprModifyLight(byte color, char bright);
+byte SprModifyGhost(byte src, byte dst, char bright);
+byte SprModifyGlow(byte src, byte dst, char bright);
+// SprLightTable(bright)[color] is SprModifyLight(color, bright), for loops
+const byte *SprLightTable(char bright);
+
 #endif
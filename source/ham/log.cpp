@@ -2,54 +2,211 @@
 #include "appdata.h"
 #include <stdio.h>
 #include <stdarg.h>
+#include <stdlib.h>
+#include <atomic>
 
 #ifdef SDL_UNPREFIXED
 	#include <SDL_platform.h>
+	#include <SDL_thread.h>
+	#include <SDL_timer.h>
 #else  // SDL_UNPREFIXED
 	#include <SDL2/SDL_platform.h>
+	#include <SDL2/SDL_thread.h>
+	#include <SDL2/SDL_timer.h>
 #endif  // SDL_UNPREFIXED
 
 #ifdef __ANDROID__
 	#include <android/log.h>
 #endif
 
+// Logging only formats the line into a ring of slots; a background thread
+// does the printing and the disk writes.  A burst of errors then costs the
+// game a vsnprintf each instead of a flush and a sync each.  Any thread may
+// log: slots are claimed with a compare-and-swap on head, and each slot's seq
+// says whether it's free (seq == position), filled (position + 1) or not
+// yet reused.  If the writer falls a whole ring behind, lines are dropped and
+// counted rather than making the game wait.
+#define LOG_SLOTS	256
+#define LOG_LINE	512
+
+struct logSlot_t
+{
+	std::atomic<unsigned> seq;
+	LogLevel level;
+	char text[LOG_LINE];
+};
+
+static logSlot_t ring[LOG_SLOTS];
+static std::atomic<unsigned> head;
+static std::atomic<unsigned> written;	// only the writer moves this
+static std::atomic<unsigned> dropped;
+static std::atomic<int> minLevel{LOG_DEBUG};
+
+static std::atomic<int> started;	// 0 = not yet, 1 = starting, 2 = running
+static SDL_Thread *writer;
+static SDL_sem *wake;
+static std::atomic<bool> quitting;
+
 static FILE* errorLog = nullptr;
 
-void LogDebug(const char* fmt, ...) {
-	va_list args;
-	va_start(args, fmt);
+static void WriteLine(LogLevel level, const char *text)
+{
+	if (level >= LOG_ERROR) {
+		if (!errorLog)
+			errorLog = AppdataOpen("error.log", "wt");
+		if (errorLog)
+			fprintf(errorLog, "%s\n", text);
+	}
+
 #ifdef __ANDROID__
-	__android_log_vprint(ANDROID_LOG_DEBUG, "HamSandwich", fmt, args);
+	__android_log_write(level >= LOG_ERROR ? ANDROID_LOG_ERROR : ANDROID_LOG_DEBUG, "HamSandwich", text);
 #else
-	vprintf(fmt, args);
-	printf("\n");
+	printf("%s\n", text);
 #endif
-	va_end(args);
 }
 
-void LogError(const char* fmt, ...) {
-	if (!errorLog) {
-		errorLog = AppdataOpen("error.log", "wt");
-		if (!errorLog) {
+// Writes out everything that's been logged so far.  Only one thread may be in
+// here at a time: the writer thread, or whoever logged if there isn't one.
+static void Drain()
+{
+	unsigned pos = written.load(std::memory_order_relaxed);
+	unsigned lost;
+	bool wroteError = false;
+
+	while (true) {
+		logSlot_t *slot = &ring[pos % LOG_SLOTS];
+		if (slot->seq.load(std::memory_order_acquire) != pos + 1)
+			break;
+		WriteLine(slot->level, slot->text);
+		wroteError |= slot->level >= LOG_ERROR;
+		slot->seq.store(pos + LOG_SLOTS, std::memory_order_release);
+		pos++;
+		written.store(pos, std::memory_order_release);
+	}
+
+	lost = dropped.exchange(0);
+	if (lost) {
+		char text[64];
+		snprintf(text, sizeof(text), "(%u log lines dropped)", lost);
+		WriteLine(LOG_ERROR, text);
+		wroteError = true;
+	}
+
+	fflush(stdout);
+	if (wroteError && errorLog) {
+		fflush(errorLog);
+		AppdataSync();
+	}
+}
+
+static int SDLCALL WriterThread(void *)
+{
+	while (!quitting.load()) {
+		SDL_SemWaitTimeout(wake, 100);
+		Drain();
+	}
+	Drain();
+	return 0;
+}
+
+static void StopWriter()
+{
+	quitting = true;
+	SDL_SemPost(wake);
+	SDL_WaitThread(writer, nullptr);
+	writer = nullptr;
+}
+
+// The writer starts with the first line logged.  If there can't be one (no
+// threads on this platform), lines are written out as they're logged.
+static bool StartWriter()
+{
+	int expect = 0;
+
+	if (started.load(std::memory_order_acquire) == 2)
+		return writer != nullptr;
+	if (!started.compare_exchange_strong(expect, 1)) {
+		while (started.load(std::memory_order_acquire) != 2)
+			SDL_Delay(1);
+		return writer != nullptr;
+	}
+
+	for (unsigned i = 0; i < LOG_SLOTS; i++)
+		ring[i].seq.store(i, std::memory_order_relaxed);
+	wake = SDL_CreateSemaphore(0);
+	if (wake)
+		writer = SDL_CreateThread(WriterThread, "Log", nullptr);
+	if (writer)
+		atexit(StopWriter);
+	started.store(2, std::memory_order_release);
+	return writer != nullptr;
+}
+
+static void LogLine(LogLevel level, const char* fmt, va_list args)
+{
+	bool threaded;
+	unsigned pos;
+	logSlot_t *slot;
+
+	if (level < minLevel.load(std::memory_order_relaxed))
+		return;
+	threaded = StartWriter();
+
+	pos = head.load(std::memory_order_relaxed);
+	while (true) {
+		slot = &ring[pos % LOG_SLOTS];
+		int diff = (int)(slot->seq.load(std::memory_order_acquire) - pos);
+		if (diff == 0) {
+			if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				break;
+		} else if (diff < 0) {
+			dropped++;	// the writer is a whole ring behind
+			if (wake)
+				SDL_SemPost(wake);
 			return;
+		} else {
+			pos = head.load(std::memory_order_relaxed);
 		}
 	}
 
-	va_list args, dup;
-	va_start(args, fmt);
-	va_copy(dup, args);
-	vfprintf(errorLog, fmt, dup);
-	fprintf(errorLog, "\n");
-	va_end(dup);
+	slot->level = level;
+	vsnprintf(slot->text, LOG_LINE, fmt, args);
+	slot->seq.store(pos + 1, std::memory_order_release);
 
-#ifdef __ANDROID__
-	__android_log_vprint(ANDROID_LOG_ERROR, "HamSandwich", fmt, args);
-#else
-	vprintf(fmt, args);
-	printf("\n");
-#endif
+	if (threaded)
+		SDL_SemPost(wake);
+	else
+		Drain();
+}
+
+void LogSetLevel(LogLevel level) {
+	minLevel = level;
+}
+
+void LogFlush() {
+	unsigned target = head.load();
+
+	if (!StartWriter()) {
+		Drain();
+		return;
+	}
+	SDL_SemPost(wake);
+	while ((int)(written.load() - target) < 0) {
+		// a slot claimed but not yet filled holds this up, so give it a moment
+		SDL_Delay(1);
+	}
+}
+
+void LogDebug(const char* fmt, ...) {
+	va_list args;
+	va_start(args, fmt);
+	LogLine(LOG_DEBUG, fmt, args);
 	va_end(args);
+}
 
-	fflush(errorLog);
-	AppdataSync();
+void LogError(const char* fmt, ...) {
+	va_list args;
+	va_start(args, fmt);
+	LogLine(LOG_ERROR, fmt, args);
+	va_end(args);
 }
@@ -15,9 +15,17 @@
 #define PRINTF_FMT
 #endif  // _MSC_VER
 
-// Debug and error logging functions
+// Debug and error logging functions.  They queue the line and return; a
+// background thread prints it, and writes errors to error.log.
+enum LogLevel {
+	LOG_DEBUG,
+	LOG_ERROR,
+};
+
 void LogDebug(PRINTF_FMT const char* fmt, ...) PRINTF_FUNC(1);
 void LogError(PRINTF_FMT const char* fmt, ...) PRINTF_FUNC(1);
+void LogSetLevel(LogLevel level);  // drop anything less severe than this
+void LogFlush();  // wait until everything logged so far is written out
 
 #undef PRINTF_FUNC
 #undef PRINTF_FMT
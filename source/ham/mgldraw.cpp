@@ -4,6 +4,10 @@
 #include "hammusic.h"
 #include "log.h"
 #include "softjoystick.h"
+#include "trace.h"
+#include "perf.h"
+#include "imagecache.h"
+#include "randstream.h"
 #include <random>
 #include <algorithm>
 
@@ -244,6 +248,9 @@ void MGLDraw::PseudoCopy(int y,int x,byte* data,int len)
 
 inline void MGLDraw::StartFlip(void)
 {
+	TraceFrame();
+	TraceBegin("Flip");
+	PerfStartFlip(this);
 }
 
 void MGLDraw::ResizeBuffer(int w, int h)
@@ -292,6 +299,8 @@ void MGLDraw::FinishFlip(void)
 		softJoystick->render(renderer);
 	}
 	SDL_RenderPresent(renderer);
+	PerfFinishFlip(this);
+	TraceEnd();
 	UpdateMusic();
 
 	SDL_Event e;
@@ -305,6 +314,14 @@ void MGLDraw::FinishFlip(void)
 				lastKeyPressed = e.key.keysym.sym;
 			}
 
+			if (e.key.keysym.scancode == SDL_SCANCODE_F9 && !e.key.repeat)
+			{
+				if (e.key.keysym.mod & KMOD_SHIFT)
+					PerfSaveCSV("perf.csv");
+				else
+					PerfToggle();
+			}
+
 #ifndef __EMSCRIPTEN__
 			if (e.key.keysym.scancode == SDL_SCANCODE_F11)
 			{
@@ -412,8 +429,8 @@ void MGLDraw::TeensyFlip(void)
 {
 	int i,j,x,y;
 
-	x=640/4;
-	y=480/4;
+	x=xRes/4;
+	y=yRes/4;
 	// blit to the screen
 	StartFlip();
 	for(i=0;i<yRes/2;i++)
@@ -433,8 +450,8 @@ void MGLDraw::TeensyWaterFlip(int v)
 					-1,-2,-2,-2,-2,-1,-1,-1};
 	v=v%24;
 
-	x=640/4;
-	y=480/4;
+	x=xRes/4;
+	y=yRes/4;
 	// blit to the screen
 	StartFlip();
 	for(i=0;i<yRes/2;i++)
@@ -862,35 +879,28 @@ bool MGLDraw::LoadBMP(const char *name)
 bool MGLDraw::LoadBMP(const char *name, PALETTE pal)
 {
 	int i,w;
+	TRACE_SCOPE("LoadBMP");
 
-	SDL_Surface* b = IMG_Load(name);
-	if (!b) {
-		LogError("%s: %s", name, SDL_GetError());
+	// decoded once and kept, see imagecache.h
+	std::shared_ptr<const cachedImage_t> b = GetImage(name);
+	if (!b)
 		return false;
-	}
 
-	if(pal && b->format->palette)
-		for(i=0; i<256 && i < b->format->palette->ncolors; i++)
+	if(pal)
+		for(i=0; i<b->numColors; i++)
 		{
-			pal[i].r = b->format->palette->colors[i].r;
-			pal[i].g = b->format->palette->colors[i].g;
-			pal[i].b = b->format->palette->colors[i].b;
+			pal[i].r = b->pal[i].r;
+			pal[i].g = b->pal[i].g;
+			pal[i].b = b->pal[i].b;
 		}
 	RealizePalette();
 
-	w=b->w;
+	w=b->width;
 	if(w>xRes)
 		w=xRes;
 
-	SDL_LockSurface(b);
-	for(i=0;i<b->h;i++)
-	{
-		if(i<yRes)
-			memcpy(&scrn[i*pitch], &((byte*) b->pixels)[b->pitch * i], w);
-	}
-
-	SDL_UnlockSurface(b);
-	SDL_FreeSurface(b);
+	for(i=0;i<b->height && i<yRes;i++)
+		memcpy(&scrn[i*pitch], &b->pixels[i*b->width], w);
 	return true;
 }
 
@@ -925,6 +935,7 @@ HWND MGLDraw::GetHWnd(void)
 
 void FatalError(const char *msg)
 {
+	LogFlush();
 	fprintf(stderr, "FATAL: %s\n", msg);
 	SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Fatal Error", msg, nullptr);
 	if (_globalMGLDraw)
@@ -935,10 +946,13 @@ void FatalError(const char *msg)
 // Global RNG
 
 std::mt19937_64 mersenne;
+dword randSeed, randSeedEpoch;
 
 void SeedRNG(void)
 {
-	mersenne.seed(timeGetTime());
+	randSeed = timeGetTime();
+	randSeedEpoch++;
+	mersenne.seed(randSeed);
 }
 
 dword Random(dword range)
@@ -958,5 +972,7 @@ long MGL_randoml(long range)
 
 void MGL_srand(int seed)
 {
+	randSeed = seed;
+	randSeedEpoch++;
 	mersenne.seed(seed);
 }
@@ -0,0 +1,253 @@
+#include "perf.h"
+#include "mgldraw.h"
+#include "jamulfont.h"
+#include "appdata.h"
+#include "log.h"
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include <algorithm>
+
+// Each timer adds up its time over a frame, and PerfStartFlip moves the
+// totals into a ring of the last PERF_HISTORY frames.  Counters keep the last
+// value they were given in a frame.
+struct perfTimer_t {
+	const char *name;
+	uint64_t total;
+	float hist[PERF_HISTORY];  // microseconds
+};
+
+struct perfCounter_t {
+	const char *name;
+	int (*count)();
+	int value;
+	int hist[PERF_HISTORY];
+};
+
+bool perfOn = false;
+
+static std::vector<perfTimer_t> timers;
+static std::vector<perfCounter_t> counters;
+static float frameHist[PERF_HISTORY];
+static int frames;  // recorded since the overlay came on
+static uint64_t lastFlip, flipStart;
+static int flipTimer = -1;
+static double usec;
+
+static mfont_t *perfFont;
+static std::vector<byte> under;  // what the overlay covers
+static int underX, underY, underW, underH;
+
+uint64_t PerfNow() {
+	return SDL_GetPerformanceCounter();
+}
+
+int PerfTimerId(const char *name) {
+	for (size_t i = 0; i < timers.size(); i++)
+		if (!strcmp(timers[i].name, name))
+			return (int)i;
+	timers.emplace_back();
+	memset(&timers.back(), 0, sizeof(perfTimer_t));
+	timers.back().name = name;
+	return (int)timers.size() - 1;
+}
+
+void PerfAddTime(int id, uint64_t ticks) {
+	timers[id].total += ticks;
+}
+
+static perfCounter_t *FindCounter(const char *name) {
+	for (size_t i = 0; i < counters.size(); i++)
+		if (counters[i].name == name || !strcmp(counters[i].name, name))
+			return &counters[i];
+	counters.emplace_back();
+	memset(&counters.back(), 0, sizeof(perfCounter_t));
+	counters.back().name = name;
+	return &counters.back();
+}
+
+void PerfCountEvent(const char *name, int value) {
+	FindCounter(name)->value = value;
+}
+
+void PerfWatch(const char *name, int (*count)()) {
+	perfCounter_t *c = FindCounter(name);
+
+	c->count = count;
+	if (!count)
+		c->value = 0;
+}
+
+void PerfSetFont(mfont_t *font) {
+	perfFont = font;
+}
+
+void PerfToggle() {
+	perfOn = !perfOn;
+	frames = 0;
+	lastFlip = 0;
+	for (perfTimer_t &t : timers)
+		t.total = 0;
+	if (flipTimer < 0)
+		flipTimer = PerfTimerId("flip");
+	usec = 1000000.0 / SDL_GetPerformanceFrequency();
+}
+
+// the median, 95th percentile and worst of the recorded frames
+static void Percentiles(const float *hist, float *p50, float *p95, float *worst) {
+	float sorted[PERF_HISTORY];
+	int n = std::min(frames, PERF_HISTORY);
+
+	if (n == 0) {
+		*p50 = *p95 = *worst = 0;
+		return;
+	}
+	std::copy(hist, hist + n, sorted);
+	std::sort(sorted, sorted + n);
+	*p50 = sorted[n / 2];
+	*p95 = sorted[std::min(n - 1, n * 95 / 100)];
+	*worst = sorted[n - 1];
+}
+
+static void EndFrame() {
+	uint64_t now = PerfNow();
+	int slot = frames % PERF_HISTORY;
+
+	if (!lastFlip) {
+		// the first flip after turning on only starts the first frame
+		lastFlip = now;
+		for (perfTimer_t &t : timers)
+			t.total = 0;
+		return;
+	}
+	frameHist[slot] = (float)((now - lastFlip) * usec);
+	lastFlip = now;
+	for (perfTimer_t &t : timers) {
+		t.hist[slot] = (float)(t.total * usec);
+		t.total = 0;
+	}
+	for (perfCounter_t &c : counters) {
+		if (c.count)
+			c.value = c.count();
+		c.hist[slot] = c.value;
+	}
+	frames++;
+}
+
+static void DrawOverlay(MGLDraw *mgl) {
+	char s[64];
+	float p50, p95, worst;
+	int line, x, y, i, bottom;
+	int slot = (frames - 1) % PERF_HISTORY;
+
+	line = perfFont->height + 2;
+	underX = 4;
+	underY = 4;
+	underW = std::min(300, mgl->GetWidth() - underX);
+	underH = std::min(line * (int)(3 + timers.size() + counters.size()) + 4, mgl->GetHeight() - underY);
+	if (underW <= 0 || underH <= 0)
+		return;
+
+	// keep what's under it, so screens that don't redraw every frame don't
+	// end up with the overlay burned in
+	under.resize(underW * underH);
+	for (i = 0; i < underH; i++)
+		memcpy(&under[i * underW], mgl->GetScreen() + underX + (underY + i) * mgl->GetWidth(), underW);
+	mgl->FillBox(underX, underY, underX + underW - 1, underY + underH - 1, 0);
+
+	x = underX + 2;
+	y = underY + 2;
+	bottom = underY + underH - line;
+	Percentiles(frameHist, &p50, &p95, &worst);
+	snprintf(s, sizeof(s), "frame %.1f ms, %.0f fps", frameHist[slot] / 1000.0f, p50 > 0 ? 1000000.0f / p50 : 0.0f);
+	FontPrintString(x, y, s, perfFont);
+	y += line;
+	FontPrintString(x, y, "us", perfFont);
+	FontPrintString(x + 100, y, "now", perfFont);
+	FontPrintString(x + 150, y, "med", perfFont);
+	FontPrintString(x + 200, y, "95%", perfFont);
+	FontPrintString(x + 250, y, "max", perfFont);
+	y += line;
+	for (const perfTimer_t &t : timers) {
+		if (y > bottom)
+			return;
+		Percentiles(t.hist, &p50, &p95, &worst);
+		FontPrintString(x, y, t.name, perfFont);
+		snprintf(s, sizeof(s), "%.0f", t.hist[slot]);
+		FontPrintString(x + 100, y, s, perfFont);
+		snprintf(s, sizeof(s), "%.0f", p50);
+		FontPrintString(x + 150, y, s, perfFont);
+		snprintf(s, sizeof(s), "%.0f", p95);
+		FontPrintString(x + 200, y, s, perfFont);
+		snprintf(s, sizeof(s), "%.0f", worst);
+		FontPrintString(x + 250, y, s, perfFont);
+		y += line;
+	}
+	for (const perfCounter_t &c : counters) {
+		if (y > bottom)
+			return;
+		FontPrintString(x, y, c.name, perfFont);
+		snprintf(s, sizeof(s), "%d", c.value);
+		FontPrintString(x + 100, y, s, perfFont);
+		y += line;
+	}
+}
+
+void PerfStartFlip(MGLDraw *mgl) {
+	underH = 0;
+	if (!perfOn)
+		return;
+
+	EndFrame();
+	if (perfFont && frames > 0)
+		DrawOverlay(mgl);
+	flipStart = PerfNow();
+}
+
+void PerfFinishFlip(MGLDraw *mgl) {
+	if (underH > 0) {
+		for (int i = 0; i < underH; i++)
+			memcpy(mgl->GetScreen() + underX + (underY + i) * mgl->GetWidth(), &under[i * underW], underW);
+		underH = 0;
+	}
+	if (perfOn && flipStart) {
+		PerfAddTime(flipTimer, PerfNow() - flipStart);
+		flipStart = 0;
+	}
+}
+
+bool PerfSaveCSV(const char *fname) {
+	int n = std::min(frames, PERF_HISTORY);
+	int first = frames - n;
+
+	if (n == 0) {
+		LogDebug("nothing to save in %s, F9 starts recording", fname);
+		return false;
+	}
+
+	FILE *f = AppdataOpen(fname, "wt");
+	if (!f) {
+		LogError("can't write %s", fname);
+		return false;
+	}
+
+	fprintf(f, "frame,frame us");
+	for (const perfTimer_t &t : timers)
+		fprintf(f, ",%s us", t.name);
+	for (const perfCounter_t &c : counters)
+		fprintf(f, ",%s", c.name);
+	fprintf(f, "\n");
+	for (int i = first; i < frames; i++) {
+		int slot = i % PERF_HISTORY;
+		fprintf(f, "%d,%.1f", i, frameHist[slot]);
+		for (const perfTimer_t &t : timers)
+			fprintf(f, ",%.1f", t.hist[slot]);
+		for (const perfCounter_t &c : counters)
+			fprintf(f, ",%d", c.hist[slot]);
+		fprintf(f, "\n");
+	}
+	fclose(f);
+	AppdataSync();
+	LogDebug("saved the last %d frames to %s", n, fname);
+	return true;
+}
@@ -0,0 +1,61 @@
+#ifndef PERF_H
+#define PERF_H
+
+#include <stdint.h>
+
+// The profiler overlay.  F9 shows where each frame goes: every named timer's
+// time this frame and its median, 95th percentile and worst over the last
+// PERF_HISTORY frames, plus the counters.  Shift+F9 saves those frames to
+// perf.csv.  While the overlay is off nothing is recorded, and timers and
+// counters cost a test of perfOn.  Main thread only.  Names must last as long
+// as the program does, so pass string literals.
+
+struct mfont_t;
+class MGLDraw;
+
+#define PERF_HISTORY 128
+
+extern bool perfOn;
+
+int PerfTimerId(const char *name);
+void PerfAddTime(int id, uint64_t ticks);  // SDL_GetPerformanceCounter() units
+uint64_t PerfNow();
+
+class PerfScope {
+public:
+	explicit PerfScope(int id) : id(id), start(perfOn ? PerfNow() : 0) {}
+	~PerfScope() {
+		if (start)
+			PerfAddTime(id, PerfNow() - start);
+	}
+	PerfScope(const PerfScope&) = delete;
+	PerfScope& operator=(const PerfScope&) = delete;
+private:
+	int id;
+	uint64_t start;
+};
+
+// PERF_SCOPE("name") times from there to the end of the block, adding up
+// every time it runs in a frame
+#define PERF_JOIN2(a, b) a##b
+#define PERF_JOIN(a, b) PERF_JOIN2(a, b)
+#define PERF_SCOPE(name) \
+	static int PERF_JOIN(perfId, __LINE__) = PerfTimerId(name); \
+	PerfScope PERF_JOIN(perfScope, __LINE__)(PERF_JOIN(perfId, __LINE__))
+
+void PerfCountEvent(const char *name, int value);
+inline void PerfCount(const char *name, int value) {  // a counter's value this frame
+	if (perfOn)
+		PerfCountEvent(name, value);
+}
+void PerfWatch(const char *name, int (*count)());  // PerfCount(name, count()) every frame, NULL stops
+
+void PerfSetFont(mfont_t *font);  // what the overlay is drawn in, none = not drawn
+void PerfToggle();
+bool PerfSaveCSV(const char *fname);
+
+// MGLDraw calls these around every flip
+void PerfStartFlip(MGLDraw *mgl);
+void PerfFinishFlip(MGLDraw *mgl);
+
+#endif  // PERF_H
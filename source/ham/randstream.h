@@ -0,0 +1,107 @@
+#ifndef RANDSTREAM_H
+#define RANDSTREAM_H
+
+#include "jamultypes.h"
+#include <stdint.h>
+
+// Random numbers that don't come from the one shared generator.  Each
+// RandomStream is keyed by the seed (whatever SeedRNG or MGL_srand last set),
+// a subsystem, an entity and a tick, and its Nth number is just a hash of
+// the key and N.  So two streams never disturb each other, one can be worked
+// on from any thread, and a stream made again from the same key gives the
+// same numbers, whatever else drew what in between.
+//
+// Moving code over: give the file a stream of its own for its subsystem and
+// call its Random/Int/Long where the globals were.  That alone keeps, say,
+// particles from changing what the monsters roll.  Where things are updated
+// in parallel or out of order, make a stream per entity and tick instead.
+//
+// Reseeding restarts every stream, including long-lived ones, from number 0.
+
+enum RandSubsystem : dword {
+	RAND_PARTICLE = 1,
+	RAND_BULLET,
+	RAND_AI,
+	RAND_SOUND,
+	RAND_RENDER,	// only for how things look, never for what happens
+};
+
+extern dword randSeed, randSeedEpoch;  // set by SeedRNG and MGL_srand
+
+class RandomStream {
+public:
+	RandomStream() : RandomStream(0) {}
+	explicit RandomStream(dword subsystem, dword id = 0, dword tick = 0)
+		: subsystem(subsystem), id(id), tick(tick), epoch(randSeedEpoch), counter(0) {
+		Rekey();
+	}
+
+	// a number in [0, range), or 0 if range is 0
+	dword Random(dword range) {
+		return Scale(Next(), range);
+	}
+	int Int(int range) {  // for what called MGL_random
+		return (int)Scale(Next(), (dword)range);
+	}
+	long Long(long range) {  // for what called MGL_randoml
+		return (long)Scale(Next(), (dword)range);
+	}
+
+	dword Next() {
+		CheckSeed();
+		return Hash(key, counter++);
+	}
+
+	// the next n raw numbers in one go, the same ones n calls to Next would
+	// give.  Scale each to the range it's wanted in.  The loop has nothing
+	// carried between numbers, so the compiler can do several at once.
+	void Fill(dword *out, int n) {
+		uint32_t k, c;
+
+		CheckSeed();
+		k = key;
+		c = counter;
+		for (int i = 0; i < n; i++)
+			out[i] = Hash(k, c + (uint32_t)i);
+		counter += (uint32_t)n;
+	}
+
+	static dword Scale(dword r, dword range) {
+		return (dword)(((uint64_t)(uint32_t)r * (uint32_t)range) >> 32);
+	}
+
+private:
+	// dword is 64 bits on some platforms, and the numbers must come out the
+	// same on all of them, so it's all done in 32
+	static uint32_t Mix(uint32_t x) {
+		x ^= x >> 16;
+		x *= 0x7feb352du;
+		x ^= x >> 15;
+		x *= 0x846ca68bu;
+		x ^= x >> 16;
+		return x;
+	}
+
+	static uint32_t Hash(uint32_t key, uint32_t n) {
+		return Mix(key + n * 0x9e3779b9u);
+	}
+
+	void CheckSeed() {
+		if (epoch != randSeedEpoch) {
+			epoch = randSeedEpoch;
+			counter = 0;
+			Rekey();
+		}
+	}
+
+	void Rekey() {
+		key = Mix((uint32_t)randSeed ^ Mix((uint32_t)subsystem ^ Mix((uint32_t)id ^ Mix((uint32_t)tick))));
+	}
+
+	dword subsystem, id, tick;
+	dword epoch;
+	uint32_t key;
+	uint32_t counter;
+};
+
+#endif  // RANDSTREAM_H
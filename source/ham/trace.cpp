@@ -0,0 +1,123 @@
+#include "trace.h"
+#include "appdata.h"
+#include "log.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <atomic>
+#include <memory>
+
+#ifdef SDL_UNPREFIXED
+	#include <SDL_thread.h>
+	#include <SDL_timer.h>
+#else  // SDL_UNPREFIXED
+	#include <SDL2/SDL_thread.h>
+	#include <SDL2/SDL_timer.h>
+#endif  // SDL_UNPREFIXED
+
+// Events go into one array allocated up front, so recording one is a counter
+// bump and a few stores from any thread.  When it fills, recording stops and
+// the trace says so.
+#define TRACE_MAX_EVENTS (1 << 20)
+
+struct traceEvent_t {
+	const char *name;
+	uint64_t time, dur;
+	unsigned long thread;
+	char phase;  // B(egin), E(nd), X (complete span), i(nstant)
+};
+
+bool traceOn = false;
+
+static std::unique_ptr<traceEvent_t[]> events;
+static std::atomic<unsigned> numEvents;
+static std::string traceName;
+static uint64_t traceStart;
+static bool atExitSet;
+
+void TraceEvent(const char *name, char phase) {
+	unsigned n = numEvents++;
+	if (n >= TRACE_MAX_EVENTS)
+		return;
+	traceEvent_t *e = &events[n];
+	e->name = name;
+	e->time = SDL_GetPerformanceCounter();
+	e->dur = 0;
+	e->thread = SDL_ThreadID();
+	e->phase = phase;
+}
+
+void TraceSpanEvent(const char *name, uint64_t start, uint64_t end) {
+	unsigned n = numEvents++;
+	if (n >= TRACE_MAX_EVENTS)
+		return;
+	traceEvent_t *e = &events[n];
+	e->name = name;
+	e->time = start;
+	e->dur = end - start;
+	e->thread = SDL_ThreadID();
+	e->phase = 'X';
+}
+
+void TraceStart(const char *fname) {
+	if (traceOn)
+		TraceStop();
+	if (!events)
+		events.reset(new traceEvent_t[TRACE_MAX_EVENTS]);
+	numEvents = 0;
+	traceName = fname;
+	traceStart = SDL_GetPerformanceCounter();
+	traceOn = true;
+	if (!atExitSet) {
+		atExitSet = true;
+		atexit(TraceStop);
+	}
+}
+
+static void PrintName(FILE *f, const char *name) {
+	fputc('"', f);
+	for (; *name; name++) {
+		if (*name == '"' || *name == '\\')
+			fputc('\\', f);
+		fputc(*name, f);
+	}
+	fputc('"', f);
+}
+
+void TraceStop() {
+	if (!traceOn)
+		return;
+	traceOn = false;
+
+	FILE *f = AppdataOpen(traceName.c_str(), "wt");
+	if (!f) {
+		LogError("can't write trace %s", traceName.c_str());
+		return;
+	}
+
+	unsigned count = numEvents.load();
+	if (count > TRACE_MAX_EVENTS) {
+		LogError("trace %s filled up, only the first %d events are in it", traceName.c_str(), TRACE_MAX_EVENTS);
+		count = TRACE_MAX_EVENTS;
+	}
+
+	double usec = 1000000.0 / SDL_GetPerformanceFrequency();
+	fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	for (unsigned i = 0; i < count; i++) {
+		const traceEvent_t *e = &events[i];
+		fprintf(f, "%s{\"ph\":\"%c\",\"pid\":1,\"tid\":%lu,\"ts\":%.3f", i ? ",\n" : "", e->phase, e->thread, (double)(int64_t)(e->time - traceStart) * usec);
+		if (e->phase == 'X')
+			fprintf(f, ",\"dur\":%.3f", e->dur * usec);
+		if (e->phase == 'i')
+			fprintf(f, ",\"s\":\"g\"");
+		if (e->name) {
+			fprintf(f, ",\"name\":");
+			PrintName(f, e->name);
+		}
+		fputc('}', f);
+	}
+	fprintf(f, "\n]}\n");
+	fclose(f);
+	AppdataSync();
+	LogDebug("trace written to %s: %u events", traceName.c_str(), count);
+}
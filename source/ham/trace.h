@@ -0,0 +1,61 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+
+// Trace events, saved in Chrome's trace format: open the file in
+// chrome://tracing or ui.perfetto.dev.  While no trace is running, each of
+// these costs a test of traceOn.  Event names must last as long as the trace
+// does, so pass string literals.
+
+void TraceStart(const char *fname);  // saved to fname by TraceStop, or at exit
+void TraceStop();
+
+extern bool traceOn;
+void TraceEvent(const char *name, char phase);
+void TraceSpanEvent(const char *name, uint64_t start, uint64_t end);
+
+inline void TraceBegin(const char *name) {
+	if (traceOn)
+		TraceEvent(name, 'B');
+}
+
+inline void TraceEnd() {
+	if (traceOn)
+		TraceEvent(nullptr, 'E');
+}
+
+// something that ran from start to end, in SDL_GetPerformanceCounter() units
+inline void TraceSpan(const char *name, uint64_t start, uint64_t end) {
+	if (traceOn)
+		TraceSpanEvent(name, start, end);
+}
+
+// a line across the whole trace where a new frame starts
+inline void TraceFrame() {
+	if (traceOn)
+		TraceEvent("frame", 'i');
+}
+
+// TRACE_SCOPE("name") traces from there to the end of the block
+class TraceScope {
+public:
+	explicit TraceScope(const char *name) : on(traceOn) {
+		if (on)
+			TraceEvent(name, 'B');
+	}
+	~TraceScope() {
+		if (on)
+			TraceEvent(nullptr, 'E');
+	}
+	TraceScope(const TraceScope&) = delete;
+	TraceScope& operator=(const TraceScope&) = delete;
+private:
+	bool on;
+};
+
+#define TRACE_JOIN2(a, b) a##b
+#define TRACE_JOIN(a, b) TRACE_JOIN2(a, b)
+#define TRACE_SCOPE(name) TraceScope TRACE_JOIN(traceScope, __LINE__)(name)
+
+#endif  // TRACE_H
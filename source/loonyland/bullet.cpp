@@ -7,6 +7,10 @@
 #include "bowling.h"
 #include "ch_witch.h"
 #include "badge.h"
+#include "perf.h"
+#include "randstream.h"
+
+static RandomStream bulletRng(RAND_BULLET);
 
 bullet_t bullet[MAX_BULLETS];
 sprite_set_t *bulletSpr;
@@ -146,14 +150,14 @@ void BulletHitWallX(bullet_t *me,Map *map,world_t *world)
 				{
 					int i;
 					for(i=0;i<2;i++)
-						FireBullet(me->x-me->dx,me->y-me->dy,(byte)Random(256),BLT_KNIFESHRP);
+						FireBullet(me->x-me->dx,me->y-me->dy,(byte)bulletRng.Random(256),BLT_KNIFESHRP);
 				}
 				me->target=0;
 			}
 			if(player.fireFlags&FF_REFLECT)
 			{
 				me->x-=me->dx;
-				me->facing=(byte)(84+Random(89));
+				me->facing=(byte)(84+bulletRng.Random(89));
 				if(me->dx<0)
 					me->facing=(me->facing+128)&255;
 				me->dx=Cosine(me->facing)*11;
@@ -165,7 +169,7 @@ void BulletHitWallX(bullet_t *me,Map *map,world_t *world)
 		case BLT_LOONYBALL:
 			me->x-=me->dx;
 			me->dx=-me->dx;
-			me->dy+=-FIXAMT/8+Random(FIXAMT/4+1);
+			me->dy+=-FIXAMT/8+bulletRng.Random(FIXAMT/4+1);
 			break;
 		case BLT_BOWLINGBALL:
 		case BLT_BOOMERANG:
@@ -220,7 +224,7 @@ void BulletHitWallX(bullet_t *me,Map *map,world_t *world)
 			break;
 		case BLT_ITEM:
 			me->x-=me->dx;
-			me->dx=-me->dx-FIXAMT*2+Random(FIXAMT*4);
+			me->dx=-me->dx-FIXAMT*2+bulletRng.Random(FIXAMT*4);
 			Clamp(&me->dx,FIXAMT*6);
 			break;
 		case BLT_CACTUS:
@@ -228,7 +232,7 @@ void BulletHitWallX(bullet_t *me,Map *map,world_t *world)
 		case BLT_KNIFESHRP:
 			me->target=0;
 			me->x-=me->dx;
-			me->facing=(byte)(84+Random(89));
+			me->facing=(byte)(84+bulletRng.Random(89));
 			if(me->dx<0)
 				me->facing=(me->facing+128)&255;
 			me->dx=Cosine(me->facing)*16;
@@ -275,14 +279,14 @@ void BulletHitWallY(bullet_t *me,Map *map,world_t *world)
 				{
 					int i;
 					for(i=0;i<3;i++)
-						FireBullet(me->x-me->dx,me->y-me->dy,(byte)Random(256),BLT_KNIFESHRP);
+						FireBullet(me->x-me->dx,me->y-me->dy,(byte)bulletRng.Random(256),BLT_KNIFESHRP);
 				}
 				me->target=0;
 			}
 			if(player.fireFlags&FF_REFLECT)
 			{
 				me->y-=me->dy;
-				me->facing=(byte)(20+Random(89));
+				me->facing=(byte)(20+bulletRng.Random(89));
 				if(me->dy>0)
 					me->facing+=128;
 				me->dx=Cosine(me->facing)*11;
@@ -294,7 +298,7 @@ void BulletHitWallY(bullet_t *me,Map *map,world_t *world)
 		case BLT_LOONYBALL:
 			me->y-=me->dy;
 			me->dy=-me->dy;
-			me->dx+=-FIXAMT/8+Random(FIXAMT/4+1);
+			me->dx+=-FIXAMT/8+bulletRng.Random(FIXAMT/4+1);
 			break;
 		case BLT_BOWLINGBALL:
 		case BLT_BOOMERANG:
@@ -349,7 +353,7 @@ void BulletHitWallY(bullet_t *me,Map *map,world_t *world)
 			break;
 		case BLT_ITEM:
 			me->y-=me->dy;
-			me->dy=-me->dy-FIXAMT*2+Random(FIXAMT*4);
+			me->dy=-me->dy-FIXAMT*2+bulletRng.Random(FIXAMT*4);
 			Clamp(&me->dy,FIXAMT*6);
 			break;
 		case BLT_CACTUS:
@@ -357,7 +361,7 @@ void BulletHitWallY(bullet_t *me,Map *map,world_t *world)
 		case BLT_KNIFESHRP:
 			me->target=0;
 			me->y-=me->dy;
-			me->facing=(byte)(20+Random(89));
+			me->facing=(byte)(20+bulletRng.Random(89));
 			if(me->dy>0)
 				me->facing+=128;
 			me->dx=Cosine(me->facing)*16;
@@ -495,10 +499,10 @@ void BombRanOut(bullet_t *me)
 		MakeSound(SND_BOOM,me->x,me->y,SND_CUTOFF,1200);
 
 		// and launch two more
-		FireBullet(me->x-64*FIXAMT+Random(128*FIXAMT),
-			me->y-48*FIXAMT+Random(96*FIXAMT),0,BLT_GOODBOOM);
-		FireBullet(me->x-64*FIXAMT+Random(128*FIXAMT),
-			me->y-48*FIXAMT+Random(96*FIXAMT),0,BLT_GOODBOOM);
+		FireBullet(me->x-64*FIXAMT+bulletRng.Random(128*FIXAMT),
+			me->y-48*FIXAMT+bulletRng.Random(96*FIXAMT),0,BLT_GOODBOOM);
+		FireBullet(me->x-64*FIXAMT+bulletRng.Random(128*FIXAMT),
+			me->y-48*FIXAMT+bulletRng.Random(96*FIXAMT),0,BLT_GOODBOOM);
 	}
 	else
 	{
@@ -613,7 +617,7 @@ void BulletRanOut(bullet_t *me,Map *map,world_t *world)
 			BombRanOut(me);
 			break;
 		case BLT_WATER:
-			if(Random(3)==0)
+			if(bulletRng.Random(3)==0)
 				MakeSound(SND_WATERSPLASH,me->x,me->y,SND_CUTOFF,200);
 			ExplodeParticles(PART_WATER,me->x,me->y,me->z,8);
 			me->type=BLT_NONE;
@@ -739,7 +743,7 @@ void HitBadguys(bullet_t *me,Map *map,world_t *world)
 				{
 					for(i=0;i<3;i++)
 					{
-						you=FireBullet(me->x-me->dx,me->y-me->dy,(byte)Random(256),BLT_KNIFESHRP);
+						you=FireBullet(me->x-me->dx,me->y-me->dy,(byte)bulletRng.Random(256),BLT_KNIFESHRP);
 						if(you)
 							you->target=me->target;
 					}
@@ -877,7 +881,7 @@ void HitBadguys(bullet_t *me,Map *map,world_t *world)
 				{
 					for(i=0;i<player.wpnLevel*8;i++)
 					{
-						you=FireBullet(me->x,me->y,(byte)Random(256),BLT_ICE2);
+						you=FireBullet(me->x,me->y,(byte)bulletRng.Random(256),BLT_ICE2);
 						if(you)
 							you->target=me->target;
 					}
@@ -981,7 +985,7 @@ void HitBadguys(bullet_t *me,Map *map,world_t *world)
 		case BLT_WATER:
 			if(FindVictim(me->x>>FIXSHIFT,me->y>>FIXSHIFT,8,0,0,1,map,world))
 			{
-				FireBullet(me->x-10*FIXAMT+Random(20*FIXAMT),me->y-10*FIXAMT+Random(20*FIXAMT),0,BLT_MISLSMOKE);
+				FireBullet(me->x-10*FIXAMT+bulletRng.Random(20*FIXAMT),me->y-10*FIXAMT+bulletRng.Random(20*FIXAMT),0,BLT_MISLSMOKE);
 				MakeSound(SND_STEAM,me->x,me->y,SND_CUTOFF,600);
 				me->type=BLT_NONE;
 			}
@@ -1305,7 +1309,7 @@ void UpdateBullet(bullet_t *me,Map *map,world_t *world)
 			if(me->anim>=b)
 			{
 				me->anim=0;
-				FireBullet(me->x,me->y,(byte)Random(256),BLT_WITCHGAS);
+				FireBullet(me->x,me->y,(byte)bulletRng.Random(256),BLT_WITCHGAS);
 			}
 			ExplodeParticles(PART_YELLOW,me->x,me->y,me->z,1);
 			break;
@@ -1370,15 +1374,15 @@ void UpdateBullet(bullet_t *me,Map *map,world_t *world)
 			}
 			// make sizzle around player constantly
 			LightningBolt(
-				goodguy->x-FIXAMT*32+Random(FIXAMT*64),
-				goodguy->y-FIXAMT*52+Random(FIXAMT*64),
-				goodguy->x-FIXAMT*32+Random(FIXAMT*64),
-				goodguy->y-FIXAMT*52+Random(FIXAMT*64));
+				goodguy->x-FIXAMT*32+bulletRng.Random(FIXAMT*64),
+				goodguy->y-FIXAMT*52+bulletRng.Random(FIXAMT*64),
+				goodguy->x-FIXAMT*32+bulletRng.Random(FIXAMT*64),
+				goodguy->y-FIXAMT*52+bulletRng.Random(FIXAMT*64));
 			break;
 		case BLT_WITCHSPEED:
 			me->x=goodguy->x;
 			me->y=goodguy->y;
-			Burn(me->x,me->y,Random(FIXAMT*40));
+			Burn(me->x,me->y,bulletRng.Random(FIXAMT*40));
 			if(player.speed<1)
 			{
 				player.speed=10;
@@ -1592,7 +1596,7 @@ void UpdateBullet(bullet_t *me,Map *map,world_t *world)
 					me->dz=0;
 				}
 			}
-			if(opt.cheats[CH_KICKCAT] && Random(600)==0)
+			if(opt.cheats[CH_KICKCAT] && bulletRng.Random(600)==0)
 			{
 				MakeSound(SND_MEOW,me->x,me->y,SND_CUTOFF,500);
 			}
@@ -1754,7 +1758,7 @@ void UpdateBullet(bullet_t *me,Map *map,world_t *world)
 			if(me->anim==4)
 			{
 				FireBullet(me->x+Cosine(me->facing)*TILE_WIDTH,me->y+Sine(me->facing)*TILE_HEIGHT,
-						((me->facing+(256-16))+(byte)Random(33))&255,BLT_EARTHSPIKE);
+						((me->facing+(256-16))+(byte)bulletRng.Random(33))&255,BLT_EARTHSPIKE);
 			}
 			if(me->anim>4 && me->anim<10)
 				HitBadguys(me,map,world);
@@ -2102,7 +2106,7 @@ void UpdateBullet(bullet_t *me,Map *map,world_t *world)
 			{
 				for(b=0;b<4;b++)
 				{
-					you=FireBullet(me->x,me->y,(byte)Random(256),BLT_HOTPANTS);
+					you=FireBullet(me->x,me->y,(byte)bulletRng.Random(256),BLT_HOTPANTS);
 					if(you)
 						you->target=me->target-1;
 				}
@@ -2181,10 +2185,10 @@ void UpdateBullet(bullet_t *me,Map *map,world_t *world)
 			{
 				// make sizzle around player if there was no target
 				LightningBolt(
-					goodguy->x-FIXAMT*32+Random(FIXAMT*64),
-					goodguy->y-FIXAMT*52+Random(FIXAMT*64),
-					goodguy->x-FIXAMT*32+Random(FIXAMT*64),
-					goodguy->y-FIXAMT*52+Random(FIXAMT*64));
+					goodguy->x-FIXAMT*32+bulletRng.Random(FIXAMT*64),
+					goodguy->y-FIXAMT*52+bulletRng.Random(FIXAMT*64),
+					goodguy->x-FIXAMT*32+bulletRng.Random(FIXAMT*64),
+					goodguy->y-FIXAMT*52+bulletRng.Random(FIXAMT*64));
 			}
 			me->type=BLT_NONE;	// begone immediately
 			break;
@@ -2199,9 +2203,9 @@ void UpdateBullet(bullet_t *me,Map *map,world_t *world)
 					you=FireBullet(me->x-me->dx/2,me->y-me->dy/2,me->facing,BLT_WATER);
 					if(you)
 					{
-						you->x+=-FIXAMT*8+Random(FIXAMT*16);
-						you->y+=-FIXAMT*8+Random(FIXAMT*16);
-						you->z=me->z-me->dz-FIXAMT*4+Random(FIXAMT*8);
+						you->x+=-FIXAMT*8+bulletRng.Random(FIXAMT*16);
+						you->y+=-FIXAMT*8+bulletRng.Random(FIXAMT*16);
+						you->z=me->z-me->dz-FIXAMT*4+bulletRng.Random(FIXAMT*8);
 						you->anim=1;
 					}
 				}
@@ -2303,11 +2307,11 @@ void UpdateBullet(bullet_t *me,Map *map,world_t *world)
 				me->anim=0;
 			break;
 		case BLT_EVILFACE:
-			me->anim+=(byte)Random(3);
+			me->anim+=(byte)bulletRng.Random(3);
 			if(me->anim>=6*16)
 				me->anim=6*16-1;
-			me->dx+=-FIXAMT/16+Random(FIXAMT/8);
-			me->dy-=Random(FIXAMT/16);
+			me->dx+=-FIXAMT/16+bulletRng.Random(FIXAMT/8);
+			me->dy-=bulletRng.Random(FIXAMT/16);
 			break;
 		case BLT_WOLFSHOCK:
 			w=LockOnEvil3(me->x>>FIXSHIFT,me->y>>FIXSHIFT,(player.fireRange+1)*TILE_HEIGHT);
@@ -2323,10 +2327,10 @@ void UpdateBullet(bullet_t *me,Map *map,world_t *world)
 			{
 				// make sizzle around player if there was no target
 				LightningBolt(
-					goodguy->x-FIXAMT*32+Random(FIXAMT*64),
-					goodguy->y-FIXAMT*52+Random(FIXAMT*64),
-					goodguy->x-FIXAMT*32+Random(FIXAMT*64),
-					goodguy->y-FIXAMT*52+Random(FIXAMT*64));
+					goodguy->x-FIXAMT*32+bulletRng.Random(FIXAMT*64),
+					goodguy->y-FIXAMT*52+bulletRng.Random(FIXAMT*64),
+					goodguy->x-FIXAMT*32+bulletRng.Random(FIXAMT*64),
+					goodguy->y-FIXAMT*52+bulletRng.Random(FIXAMT*64));
 			}
 			me->type=BLT_NONE;	// begone immediately
 			break;
@@ -2343,10 +2347,10 @@ void UpdateBullet(bullet_t *me,Map *map,world_t *world)
 			{
 				// make sizzle around ghost if there was no target
 				LightningBolt(
-					me->x-FIXAMT*32+Random(FIXAMT*64),
-					me->y-FIXAMT*52+Random(FIXAMT*64),
-					me->x-FIXAMT*32+Random(FIXAMT*64),
-					me->y-FIXAMT*52+Random(FIXAMT*64));
+					me->x-FIXAMT*32+bulletRng.Random(FIXAMT*64),
+					me->y-FIXAMT*52+bulletRng.Random(FIXAMT*64),
+					me->x-FIXAMT*32+bulletRng.Random(FIXAMT*64),
+					me->y-FIXAMT*52+bulletRng.Random(FIXAMT*64));
 			}
 			me->type=BLT_NONE;	// begone immediately
 			break;
@@ -2399,9 +2403,9 @@ void UpdateBullet(bullet_t *me,Map *map,world_t *world)
 					me->dx=Cosine(me->facing)*12;
 					me->dy=Sine(me->facing)*12;
 				}
-				if(player.spellXP[ITM_WHOTPANTS-ITM_WBOMB] && Random(3)==0)
+				if(player.spellXP[ITM_WHOTPANTS-ITM_WBOMB] && bulletRng.Random(3)==0)
 				{
-					FireBullet(me->x,me->y,(byte)Random(256),BLT_THFFIRE);
+					FireBullet(me->x,me->y,(byte)bulletRng.Random(256),BLT_THFFIRE);
 				}
 			}
 
@@ -2669,6 +2673,7 @@ void UpdateBullets(Map *map,world_t *world)
 {
 	int i;
 	static byte updFlip=0,thornFlip=0;
+	PERF_SCOPE("bullets");
 
 	updFlip++;
 	if(updFlip==4)
@@ -2813,11 +2818,11 @@ void FireMe(bullet_t *me,int x,int y,byte facing,byte type)
 			me->z=FIXAMT*20;
 			me->dx=Cosine(me->facing)*11;
 			me->dy=Sine(me->facing)*11;
-			me->dz=-FIXAMT+Random(FIXAMT*6);
+			me->dz=-FIXAMT+bulletRng.Random(FIXAMT*6);
 			if(opt.cheats[CH_FROGWPN])
 				me->anim=2;
 			else
-				me->anim=(byte)Random(8);
+				me->anim=(byte)bulletRng.Random(8);
 			if(player.fireFlags&FF_HOMING)
 				me->target=LockOnEvil(me->x>>FIXSHIFT,me->y>>FIXSHIFT);
 			break;
@@ -2830,8 +2835,8 @@ void FireMe(bullet_t *me,int x,int y,byte facing,byte type)
 			break;
 		case BLT_EVILFACE:
 			me->anim=0;
-			me->dx=-FIXAMT+Random(FIXAMT*2);
-			me->dy=-FIXAMT-Random(FIXAMT*2);
+			me->dx=-FIXAMT+bulletRng.Random(FIXAMT*2);
+			me->dy=-FIXAMT-bulletRng.Random(FIXAMT*2);
 			me->dz=0;
 			me->z=40*FIXAMT;
 			me->timer=30*10;
@@ -2953,14 +2958,14 @@ void FireMe(bullet_t *me,int x,int y,byte facing,byte type)
 			me->anim=facing;
 			me->timer=30*5;
 			me->z=FIXAMT*20;
-			me->facing=(byte)Random(256);
-			me->bright=(byte)Random(5);
+			me->facing=(byte)bulletRng.Random(256);
+			me->bright=(byte)bulletRng.Random(5);
 			me->dx=Cosine(me->facing)*me->bright;
 			me->dy=Sine(me->facing)*me->bright;
-			me->dz=Random(FIXAMT*4);
+			me->dz=bulletRng.Random(FIXAMT*4);
 			if(me->anim>=ITM_BATDOLL && me->anim<=ITM_WOLFDOLL)
 			{
-				me->bright=(byte)Random(3);
+				me->bright=(byte)bulletRng.Random(3);
 				me->timer=30*20;
 				me->dx=Cosine(me->facing)*me->bright;
 				me->dy=Sine(me->facing)*me->bright;
@@ -2981,7 +2986,7 @@ void FireMe(bullet_t *me,int x,int y,byte facing,byte type)
 			me->anim=0;
 			me->timer=60;
 			me->z=FIXAMT*20;
-			me->facing=(byte)Random(256);
+			me->facing=(byte)bulletRng.Random(256);
 			me->dx=Cosine(me->facing)*2;
 			me->dy=Sine(me->facing)*2;
 			me->dz=0;
@@ -3159,7 +3164,7 @@ void FireMe(bullet_t *me,int x,int y,byte facing,byte type)
 			me->anim=0;
 			me->timer=120;
 			me->z=FIXAMT*60;
-			i=Random(8)+1;
+			i=bulletRng.Random(8)+1;
 			me->dx=Cosine(me->facing)*i;
 			me->dy=Sine(me->facing)*i;
 			me->dz=20*FIXAMT;
@@ -3412,7 +3417,7 @@ void GetKicked(bullet_t *me)
 			if(ballSoundClock==0)
 			{
 				if(opt.cheats[CH_KICKCAT])
-					MakeSound(SND_CATDRIBBLE+Random(2),me->x,me->y,SND_CUTOFF,300);
+					MakeSound(SND_CATDRIBBLE+bulletRng.Random(2),me->x,me->y,SND_CUTOFF,300);
 				else
 					MakeSound(SND_BALLDRIBBLE,me->x,me->y,SND_CUTOFF,300);
 				ballSoundClock=5;
@@ -3435,7 +3440,7 @@ void GetKicked(bullet_t *me)
 		if(ballSoundClock==0)
 		{
 			if(opt.cheats[CH_KICKCAT])
-				MakeSound(SND_CATDRIBBLE+Random(2),me->x,me->y,SND_CUTOFF,300);
+				MakeSound(SND_CATDRIBBLE+bulletRng.Random(2),me->x,me->y,SND_CUTOFF,300);
 			else
 				MakeSound(SND_BALLDRIBBLE,me->x,me->y,SND_CUTOFF,300);
 			ballSoundClock=5;
@@ -3443,7 +3448,7 @@ void GetKicked(bullet_t *me)
 		if(c==10)
 		{
 			// couldn't determine an angle
-			me->facing=(byte)Random(256);
+			me->facing=(byte)bulletRng.Random(256);
 			me->dx/=2;
 			me->dy/=2;
 			me->dx+=Cosine(me->facing)*4;
@@ -3512,7 +3517,7 @@ void ThrowBall(void)
 				MakeSound(SND_BALLKICK,bullet[i].x,bullet[i].y,SND_CUTOFF,300);
 			bullet[i].dz=FIXAMT*6;
 			bullet[i].dy=FIXAMT*10;
-			bullet[i].dx=-FIXAMT*4+Random(FIXAMT*8);
+			bullet[i].dx=-FIXAMT*4+bulletRng.Random(FIXAMT*8);
 			bullet[i].target=65535;
 			ballSteerClock=0;
 			return;
@@ -3,6 +3,7 @@
 #include "jamulfmv.h"
 #include "game.h"
 #include "options.h"
+#include "perf.h"
 
 mfont_t  *gameFont[3]={NULL,NULL,NULL};
 MGLDraw  *mgl=NULL;
@@ -42,6 +43,7 @@ bool InitDisplay(MGLDraw *mainmgl)
 	if(FontLoad("graphics/verdana.jft",gameFont[1])!=FONT_OK)
 		return false;
 	cursor[0] = RightBraceHack(gameFont[1]);
+	PerfSetFont(gameFont[1]);
 
 	gameFont[2]=(mfont_t *)malloc(sizeof(mfont_t));
 	if(!gameFont[2])
@@ -57,6 +59,7 @@ bool InitDisplay(MGLDraw *mainmgl)
 
 void ExitDisplay(void)
 {
+	PerfSetFont(NULL);
 	if(gameFont[0])
 	{
 		FontFree(gameFont[0]);
@@ -575,9 +578,11 @@ void DisplayList::ClearList(void)
 
 void DisplayList::Render(void)
 {
-	int i;
+	int i,n;
+	PERF_SCOPE("sprite draw");
 
 	i=head;
+	n=0;
 
 	while(i!=-1)
 	{
@@ -679,7 +684,9 @@ void DisplayList::Render(void)
 			}
 		}
 		i=dispObj[i].next;
+		n++;
 	}
+	PerfCount("display objects",n);
 }
 
 void DrawBox(int x,int y,int x2,int y2,byte c)
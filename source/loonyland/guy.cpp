@@ -10,6 +10,7 @@
 #include "ch_witch.h"
 #include "bossbash.h"
 #include "ch_summon.h"
+#include "perf.h"
 
 Guy **guys;
 Guy *goodguy;
@@ -1330,6 +1331,17 @@ void Guy::GetShot(int dx,int dy,byte damage,Map *map,world_t *world)
 
 //-----------------------------------------------------------------------
 
+static int LiveGuys(void)
+{
+	int i,n;
+
+	n=0;
+	for(i=0;i<maxGuys;i++)
+		if(guys[i]->type)
+			n++;
+	return n;
+}
+
 void InitGuys(int max)
 {
 	int i;
@@ -1340,6 +1352,7 @@ void InitGuys(int max)
 	for(i=0;i<maxGuys;i++)
 		guys[i]=new Guy();
 	goodguy=NULL;
+	PerfWatch("guys alive",LiveGuys);
 }
 
 void ExitGuys(void)
@@ -1357,6 +1370,7 @@ void ExitGuys(void)
 		free(guys);
 		guys=NULL;
 	}
+	PerfWatch("guys alive",NULL);
 }
 
 void UpdateGuys(Map *map,world_t *world)
@@ -1364,6 +1378,7 @@ void UpdateGuys(Map *map,world_t *world)
 	int i,j,preLife;
 	static byte filmflip;
 	byte numRuns,numRenders;
+	PERF_SCOPE("guys");
 
 	UpdateMonsterTypes();
 
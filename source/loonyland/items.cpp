@@ -1,5 +1,6 @@
 #include "items.h"
 #include "display.h"
+#include "perf.h"
 
 item_t itemInfo[MAX_ITMS]={
 	{0,0,0,0,0},
@@ -177,6 +178,7 @@ char *WeaponName(byte w)
 
 void UpdateItems(void)
 {
+	PERF_SCOPE("items");
 	itemAnim++;
 	if(itemAnim>4095)
 		itemAnim=0;
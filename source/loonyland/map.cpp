@@ -6,6 +6,7 @@
 #include "options.h"
 #include "quest.h"
 #include "badge.h"
+#include "perf.h"
 
 #define NUM_STARS 400
 
@@ -237,6 +238,7 @@ void Map::Update(byte mode,world_t *world)
 	int i,x,y;
 	static byte timeToReset=0;
 	static byte timeToAnim=0;
+	PERF_SCOPE("map");
 
 	timeToReset++;
 	if(timeToReset<2)
@@ -894,6 +896,7 @@ void Map::Clone(int sx,int sy,int blkwidth,int blkheight,int dx,int dy)
 void Map::Render(world_t *world,int camX,int camY,byte flags)
 {
 	int i,j;
+	PERF_SCOPE("map draw");
 
 	int tileX,tileY;
 	int ofsX,ofsY;
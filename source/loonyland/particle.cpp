@@ -2,6 +2,11 @@
 #include "bullet.h"
 #include "monster.h"
 #include "options.h"
+#include "perf.h"
+#include "randstream.h"
+
+static RandomStream particleRng(RAND_PARTICLE);
+static RandomStream renderRng(RAND_RENDER);	// rolls made while drawing, so frames drawn or skipped don't move particleRng
 
 Particle **particleList;
 int		maxParticles;
@@ -29,13 +34,13 @@ void Particle::Go(byte type,int x,int y,int z,byte angle,byte force)
 
 	if(fforce==0)
 		fforce=1;
-	this->x=x+Random(4<<FIXSHIFT)-(2<<FIXSHIFT);
-	this->y=y+Random(4<<FIXSHIFT)-(2<<FIXSHIFT);
+	this->x=x+particleRng.Random(4<<FIXSHIFT)-(2<<FIXSHIFT);
+	this->y=y+particleRng.Random(4<<FIXSHIFT)-(2<<FIXSHIFT);
 	this->z=z;
-	this->dx=Cosine(angle)*Random(fforce);
-	this->dy=Sine(angle)*Random(fforce);
-	this->dz=Random(fforce*2)<<FIXSHIFT;
-	this->life=Random(force)+10;
+	this->dx=Cosine(angle)*particleRng.Random(fforce);
+	this->dy=Sine(angle)*particleRng.Random(fforce);
+	this->dz=particleRng.Random(fforce*2)<<FIXSHIFT;
+	this->life=particleRng.Random(force)+10;
 }
 
 void Particle::GoLightning(int x,int y,int x2,int y2)
@@ -57,13 +62,13 @@ void Particle::GoRandom(byte type,int x,int y,int z,byte force)
 	if(force==0)
 		return;
 
-	this->x=x+Random(32<<FIXSHIFT)-(16<<FIXSHIFT);
-	this->y=y+Random(32<<FIXSHIFT)-(16<<FIXSHIFT);
+	this->x=x+particleRng.Random(32<<FIXSHIFT)-(16<<FIXSHIFT);
+	this->y=y+particleRng.Random(32<<FIXSHIFT)-(16<<FIXSHIFT);
 	this->z=z;
-	this->dx=(Random(force)-force/2)<<FIXSHIFT;
-	this->dy=(Random(force)-force/2)<<FIXSHIFT;
-	this->dz=Random(force*2)<<FIXSHIFT;
-	this->life=Random(force)+20;
+	this->dx=(particleRng.Random(force)-force/2)<<FIXSHIFT;
+	this->dy=(particleRng.Random(force)-force/2)<<FIXSHIFT;
+	this->dz=particleRng.Random(force*2)<<FIXSHIFT;
+	this->life=particleRng.Random(force)+20;
 }
 
 void Particle::Update(Map *map)
@@ -186,8 +191,8 @@ void Particle::Update(Map *map)
 					size=1;
 				break;
 			case PART_SNOW:
-				dx+=Random(FIXAMT)-FIXAMT/2;
-				dy+=Random(FIXAMT)-FIXAMT/2;
+				dx+=particleRng.Random(FIXAMT)-FIXAMT/2;
+				dy+=particleRng.Random(FIXAMT)-FIXAMT/2;
 				Dampen(&dx,FIXAMT/8);
 				Dampen(&dy,FIXAMT/8);
 				dz+=FIXAMT*15/16;	// not as much gravity as other things
@@ -236,11 +241,11 @@ void Particle::Update(Map *map)
 					color-=2;
 				break;
 			case PART_FIRE:
-				dz+=FIXAMT+Random(FIXAMT/4);
+				dz+=FIXAMT+particleRng.Random(FIXAMT/4);
 				Dampen(&dx,FIXAMT/8);
 				Dampen(&dy,FIXAMT/8);
-				dx=dx-FIXAMT/8+Random(FIXAMT/4);
-				dy=dy-FIXAMT/8+Random(FIXAMT/4);
+				dx=dx-FIXAMT/8+particleRng.Random(FIXAMT/4);
+				dy=dy-FIXAMT/8+particleRng.Random(FIXAMT/4);
 				if(size>0)
 					size--;
 				else
@@ -253,11 +258,11 @@ void Particle::Update(Map *map)
 					color=128+life;
 				break;
 			case PART_COLDFIRE:
-				dz+=FIXAMT+Random(FIXAMT/4);
+				dz+=FIXAMT+particleRng.Random(FIXAMT/4);
 				Dampen(&dx,FIXAMT/8);
 				Dampen(&dy,FIXAMT/8);
-				dx=dx-FIXAMT/8+Random(FIXAMT/4);
-				dy=dy-FIXAMT/8+Random(FIXAMT/4);
+				dx=dx-FIXAMT/8+particleRng.Random(FIXAMT/4);
+				dy=dy-FIXAMT/8+particleRng.Random(FIXAMT/4);
 				if(size>0)
 					size--;
 				else
@@ -331,6 +336,7 @@ void ExitParticles(void)
 void UpdateParticles(Map *map)
 {
 	int i;
+	PERF_SCOPE("particles");
 
 	snowCount=0;
 	for(i=0;i<maxParticles;i++)
@@ -620,12 +626,12 @@ void RenderLightningParticle(int x1,int y1,int x2,int y2,int range,byte bright,b
 			midx=x1+(x2-x1)/2;
 		else
 			midx=x2+(x1-x2)/2;
-		midx+=Random(range)-range/2;
+		midx+=renderRng.Random(range)-range/2;
 		if(y1<y2)
 			midy=y1+(y2-y1)/2;
 		else
 			midy=y2+(y1-y2)/2;
-		midy+=Random(range)-range/2;
+		midy+=renderRng.Random(range)-range/2;
 		RenderLightningParticle(x1,y1,midx,midy,range*3/4,bright,scrn);
 		RenderLightningParticle(midx,midy,x2,y2,range*3/4,bright,scrn);
 	}
@@ -645,7 +651,7 @@ void RenderParticles(void)
 								particleList[i]->color,(char)particleList[i]->size);
 			else if(particleList[i]->type==PART_CIRCLE)
 				ParticleDraw(particleList[i]->x>>FIXSHIFT,particleList[i]->y>>FIXSHIFT,
-							 particleList[i]->z>>FIXSHIFT,particleList[i]->color,(byte)Random(particleList[i]->size+1),
+							 particleList[i]->z>>FIXSHIFT,particleList[i]->color,(byte)renderRng.Random(particleList[i]->size+1),
 							 DISPLAY_DRAWME|DISPLAY_CIRCLEPART);
 			else if(particleList[i]->type==PART_RING)
 				ParticleDraw(particleList[i]->x>>FIXSHIFT,particleList[i]->y>>FIXSHIFT,
@@ -724,16 +730,16 @@ void MakeRingParticle(int x,int y, int z,byte size,byte cnt)
 	{
 		if(!particleList[i]->Alive())
 		{
-			ang=(byte)Random(256);
+			ang=(byte)particleRng.Random(256);
 			particleList[i]->x=x+Cosine(ang)*size;
 			particleList[i]->y=y+Sine(ang)*size;
 			particleList[i]->z=z;
 			particleList[i]->dx=0;
 			particleList[i]->dy=0;
-			particleList[i]->dz=Random(FIXAMT*2);
+			particleList[i]->dz=particleRng.Random(FIXAMT*2);
 			particleList[i]->color=191;
-			particleList[i]->life=10+(byte)Random(30);
-			particleList[i]->size=8*4+(byte)Random(4*4);
+			particleList[i]->life=10+(byte)particleRng.Random(30);
+			particleList[i]->size=8*4+(byte)particleRng.Random(4*4);
 			particleList[i]->type=PART_FIRE;
 			cnt--;
 			if(!cnt)
@@ -757,10 +763,10 @@ void MakeColdRingParticle(int x,int y, int z,byte size)
 			particleList[i]->z=z;
 			particleList[i]->dx=0;
 			particleList[i]->dy=0;
-			particleList[i]->dz=Random(FIXAMT*2);
+			particleList[i]->dz=particleRng.Random(FIXAMT*2);
 			particleList[i]->color=31;
-			particleList[i]->life=10+Random(30);
-			particleList[i]->size=8*4+(byte)Random(4*4);
+			particleList[i]->life=10+particleRng.Random(30);
+			particleList[i]->size=8*4+(byte)particleRng.Random(4*4);
 			particleList[i]->type=PART_COLDFIRE;
 			ang++;
 			if(!ang)
@@ -777,12 +783,12 @@ void GlassShatter(int x,int y,int x2,int y2,int z,byte amt)
 	{
 		if(!particleList[i]->Alive())
 		{
-			particleList[i]->x=(x+Random(x2-x));
-			particleList[i]->y=(y+Random(y2-y));
+			particleList[i]->x=(x+particleRng.Random(x2-x));
+			particleList[i]->y=(y+particleRng.Random(y2-y));
 			particleList[i]->z=z;
-			particleList[i]->GoRandom(PART_GLASS,(x+Random(x2-x)),(y+Random(y2-y)),
-					Random(10*FIXAMT),20);
-			particleList[i]->color=(byte)Random(8)*32+16;
+			particleList[i]->GoRandom(PART_GLASS,(x+particleRng.Random(x2-x)),(y+particleRng.Random(y2-y)),
+					particleRng.Random(10*FIXAMT),20);
+			particleList[i]->color=(byte)particleRng.Random(8)*32+16;
 			if(!(--amt))
 				break;
 		}
@@ -858,7 +864,7 @@ void MakeItSnow(Map *map)
 	int cx,cy;
 
 	// only 25% of particles may be snowflakes
-	if(Random(100)>30 || snowCount>maxParticles/4)
+	if(particleRng.Random(100)>30 || snowCount>maxParticles/4)
 		return;
 
 	GetCamera(&cx,&cy);
@@ -869,14 +875,14 @@ void MakeItSnow(Map *map)
 		if(!particleList[i]->Alive())
 		{
 
-			particleList[i]->x=(Random(640)+cx)<<FIXSHIFT;
-			particleList[i]->y=(Random(480)+cy)<<FIXSHIFT;
-			particleList[i]->z=(300+Random(300))<<FIXSHIFT;
+			particleList[i]->x=(particleRng.Random(640)+cx)<<FIXSHIFT;
+			particleList[i]->y=(particleRng.Random(480)+cy)<<FIXSHIFT;
+			particleList[i]->z=(300+particleRng.Random(300))<<FIXSHIFT;
 			particleList[i]->dx=0;
 			particleList[i]->dy=0;
 			particleList[i]->dz=0;
 			particleList[i]->size=2;
-			particleList[i]->life=50+Random(50);
+			particleList[i]->life=50+particleRng.Random(50);
 			particleList[i]->type=PART_SNOW;
 			particleList[i]->color=31;
 			break;
@@ -893,14 +899,14 @@ void SpecialSnow(int x,int y)
 		if(!particleList[i]->Alive())
 		{
 
-			particleList[i]->x=x-FIXAMT*10+Random(FIXAMT*20);
-			particleList[i]->y=y-FIXAMT*10+Random(FIXAMT*20);
-			particleList[i]->z=(50+Random(20))<<FIXSHIFT;
+			particleList[i]->x=x-FIXAMT*10+particleRng.Random(FIXAMT*20);
+			particleList[i]->y=y-FIXAMT*10+particleRng.Random(FIXAMT*20);
+			particleList[i]->z=(50+particleRng.Random(20))<<FIXSHIFT;
 			particleList[i]->dx=0;
 			particleList[i]->dy=0;
 			particleList[i]->dz=0;
 			particleList[i]->size=2;
-			particleList[i]->life=20+Random(30);
+			particleList[i]->life=20+particleRng.Random(30);
 			particleList[i]->type=PART_SNOW;
 			break;
 		}
@@ -926,20 +932,20 @@ void Burn(int x,int y,int z)
 	int i;
 	byte num;
 
-	num=(byte)Random(8)+1;
+	num=(byte)particleRng.Random(8)+1;
 	for(i=0;i<maxParticles;i++)
 	{
 		if(!particleList[i]->Alive())
 		{
-			particleList[i]->x=x-FIXAMT*2+Random(FIXAMT*4);
+			particleList[i]->x=x-FIXAMT*2+particleRng.Random(FIXAMT*4);
 			particleList[i]->y=y;
-			particleList[i]->z=z-FIXAMT*2+Random(FIXAMT*4);
-			particleList[i]->dx=-FIXAMT*2+Random(FIXAMT*4);
+			particleList[i]->z=z-FIXAMT*2+particleRng.Random(FIXAMT*4);
+			particleList[i]->dx=-FIXAMT*2+particleRng.Random(FIXAMT*4);
 			particleList[i]->dy=0;
-			particleList[i]->dz=Random(FIXAMT*2);
+			particleList[i]->dz=particleRng.Random(FIXAMT*2);
 			particleList[i]->color=191;
-			particleList[i]->life=10+Random(30);
-			particleList[i]->size=8*4+(byte)Random(4*4);
+			particleList[i]->life=10+particleRng.Random(30);
+			particleList[i]->size=8*4+(byte)particleRng.Random(4*4);
 			particleList[i]->type=PART_FIRE;
 			if(--num==0)
 				break;
@@ -1,4 +1,5 @@
 #include "tile.h"
+#include "jamulspr.h"
 
 tile_t tiles[NUMTILES];
 MGLDraw *tileMGL;
@@ -46,17 +47,11 @@ void LoadTiles(FILE *f)
 	fread(tiles,NUMTILES,sizeof(tile_t),f);
 }
 
-// defined in jamulspr.cpp
-extern byte SprModifyColor(byte color, byte hue);
-extern byte SprGetColor(byte color);
-extern byte SprModifyLight(byte color, char bright);
-extern byte SprModifyGhost(byte src, byte dst, char bright);
-extern byte SprModifyGlow(byte src, byte dst, char bright);
-
 void RenderFloorTile(int x,int y,int t,char light)
 {
 	byte *dst,*src;
 	int wid,hgt;
+	const byte *lit = SprLightTable(light);
 
 	if(light==0)
 	{
@@ -122,7 +117,7 @@ void RenderFloorTile(int x,int y,int t,char light)
 		hgt--;
 		for (int i = 0; i < wid; ++i)
 		{
-			dst[i] = SprModifyLight(src[i], light);
+			dst[i] = lit[src[i]];
 		}
 		dst += 640;
 		src += 32;
@@ -134,6 +129,8 @@ void RenderFloorTileShadow(int x,int y,int t,char light)
 	byte *dst,*src;
 	int wid,hgt;
 	int darkpart;
+	const byte *lit = SprLightTable(light);
+	const byte *dark = SprLightTable(light - 4);
 
 	if(x<0)
 	{
@@ -188,7 +185,7 @@ void RenderFloorTileShadow(int x,int y,int t,char light)
 		hgt--;
 		for (int i = 0; i < wid; ++i)
 		{
-			dst[i] = SprModifyLight(src[i], light - 4 * (i > wid - darkpart));
+			dst[i] = (i > wid - darkpart ? dark : lit)[src[i]];
 		}
 		dst += 640;
 		src += 32;
@@ -254,6 +251,7 @@ void RenderFloorTileTrans(int x,int y,int t,char light)
 {
 	byte *dst,*src;
 	int wid,hgt;
+	const byte *lit = SprLightTable(light);
 
 	if(x<0)
 	{
@@ -301,7 +299,7 @@ void RenderFloorTileTrans(int x,int y,int t,char light)
 		hgt--;
 		for (int i = 0; i < wid; ++i)
 		{
-			if (src[i]) dst[i] = SprModifyLight(src[i], light);
+			if (src[i]) dst[i] = lit[src[i]];
 		}
 		dst += 640;
 		src += 32;
@@ -4,6 +4,7 @@
 #include "player.h"
 #include "game.h"
 #include "quest.h"
+#include "radar.h"
 
 void PlantAsbestos(Map *map,world_t *world,byte amt)
 {
@@ -21,6 +22,7 @@ void PlantAsbestos(Map *map,world_t *world,byte amt)
 		{
 			amt--;
 			map->map[x+y*map->width].item=IT_BURIEDASB;
+			Radar_ItemChanged(map,x,y);
 		}
 	}
 }
@@ -43,6 +45,7 @@ void PlantBubbleweed(Map *map,world_t *world,byte amt)
 		{
 			amt--;
 			map->map[x+y*map->width].item=IT_HERBB;
+			Radar_ItemChanged(map,x,y);
 		}
 	}
 }
@@ -63,6 +66,7 @@ void PlantCilantro(Map *map,world_t *world,byte amt)
 		{
 			amt--;
 			map->map[x+y*map->width].item=IT_HERBC;
+			Radar_ItemChanged(map,x,y);
 		}
 	}
 }
@@ -84,6 +88,7 @@ void PlantDevilgrass(Map *map,world_t *world,byte amt)
 		{
 			amt--;
 			map->map[x+y*map->width].item=IT_HERBD;
+			Radar_ItemChanged(map,x,y);
 		}
 	}
 }
@@ -103,6 +108,7 @@ void PlantElderberry(Map *map,world_t *world,byte amt)
 		{
 			amt--;
 			map->map[x+y*map->width].item=IT_HERBE;
+			Radar_ItemChanged(map,x,y);
 		}
 	}
 }
@@ -123,6 +129,7 @@ void PlantFrostbane(Map *map,world_t *world,byte amt)
 		{
 			amt--;
 			map->map[x+y*map->width].item=IT_HERBF;
+			Radar_ItemChanged(map,x,y);
 		}
 	}
 }
@@ -143,9 +150,15 @@ void AddCracks(Map *map,world_t *world,byte amt)
 		{
 			amt--;
 			if(player.levelNum>=LVL_GEYSER && player.levelNum<=LVL_TITANS)	// underground, use undercracks
+			{
 				map->map[x+y*map->width].item=IT_CRACKUNDER;
+				Radar_ItemChanged(map,x,y);
+			}
 			else
+			{
 				map->map[x+y*map->width].item=IT_CRACK;
+				Radar_ItemChanged(map,x,y);
+			}
 		}
 	}
 	if(player.levelNum==LVL_WESTWOOD && player.var[VAR_QUESTASSIGN+QUEST_SUPPLIES] && !player.var[VAR_QUESTDONE+QUEST_SUPPLIES] &&
@@ -162,6 +175,7 @@ void AddCracks(Map *map,world_t *world,byte amt)
 			{
 				amt--;
 				map->map[x+y*map->width].item=IT_SUPCRACK;
+				Radar_ItemChanged(map,x,y);
 			}
 		}
 	}
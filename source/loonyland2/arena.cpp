@@ -1,4 +1,5 @@
 #include "arena.h"
+#include "radar.h"
 #include "leveldef.h"
 #include "monster.h"
 #include "player.h"
@@ -1455,6 +1456,7 @@ void ScatterSwords(Map *map)
 		if(map->map[i].wall==0 && map->map[i].item==0 && (map->map[i+map->width].wall==0))
 		{
 			map->map[i].item=IT_SWORD;
+			Radar_ItemChanged(map,i%map->width,i/map->width);
 			n--;
 		}
 	}
@@ -1566,19 +1568,12 @@ void UpdateArena(void)
 
 	if((arenaMatch[player.arenaLvl].flags&AF_HEALING) && (player.arenaTime%10)==0)
 	{
-		word w;
-
-		w=GuyList_First();
-		while(w!=65535)
+		for(Guy *g : GuyQuery().Team(EVIL).Alive())
 		{
-			if(GetGuy(w)->type && GetGuy(w)->team==EVIL && GetGuy(w)->hp)
-			{
-				if(player.var[VAR_MADCAP])
-					HealGuy(GetGuy(w),10);
-				else
-					HealGuy(GetGuy(w),1);
-			}
-			w=GuyList_Next();
+			if(player.var[VAR_MADCAP])
+				HealGuy(g,10);
+			else
+				HealGuy(g,1);
 		}
 	}
 
@@ -8,6 +8,12 @@
 #include "alchemy.h"
 #include "leveldef.h"
 #include "madcap.h"
+#include "hamworld.h"
+#include <stdexcept>
+#include "perf.h"
+#include "randstream.h"
+
+static RandomStream bulletRng(RAND_BULLET);
 
 bullet_t bullet[MAX_BULLETS];
 sprite_set_t *bulletSpr;
@@ -1426,16 +1432,16 @@ void BulletHitWall(byte y,bullet_t *me,Map *map,world_t *world)
 			if(y)
 			{
 				if(me->dy<0)
-					me->facing=(byte)Random(128);	// an angle on the bottom side
+					me->facing=(byte)bulletRng.Random(128);	// an angle on the bottom side
 				else
-					me->facing=(byte)Random(128)+128;	// an angle on the top side
+					me->facing=(byte)bulletRng.Random(128)+128;	// an angle on the top side
 			}
 			else
 			{
 				if(me->dx<0)
-					me->facing=(byte)Random(128)+192;	// an angle on the right side
+					me->facing=(byte)bulletRng.Random(128)+192;	// an angle on the right side
 				else
-					me->facing=(byte)Random(128)+64;	// an angle on the left side
+					me->facing=(byte)bulletRng.Random(128)+64;	// an angle on the left side
 			}
 			me->dx=Cosine(me->facing)*me->speed/FIXAMT;
 			me->dy=Sine(me->facing)*me->speed/FIXAMT;
@@ -1547,7 +1553,7 @@ void BulletHitFloor(bullet_t *me,Map *map,world_t *world)
 		case BH_RNDBOUNCE:	// bounce in a random direction, V=amount of speed to keep, 255=all
 			me->speed=(short)((int)(me->speed*bulDef[me->type].flrFriction)/255);
 			me->dz=-(short)((int)(me->dz*bulDef[me->type].flrValue)/255);
-			me->facing=(byte)Random(256);
+			me->facing=(byte)bulletRng.Random(256);
 			me->dx=Cosine(me->facing)*me->speed/FIXAMT;
 			me->dy=Sine(me->facing)*me->speed/FIXAMT;
 			break;
@@ -1660,7 +1666,7 @@ void BulletHitAGuy(bullet_t *me,Map *map,world_t *world)
 			break;
 		case BH_RNDBOUNCE:	// bounce in a random direction, V=amount of speed to keep, 255=all
 			me->speed=(short)((int)(me->speed*bulDef[me->type].hitValue)/255);
-			me->facing=me->facing+128-64+(byte)Random(129);	// any direction that is within 90 degrees either way of the opposite of your original heading
+			me->facing=me->facing+128-64+(byte)bulletRng.Random(129);	// any direction that is within 90 degrees either way of the opposite of your original heading
 			me->dx=Cosine(me->facing)*me->speed/FIXAMT;
 			me->dy=Sine(me->facing)*me->speed/FIXAMT;
 			break;
@@ -1845,7 +1851,7 @@ void HitBadguys(bullet_t *me,Map *map,world_t *world)
 
 		if(bulDef[me->type].flags&BF_RANDHITDIR)
 		{
-			f=(byte)Random(256);
+			f=(byte)bulletRng.Random(256);
 		}
 		else
 			f=me->facing;
@@ -2373,6 +2379,7 @@ void RenderBullet(bullet_t *me)
 void UpdateBullets(Map *map,world_t *world)
 {
 	int i;
+	PERF_SCOPE("bullets");
 
 	itmBright+=itmDBright;
 	if(itmBright>4 || itmBright==0)
@@ -2547,6 +2554,87 @@ void LoadBullets(FILE *f)
 	}
 }
 
+static void SaveBullet(hamworld::Section *f, const bullet_t *b)
+{
+	f->write_varint(b->type);
+	f->write_svarint(b->x);
+	f->write_svarint(b->y);
+	f->write_svarint(b->z);
+	f->write_svarint(b->dx);
+	f->write_svarint(b->dy);
+	f->write_svarint(b->dz);
+	f->write_svarint(b->speed);
+	f->write_varint(b->timer);
+	f->write_svarint(b->target);
+	f->write_svarint(b->owner);
+	f->write_varint(b->anim);
+	f->write_varint(b->frame);
+	f->write_varint(b->facing);
+	f->write_varint(b->bright);
+	f->write_varint(b->team);
+	f->write_varint(b->damage);
+	f->write_varint(b->nohit);
+	f->write_svarint(b->canthit);
+	f->write_varint(b->pSpawnTimer);
+	f->write_varint(b->bSpawnTimer);
+	f->write_varint(b->bounces);
+	f->write_varint(b->pierces);
+	f->write_varint(0);  // no extension flags
+}
+
+static void LoadBullet(hamworld::Section *f, bullet_t *b)
+{
+	b->type = f->read_varint();
+	b->x = f->read_svarint();
+	b->y = f->read_svarint();
+	b->z = f->read_svarint();
+	b->dx = f->read_svarint();
+	b->dy = f->read_svarint();
+	b->dz = f->read_svarint();
+	b->speed = f->read_svarint();
+	b->timer = f->read_varint();
+	b->target = f->read_svarint();
+	b->owner = f->read_svarint();
+	b->anim = f->read_varint();
+	b->frame = f->read_varint();
+	b->facing = f->read_varint();
+	b->bright = f->read_varint();
+	b->team = f->read_varint();
+	b->damage = f->read_varint();
+	b->nohit = f->read_varint();
+	b->canthit = f->read_svarint();
+	b->pSpawnTimer = f->read_varint();
+	b->bSpawnTimer = f->read_varint();
+	b->bounces = f->read_varint();
+	b->pierces = f->read_varint();
+	f->read_varint();  // ignore extension flags
+}
+
+void SaveBullets(hamworld::Section *f)
+{
+	size_t count = 0;
+	for (int i = 0; i < MAX_BULLETS; ++i)
+		if (bullet[i].type)
+			++count;
+
+	f->write_varint(count);
+	for (int i = 0; i < MAX_BULLETS; ++i)
+		if (bullet[i].type)
+			SaveBullet(f, &bullet[i]);
+}
+
+void LoadBullets(hamworld::Section *f)
+{
+	for (int i = 0; i < MAX_BULLETS; ++i)
+		bullet[i].type = BLT_NONE;
+
+	size_t count = f->read_varint();
+	if (count > MAX_BULLETS)
+		throw std::runtime_error("too many bullets in saved game");
+	for (size_t i = 0; i < count; ++i)
+		LoadBullet(f, &bullet[i]);
+}
+
 void SmashTrees(int owner,int x,int y,int radius,Map *map)
 {
 	byte n;
@@ -11,6 +11,8 @@
 #include "particle.h"
 #pragma pack(1)
 
+namespace hamworld { class Section; }
+
 // bullet traits
 #define BF_HITEVIL	(1)
 #define BF_HITGOOD	(2)
@@ -233,5 +235,7 @@ byte EatItem(int x,int y);
 
 void LoadBullets(FILE *f);
 void SaveBullets(FILE *f);
+void LoadBullets(hamworld::Section *f);
+void SaveBullets(hamworld::Section *f);
 
 #endif
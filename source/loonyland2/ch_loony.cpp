@@ -480,7 +480,6 @@ void CastSpell(Guy *me)
 	int i,x,y;
 	byte sp;
 	Guy *g;
-	word w;
 	bullet_t *b;
 
 	sp=player.spell;
@@ -550,39 +549,27 @@ void CastSpell(Guy *me)
 			}
 			break;
 		case SKILL_BONEBOMB:
-			w=GuyList_First();
-			while(w!=65535)
+			for(Guy *b : GuyQuery().Type(MONS_BONEHEAD).Alive())
 			{
-				if(GetGuy(w)->type==MONS_BONEHEAD && GetGuy(w)->hp)
-				{
-					MakeNormalSound(SND_BONEBOMB);
-					FireBullet(goodguy->ID,GetGuy(w)->x,GetGuy(w)->y,0,0,BLT_BONEBOOM,(word)(SpecificSkillVal(0,SKILL_BONEBOMB)*(SpellDamageBoost(SC_DEATH))/100.0f));
-					GetGuy(w)->hp=1;
-					meleeAttacker=NULL;
-					GetGuy(w)->GetShotReal(0,0,9999,curMap,&curWorld);
-				}
-
-				w=GuyList_Next();
+				MakeNormalSound(SND_BONEBOMB);
+				FireBullet(goodguy->ID,b->x,b->y,0,0,BLT_BONEBOOM,(word)(SpecificSkillVal(0,SKILL_BONEBOMB)*(SpellDamageBoost(SC_DEATH))/100.0f));
+				b->hp=1;
+				meleeAttacker=NULL;
+				b->GetShotReal(0,0,9999,curMap,&curWorld);
 			}
 			break;
 		case SKILL_SHROOM:
-			w=GuyList_First();
-			while(w!=65535)
+			for(Guy *s : GuyQuery().NotTeam(me->team).Alive().Radius(me->x,me->y,(int)SpecificSkillVal(1,SKILL_SHROOM)*FIXAMT))
 			{
-				if(GetGuy(w)->team!=me->team && GetGuy(w)->hp && !(monsType[GetGuy(w)->type].flags&(MF_INVINCIBLE|MF_NOHIT)) && !(monsType[GetGuy(w)->type].location&(ML_BOSS|ML_NOMIND)) && (GetGuy(w)->type!=MONS_SHROOM))
+				if(!(monsType[s->type].flags&(MF_INVINCIBLE|MF_NOHIT)) && !(monsType[s->type].location&(ML_BOSS|ML_NOMIND)) && (s->type!=MONS_SHROOM))
 				{
-					if(Distance(me->x,me->y,GetGuy(w)->x,GetGuy(w)->y)<(int)SpecificSkillVal(1,SKILL_SHROOM)*FIXAMT)
-					{
-						MakeSound(SND_SHROOMIFY,GetGuy(w)->x,GetGuy(w)->y,SND_CUTOFF|SND_RANDOM,200);
-						GetGuy(w)->originalType=GetGuy(w)->type;
-						GetGuy(w)->shroomTime=(word)SpecificSkillVal(0,SKILL_SHROOM);
-						GetGuy(w)->type=MONS_SHROOM;
-						DoMove(GetGuy(w),ANIM_IDLE,128,0,0,0);
-						MakeRingParticle(GetGuy(w)->x,GetGuy(w)->y,0,32,32);
-					}
+					MakeSound(SND_SHROOMIFY,s->x,s->y,SND_CUTOFF|SND_RANDOM,200);
+					s->originalType=s->type;
+					s->shroomTime=(word)SpecificSkillVal(0,SKILL_SHROOM);
+					s->type=MONS_SHROOM;
+					DoMove(s,ANIM_IDLE,128,0,0,0);
+					MakeRingParticle(s->x,s->y,0,32,32);
 				}
-
-				w=GuyList_Next();
 			}
 			if(TalentBonus(TLT_GREENTHUMB)>0)
 				HealGoodguy(RecoverAmt((word)(0.5f+TalentBonus(TLT_GREENTHUMB))));
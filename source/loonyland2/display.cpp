@@ -5,6 +5,7 @@
 #include "options.h"
 #include "items.h"
 #include "title.h"
+#include "perf.h"
 
 mfont_t  *gameFont[2]={NULL,NULL};
 MGLDraw  *mgl=NULL;
@@ -44,6 +45,7 @@ bool InitDisplay(MGLDraw *mainmgl)
 	if(FontLoad("graphics/verdana.jft",gameFont[1])!=FONT_OK)
 		return false;
 	cursor[0] = RightBraceHack(gameFont[1]);
+	PerfSetFont(gameFont[1]);
 
 	dispList=new DisplayList();
 
@@ -52,6 +54,7 @@ bool InitDisplay(MGLDraw *mainmgl)
 
 void ExitDisplay(void)
 {
+	PerfSetFont(NULL);
 	if(gameFont[0])
 	{
 		FontFree(gameFont[0]);
@@ -526,9 +529,11 @@ void DisplayList::ClearList(void)
 
 void DisplayList::Render(void)
 {
-	int i;
+	int i,n;
+	PERF_SCOPE("sprite draw");
 
 	i=head;
+	n=0;
 
 	while(i!=-1)
 	{
@@ -639,7 +644,9 @@ void DisplayList::Render(void)
 			}
 		}
 		i=dispObj[i].next;
+		n++;
 	}
+	PerfCount("display objects",n);
 }
 
 void DrawBox(int x,int y,int x2,int y2,byte c)
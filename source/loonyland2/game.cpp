@@ -74,6 +74,7 @@ void LunaticInit(MGLDraw *mgl)
 
 void LunaticExit(void)
 {
+	FinishSaveGame();
 	SaveOptions();
 	ExitChatStuff();
 	ExitWater();
@@ -1,6 +1,7 @@
 #include "guy.h"
 #include "player.h"
 #include "intface.h"
+#include "radar.h"
 #include "quest.h"
 #include "editor.h"
 #include "options.h"
@@ -14,10 +15,17 @@
 #include "achieve.h"
 #include "services.h"
 #include "config.h"
+#include "hamworld.h"
+#include <vector>
+#include <stdexcept>
+#include "perf.h"
 
 Guy **guys;
 Guy *goodguy;
 int maxGuys;
+// one bit per slot that may have a live guy in it.  Bits are set when a guy is
+// added and only cleared at the top of UpdateGuys, so it's never missing anyone.
+static std::vector<dword> guyLive;
 static byte checkActive=0;
 Guy *lifeGuy;
 Guy fakeGuy;
@@ -163,6 +171,7 @@ void TryToPush(Guy *me,int x,int y,Map *map,world_t *world)
 			// pushing an item
 			map->map[destx+desty*map->width].item=map->map[x+y*map->width].item;
 			map->map[x+y*map->width].item=IT_NONE;
+			Radar_ItemChanged(map,destx,desty);
 			SpecialItemGetCheck(map,destx,desty);
 			SpecialPushCheck(map,destx,desty);
 			SpecialPushCheck(map,x,y);
@@ -2480,6 +2489,17 @@ void Guy::GetShotReal(int dx,int dy,word damage,Map *map,world_t *world)
 
 //-----------------------------------------------------------------------
 
+static int LiveGuys(void)
+{
+	int i,n;
+
+	n=0;
+	for(i=0;i<maxGuys;i++)
+		if(guys[i]->type)
+			n++;
+	return n;
+}
+
 void InitGuys(int max)
 {
 	int i;
@@ -2489,7 +2509,9 @@ void InitGuys(int max)
 	guys=(Guy **)malloc(sizeof(Guy *)*maxGuys);
 	for(i=0;i<maxGuys;i++)
 		guys[i]=new Guy();
+	guyLive.assign((maxGuys+31)/32,0);
 	goodguy=NULL;
+	PerfWatch("guys alive",LiveGuys);
 }
 
 void ExitGuys(void)
@@ -2507,6 +2529,8 @@ void ExitGuys(void)
 		free(guys);
 		guys=NULL;
 	}
+	guyLive.clear();
+	PerfWatch("guys alive",NULL);
 }
 
 void UpdateGuys(Map *map,world_t *world)
@@ -2514,6 +2538,7 @@ void UpdateGuys(Map *map,world_t *world)
 	int i,j;
 	static byte filmflip,poisonTick=0,freezeTick=0;
 	byte numRuns,numRenders;
+	PERF_SCOPE("guys");
 
 	if(freezeTick<30*4-TalentBonus(TLT_FREEZING))	// 4 seconds minus 8 ticks per level of Freezing
 		freezeTick++;
@@ -2537,6 +2562,11 @@ void UpdateGuys(Map *map,world_t *world)
 		checkActive=0;
 	}
 
+	// forget the slots that have emptied out since last time
+	for(i=GuyList_Next(-1);i!=-1;i=GuyList_Next(i))
+		if(guys[i]->type==MONS_NONE)
+			guyLive[i/32]&=~(1u<<(i%32));
+
 	for(i=0;i<maxGuys;i++)
 	{
 		if(guys[i]->type!=MONS_NONE && guys[i]->IsActive(map))
@@ -2714,6 +2744,7 @@ Guy *AddGuy(int x,int y,int z,byte type)
 			guys[i]->frozen=0;
 			guys[i]->stun=0;
 			guys[i]->type=type;
+			guyLive[i/32]|=(1u<<(i%32));
 			guys[i]->safeX=x;
 			guys[i]->safeY=y;
 			guys[i]->x=x;
@@ -2854,6 +2885,7 @@ void LoadGuys(FILE *f)
 	{
 		fread(&g,sizeof(Guy),1,f);
 		(*guys[g.ID])=g;
+		guyLive[g.ID/32]|=(1u<<(g.ID%32));
 		if(guys[g.ID]->target==(Guy *)(65535))
 			guys[g.ID]->target=NULL;
 		else
@@ -2866,6 +2898,161 @@ void LoadGuys(FILE *f)
 	player.fireFlags&=(~FF_HELPERHERE);
 }
 
+static void SaveGuy(hamworld::Section *f, const Guy *g)
+{
+	f->write_varint(g->ID);
+	f->write_varint(g->type);
+	f->write_svarint(g->safeX);
+	f->write_svarint(g->safeY);
+	f->write_svarint(g->x);
+	f->write_svarint(g->y);
+	f->write_svarint(g->z);
+	f->write_svarint(g->oldx);
+	f->write_svarint(g->oldy);
+	f->write_svarint(g->dx);
+	f->write_svarint(g->dy);
+	f->write_svarint(g->dz);
+	f->write_varint(g->mapx);
+	f->write_varint(g->mapy);
+	f->write_varint(g->facing);
+	f->write_varint(g->active);
+	f->write_varint(g->mind);
+	f->write_varint(g->mind1);
+	f->write_varint(g->mind2);
+	f->write_varint(g->mind3);
+	f->write_varint(g->wallBump);
+	f->write_varint(g->reload);
+	f->write_varint(g->ouch);
+	f->write_varint(g->action);
+	f->write_varint(g->frmTimer);
+	f->write_varint(g->frmAdvance);
+	f->write_varint(g->frm);
+	f->write_varint(g->seq);
+	f->write_svarint(g->bright);
+	// pointers are stored as guy numbers plus one, zero meaning nobody
+	f->write_varint(g->target ? g->target->ID + 1 : 0);
+	f->write_varint(g->parent ? g->parent->ID + 1 : 0);
+	f->write_svarint(g->hp);
+	f->write_varint(g->tag);
+	f->write_svarint(g->rectx);
+	f->write_svarint(g->recty);
+	f->write_svarint(g->rectx2);
+	f->write_svarint(g->recty2);
+	f->write_varint(g->team);
+	f->write_svarint(g->stun);
+	f->write_svarint(g->kbdx);
+	f->write_svarint(g->kbdy);
+	f->write_svarint(g->kbdz);
+	f->write_varint(g->poison);
+	f->write_varint(g->mindControl);
+	f->write_varint(g->frozen);
+	f->write_varint(g->originalType);
+	f->write_varint(g->shroomTime);
+	f->write_varint(g->ignited);
+	f->write_varint(0);  // no extension flags
+}
+
+static Guy *LoadGuyRef(size_t ref)
+{
+	if (ref == 0)
+		return NULL;
+	if (ref > (size_t)maxGuys)
+		throw std::runtime_error("bad guy reference in saved game");
+	return guys[ref - 1];
+}
+
+static void LoadGuy(hamworld::Section *f, size_t *target, size_t *parent)
+{
+	size_t id = f->read_varint();
+	if (id >= (size_t)maxGuys)
+		throw std::runtime_error("bad guy number in saved game");
+
+	Guy *g = guys[id];
+	g->ID = id;
+	guyLive[id / 32] |= (1u << (id % 32));
+	g->type = f->read_varint();
+	g->safeX = f->read_svarint();
+	g->safeY = f->read_svarint();
+	g->x = f->read_svarint();
+	g->y = f->read_svarint();
+	g->z = f->read_svarint();
+	g->oldx = f->read_svarint();
+	g->oldy = f->read_svarint();
+	g->dx = f->read_svarint();
+	g->dy = f->read_svarint();
+	g->dz = f->read_svarint();
+	g->mapx = f->read_varint();
+	g->mapy = f->read_varint();
+	g->facing = f->read_varint();
+	g->active = f->read_varint();
+	g->mind = f->read_varint();
+	g->mind1 = f->read_varint();
+	g->mind2 = f->read_varint();
+	g->mind3 = f->read_varint();
+	g->wallBump = f->read_varint();
+	g->reload = f->read_varint();
+	g->ouch = f->read_varint();
+	g->action = f->read_varint();
+	g->frmTimer = f->read_varint();
+	g->frmAdvance = f->read_varint();
+	g->frm = f->read_varint();
+	g->seq = f->read_varint();
+	g->bright = f->read_svarint();
+	target[id] = f->read_varint();
+	parent[id] = f->read_varint();
+	g->hp = f->read_svarint();
+	g->tag = f->read_varint();
+	g->rectx = f->read_svarint();
+	g->recty = f->read_svarint();
+	g->rectx2 = f->read_svarint();
+	g->recty2 = f->read_svarint();
+	g->team = f->read_varint();
+	g->stun = f->read_svarint();
+	g->kbdx = f->read_svarint();
+	g->kbdy = f->read_svarint();
+	g->kbdz = f->read_svarint();
+	g->poison = f->read_varint();
+	g->mindControl = f->read_varint();
+	g->frozen = f->read_varint();
+	g->originalType = f->read_varint();
+	g->shroomTime = f->read_varint();
+	g->ignited = f->read_varint();
+	f->read_varint();  // ignore extension flags
+}
+
+void SaveGuys(hamworld::Section *f)
+{
+	size_t count = 0;
+	for (int i = 0; i < maxGuys; ++i)
+		if (guys[i]->type != MONS_NONE)
+			++count;
+
+	f->write_varint(count);
+	for (int i = 0; i < maxGuys; ++i)
+		if (guys[i]->type != MONS_NONE)
+			SaveGuy(f, guys[i]);
+}
+
+void LoadGuys(hamworld::Section *f)
+{
+	ExitGuys();
+	InitGuys(MAX_MAPMONS);
+
+	// links can point forward, so they are resolved once everyone is in
+	std::vector<size_t> target(maxGuys, 0), parent(maxGuys, 0);
+
+	size_t count = f->read_varint();
+	for (size_t i = 0; i < count; ++i)
+		LoadGuy(f, &target[0], &parent[0]);
+
+	for (int i = 0; i < maxGuys; ++i)
+	{
+		guys[i]->target = LoadGuyRef(target[i]);
+		guys[i]->parent = LoadGuyRef(parent[i]);
+	}
+	player.fireFlags&=(~FF_HELPERHERE);
+}
+
 void CameraOnPlayer(byte sum)
 {
 	int i;
@@ -4434,35 +4621,27 @@ void DropMoney(int money,int x,int y)
 
 void NovaGuys(byte team,int x,int y,int radius,word dmg,byte stun,word knock)
 {
-	int i;
 	int dx,dy;
 	byte ang;
 
-	for(i=0;i<maxGuys;i++)
+	for(Guy *g : GuyQuery().NotTeam(team).Alive().Grounded().Radius(x,y,radius))
 	{
-		if(guys[i]->type && guys[i]->hp && guys[i]->team!=team && guys[i]->z==0)
+		ang=AngleFrom(x,y,g->x,g->y);
+		dx=Cosine(ang)*knock/FIXAMT;
+		dy=Sine(ang)*knock/FIXAMT;
+		meleeAttacker=NULL;
+		if(g->GetShot(dx,dy,DamageAmt(dmg,team),curMap,&curWorld))
 		{
-			if(Distance(x,y,guys[i]->x,guys[i]->y)<radius)
-			{
-				ang=AngleFrom(x,y,guys[i]->x,guys[i]->y);
-				dx=Cosine(ang)*knock/FIXAMT;
-				dy=Sine(ang)*knock/FIXAMT;
-				meleeAttacker=NULL;
-				if(guys[i]->GetShot(dx,dy,DamageAmt(dmg,team),curMap,&curWorld))
-				{
-					if(team==EVIL)
-						guys[i]->GetFrozen(stun);
-					else
-						guys[i]->GetStunned(stun);
-				}
-			}
+			if(team==EVIL)
+				g->GetFrozen(stun);
+			else
+				g->GetStunned(stun);
 		}
 	}
 }
 
 int BulletFindDrainTarget(byte team,byte myFace,int x,int y,int notme,Map *map,world_t *world)
 {
-	int i;
 	int range;
 	int score,bestScore;
 	Guy *target;
@@ -4470,16 +4649,16 @@ int BulletFindDrainTarget(byte team,byte myFace,int x,int y,int notme,Map *map,w
 
 	target=NULL;
 	bestScore=999999999;
-	for(i=0;i<maxGuys;i++)
-		if(guys[i]->type && guys[i]->hp && (guys[i]->team&team)==0 && guys[i]->ID!=(notme-1) &&
-			!(MonsterFlags(guys[i]->type)&(MF_NOHIT|MF_INVINCIBLE)) && map->CheckLOS(goodguy->mapx,goodguy->mapy,20,guys[i]->mapx,guys[i]->mapy))
+	for(Guy *g : GuyQuery().Enemies(team).Alive().Radius(x,y,320*FIXAMT))
+		if(g->ID!=(notme-1) && !(MonsterFlags(g->type)&(MF_NOHIT|MF_INVINCIBLE)) &&
+			map->CheckLOS(goodguy->mapx,goodguy->mapy,20,g->mapx,g->mapy))
 		{
-			ang=AngleDiff(myFace,AngleFrom(x,y,guys[i]->x,guys[i]->y));
-			range=Distance(x,y,guys[i]->x,guys[i]->y);
+			ang=AngleDiff(myFace,AngleFrom(x,y,g->x,g->y));
+			range=Distance(x,y,g->x,g->y);
 			score=(range/FIXAMT)*(ang*2);
-			if(range<320*FIXAMT && score<bestScore && NotBeingDrained(guys[i]->ID))
+			if(score<bestScore && NotBeingDrained(g->ID))
 			{
-				target=guys[i];
+				target=g;
 				bestScore=score;
 			}
 		}
@@ -4492,7 +4671,6 @@ int BulletFindDrainTarget(byte team,byte myFace,int x,int y,int notme,Map *map,w
 
 int BulletFindTarget(byte team,byte myFace,int x,int y,int notme,Map *map,world_t *world)
 {
-	int i;
 	int range;
 	int score,bestScore;
 	Guy *target;
@@ -4500,16 +4678,15 @@ int BulletFindTarget(byte team,byte myFace,int x,int y,int notme,Map *map,world_
 
 	target=NULL;
 	bestScore=999999999;
-	for(i=0;i<maxGuys;i++)
-		if(guys[i]->type && guys[i]->hp && (guys[i]->team&team)==0 && guys[i]->ID!=(notme-1) &&
-			!(MonsterFlags(guys[i]->type)&(MF_NOHIT|MF_INVINCIBLE)))
+	for(Guy *g : GuyQuery().Enemies(team).Alive().Radius(x,y,320*FIXAMT))
+		if(g->ID!=(notme-1) && !(MonsterFlags(g->type)&(MF_NOHIT|MF_INVINCIBLE)))
 		{
-			ang=AngleDiff(myFace,AngleFrom(x,y,guys[i]->x,guys[i]->y));
-			range=Distance(x,y,guys[i]->x,guys[i]->y);
+			ang=AngleDiff(myFace,AngleFrom(x,y,g->x,g->y));
+			range=Distance(x,y,g->x,g->y);
 			score=(range/FIXAMT)*(ang*2);
-			if(range<320*FIXAMT && score<bestScore)
+			if(score<bestScore)
 			{
-				target=guys[i];
+				target=g;
 				bestScore=score;
 			}
 		}
@@ -4522,23 +4699,20 @@ int BulletFindTarget(byte team,byte myFace,int x,int y,int notme,Map *map,world_
 
 int BulletFindTargetClosest(byte team,int x,int y,int notme,int maxRange,Map *map,world_t *world)
 {
-	int i;
 	int range;
-	int score,bestScore;
 	Guy *target;
+	int bestRange;
 
 	target=NULL;
-	bestScore=999999999;
-	for(i=0;i<maxGuys;i++)
-		if(guys[i]->type && guys[i]->hp && (guys[i]->team&team)==0 && guys[i]->ID!=(notme-1) &&
-			!(MonsterFlags(guys[i]->type)&(MF_NOHIT|MF_INVINCIBLE)))
+	bestRange=999999999;
+	for(Guy *g : GuyQuery().Enemies(team).Alive().Radius(x,y,maxRange))
+		if(g->ID!=(notme-1) && !(MonsterFlags(g->type)&(MF_NOHIT|MF_INVINCIBLE)))
 		{
-			range=Distance(x,y,guys[i]->x,guys[i]->y);
-			score=range;
-			if(range<maxRange && score<bestScore)
+			range=Distance(x,y,g->x,g->y);
+			if(range<bestRange)
 			{
-				target=guys[i];
-				bestScore=score;
+				target=g;
+				bestRange=range;
 			}
 		}
 
@@ -4782,28 +4956,22 @@ void AddRumbleGuys(Map *map)
 
 void TornadoGuys(byte team,int x,int y,int radius,Map *map,world_t *world)
 {
-	int i,mapx,mapy;
-	int range;
+	int mapx,mapy;
 	int ang;
 
 	mapx=x/(TILE_WIDTH*FIXAMT);
 	mapy=y/(TILE_HEIGHT*FIXAMT);
 
-	for(i=0;i<maxGuys;i++)
-		if(guys[i]->type && guys[i]->hp && (guys[i]->team&team)==0 &&
-			!(MonsterFlags(guys[i]->type)&(MF_NOMOVE|MF_NOHIT)) && map->CheckLOS(mapx,mapy,30,guys[i]->mapx,guys[i]->mapy))
+	for(Guy *g : GuyQuery().Enemies(team).Alive().Radius(x,y,radius))
+		if(!(MonsterFlags(g->type)&(MF_NOMOVE|MF_NOHIT)) && map->CheckLOS(mapx,mapy,30,g->mapx,g->mapy))
 		{
-			range=Distance(x,y,guys[i]->x,guys[i]->y);
-			if(range<radius)
-			{
-				ang=AngleFrom(guys[i]->x,guys[i]->y,x,y);
+			ang=AngleFrom(g->x,g->y,x,y);
 
-				// bosses and player are pulled half as much
-				guys[i]->kbdx+=Cosine(ang)*5/(1+((monsType[guys[i]->type].location&ML_BOSS)!=0)+(guys[i]->type==player.monsType));
-				guys[i]->kbdy+=Sine(ang)*5/(1+((monsType[guys[i]->type].location&ML_BOSS)!=0)+(guys[i]->type==player.monsType));
-				Clamp(&guys[i]->kbdx,FIXAMT*80);
-				Clamp(&guys[i]->kbdy,FIXAMT*80);
-			}
+			// bosses and player are pulled half as much
+			g->kbdx+=Cosine(ang)*5/(1+((monsType[g->type].location&ML_BOSS)!=0)+(g->type==player.monsType));
+			g->kbdy+=Sine(ang)*5/(1+((monsType[g->type].location&ML_BOSS)!=0)+(g->type==player.monsType));
+			Clamp(&g->kbdx,FIXAMT*80);
+			Clamp(&g->kbdy,FIXAMT*80);
 		}
 }
 
@@ -5025,44 +5193,179 @@ void RepairPuppets(void)
 
 void GroundStomp(word damage,Map *map,world_t *world)
 {
-	word g;
+	for(Guy *g : GuyQuery().Team(GOOD).Alive().Grounded())
+		g->GetShot(0,0,DamageAmt(damage,EVIL),map,world);
+}
+
+//-------------- GuyList
+
+int GuyList_Next(int slot)
+{
+	int i;
+	dword bits;
+
+	if(guyLive.empty())
+		return -1;	// no guys at all right now
 
-	g=GuyList_First();
-	while(g!=65535)
+	for(i=slot+1;i<maxGuys;)
 	{
-		if(GetGuy(g)->team==GOOD && GetGuy(g)->hp>0 && GetGuy(g)->z==0)
+		bits=guyLive[i/32]>>(i%32);
+		if(bits==0)
 		{
-			GetGuy(g)->GetShot(0,0,DamageAmt(damage,EVIL),map,world);
+			i=(i/32+1)*32;	// nobody else in this word
+			continue;
+		}
+		while(!(bits&1))
+		{
+			bits>>=1;
+			i++;
 		}
-		g=GuyList_Next();
+		return i;
 	}
+	return -1;
 }
 
-//-------------- GuyList
+#define GQ_TEAM		(1)
+#define GQ_NOTTEAM	(2)
+#define GQ_ENEMIES	(4)
+#define GQ_TYPE		(8)
+#define GQ_ALIVE	(16)
+#define GQ_GROUNDED	(32)
+#define GQ_RADIUS	(64)
+#define GQ_RECT		(128)
 
-static word guyVal;
+GuyQuery::GuyQuery(void)
+{
+	filters=0;
+	team=0;
+	type=0;
+	x=y=x2=y2=radius=0;
+}
 
-word GuyList_First(void)
+GuyQuery GuyQuery::Team(byte t) const
 {
-	guyVal=0;
-	while(guys[guyVal]->type==MONS_NONE && guyVal<maxGuys)
-		guyVal++;
+	GuyQuery q=*this;
+	q.filters|=GQ_TEAM;
+	q.team=t;
+	return q;
+}
 
-	if(guyVal>=maxGuys)
-		return 65535;
+GuyQuery GuyQuery::NotTeam(byte t) const
+{
+	GuyQuery q=*this;
+	q.filters|=GQ_NOTTEAM;
+	q.team=t;
+	return q;
+}
 
-	return guyVal;
+GuyQuery GuyQuery::Enemies(byte t) const
+{
+	GuyQuery q=*this;
+	q.filters|=GQ_ENEMIES;
+	q.team=t;
+	return q;
 }
 
-word GuyList_Next(void)
+GuyQuery GuyQuery::Type(byte t) const
 {
-	guyVal++;
-	while(guyVal<maxGuys && guys[guyVal]->type==MONS_NONE)
-		guyVal++;
+	GuyQuery q=*this;
+	q.filters|=GQ_TYPE;
+	q.type=t;
+	return q;
+}
 
-	if(guyVal>=maxGuys)
-		return 65535;
+GuyQuery GuyQuery::Alive(void) const
+{
+	GuyQuery q=*this;
+	q.filters|=GQ_ALIVE;
+	return q;
+}
 
-	return guyVal;
+GuyQuery GuyQuery::Grounded(void) const
+{
+	GuyQuery q=*this;
+	q.filters|=GQ_GROUNDED;
+	return q;
+}
+
+GuyQuery GuyQuery::Radius(int cx,int cy,int r) const
+{
+	GuyQuery q=*this;
+	q.filters|=GQ_RADIUS;
+	q.x=cx;
+	q.y=cy;
+	q.radius=r;
+	return q;
+}
+
+GuyQuery GuyQuery::Rect(int rx,int ry,int rx2,int ry2) const
+{
+	GuyQuery q=*this;
+	q.filters|=GQ_RECT;
+	q.x=rx;
+	q.y=ry;
+	q.x2=rx2;
+	q.y2=ry2;
+	return q;
+}
+
+bool GuyQuery::Matches(const Guy *g) const
+{
+	if(g->type==MONS_NONE)
+		return false;
+	if((filters&GQ_TEAM) && g->team!=team)
+		return false;
+	if((filters&GQ_NOTTEAM) && g->team==team)
+		return false;
+	if((filters&GQ_ENEMIES) && (g->team&team))
+		return false;
+	if((filters&GQ_TYPE) && g->type!=type)
+		return false;
+	if((filters&GQ_ALIVE) && g->hp<=0)
+		return false;
+	if((filters&GQ_GROUNDED) && g->z!=0)
+		return false;
+	if(filters&GQ_RADIUS)
+	{
+		// cheap box test first, Distance() has the final word so results match it exactly
+		if(g->x-x>radius || x-g->x>radius || g->y-y>radius || y-g->y>radius)
+			return false;
+		if(Distance(x,y,g->x,g->y)>=radius)
+			return false;
+	}
+	if((filters&GQ_RECT) && (g->x<x || g->x>x2 || g->y<y || g->y>y2))
+		return false;
+	return true;
+}
+
+GuyQuery::iterator::iterator(const GuyQuery *q,int slot)
+{
+	this->q=q;
+	this->slot=slot;
+	if(slot!=-1 && !q->Matches(guys[slot]))
+		++(*this);
 }
 
+Guy *GuyQuery::iterator::operator*(void) const
+{
+	return guys[slot];
+}
+
+GuyQuery::iterator &GuyQuery::iterator::operator++(void)
+{
+	do
+	{
+		slot=GuyList_Next(slot);
+	} while(slot!=-1 && !q->Matches(guys[slot]));
+	return *this;
+}
+
+GuyQuery::iterator GuyQuery::begin(void) const
+{
+	return iterator(this,GuyList_Next(-1));
+}
+
+GuyQuery::iterator GuyQuery::end(void) const
+{
+	return iterator(this,-1);
+}
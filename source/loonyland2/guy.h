@@ -9,6 +9,8 @@
 #include "bullet.h"
 #pragma pack(4)
 
+namespace hamworld { class Section; }
+
 #define ACTION_IDLE	0
 #define ACTION_BUSY 1
 
@@ -114,6 +116,8 @@ void ShiftGuys(char dx,char dy,Map *map);
 void CameraOnPlayer(byte sum);
 void LoadGuys(FILE *f);
 void SaveGuys(FILE *f);
+void LoadGuys(hamworld::Section *f);
+void SaveGuys(hamworld::Section *f);
 void PrepGuys(Map *map);
 void KillAllMonsters(byte type);
 byte AnyMonsterExists(void);
@@ -146,7 +150,48 @@ void RepairPuppets(void);
 void GroundStomp(word damage,Map *map,world_t *world);
 void DropMoney(int money,int x,int y);
 
-word GuyList_First(void);
-word GuyList_Next(void);
+// A filtered walk over the live guys, in slot order:
+//     for(Guy *g : GuyQuery().Enemies(team).Radius(x,y,r)) ...
+// Each query keeps its own place, so they can nest (a GetShot partway through
+// one can set off others).  Filters are checked as each guy is reached.
+class GuyQuery
+{
+	public:
+		GuyQuery(void);
+
+		GuyQuery Team(byte t) const;	// on team t
+		GuyQuery NotTeam(byte t) const;	// not on team t
+		GuyQuery Enemies(byte t) const;	// sharing no team bits with t
+		GuyQuery Type(byte t) const;
+		GuyQuery Alive(void) const;		// hp above 0
+		GuyQuery Grounded(void) const;	// z is 0
+		GuyQuery Radius(int cx,int cy,int r) const;	// Distance() to (cx,cy) under r
+		GuyQuery Rect(int rx,int ry,int rx2,int ry2) const;	// x,y inside, inclusive
+
+		bool Matches(const Guy *g) const;
+
+		class iterator
+		{
+			public:
+				iterator(const GuyQuery *q,int slot);
+				Guy *operator*(void) const;
+				iterator &operator++(void);
+				bool operator!=(const iterator &o) const { return slot!=o.slot; }
+			private:
+				const GuyQuery *q;
+				int slot;
+		};
+
+		iterator begin(void) const;
+		iterator end(void) const;
+
+	private:
+		word filters;
+		byte team,type;
+		int x,y,x2,y2,radius;
+};
+
+// the next slot after 'slot' that may hold a live guy, or -1 if there are no more
+int GuyList_Next(int slot);
 
 #endif
@@ -3,6 +3,7 @@
 #include "editor.h"
 #include "gallery.h"
 #include "options.h"
+#include "perf.h"
 
 item_t itemInfo[MAX_ITMS]={
 	{"None",0,0,0,0,0},
@@ -256,6 +257,7 @@ char *ItemName(byte itm)
 
 void UpdateItems(void)
 {
+	PERF_SCOPE("items");
 	itemAnim++;
 	if(itemAnim>4095)
 		itemAnim=0;
@@ -11,6 +11,11 @@
 #include "leveldef.h"
 #include "madcap.h"
 #include "config.h"
+#include "radar.h"
+#include "hamworld.h"
+#include <algorithm>
+#include <stdexcept>
+#include "perf.h"
 
 #define NUM_STARS 400
 
@@ -339,6 +344,7 @@ void Map::Update(byte mode,world_t *world)
 	int i,x,y;
 	static byte timeToReset=0;
 	static byte timeToAnim=0;
+	PERF_SCOPE("map");
 
 	UpdateWater();
 
@@ -423,7 +429,10 @@ void Map::Update(byte mode,world_t *world)
 				}
 			}
 			if(player.var[VAR_GOURDDEAD] && map[i].item>=IT_VINEWALL && map[i].item<=IT_VINEWALL3 && (rand()%1000)==0)
+			{
 				map[i].item=IT_DEADVINE+map[i].item-IT_VINEWALL;	// randomly kill the vines over time
+				Radar_ItemChanged(this,i%width,i/width);
+			}
 			if(mode!=UPDATE_FADE)
 			{
 				if(map[i].item>=IT_SHROOM && map[i].item<=IT_SHROOMPATCH2 && config.shading==1)
@@ -574,6 +583,7 @@ byte PlaceItemCallback(int x,int y,int cx,int cy,int value,Map *map)
 		return 1;
 
 	map->map[x+y*map->width].item=(byte)value;
+	Radar_ItemChanged(map,x,y);
 	return 0;	// all done, you placed the item
 }
 
@@ -827,6 +837,7 @@ void Map::Clone(int sx,int sy,int blkwidth,int blkheight,int dx,int dy)
 void Map::Render(world_t *world,int camX,int camY,byte flags)
 {
 	int i,j;
+	PERF_SCOPE("map draw");
 
 	int tileX,tileY;
 	int ofsX,ofsY;
@@ -1172,6 +1183,143 @@ void Map::SaveProgress(FILE *f)
 	fwrite(special,sizeof(special_t),MAX_SPECIAL,f);
 }
 
+static void SaveProgressTile(hamworld::Section *f, const mapTile_t *t)
+{
+	f->write_varint(t->floor);
+	f->write_varint(t->wall);
+	f->write_varint(t->item);
+	f->write_varint(t->itemInfo);
+	f->write_varint(t->tag);
+	f->stream.put(t->light);
+	f->stream.put(t->templight);
+	f->write_varint(t->opaque);
+}
+
+static void LoadProgressTile(hamworld::Section *f, mapTile_t *t)
+{
+	t->floor = f->read_varint();
+	t->wall = f->read_varint();
+	t->item = f->read_varint();
+	t->itemInfo = f->read_varint();
+	t->tag = f->read_varint();
+	t->light = f->stream.get();
+	t->templight = f->stream.get();
+	t->opaque = f->read_varint();
+}
+
+static void SaveProgressSpecial(hamworld::Section *f, const special_t *spcl)
+{
+	f->write_varint(spcl->trigger);
+	f->write_svarint(spcl->trigValue);
+	f->write_svarint(spcl->trigValue2);
+	f->write_svarint(spcl->trigX);
+	f->write_svarint(spcl->trigY);
+	f->write_varint(spcl->effect);
+	f->write_svarint(spcl->x);
+	f->write_svarint(spcl->y);
+	f->write_varint(spcl->effectTag);
+	f->write_svarint(spcl->effectX);
+	f->write_svarint(spcl->effectY);
+	f->write_svarint(spcl->value);
+	f->write_string(std::string(spcl->msg, strnlen(spcl->msg, sizeof(spcl->msg))));
+}
+
+static void LoadProgressSpecial(hamworld::Section *f, special_t *spcl)
+{
+	spcl->trigger = f->read_varint();
+	spcl->trigValue = f->read_svarint();
+	spcl->trigValue2 = f->read_svarint();
+	spcl->trigX = f->read_svarint();
+	spcl->trigY = f->read_svarint();
+	spcl->effect = f->read_varint();
+	spcl->x = f->read_svarint();
+	spcl->y = f->read_svarint();
+	spcl->effectTag = f->read_varint();
+	spcl->effectX = f->read_svarint();
+	spcl->effectY = f->read_svarint();
+	spcl->value = f->read_svarint();
+	// a full 32-character message has no terminator, so read it raw
+	std::string msg;
+	f->read_string(&msg);
+	memset(spcl->msg, 0, sizeof(spcl->msg));
+	memcpy(spcl->msg, msg.data(), std::min(msg.size(), sizeof(spcl->msg)));
+}
+
+void Map::SaveProgress(hamworld::Section *f)
+{
+	int i, run;
+	special_t blank;
+
+	f->write_varint(width);
+	f->write_varint(height);
+	f->write_varint(flags);
+
+	// most of a map is long stretches of identical tiles, so store runs
+	for (i = 0; i < width * height; i += run)
+	{
+		run = 1;
+		while (i + run < width * height && !memcmp(&map[i], &map[i + run], sizeof(mapTile_t)))
+			run++;
+		f->write_varint(run);
+		SaveProgressTile(f, &map[i]);
+	}
+
+	// only the specials that are in use
+	memset(&blank, 0, sizeof(special_t));
+	size_t special_count = 0;
+	for (i = 0; i < MAX_SPECIAL; ++i)
+		if (memcmp(&special[i], &blank, sizeof(special_t)))
+			++special_count;
+	f->write_varint(special_count);
+	for (i = 0; i < MAX_SPECIAL; ++i)
+		if (memcmp(&special[i], &blank, sizeof(special_t)))
+		{
+			f->write_varint(i);
+			SaveProgressSpecial(f, &special[i]);
+		}
+
+	f->write_varint(0);  // no extension flags
+}
+
+void Map::LoadFromProgress(hamworld::Section *f)
+{
+	int i, j, run;
+
+	if(map)
+		free(map);
+	map = NULL;
+
+	width = f->read_varint();
+	height = f->read_varint();
+	flags = f->read_varint();
+	// map coordinates are bytes everywhere else, so nothing bigger than 256x256 is legit
+	if (width <= 0 || height <= 0 || width > 256 || height > 256)
+		throw std::runtime_error("bad map size in saved game");
+	map = (mapTile_t *)malloc(width * height * sizeof(mapTile_t));
+
+	for (i = 0; i < width * height; i += run)
+	{
+		run = f->read_varint();
+		if (run <= 0 || i + run > width * height)
+			throw std::runtime_error("bad tile run in saved game");
+		LoadProgressTile(f, &map[i]);
+		for (j = 1; j < run; ++j)
+			map[i + j] = map[i];
+	}
+
+	memset(special, 0, sizeof(special_t) * MAX_SPECIAL);
+	size_t special_count = f->read_varint();
+	for (size_t n = 0; n < special_count; ++n)
+	{
+		size_t which = f->read_varint();
+		if (which >= MAX_SPECIAL)
+			throw std::runtime_error("bad special number in saved game");
+		LoadProgressSpecial(f, &special[which]);
+	}
+
+	f->read_varint();  // ignore extension flags
+}
+
 void ZapWall(Map *map,int x,int y,word newFloor)
 {
 	word flr,wall;
@@ -1366,6 +1514,7 @@ void DropItemTag(Map *map,byte type,byte tag,byte fire)
 			}
 
 			map->map[i].item=type;
+			Radar_ItemChanged(map,x,y);
 		}
 		x++;
 		if(x==map->width)
@@ -1656,7 +1805,10 @@ void SpecialTakeEffect(byte num,Map *map,special_t *spcl,Guy *victim)
 			break;
 		case SPC_DROPITEM:
 			if(spcl->effectTag==0)
+			{
 				map->map[spcl->effectX+spcl->effectY*map->width].item=spcl->value;
+				Radar_ItemChanged(map,spcl->effectX,spcl->effectY);
+			}
 			else
 				DropItemTag(map,spcl->value,spcl->effectTag,(spcl->msg[0]=='@'));
 			break;
@@ -1794,6 +1946,8 @@ byte RopeStump(Map *map,int x,int y,byte fx)
 		}
 		map->map[x-7+y*map->width].item=IT_ROPEDSTUMP;
 		map->map[x+y*map->width].item=IT_NONE;
+		for(i=x-7;i<x;i++)
+			Radar_ItemChanged(map,i,y);
 		return 1;
 	}
 	else if(x<map->width-7 && map->map[x+7+y*map->width].item==IT_STUMP && map->map[x+7+y*map->width].tag==map->map[x+y*map->width].tag)
@@ -1807,6 +1961,8 @@ byte RopeStump(Map *map,int x,int y,byte fx)
 		}
 		map->map[x+y*map->width].item=IT_ROPEDSTUMP;
 		map->map[x+7+y*map->width].item=IT_NONE;
+		for(i=x;i<x+7;i++)
+			Radar_ItemChanged(map,i,y);
 		return 1;
 	}
 	return 0;
@@ -1837,6 +1993,7 @@ void PrisonBreak(Map *map,byte situation)
 	if(situation==0 || situation==1)
 	{
 		map->map[25+0*map->width].item=IT_EXIT;
+		Radar_ItemChanged(map,25,0);
 
 		for(i=0;i<MAX_SPECIAL;i++)
 			if(map->special[i].trigger==0)
@@ -1870,6 +2027,7 @@ void PrisonBreak(Map *map,byte situation)
 	if(situation==2)	// in the clearing, not the camp
 	{
 		map->map[14+34*map->width].item=IT_EXIT;
+		Radar_ItemChanged(map,14,34);
 
 		for(i=0;i<MAX_SPECIAL;i++)
 			if(map->special[i].trigger==0)
@@ -1888,6 +2046,7 @@ void PrisonBreak(Map *map,byte situation)
 		if(GotItem(IT_KEY3)==0)
 		{
 			map->map[14+30*map->width].item=IT_KEY3;
+			Radar_ItemChanged(map,14,30);
 		}
 	}
 }
@@ -1903,6 +2062,7 @@ void SmashFrostGate(Map *map,byte fx)
 		if(map->map[i].item==IT_ICEBLOCK)
 		{
 			map->map[i].item=IT_ICEMELT;
+			Radar_ItemChanged(map,i%map->width,i/map->width);
 			if(fx)
 			{
 				for(j=0;j<5;j++)
@@ -103,6 +103,7 @@ typedef struct mapBadguy_t
 } mapBadguy_t;
 
 struct world_t;
+namespace hamworld { class Section; }
 
 class Map
 {
@@ -134,6 +135,8 @@ class Map
 		void CopyChunk(int cx,int cy,int cwidth,int cheight,int dx,int dy);
 		void SaveProgress(FILE *f);
 		void LoadFromProgress(FILE *f);
+		void SaveProgress(hamworld::Section *f);
+		void LoadFromProgress(hamworld::Section *f);
 		void ChopTree(int x,int y,byte fx);
 
 		int width,height;
@@ -887,22 +887,20 @@ void AI_TinGuy(Guy *me,Map *map,world_t *world,Guy *goodguy)
 		else
 		{
 			me->mind3=60;
-			x=GuyList_First();
 			y=0;
-			while(x!=65535)
+			for(Guy *g : GuyQuery().Team(2).Alive())
 			{
-				if(GetGuy(x)->team==2 && GetGuy(x)->type!=MONS_TINPOT && GetGuy(x)->hp>0 && map->CheckLOS(me->mapx,me->mapy,10,GetGuy(x)->mapx,GetGuy(x)->mapy))
+				if(g->type!=MONS_TINPOT && map->CheckLOS(me->mapx,me->mapy,10,g->mapx,g->mapy))
 				{
-					GetGuy(x)->hp=MonsterHP(GetGuy(x)->type,GetGuy(x)->team);
-					map->map[GetGuy(x)->mapx+(GetGuy(x)->mapy*map->width)].templight=32;
+					g->hp=MonsterHP(g->type,g->team);
+					map->map[g->mapx+(g->mapy*map->width)].templight=32;
 					if(y==0)
 					{
 						MakeSound(SND_BIGHEAL,me->x,me->y,SND_CUTOFF|SND_RANDOM,1200);
 						y=1;
 					}
-					LightningBolt(me->x,me->y-me->z-FIXAMT*20,GetGuy(x)->x,GetGuy(x)->y-FIXAMT*20);
+					LightningBolt(me->x,me->y-me->z-FIXAMT*20,g->x,g->y-FIXAMT*20);
 				}
-				x=GuyList_Next();
 			}
 		}
 	}
@@ -1483,23 +1481,14 @@ void AI_Toymaker(Guy *me,Map *map,world_t *world,Guy *goodguy)
 
 void AI_Toypower(Guy *me,Map *map,world_t *world,Guy *goodguy)
 {
-	int i;
-
 	BasicAI(me,SND_MOUSEOUCH,SND_POWERDIE,map,world,goodguy);
 
 	if(me->hp==0 && me->ouch==4)
 		KillKids(me);
 
 	me->mind1++;
-	i=GuyList_First();
-	while(i!=65535)
-	{
-		if(GetGuy(i)->type==MONS_TOYCRYSTAL)
-		{
-			GetGuy(i)->mind=GetGuy(i)->mind1*(256/6)+me->mind1;
-		}
-		i=GuyList_Next();
-	}
+	for(Guy *g : GuyQuery().Type(MONS_TOYCRYSTAL))
+		g->mind=g->mind1*(256/6)+me->mind1;
 	if(me->action==ACTION_BUSY)
 	{
 		if(me->seq==ANIM_DIE)
@@ -2090,17 +2079,13 @@ void AI_BunnyBoss(Guy *me,Map *map,world_t *world,Guy *goodguy)
 			}
 			if(me->mind==22)
 			{
-				word w;
-				w=GuyList_First();
-				while(w!=65535)
+				for(Guy *g : GuyQuery().Type(MONS_VILLAGER))
 				{
-					if(GetGuy(w)->type==MONS_VILLAGER && GetGuy(w)->tag==24)
+					if(g->tag==24)
 					{
-						GetGuy(w)->type=MONS_NONE;
+						g->type=MONS_NONE;
 						break;
 					}
-					else
-						w=GuyList_Next();
 				}
 				PlayerSetVar(VAR_QUESTDONE+QUEST_LEADER,1);
 			}
@@ -3369,24 +3354,20 @@ void AI_TitanBig(Guy *me,Map *map,world_t *world,Guy *goodguy)
 		}
 		if(me->seq==ANIM_A1 && me->frm>=4 && me->frm<=10)
 		{
-			int g;
-
-			g=GuyList_First();
-			while(g!=65535)
+			for(Guy *g : GuyQuery().Team(GOOD).Alive())
 			{
-				if(GetGuy(g)->hp && GetGuy(g)->team==GOOD && !(monsType[GetGuy(g)->type].flags&MF_NOMOVE))
+				if(!(monsType[g->type].flags&MF_NOMOVE))
 				{
-					i=AngleFrom(me->x,me->y,GetGuy(g)->x,GetGuy(g)->y);
+					i=AngleFrom(me->x,me->y,g->x,g->y);
 					i=me->mind3+256-i;
-					if(i>256-48 && i<256+48 && map->CheckLOS(me->mapx,me->mapy,12,GetGuy(g)->mapx,GetGuy(g)->mapy))	// make sure the player is somewhere in front of you
+					if(i>256-48 && i<256+48 && map->CheckLOS(me->mapx,me->mapy,12,g->mapx,g->mapy))	// make sure the player is somewhere in front of you
 					{
-						i=AngleFrom(me->x,me->y,GetGuy(g)->x,GetGuy(g)->y);
-						GetGuy(g)->kbdx+=Cosine(i)*5;
-						GetGuy(g)->kbdy+=Sine(i)*5;
-						GetGuy(g)->GetFrozen(30);
+						i=AngleFrom(me->x,me->y,g->x,g->y);
+						g->kbdx+=Cosine(i)*5;
+						g->kbdy+=Sine(i)*5;
+						g->GetFrozen(30);
 					}
 				}
-				g=GuyList_Next();
 			}
 		}
 
@@ -5,6 +5,11 @@
 #include "player.h"
 #include "leveldef.h"
 #include "skill.h"
+#include "perf.h"
+#include "randstream.h"
+
+static RandomStream particleRng(RAND_PARTICLE);
+static RandomStream renderRng(RAND_RENDER);	// rolls made while drawing, so frames drawn or skipped don't move particleRng
 
 Particle **particleList;
 int		maxParticles;
@@ -32,13 +37,13 @@ void Particle::Go(byte type,int x,int y,int z,byte angle,byte force)
 
 	if(fforce==0)
 		fforce=1;
-	this->x=x+Random(4<<FIXSHIFT)-(2<<FIXSHIFT);
-	this->y=y+Random(4<<FIXSHIFT)-(2<<FIXSHIFT);
+	this->x=x+particleRng.Random(4<<FIXSHIFT)-(2<<FIXSHIFT);
+	this->y=y+particleRng.Random(4<<FIXSHIFT)-(2<<FIXSHIFT);
 	this->z=z;
-	this->dx=Cosine(angle)*Random(fforce);
-	this->dy=Sine(angle)*Random(fforce);
-	this->dz=Random(fforce*2)<<FIXSHIFT;
-	this->life=Random(force)+10;
+	this->dx=Cosine(angle)*particleRng.Random(fforce);
+	this->dy=Sine(angle)*particleRng.Random(fforce);
+	this->dz=particleRng.Random(fforce*2)<<FIXSHIFT;
+	this->life=particleRng.Random(force)+10;
 }
 
 void Particle::GoExact(byte type,int x,int y,int z,byte angle,byte force)
@@ -56,7 +61,7 @@ void Particle::GoExact(byte type,int x,int y,int z,byte angle,byte force)
 	this->dy=Sine(angle)*force;
 	this->dz=force*FIXAMT*2;
 	this->life=25;
-	this->color=(byte)(Random(7)+1)*32+16;
+	this->color=(byte)(particleRng.Random(7)+1)*32+16;
 	if(this->color==32*2+16)
 		this->color=32*7+16;
 }
@@ -80,13 +85,13 @@ void Particle::GoRandom(byte type,int x,int y,int z,byte force)
 	if(force==0)
 		return;
 
-	this->x=x+Random(32<<FIXSHIFT)-(16<<FIXSHIFT);
-	this->y=y+Random(32<<FIXSHIFT)-(16<<FIXSHIFT);
+	this->x=x+particleRng.Random(32<<FIXSHIFT)-(16<<FIXSHIFT);
+	this->y=y+particleRng.Random(32<<FIXSHIFT)-(16<<FIXSHIFT);
 	this->z=z;
-	this->dx=(Random(force)-force/2)<<FIXSHIFT;
-	this->dy=(Random(force)-force/2)<<FIXSHIFT;
-	this->dz=Random(force*2)<<FIXSHIFT;
-	this->life=Random(force)+20;
+	this->dx=(particleRng.Random(force)-force/2)<<FIXSHIFT;
+	this->dy=(particleRng.Random(force)-force/2)<<FIXSHIFT;
+	this->dz=particleRng.Random(force*2)<<FIXSHIFT;
+	this->life=particleRng.Random(force)+20;
 }
 
 void Particle::Update(Map *map)
@@ -131,8 +136,8 @@ void Particle::Update(Map *map)
 				if(life<30 && size>1)
 					size--;
 				color=31;
-				dx+=Random(FIXAMT/2+1)-FIXAMT/4;
-				dy+=Random(FIXAMT/2+1)-FIXAMT/4;
+				dx+=particleRng.Random(FIXAMT/2+1)-FIXAMT/4;
+				dy+=particleRng.Random(FIXAMT/2+1)-FIXAMT/4;
 				Dampen(&dx,FIXAMT/8);
 				Dampen(&dy,FIXAMT/8);
 				break;
@@ -203,8 +208,8 @@ void Particle::Update(Map *map)
 				dz+=FIXAMT+FIXAMT/4;
 				Dampen(&dx,FIXAMT/8);
 				Dampen(&dy,FIXAMT/8);
-				dx=dx-FIXAMT/8+Random(FIXAMT/4);
-				dy=dy-FIXAMT/8+Random(FIXAMT/4);
+				dx=dx-FIXAMT/8+particleRng.Random(FIXAMT/4);
+				dy=dy-FIXAMT/8+particleRng.Random(FIXAMT/4);
 				break;
 			case PART_WATER:
 				v=life;
@@ -240,8 +245,8 @@ void Particle::Update(Map *map)
 					size=1;
 				break;
 			case PART_SNOW:
-				dx+=Random(FIXAMT)-FIXAMT/2;
-				dy+=Random(FIXAMT)-FIXAMT/2;
+				dx+=particleRng.Random(FIXAMT)-FIXAMT/2;
+				dy+=particleRng.Random(FIXAMT)-FIXAMT/2;
 				Dampen(&dx,FIXAMT/8);
 				Dampen(&dy,FIXAMT/8);
 				dz+=FIXAMT*15/16;	// not as much gravity as other things
@@ -290,11 +295,11 @@ void Particle::Update(Map *map)
 					color-=2;
 				break;
 			case PART_FIRE:
-				dz+=FIXAMT+Random(FIXAMT/4);
+				dz+=FIXAMT+particleRng.Random(FIXAMT/4);
 				Dampen(&dx,FIXAMT/8);
 				Dampen(&dy,FIXAMT/8);
-				dx=dx-FIXAMT/8+Random(FIXAMT/4);
-				dy=dy-FIXAMT/8+Random(FIXAMT/4);
+				dx=dx-FIXAMT/8+particleRng.Random(FIXAMT/4);
+				dy=dy-FIXAMT/8+particleRng.Random(FIXAMT/4);
 				if(size>0)
 					size--;
 				else
@@ -307,11 +312,11 @@ void Particle::Update(Map *map)
 					color=128+life;
 				break;
 			case PART_COLDFIRE:
-				dz+=FIXAMT+Random(FIXAMT/4);
+				dz+=FIXAMT+particleRng.Random(FIXAMT/4);
 				Dampen(&dx,FIXAMT/8);
 				Dampen(&dy,FIXAMT/8);
-				dx=dx-FIXAMT/8+Random(FIXAMT/4);
-				dy=dy-FIXAMT/8+Random(FIXAMT/4);
+				dx=dx-FIXAMT/8+particleRng.Random(FIXAMT/4);
+				dy=dy-FIXAMT/8+particleRng.Random(FIXAMT/4);
 				if(size>0)
 					size--;
 				else
@@ -415,6 +420,7 @@ void ExitParticles(void)
 void UpdateParticles(Map *map)
 {
 	int i;
+	PERF_SCOPE("particles");
 
 	snowCount=0;
 	for(i=0;i<maxParticles;i++)
@@ -738,12 +744,12 @@ void RenderLightningParticle(int x1,int y1,int x2,int y2,int range,byte bright,b
 			midx=x1+(x2-x1)/2;
 		else
 			midx=x2+(x1-x2)/2;
-		midx+=Random(range)-range/2;
+		midx+=renderRng.Random(range)-range/2;
 		if(y1<y2)
 			midy=y1+(y2-y1)/2;
 		else
 			midy=y2+(y1-y2)/2;
-		midy+=Random(range)-range/2;
+		midy+=renderRng.Random(range)-range/2;
 		RenderLightningParticle(x1,y1,midx,midy,range*3/4,bright,scrn);
 		RenderLightningParticle(midx,midy,x2,y2,range*3/4,bright,scrn);
 	}
@@ -775,7 +781,7 @@ void RenderParticles(void)
 			}
 			else if(particleList[i]->type==PART_CIRCLE || particleList[i]->type==PART_FLOATY)
 				ParticleDraw(particleList[i]->x>>FIXSHIFT,particleList[i]->y>>FIXSHIFT,
-							 particleList[i]->z>>FIXSHIFT,particleList[i]->color,(byte)Random(particleList[i]->size+1),
+							 particleList[i]->z>>FIXSHIFT,particleList[i]->color,(byte)renderRng.Random(particleList[i]->size+1),
 							 DISPLAY_DRAWME|DISPLAY_CIRCLEPART);
 			else if(particleList[i]->type==PART_FX || particleList[i]->type==PART_WATER)
 				ParticleDraw(particleList[i]->x>>FIXSHIFT,particleList[i]->y>>FIXSHIFT,
@@ -886,16 +892,16 @@ void MakeRingParticle(int x,int y, int z,byte size,byte cnt)
 	{
 		if(!particleList[i]->Alive())
 		{
-			ang=(byte)Random(256);
+			ang=(byte)particleRng.Random(256);
 			particleList[i]->x=x+Cosine(ang)*size;
 			particleList[i]->y=y+Sine(ang)*size;
 			particleList[i]->z=z;
 			particleList[i]->dx=0;
 			particleList[i]->dy=0;
-			particleList[i]->dz=Random(FIXAMT*2);
+			particleList[i]->dz=particleRng.Random(FIXAMT*2);
 			particleList[i]->color=191;
-			particleList[i]->life=10+(byte)Random(30);
-			particleList[i]->size=8*4+(byte)Random(4*4);
+			particleList[i]->life=10+(byte)particleRng.Random(30);
+			particleList[i]->size=8*4+(byte)particleRng.Random(4*4);
 			particleList[i]->type=PART_FIRE;
 			cnt--;
 			if(!cnt)
@@ -919,10 +925,10 @@ void MakeColdRingParticle(int x,int y, int z,byte size)
 			particleList[i]->z=z;
 			particleList[i]->dx=0;
 			particleList[i]->dy=0;
-			particleList[i]->dz=Random(FIXAMT*2);
+			particleList[i]->dz=particleRng.Random(FIXAMT*2);
 			particleList[i]->color=31;
-			particleList[i]->life=10+Random(30);
-			particleList[i]->size=8*4+(byte)Random(4*4);
+			particleList[i]->life=10+particleRng.Random(30);
+			particleList[i]->size=8*4+(byte)particleRng.Random(4*4);
 			particleList[i]->type=PART_COLDFIRE;
 			ang+=4;
 			if(!ang)
@@ -944,11 +950,11 @@ void MakePlagueRingParticle(int x,int y, int z,int size)
 			particleList[i]->x=x+Cosine(ang)*size;
 			particleList[i]->y=y+Sine(ang)*size;
 			particleList[i]->z=z;
-			particleList[i]->dx=-FIXAMT*2+Random(FIXAMT*4+1);
-			particleList[i]->dy=-FIXAMT*2+Random(FIXAMT*4+1);
-			particleList[i]->dz=Random(FIXAMT*2);
+			particleList[i]->dx=-FIXAMT*2+particleRng.Random(FIXAMT*4+1);
+			particleList[i]->dy=-FIXAMT*2+particleRng.Random(FIXAMT*4+1);
+			particleList[i]->dz=particleRng.Random(FIXAMT*2);
 			particleList[i]->color=31;
-			particleList[i]->life=20+Random(10);
+			particleList[i]->life=20+particleRng.Random(10);
 			particleList[i]->size=10;
 			particleList[i]->type=PART_FLOATY;
 			ang+=6;
@@ -966,12 +972,12 @@ void GlassShatter(int x,int y,int x2,int y2,int z,byte amt)
 	{
 		if(!particleList[i]->Alive())
 		{
-			particleList[i]->x=(x+Random(x2-x));
-			particleList[i]->y=(y+Random(y2-y));
+			particleList[i]->x=(x+particleRng.Random(x2-x));
+			particleList[i]->y=(y+particleRng.Random(y2-y));
 			particleList[i]->z=z;
-			particleList[i]->GoRandom(PART_GLASS,(x+Random(x2-x)),(y+Random(y2-y)),
-					Random(10*FIXAMT),20);
-			particleList[i]->color=(byte)Random(8)*32+16;
+			particleList[i]->GoRandom(PART_GLASS,(x+particleRng.Random(x2-x)),(y+particleRng.Random(y2-y)),
+					particleRng.Random(10*FIXAMT),20);
+			particleList[i]->color=(byte)particleRng.Random(8)*32+16;
 			if(!(--amt))
 				break;
 		}
@@ -1047,7 +1053,7 @@ void MakeItSnow(Map *map)
 	int cx,cy;
 
 	// only 25% of particles may be snowflakes
-	if(Random(100)>30 || snowCount>maxParticles/4)
+	if(particleRng.Random(100)>30 || snowCount>maxParticles/4)
 		return;
 
 	GetCamera(&cx,&cy);
@@ -1057,14 +1063,14 @@ void MakeItSnow(Map *map)
 	{
 		if(!particleList[i]->Alive())
 		{
-			particleList[i]->x=(Random(640)+cx)<<FIXSHIFT;
-			particleList[i]->y=(Random(480)+cy)<<FIXSHIFT;
-			particleList[i]->z=(300+Random(300))<<FIXSHIFT;
+			particleList[i]->x=(particleRng.Random(640)+cx)<<FIXSHIFT;
+			particleList[i]->y=(particleRng.Random(480)+cy)<<FIXSHIFT;
+			particleList[i]->z=(300+particleRng.Random(300))<<FIXSHIFT;
 			particleList[i]->dx=0;
 			particleList[i]->dy=0;
 			particleList[i]->dz=0;
 			particleList[i]->size=2;
-			particleList[i]->life=50+Random(50);
+			particleList[i]->life=50+particleRng.Random(50);
 			particleList[i]->type=PART_SNOW;
 			particleList[i]->color=31;
 			break;
@@ -1081,14 +1087,14 @@ void SpecialSnow(int x,int y)
 		if(!particleList[i]->Alive())
 		{
 
-			particleList[i]->x=x-FIXAMT*10+Random(FIXAMT*20);
-			particleList[i]->y=y-FIXAMT*10+Random(FIXAMT*20);
-			particleList[i]->z=(50+Random(20))<<FIXSHIFT;
+			particleList[i]->x=x-FIXAMT*10+particleRng.Random(FIXAMT*20);
+			particleList[i]->y=y-FIXAMT*10+particleRng.Random(FIXAMT*20);
+			particleList[i]->z=(50+particleRng.Random(20))<<FIXSHIFT;
 			particleList[i]->dx=0;
 			particleList[i]->dy=0;
 			particleList[i]->dz=0;
 			particleList[i]->size=2;
-			particleList[i]->life=20+Random(30);
+			particleList[i]->life=20+particleRng.Random(30);
 			particleList[i]->type=PART_SNOW;
 			break;
 		}
@@ -1115,20 +1121,20 @@ void Burn(int x,int y,int z)
 	int i;
 	byte num;
 
-	num=(byte)Random(8)+1;
+	num=(byte)particleRng.Random(8)+1;
 	for(i=0;i<maxParticles;i++)
 	{
 		if(!particleList[i]->Alive())
 		{
-			particleList[i]->x=x-FIXAMT*2+Random(FIXAMT*4);
+			particleList[i]->x=x-FIXAMT*2+particleRng.Random(FIXAMT*4);
 			particleList[i]->y=y;
-			particleList[i]->z=z-FIXAMT*2+Random(FIXAMT*4);
-			particleList[i]->dx=-FIXAMT*2+Random(FIXAMT*4);
+			particleList[i]->z=z-FIXAMT*2+particleRng.Random(FIXAMT*4);
+			particleList[i]->dx=-FIXAMT*2+particleRng.Random(FIXAMT*4);
 			particleList[i]->dy=0;
-			particleList[i]->dz=Random(FIXAMT*2);
+			particleList[i]->dz=particleRng.Random(FIXAMT*2);
 			particleList[i]->color=191;
-			particleList[i]->life=10+Random(30);
-			particleList[i]->size=8*4+(byte)Random(4*4);
+			particleList[i]->life=10+particleRng.Random(30);
+			particleList[i]->size=8*4+(byte)particleRng.Random(4*4);
 			particleList[i]->type=PART_FIRE;
 			if(--num==0)
 				break;
@@ -1144,9 +1150,9 @@ void Smoke(int x,int y,int z)
 	{
 		if(!particleList[i]->Alive())
 		{
-			particleList[i]->x=x-FIXAMT*2+Random(FIXAMT*4);
+			particleList[i]->x=x-FIXAMT*2+particleRng.Random(FIXAMT*4);
 			particleList[i]->y=y;
-			particleList[i]->z=z-FIXAMT*2+Random(FIXAMT*4);
+			particleList[i]->z=z-FIXAMT*2+particleRng.Random(FIXAMT*4);
 			particleList[i]->dx=0;
 			particleList[i]->dy=0;
 			particleList[i]->dz=0;
@@ -1172,11 +1178,11 @@ void ParticleBoom(byte type,int x,int y,int z)
 			{
 				if(!particleList[i]->Alive())
 				{
-					particleList[i]->x=x-FIXAMT*2+Random(FIXAMT*4+1);
-					particleList[i]->y=y-FIXAMT*2+Random(FIXAMT*4+1);
+					particleList[i]->x=x-FIXAMT*2+particleRng.Random(FIXAMT*4+1);
+					particleList[i]->y=y-FIXAMT*2+particleRng.Random(FIXAMT*4+1);
 					particleList[i]->z=z;
-					particleList[i]->dx=-FIXAMT/2+Random(FIXAMT+1);
-					particleList[i]->dy=-FIXAMT/2+Random(FIXAMT+1);
+					particleList[i]->dx=-FIXAMT/2+particleRng.Random(FIXAMT+1);
+					particleList[i]->dy=-FIXAMT/2+particleRng.Random(FIXAMT+1);
 					particleList[i]->dz=0;
 					particleList[i]->color=31;
 					particleList[i]->life=60;
@@ -1220,15 +1226,15 @@ void ParticleBoom(byte type,int x,int y,int z)
 			{
 				if(!particleList[i]->Alive())
 				{
-					particleList[i]->x=x-FIXAMT*2+Random(FIXAMT*4+1);
+					particleList[i]->x=x-FIXAMT*2+particleRng.Random(FIXAMT*4+1);
 					particleList[i]->y=y;
-					particleList[i]->z=z-FIXAMT*2+Random(FIXAMT*4+1);
-					particleList[i]->dx=-FIXAMT*3+Random(FIXAMT*6+1);
-					particleList[i]->dy=-FIXAMT*3+Random(FIXAMT*6+1);
-					particleList[i]->dz=Random(FIXAMT*2);
+					particleList[i]->z=z-FIXAMT*2+particleRng.Random(FIXAMT*4+1);
+					particleList[i]->dx=-FIXAMT*3+particleRng.Random(FIXAMT*6+1);
+					particleList[i]->dy=-FIXAMT*3+particleRng.Random(FIXAMT*6+1);
+					particleList[i]->dz=particleRng.Random(FIXAMT*2);
 					particleList[i]->color=191;
-					particleList[i]->life=10+Random(30);
-					particleList[i]->size=8*4+(byte)Random(4*4);
+					particleList[i]->life=10+particleRng.Random(30);
+					particleList[i]->size=8*4+(byte)particleRng.Random(4*4);
 					particleList[i]->type=PART_FIRE;
 					if(--amt==0)
 						break;
@@ -1244,14 +1250,14 @@ void ParticleBoom(byte type,int x,int y,int z)
 			{
 				if(!particleList[i]->Alive())
 				{
-					particleList[i]->x=x-FIXAMT*1+Random(FIXAMT*2+1);
+					particleList[i]->x=x-FIXAMT*1+particleRng.Random(FIXAMT*2+1);
 					particleList[i]->y=y;
-					particleList[i]->z=z-FIXAMT*1+Random(FIXAMT*2+1);
+					particleList[i]->z=z-FIXAMT*1+particleRng.Random(FIXAMT*2+1);
 					particleList[i]->dx=0;
 					particleList[i]->dy=0;
 					particleList[i]->dz=0;
 					particleList[i]->size=2;
-					particleList[i]->life=20+Random(20);
+					particleList[i]->life=20+particleRng.Random(20);
 					particleList[i]->type=PART_SNOW;
 					particleList[i]->color=31;
 					if(--amt==0)
@@ -1291,14 +1297,14 @@ void ParticleBoom(byte type,int x,int y,int z)
 			{
 				if(!particleList[i]->Alive())
 				{
-					particleList[i]->x=x-FIXAMT*10+Random(FIXAMT*20+1);
-					particleList[i]->y=y-FIXAMT*10+Random(FIXAMT*20+1);
-					particleList[i]->z=FIXAMT*2+Random(FIXAMT*4+1);
-					particleList[i]->dx=-FIXAMT*2+Random(FIXAMT*4+1);
-					particleList[i]->dy=-FIXAMT*2+Random(FIXAMT*4+1);
-					particleList[i]->dz=Random(FIXAMT*2);
+					particleList[i]->x=x-FIXAMT*10+particleRng.Random(FIXAMT*20+1);
+					particleList[i]->y=y-FIXAMT*10+particleRng.Random(FIXAMT*20+1);
+					particleList[i]->z=FIXAMT*2+particleRng.Random(FIXAMT*4+1);
+					particleList[i]->dx=-FIXAMT*2+particleRng.Random(FIXAMT*4+1);
+					particleList[i]->dy=-FIXAMT*2+particleRng.Random(FIXAMT*4+1);
+					particleList[i]->dz=particleRng.Random(FIXAMT*2);
 					particleList[i]->color=31;
-					particleList[i]->life=20+Random(10);
+					particleList[i]->life=20+particleRng.Random(10);
 					particleList[i]->size=10;
 					particleList[i]->type=ptype;
 					if(--amt==0)
@@ -1315,12 +1321,12 @@ void ParticleBoom(byte type,int x,int y,int z)
 			{
 				if(!particleList[i]->Alive())
 				{
-					particleList[i]->x=x-FIXAMT*10+Random(FIXAMT*20+1);
-					particleList[i]->y=y-FIXAMT*10+Random(FIXAMT*20+1);
-					particleList[i]->z=FIXAMT*2+Random(FIXAMT*15+1);
-					particleList[i]->dx=-FIXAMT+Random(FIXAMT*2+1);
-					particleList[i]->dy=-FIXAMT+Random(FIXAMT*2+1);
-					particleList[i]->dz=Random(FIXAMT);
+					particleList[i]->x=x-FIXAMT*10+particleRng.Random(FIXAMT*20+1);
+					particleList[i]->y=y-FIXAMT*10+particleRng.Random(FIXAMT*20+1);
+					particleList[i]->z=FIXAMT*2+particleRng.Random(FIXAMT*15+1);
+					particleList[i]->dx=-FIXAMT+particleRng.Random(FIXAMT*2+1);
+					particleList[i]->dy=-FIXAMT+particleRng.Random(FIXAMT*2+1);
+					particleList[i]->dz=particleRng.Random(FIXAMT);
 					particleList[i]->color=7;
 					particleList[i]->life=7*4+3;
 					particleList[i]->size=1;
@@ -1338,12 +1344,12 @@ void ParticleBoom(byte type,int x,int y,int z)
 			{
 				if(!particleList[i]->Alive())
 				{
-					particleList[i]->x=x-FIXAMT*10+Random(FIXAMT*20+1);
-					particleList[i]->y=y-FIXAMT*10+Random(FIXAMT*20+1);
-					particleList[i]->z=z-FIXAMT*4+Random(FIXAMT*8+1);
-					particleList[i]->dx=-FIXAMT+Random(FIXAMT*2+1);
-					particleList[i]->dy=-FIXAMT+Random(FIXAMT*2+1);
-					particleList[i]->dz=Random(FIXAMT*2)+FIXAMT*5;
+					particleList[i]->x=x-FIXAMT*10+particleRng.Random(FIXAMT*20+1);
+					particleList[i]->y=y-FIXAMT*10+particleRng.Random(FIXAMT*20+1);
+					particleList[i]->z=z-FIXAMT*4+particleRng.Random(FIXAMT*8+1);
+					particleList[i]->dx=-FIXAMT+particleRng.Random(FIXAMT*2+1);
+					particleList[i]->dy=-FIXAMT+particleRng.Random(FIXAMT*2+1);
+					particleList[i]->dz=particleRng.Random(FIXAMT*2)+FIXAMT*5;
 					particleList[i]->color=7;
 					particleList[i]->life=7*4+3;
 					particleList[i]->size=1;
@@ -1362,15 +1368,15 @@ void ParticleBoom(byte type,int x,int y,int z)
 			{
 				if(!particleList[i]->Alive())
 				{
-					particleList[i]->x=x-FIXAMT*2+Random(FIXAMT*4);
+					particleList[i]->x=x-FIXAMT*2+particleRng.Random(FIXAMT*4);
 					particleList[i]->y=y;
-					particleList[i]->z=z-FIXAMT*2+Random(FIXAMT*4);
-					particleList[i]->dx=-FIXAMT*2+Random(FIXAMT*4);
+					particleList[i]->z=z-FIXAMT*2+particleRng.Random(FIXAMT*4);
+					particleList[i]->dx=-FIXAMT*2+particleRng.Random(FIXAMT*4);
 					particleList[i]->dy=0;
-					particleList[i]->dz=Random(FIXAMT*2);
+					particleList[i]->dz=particleRng.Random(FIXAMT*2);
 					particleList[i]->color=191;
-					particleList[i]->life=10+Random(30);
-					particleList[i]->size=8*4+(byte)Random(4*4);
+					particleList[i]->life=10+particleRng.Random(30);
+					particleList[i]->size=8*4+(byte)particleRng.Random(4*4);
 					particleList[i]->type=PART_FIRE;
 					if(--amt==0)
 						break;
@@ -1467,9 +1473,9 @@ void FXRing(byte color,int x,int y,int z,byte num,byte force)
 			particleList[i]->GoExact(PART_FX,x,y,z,a,force);
 			particleList[i]->x+=particleList[i]->dx*20;
 			particleList[i]->y+=particleList[i]->dy*20;
-			particleList[i]->dx+=-(force/4)+Random(force/2+1);
-			particleList[i]->dy+=-(force/4)+Random(force/2+1);
-			particleList[i]->dz=FIXAMT*5-Random(FIXAMT*3);
+			particleList[i]->dx+=-(force/4)+particleRng.Random(force/2+1);
+			particleList[i]->dy+=-(force/4)+particleRng.Random(force/2+1);
+			particleList[i]->dz=FIXAMT*5-particleRng.Random(FIXAMT*3);
 			particleList[i]->color=color*32+16;
 			particleList[i]->tx=x;
 			particleList[i]->life=50;
@@ -13,6 +13,11 @@
 #include "achieve.h"
 #include "leveldef.h"
 #include "appdata.h"
+#include "hamworld.h"
+#include "log.h"
+#include <map>
+#include <sstream>
+#include <stdexcept>
 
 char pauseOption[PAUSE_CHOICES][32]={
 	"Resume",
@@ -978,69 +983,252 @@ void HandlePauseKeyPresses(MGLDraw *mgl)
 		lastKey=k;
 }
 
-void LoadGame(void)
+// Saved games start with this code, which can never begin a profile name, so
+// the old raw-struct saves can be told apart from the sectioned ones.
+static const int SAVE_CODE_LENGTH = 8;
+static const char SAVE_CODE[SAVE_CODE_LENGTH + 1] = "\x1ALoony2";
+static const int SAVE_VERSION = 1;
+
+typedef std::map<std::string, std::string> saveSections_t;
+
+typedef struct pendingSave_t
 {
-	FILE *f;
-	char txt[64];
+	char fname[64];
+	std::string data;
+} pendingSave_t;
 
+static SDL_Thread *saveThread;
 
-	sprintf(txt,"profiles/char%02d.loony",gameToLoad+1);
-	f=AppdataOpen(txt,"rb");
-	if(!f)
+static int SaveWriterThread(void *data)
+{
+	pendingSave_t *save = (pendingSave_t *)data;
+	FILE *f;
+
+	f = AppdataOpen(save->fname, "wb");
+	if (f)
 	{
-		InitPlayer(INIT_GAME,0,0);
+		fwrite(save->data.data(), 1, save->data.size(), f);
+		fclose(f);
+		AppdataSync();
 	}
 	else
+		LogError("couldn't write saved game %s", save->fname);
+	delete save;
+	return 0;
+}
+
+void FinishSaveGame(void)
+{
+	if (saveThread)
 	{
-		fread(&player,sizeof(player_t),1,f);
-		if(player.addonName[0]=='\0')
-		{
-			ResetLevelDefs();
-			LoadWorld(&curWorld,"winter.llw");
-		}
-		else
+		SDL_WaitThread(saveThread, NULL);
+		saveThread = NULL;
+	}
+}
+
+// read a sectioned save, returns false if it's an old-style save instead
+static bool ReadSaveSections(FILE *f, saveSections_t *sections)
+{
+	std::string data;
+	char buf[4096];
+	size_t amt;
+
+	while ((amt = fread(buf, 1, sizeof(buf), f)) > 0)
+		data.append(buf, amt);
+
+	if (data.size() < SAVE_CODE_LENGTH || memcmp(data.data(), SAVE_CODE, SAVE_CODE_LENGTH))
+		return false;
+
+	std::istringstream input(data.substr(SAVE_CODE_LENGTH));
+	size_t version, len;
+	if (!hamworld::read_varint(input, &version) || version > SAVE_VERSION)
+		throw std::runtime_error("unknown saved game version");
+
+	while (hamworld::read_varint(input, &len) && len > 0)
+	{
+		std::string body(len, '\0');
+		if (!input.read(&body[0], len))
+			throw std::runtime_error("truncated saved game");
+
+		std::istringstream sec(body);
+		std::string name;
+		if (!hamworld::read_string(sec, &name))
+			throw std::runtime_error("truncated saved game");
+		(*sections)[name] = body.substr(sec.tellg());
+	}
+	return true;
+}
+
+static void GetSaveSection(saveSections_t *sections, const char *name, hamworld::Section *sec)
+{
+	saveSections_t::iterator it = sections->find(name);
+	if (it == sections->end())
+		throw std::runtime_error(std::string("saved game is missing ") + name);
+	sec->stream.str(it->second);
+}
+
+static void PutSaveSection(std::ostringstream &output, hamworld::string_view name, hamworld::Section *sec)
+{
+	std::string body = sec->save();
+	hamworld::write_varint(output, hamworld::size_varint(name.length()) + name.length() + body.length());
+	hamworld::write_string(output, name);
+	output.write(body.data(), body.size());
+}
+
+byte LoadSavedPlayer(FILE *f, player_t *p)
+{
+	saveSections_t sections;
+
+	FinishSaveGame();
+	try
+	{
+		if (!ReadSaveSections(f, &sections))
 		{
-			sprintf(txt,"addons/%s.llw",player.addonName);
-			LoadLevelDefs(player.addonName);
-			LoadWorld(&curWorld,txt);
+			rewind(f);
+			return fread(p, sizeof(player_t), 1, f) == 1;
 		}
-		LoadGuys(f);
-		LoadBullets(f);
+
+		hamworld::Section sec;
+		GetSaveSection(&sections, "player", &sec);
+		LoadPlayer(&sec, p);
+		return 1;
+	}
+	catch (std::exception &e)
+	{
+		LogError("bad saved game: %s", e.what());
+		return 0;
+	}
+}
+
+static void LoadPlayerWorld(void)
+{
+	char txt[64];
+
+	if(player.addonName[0]=='\0')
+	{
+		ResetLevelDefs();
+		LoadWorld(&curWorld,"winter.llw");
+	}
+	else
+	{
+		sprintf(txt,"addons/%s.llw",player.addonName);
+		LoadLevelDefs(player.addonName);
+		LoadWorld(&curWorld,txt);
+	}
+}
+
+static byte LoadGameSections(saveSections_t *sections)
+{
+	try
+	{
+		hamworld::Section sec;
+		GetSaveSection(sections, "player", &sec);
+		LoadPlayer(&sec, &player);
+		LoadPlayerWorld();
+
+		hamworld::Section guysec, bulletsec, mapsec;
+		GetSaveSection(sections, "guys", &guysec);
+		LoadGuys(&guysec);
+		GetSaveSection(sections, "bullets", &bulletsec);
+		LoadBullets(&bulletsec);
 		if(!curMap)
 			curMap=new Map(20,20,"hi");
-		curMap->LoadFromProgress(f);
-		fclose(f);
-		ResetInterface();
-		PlayerCalcStats();
-		if(player.invinc<30)
-			player.invinc=30;	// and make you invincible briefly
+		GetSaveSection(sections, "map", &mapsec);
+		curMap->LoadFromProgress(&mapsec);
+		return 1;
+	}
+	catch (std::exception &e)
+	{
+		LogError("bad saved game: %s", e.what());
+		return 0;
 	}
 }
 
-void SaveGame(void)
+void LoadGame(void)
 {
 	FILE *f;
 	char txt[64];
+	saveSections_t sections;
+	byte ok;
 
+	FinishSaveGame();
 	sprintf(txt,"profiles/char%02d.loony",gameToLoad+1);
-	f=AppdataOpen(txt,"wb");
+	f=AppdataOpen(txt,"rb");
 	if(!f)
 	{
+		InitPlayer(INIT_GAME,0,0);
 		return;
 	}
-	else
+
+	try
 	{
-		player.destx=goodguy->mapx;
-		player.desty=goodguy->mapy;
-		fwrite(&player,sizeof(player_t),1,f);
-		player.destx=0;
-		player.desty=0;
-		SaveGuys(f);
-		SaveBullets(f);
-		curMap->SaveProgress(f);
-		fclose(f);
-		AppdataSync();
+		ok=ReadSaveSections(f,&sections) ? LoadGameSections(&sections) : 2;
 	}
+	catch (std::exception &e)
+	{
+		LogError("bad saved game %s: %s", txt, e.what());
+		ok=0;
+	}
+
+	if(ok==2)
+	{
+		// an old save, which is just the structs dumped out
+		rewind(f);
+		fread(&player,sizeof(player_t),1,f);
+		LoadPlayerWorld();
+		LoadGuys(f);
+		LoadBullets(f);
+		if(!curMap)
+			curMap=new Map(20,20,"hi");
+		curMap->LoadFromProgress(f);
+	}
+	fclose(f);
+
+	if(!ok)
+	{
+		InitPlayer(INIT_GAME,0,0);
+		return;
+	}
+	ResetInterface();
+	PlayerCalcStats();
+	if(player.invinc<30)
+		player.invinc=30;	// and make you invincible briefly
+}
+
+void SaveGame(void)
+{
+	pendingSave_t *save;
+	hamworld::Section playersec, guysec, bulletsec, mapsec;
+	std::ostringstream output;
+
+	// the last save has to be on disk before its file can be replaced
+	FinishSaveGame();
+
+	player.destx=goodguy->mapx;
+	player.desty=goodguy->mapy;
+	SavePlayer(&playersec,&player);
+	player.destx=0;
+	player.desty=0;
+	SaveGuys(&guysec);
+	SaveBullets(&bulletsec);
+	curMap->SaveProgress(&mapsec);
+
+	output.write(SAVE_CODE,SAVE_CODE_LENGTH);
+	hamworld::write_varint(output,SAVE_VERSION);
+	PutSaveSection(output,"player",&playersec);
+	PutSaveSection(output,"guys",&guysec);
+	PutSaveSection(output,"bullets",&bulletsec);
+	PutSaveSection(output,"map",&mapsec);
+	output.put(0);
+
+	// the game state is all captured now, so the disk work can happen
+	// without holding up the game
+	save=new pendingSave_t;
+	sprintf(save->fname,"profiles/char%02d.loony",gameToLoad+1);
+	save->data=output.str();
+	saveThread=SDL_CreateThread(SaveWriterThread,"SaveGame",save);
+	if(!saveThread)
+		SaveWriterThread(save);
 }
 
 void SetupSkillPage(void)
@@ -40,6 +40,10 @@ void InitPauseMenu(void);
 void SetSubCursor(byte s);
 void LoadGame(void);
 void SaveGame(void);
+// wait for a save that's still being written in the background
+void FinishSaveGame(void);
+// read just the player out of a saved game file, old or new format
+byte LoadSavedPlayer(FILE *f,player_t *p);
 
 void PauseBox(int x,int y,int x2,int y2,byte c);
 void RenderInvItem(int x,int y,byte type,byte count,byte on);
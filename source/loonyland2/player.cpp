@@ -11,6 +11,8 @@
 #include "madcap.h"
 #include "achieve.h"
 #include "services.h"
+#include "hamworld.h"
+#include <algorithm>
 
 // characters
 #include "ch_loony.h"
@@ -1159,3 +1161,243 @@ void PlayerAddKill(byte type)
 	player.var[VAR_KILLCOUNTS+type]=(byte)(w%256);
 	player.var[VAR_KILLCOUNTS+type+1]=(byte)(w/256);
 }
+
+static void SaveFixedString(hamworld::Section *f, const char *s, size_t len)
+{
+	f->write_string(std::string(s, strnlen(s, len)));
+}
+
+static void LoadFixedString(hamworld::Section *f, char *s, size_t len)
+{
+	std::string str;
+	f->read_string(&str);
+	memset(s, 0, len);
+	memcpy(s, str.data(), std::min(str.size(), len));
+}
+
+void SavePlayer(hamworld::Section *f, const player_t *p)
+{
+	int i;
+
+	SaveFixedString(f, p->profile, sizeof(p->profile));
+	SaveFixedString(f, p->addonName, sizeof(p->addonName));
+	f->write_svarint(p->money);
+	f->write_varint(p->worldNum);
+	f->write_varint(p->levelNum);
+	f->write_svarint(p->boredom);
+	f->write_varint(p->hearts);
+	f->write_varint(p->maxHearts);
+	f->write_varint(p->fireFlags);
+	f->write_varint(p->fireRange);
+	f->write_varint(p->reload);
+	f->write_varint(p->pushPower);
+	f->write_varint(p->chatClock);
+	f->write_varint(p->saveClock);
+	f->write_varint(p->stone);
+	f->write_svarint(p->invinc);
+	f->write_svarint(p->destx);
+	f->write_svarint(p->desty);
+	f->write_varint(p->speed);
+	f->write_varint(p->difficulty);
+	f->write_varint(p->monsterPoints);
+	f->write_varint(p->batLevel);
+	f->write_svarint(p->monsType);
+	f->write_varint(p->startHearts);
+	f->write_varint(p->cheatsOn);
+	f->write_varint(p->xtraVar);
+	f->write_varint(p->crystalBall);
+	f->write_varint(p->xtraByte);
+	f->write_varint(p->clockRunning);
+	f->write_varint(p->timeLimit);
+	f->write_varint(p->timeToFinish);
+	f->write_varint(p->bestCombo);
+	f->write_varint(p->shotsFired);
+	f->write_varint(p->specialShotsFired);
+	f->write_varint(p->shouldMonsters);
+	f->write_varint(p->gemsGotten);
+	f->write_varint(p->hitsTaken);
+	f->write_varint(p->rank);
+	f->write_packed(p->var, sizeof(p->var));
+	f->write_varint(p->arenaHearts);
+	f->write_varint(p->arenaMagic);
+	f->write_varint(p->arenaStamina);
+	f->write_varint(p->playClock);
+	f->write_varint(p->potionsDrunk);
+	f->write_varint(p->kills);
+	f->write_varint(p->herbsPicked);
+	f->write_varint(p->holesDug);
+	f->write_varint(p->damageDone);
+	f->write_varint(p->xp);
+	f->write_varint(p->xpNeed);
+	f->write_varint(p->level);
+	f->write_varint(p->skillPts);
+	f->write_varint(p->damage);
+	f->write_varint(p->axeSpeed);
+	f->write_varint(p->axeMode);
+	f->write_varint(p->armor);
+	f->write_varint(p->magic);
+	f->write_varint(p->maxMagic);
+	f->write_varint(p->startMagic);
+	f->write_varint(p->stamina);
+	f->write_varint(p->maxStamina);
+	f->write_varint(p->staminaClock);
+	f->write_varint(p->magicClock);
+	// equip_t is nothing but bytes, so equipment goes through as packed blocks
+	f->write_packed(&p->axe, sizeof(equip_t));
+	f->write_packed(&p->parka, sizeof(equip_t));
+	f->write_packed(&p->amulet, sizeof(equip_t));
+	f->write_packed(p->lens, sizeof(p->lens));
+	f->write_packed(p->items, sizeof(p->items));
+	f->write_packed(p->shopInv, sizeof(p->shopInv));
+	f->write_packed(p->skillHave, sizeof(p->skillHave));
+	f->write_packed(p->skillLvl, sizeof(p->skillLvl));
+	f->write_varint(PLAYER_SKILLS);
+	for (i = 0; i < PLAYER_SKILLS; ++i)
+		f->write_varint(p->skillClock[i]);
+	f->write_varint(MAX_TALENTS);
+	for (i = 0; i < MAX_TALENTS; ++i)
+		f->write_varint(p->talentPts[i]);
+	f->write_packed(p->talentLevel, sizeof(p->talentLevel));
+	f->write_varint(p->parry);
+	f->write_varint(p->spclMove);
+	f->write_varint(p->whirlClock);
+	f->write_varint(p->spell);
+	f->write_varint(p->lastTown);
+	f->write_varint(p->shockClock);
+	f->write_varint(p->berserkClock);
+	f->write_varint(p->parkaClock);
+	f->write_varint(p->amuletClock);
+	f->write_varint(p->potionClock);
+	f->write_varint(p->potionType);
+	f->write_varint(p->potionPower);
+	f->write_varint(MAX_LOG);
+	for (i = 0; i < MAX_LOG; ++i)
+		SaveFixedString(f, p->log[i], LOG_LEN);
+	f->write_varint(p->logBright);
+	f->write_varint(p->logTime);
+	f->write_varint(p->arenaLvl);
+	f->write_varint(p->arenaTime);
+	f->write_varint(p->arenaWave);
+	f->write_varint(p->arenaSpawn);
+	f->write_varint(0);  // no extension flags
+}
+
+void LoadPlayer(hamworld::Section *f, player_t *p)
+{
+	size_t i, n;
+
+	memset(p, 0, sizeof(player_t));
+	LoadFixedString(f, p->profile, sizeof(p->profile));
+	LoadFixedString(f, p->addonName, sizeof(p->addonName));
+	p->money = f->read_svarint();
+	p->worldNum = f->read_varint();
+	p->levelNum = f->read_varint();
+	p->boredom = f->read_svarint();
+	p->hearts = f->read_varint();
+	p->maxHearts = f->read_varint();
+	p->fireFlags = f->read_varint();
+	p->fireRange = f->read_varint();
+	p->reload = f->read_varint();
+	p->pushPower = f->read_varint();
+	p->chatClock = f->read_varint();
+	p->saveClock = f->read_varint();
+	p->stone = f->read_varint();
+	p->invinc = f->read_svarint();
+	p->destx = f->read_svarint();
+	p->desty = f->read_svarint();
+	p->speed = f->read_varint();
+	p->difficulty = f->read_varint();
+	p->monsterPoints = f->read_varint();
+	p->batLevel = f->read_varint();
+	p->monsType = f->read_svarint();
+	p->startHearts = f->read_varint();
+	p->cheatsOn = f->read_varint();
+	p->xtraVar = f->read_varint();
+	p->crystalBall = f->read_varint();
+	p->xtraByte = f->read_varint();
+	p->clockRunning = f->read_varint();
+	p->timeLimit = f->read_varint();
+	p->timeToFinish = f->read_varint();
+	p->bestCombo = f->read_varint();
+	p->shotsFired = f->read_varint();
+	p->specialShotsFired = f->read_varint();
+	p->shouldMonsters = f->read_varint();
+	p->gemsGotten = f->read_varint();
+	p->hitsTaken = f->read_varint();
+	p->rank = f->read_varint();
+	f->read_packed(p->var, sizeof(p->var));
+	p->arenaHearts = f->read_varint();
+	p->arenaMagic = f->read_varint();
+	p->arenaStamina = f->read_varint();
+	p->playClock = f->read_varint();
+	p->potionsDrunk = f->read_varint();
+	p->kills = f->read_varint();
+	p->herbsPicked = f->read_varint();
+	p->holesDug = f->read_varint();
+	p->damageDone = f->read_varint();
+	p->xp = f->read_varint();
+	p->xpNeed = f->read_varint();
+	p->level = f->read_varint();
+	p->skillPts = f->read_varint();
+	p->damage = f->read_varint();
+	p->axeSpeed = f->read_varint();
+	p->axeMode = f->read_varint();
+	p->armor = f->read_varint();
+	p->magic = f->read_varint();
+	p->maxMagic = f->read_varint();
+	p->startMagic = f->read_varint();
+	p->stamina = f->read_varint();
+	p->maxStamina = f->read_varint();
+	p->staminaClock = f->read_varint();
+	p->magicClock = f->read_varint();
+	f->read_packed(&p->axe, sizeof(equip_t));
+	f->read_packed(&p->parka, sizeof(equip_t));
+	f->read_packed(&p->amulet, sizeof(equip_t));
+	f->read_packed(p->lens, sizeof(p->lens));
+	f->read_packed(p->items, sizeof(p->items));
+	f->read_packed(p->shopInv, sizeof(p->shopInv));
+	f->read_packed(p->skillHave, sizeof(p->skillHave));
+	f->read_packed(p->skillLvl, sizeof(p->skillLvl));
+	n = f->read_varint();
+	for (i = 0; i < n; ++i)
+	{
+		word w = f->read_varint();
+		if (i < PLAYER_SKILLS)
+			p->skillClock[i] = w;
+	}
+	n = f->read_varint();
+	for (i = 0; i < n; ++i)
+	{
+		word w = f->read_varint();
+		if (i < MAX_TALENTS)
+			p->talentPts[i] = w;
+	}
+	f->read_packed(p->talentLevel, sizeof(p->talentLevel));
+	p->parry = f->read_varint();
+	p->spclMove = f->read_varint();
+	p->whirlClock = f->read_varint();
+	p->spell = f->read_varint();
+	p->lastTown = f->read_varint();
+	p->shockClock = f->read_varint();
+	p->berserkClock = f->read_varint();
+	p->parkaClock = f->read_varint();
+	p->amuletClock = f->read_varint();
+	p->potionClock = f->read_varint();
+	p->potionType = f->read_varint();
+	p->potionPower = f->read_varint();
+	n = f->read_varint();
+	for (i = 0; i < n; ++i)
+	{
+		char line[LOG_LEN];
+		LoadFixedString(f, line, LOG_LEN);
+		if (i < MAX_LOG)
+			memcpy(p->log[i], line, LOG_LEN);
+	}
+	p->logBright = f->read_varint();
+	p->logTime = f->read_varint();
+	p->arenaLvl = f->read_varint();
+	p->arenaTime = f->read_varint();
+	p->arenaWave = f->read_varint();
+	p->arenaSpawn = f->read_varint();
+	f->read_varint();  // ignore extension flags
+}
@@ -286,4 +286,7 @@ void PlayerGetMoney(int amt);
 void MadcapPlayer(void);
 void PlayerAddKill(byte type);
 
+void SavePlayer(hamworld::Section *f,const player_t *p);
+void LoadPlayer(hamworld::Section *f,player_t *p);
+
 #endif
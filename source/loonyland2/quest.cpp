@@ -1,4 +1,5 @@
 #include "quest.h"
+#include "radar.h"
 #include "game.h"
 #include "control.h"
 #include "display.h"
@@ -3734,18 +3735,15 @@ void DoChatAction(byte a)
 			// unlock melody
 			PlayerSetVar(VAR_WIFEUNLOCK,1);
 			PlayerSetVar(VAR_QUESTDONE+QUEST_BOBSWIFE2,1);
-			word w;
-			w=GuyList_First();
-			while(w!=65535)
+			for(Guy *g : GuyQuery())
 			{
-				if(GetGuy(w)->tag==9)
+				if(g->tag==9)
 				{
-					GetGuy(w)->tag=10;
-					GetGuy(w)->mind1=0;
+					g->tag=10;
+					g->mind1=0;
 					MakeNormalSound(SND_DOOROPEN);
 					break;
 				}
-				w=GuyList_Next();
 			}
 			break;
 		case 32:
@@ -4220,22 +4218,20 @@ void DoChatAction(byte a)
 			break;
 		case 107:	// shroom ritual
 			curMap->map[72+51*curMap->width].item=IT_NONE;
-			i=GuyList_First();
-			while(i!=65535)
+			for(Guy *g : GuyQuery().Type(MONS_VILLAGER))
 			{
-				if(GetGuy(i)->type==MONS_VILLAGER && GetGuy(i)->tag==38)
+				if(g->tag==38)
 				{
 					MakeNormalSound(SND_SHROOMIFY);
 					curMap->BrightTorch(72,51,90,5);
-					FXRing(0,GetGuy(i)->x,GetGuy(i)->y,0,32,1);
-					GetGuy(i)->tag=39;
-					GetGuy(i)->x=(72*TILE_WIDTH+TILE_WIDTH/2)*FIXAMT;
-					GetGuy(i)->y=(51*TILE_HEIGHT+TILE_HEIGHT/2)*FIXAMT;
-					GetGuy(i)->bright=32;
-					FXRing(0,GetGuy(i)->x,GetGuy(i)->y,0,32,1);
+					FXRing(0,g->x,g->y,0,32,1);
+					g->tag=39;
+					g->x=(72*TILE_WIDTH+TILE_WIDTH/2)*FIXAMT;
+					g->y=(51*TILE_HEIGHT+TILE_HEIGHT/2)*FIXAMT;
+					g->bright=32;
+					FXRing(0,g->x,g->y,0,32,1);
 					break;
 				}
-				i=GuyList_Next();
 			}
 			PlayerSetVar(VAR_YOUTH,1);
 			break;
@@ -4245,24 +4241,14 @@ void DoChatAction(byte a)
 				if(player.var[VAR_BOKFOUND+i])
 					amt++;
 			player.var[VAR_BOKGIVEN]=amt;
-			i=GuyList_First();
-			while(i!=65535)
-			{
-				if(GetGuy(i)->type==MONS_BOKBOK)
-					GetGuy(i)->mind2=2;
-				i=GuyList_Next();
-			}
+			for(Guy *g : GuyQuery().Type(MONS_BOKBOK))
+				g->mind2=2;
 			break;
 		case 109:	// bokbok quest done
 			PlayerSetVar(VAR_QUESTDONE+QUEST_BOKBOK,1);
 			player.var[VAR_BOKGIVEN]=10;
-			i=GuyList_First();
-			while(i!=65535)
-			{
-				if(GetGuy(i)->type==MONS_BOKBOK)
-					GetGuy(i)->mind2=2;
-				i=GuyList_Next();
-			}
+			for(Guy *g : GuyQuery().Type(MONS_BOKBOK))
+				g->mind2=2;
 			if(PlayerGetItem(IT_BCRYSTAL,0,0))
 			{
 				bullet_t *b;
@@ -4346,6 +4332,7 @@ void DoChatAction(byte a)
 			PlayerSetVar(VAR_QUESTDONE+QUEST_BARON,1);
 			MakeNormalSound(SND_TITANDIE);
 			curMap->map[32+57*curMap->width].item=IT_KEY5;
+			Radar_ItemChanged(curMap,32,57);
 			break;
 		case 123:
 			PlayerSetVar(VAR_BARONDEAD,1);
@@ -5,10 +5,151 @@
 #include "skill.h"
 #include "map.h"
 #include "game.h"
+#include <vector>
+#include <algorithm>
+
+// rows of the map checked for new items each tick
+#define RADAR_SWEEP_ROWS	(2)
 
 radar_t radar[MAX_RADAR];
 static dword radarTick;
 
+// radar-worthy item categories
+#define RC_NONE		(0)
+#define RC_CRACK	(1)	// shown at tracking 5+
+#define RC_HERB		(2)	// shown at tracking 4+
+#define RC_EXIT		(3)	// shown at tracking 7+
+#define RC_ITEM		(4)	// shown at tracking 6+
+
+// every map tile holding a radar-worthy item, in map order, so that firing the
+// radar doesn't have to look at the whole map.  Entries are checked again each
+// time they're used, so items that go away just drop out.  Items that show up
+// are added by Radar_ItemChanged where that's cheap to call, and by a sweep of
+// a few rows per tick for everything else.
+typedef struct radarItem_t
+{
+	int tile;
+	byte category;
+} radarItem_t;
+
+static std::vector<radarItem_t> radarItems;
+static std::vector<byte> radarIndexed;
+static Map *radarMap;
+static mapTile_t *radarMapTiles;
+static int radarSweepY;
+static bool radarItemsChanged;
+
+// item blips from the last time the radar fired, reused as long as nothing
+// they depend on has changed
+static std::vector<radar_t> itemBlips;
+static int blipCamX,blipCamY,blipRange;
+static byte blipLevel;
+
+static byte RadarCategory(const mapTile_t *m)
+{
+	byte item=m->item;
+
+	if(item==IT_CRACKUNDER || item==IT_SUPCRACK || item==IT_CRACK)
+		return RC_CRACK;
+	if(item==IT_BURIEDASB || (item>=IT_HERBA && item<=IT_HERBF))
+		return RC_HERB;
+	if(item==IT_EXIT || item==IT_GEYSER || item==IT_UPGEYSER)
+		return RC_EXIT;
+	if((item>=IT_ROPE && item<IT_ENERGYBARRIER) || item==IT_SCROLL || item==IT_SUPPLIES || item==IT_SUPPLIES2 ||
+		(item>=IT_CHEST1 && item<=IT_CHEST5 && m->itemInfo==0))
+		return RC_ITEM;
+	return RC_NONE;
+}
+
+static byte RadarTeam(byte category,byte level)
+{
+	switch(category)
+	{
+		case RC_CRACK:
+			return (level>=5)?4:0;
+		case RC_HERB:
+			return 5;
+		case RC_EXIT:
+			return (level>=7)?7:0;
+		case RC_ITEM:
+			return (level>=6)?6:0;
+	}
+	return 0;
+}
+
+static bool RadarItemBefore(const radarItem_t &a,int tile)
+{
+	return a.tile<tile;
+}
+
+static void RadarIndexTile(int i)
+{
+	radarItem_t r;
+
+	if(radarIndexed[i])
+		return;
+	r.tile=i;
+	r.category=RadarCategory(&radarMap->map[i]);
+	if(r.category==RC_NONE)
+		return;
+
+	radarIndexed[i]=1;
+	radarItems.insert(std::lower_bound(radarItems.begin(),radarItems.end(),i,RadarItemBefore),r);
+	radarItemsChanged=true;
+}
+
+// drop items that have gone away, and notice any that turned into something else
+static void RadarCheckItems(void)
+{
+	size_t i,j;
+	byte cat;
+
+	j=0;
+	for(i=0;i<radarItems.size();i++)
+	{
+		cat=RadarCategory(&radarMap->map[radarItems[i].tile]);
+		if(cat!=radarItems[i].category)
+			radarItemsChanged=true;
+		if(cat==RC_NONE)
+		{
+			radarIndexed[radarItems[i].tile]=0;
+			continue;
+		}
+		radarItems[j].tile=radarItems[i].tile;
+		radarItems[j].category=cat;
+		j++;
+	}
+	radarItems.resize(j);
+}
+
+static void RadarIndexMap(void)
+{
+	int i;
+
+	radarMap=curMap;
+	radarMapTiles=curMap->map;
+	radarSweepY=0;
+	radarItems.clear();
+	radarIndexed.assign(curMap->width*curMap->height,0);
+	for(i=0;i<curMap->width*curMap->height;i++)
+		RadarIndexTile(i);
+	radarItemsChanged=true;
+}
+
+static void RadarSweep(int rows)
+{
+	int i;
+
+	for(;rows>0;rows--)
+	{
+		for(i=radarSweepY*radarMap->width;i<(radarSweepY+1)*radarMap->width;i++)
+			RadarIndexTile(i);
+		radarSweepY++;
+		if(radarSweepY>=radarMap->height)
+			radarSweepY=0;
+	}
+}
+
 void Radar_Clear(void)
 {
 	int i;
@@ -21,10 +162,24 @@ void Radar_Init(void)
 {
 	Radar_Clear();
 	radarTick=0;
+	radarMap=NULL;
+	itemBlips.clear();
 }
 
 void Radar_Exit(void)
 {
+	radarMap=NULL;
+	radarItems.clear();
+	radarIndexed.clear();
+	itemBlips.clear();
+}
+
+void Radar_ItemChanged(Map *map,int x,int y)
+{
+	if(map!=radarMap || map->map!=radarMapTiles)
+		return;	// not indexed, it'll get a fresh look when it is
+
+	RadarIndexTile(x+y*map->width);
 }
 
 void Radar_Add(byte team,int x,int y,float dist)
@@ -94,13 +249,73 @@ void Radar_Add(byte team,int x,int y,float dist)
 	}
 }
 
+static int RadarFirstFree(void)
+{
+	int i;
+
+	for(i=0;i<MAX_RADAR;i++)
+		if(radar[i].color==0)
+			return i;
+	return MAX_RADAR;
+}
+
+static void RadarAddItems(int camX,int camY,int range,byte level)
+{
+	size_t n;
+	int i,first,cx,cy,dx,dy;
+	byte team;
+	float dist;
+
+	first=RadarFirstFree();
+	if(!radarItemsChanged && camX==blipCamX && camY==blipCamY && range==blipRange && level==blipLevel &&
+		first+(int)itemBlips.size()<MAX_RADAR)
+	{
+		// nothing about the items has changed, put the same blips back up
+		for(n=0;n<itemBlips.size();n++)
+			radar[first+n]=itemBlips[n];
+		return;
+	}
+
+	cx=(camX/(TILE_WIDTH*FIXAMT));
+	cy=(camY/(TILE_HEIGHT*FIXAMT));
+	for(n=0;n<radarItems.size();n++)
+	{
+		team=RadarTeam(radarItems[n].category,level);
+		if(!team)
+			continue;
+
+		i=radarItems[n].tile;
+		dx=(i%curMap->width)-cx;
+		dy=(i/curMap->width)-cy;
+		if(dx*dx+dy*dy>=range*range)
+			continue;
+
+		dist=(float)sqrt((float)(dx*dx+dy*dy));
+		Radar_Add(team,((i%curMap->width)*TILE_WIDTH+TILE_WIDTH/2)*FIXAMT,((i/curMap->width)*TILE_HEIGHT+TILE_HEIGHT/2)*FIXAMT,dist*TILE_WIDTH);
+	}
+
+	// remember these blips, unless some got cut off for lack of room
+	itemBlips.clear();
+	radarItemsChanged=true;
+	i=RadarFirstFree();
+	if(i<MAX_RADAR)
+	{
+		itemBlips.assign(&radar[first],&radar[i]);
+		radarItemsChanged=false;
+		blipCamX=camX;
+		blipCamY=camY;
+		blipRange=range;
+		blipLevel=level;
+	}
+}
+
 void Radar_Update(void)
 {
 	dword time;
-	word gNum;
-	Guy *g;
-	int range,i,cx,cy;
-	float dist,dist2;
+	int range,cx,cy;
+	byte level;
+	float dist;
+	long long dx,dy,maxDist;
 
 	radarTick++;
 
@@ -111,6 +326,15 @@ void Radar_Update(void)
 		return;
 	}
 
+	level=SpecificSkillLevel(SKILL_TRACKING);
+	if(level>=4)
+	{
+		if(radarMap!=curMap || radarMapTiles!=curMap->map || (int)radarIndexed.size()!=curMap->width*curMap->height)
+			RadarIndexMap();
+		else
+			RadarSweep(RADAR_SWEEP_ROWS);
+	}
+
 	range=(int)SpecificSkillVal(0,SKILL_TRACKING);
 	GetCamera(&cx,&cy);
 	cx*=FIXAMT;
@@ -120,61 +344,34 @@ void Radar_Update(void)
 		radarTick=0;
 
 		Radar_Clear();
-		gNum=GuyList_First();
-		while(gNum!=65535)
+		maxDist=(long long)range*TILE_WIDTH*FIXAMT;
+		maxDist*=maxDist;
+		for(Guy *g : GuyQuery())
 		{
-			g=GetGuy(gNum);
 			if(g->type!=MONS_LOONY && (!(monsType[g->type].flags&MF_INVINCIBLE) || g->type==MONS_VILLAGER || g->type==MONS_BOKBOK) && g->type!=MONS_FROSTGATE)	// anyone but the player!
 			{
-				if(SpecificSkillLevel(SKILL_TRACKING)<3 && g->team==GOOD)
+				if(level<3 && g->team==GOOD)
 				{
 					// don't show friends if lower than level 3
 				}
 				else
 				{
-					dist=(float)(g->x-cx)/(float)FIXAMT;
-					dist*=dist;
-					dist2=(float)(g->y-cy)/(float)FIXAMT;
-					dist2*=dist2;
-					dist=(float)sqrt(dist+dist2);
-					if((int)(dist/(TILE_WIDTH))<range)
+					dx=g->x-cx;
+					dy=g->y-cy;
+					if(dx*dx+dy*dy<maxDist)
+					{
+						dist=(float)sqrt((float)(dx*dx+dy*dy))/(float)FIXAMT;
 						Radar_Add(g->team,g->x,g->y,dist);
+					}
 				}
 			}
-			gNum=GuyList_Next();
 		}
 
-		cx=(cx/(TILE_WIDTH*FIXAMT));
-		cy=(cy/(TILE_HEIGHT*FIXAMT));
-		if(SpecificSkillLevel(SKILL_TRACKING)>=4)
+		if(level>=4)
 		{
 			// show items (only ones you can pick up!)
-			for(i=0;i<curMap->width*curMap->height;i++)
-			{
-				if((curMap->map[i].item>=IT_ROPE && curMap->map[i].item<IT_ENERGYBARRIER) || curMap->map[i].item==IT_SCROLL ||
-					curMap->map[i].item==IT_CRACKUNDER || curMap->map[i].item==IT_CRACK || curMap->map[i].item==IT_BURIEDASB ||
-					curMap->map[i].item==IT_SUPCRACK || curMap->map[i].item==IT_SUPPLIES || curMap->map[i].item==IT_SUPPLIES2 ||
-					curMap->map[i].item==IT_GEYSER || curMap->map[i].item==IT_UPGEYSER ||
-					(curMap->map[i].item>=IT_CHEST1 && curMap->map[i].item<=IT_CHEST5 && curMap->map[i].itemInfo==0) || curMap->map[i].item==IT_EXIT)
-				{
-					dist=(float)((i%curMap->width)-cx);
-					dist*=dist;
-					dist2=(float)((i/curMap->width)-cy);
-					dist2*=dist2;
-					dist=(float)sqrt(dist+dist2);
-					if((int)(dist)<range)
-					{
-						if((curMap->map[i].item==IT_CRACKUNDER || curMap->map[i].item==IT_SUPCRACK || curMap->map[i].item==IT_CRACK) && SpecificSkillLevel(SKILL_TRACKING)>=5)
-							Radar_Add(4,((i%curMap->width)*TILE_WIDTH+TILE_WIDTH/2)*FIXAMT,((i/curMap->width)*TILE_HEIGHT+TILE_HEIGHT/2)*FIXAMT,dist*TILE_WIDTH);
-						else if(curMap->map[i].item==IT_BURIEDASB || (curMap->map[i].item>=IT_HERBA && curMap->map[i].item<=IT_HERBF))
-							Radar_Add(5,((i%curMap->width)*TILE_WIDTH+TILE_WIDTH/2)*FIXAMT,((i/curMap->width)*TILE_HEIGHT+TILE_HEIGHT/2)*FIXAMT,dist*TILE_WIDTH);
-						else if(SpecificSkillLevel(SKILL_TRACKING)>=7 && (curMap->map[i].item==IT_EXIT || curMap->map[i].item==IT_GEYSER || curMap->map[i].item==IT_UPGEYSER))
-							Radar_Add(7,((i%curMap->width)*TILE_WIDTH+TILE_WIDTH/2)*FIXAMT,((i/curMap->width)*TILE_HEIGHT+TILE_HEIGHT/2)*FIXAMT,dist*TILE_WIDTH);
-						else if(SpecificSkillLevel(SKILL_TRACKING)>=6 && (curMap->map[i].item!=IT_EXIT && curMap->map[i].item!=IT_GEYSER && curMap->map[i].item!=IT_UPGEYSER))
-							Radar_Add(6,((i%curMap->width)*TILE_WIDTH+TILE_WIDTH/2)*FIXAMT,((i/curMap->width)*TILE_HEIGHT+TILE_HEIGHT/2)*FIXAMT,dist*TILE_WIDTH);
-					}
-				}
-			}
+			RadarCheckItems();
+			RadarAddItems(cx,cy,range,level);
 		}
 	}
 }
@@ -4,6 +4,8 @@
 #include "mgldraw.h"
 #pragma pack(1)
 
+class Map;
+
 #define MAX_RADAR	(256)
 
 typedef struct radar_t
@@ -17,5 +19,7 @@ void Radar_Init(void);
 void Radar_Exit(void);
 void Radar_Update(void);
 void Radar_Render(MGLDraw *mgl);
+// let the radar know an item may have appeared at (x,y)
+void Radar_ItemChanged(Map *map,int x,int y);
 
 #endif
@@ -1,4 +1,5 @@
 #include "tile.h"
+#include "jamulspr.h"
 #include "water.h"
 #include "config.h"
 
@@ -48,17 +49,11 @@ void LoadTiles(FILE *f)
 	fread(tiles,NUMTILES,sizeof(tile_t),f);
 }
 
-// defined in jamulspr.cpp
-extern byte SprModifyColor(byte color, byte hue);
-extern byte SprGetColor(byte color);
-extern byte SprModifyLight(byte color, char bright);
-extern byte SprModifyGhost(byte src, byte dst, char bright);
-extern byte SprModifyGlow(byte src, byte dst, char bright);
-
 void RenderFloorTile(int x,int y,int t,char light)
 {
 	byte *dst,*src;
 	int wid,hgt;
+	const byte *lit = SprLightTable(light);
 
 	if(light==0)
 	{
@@ -124,7 +119,7 @@ void RenderFloorTile(int x,int y,int t,char light)
 		hgt--;
 		for (int i = 0; i < wid; ++i)
 		{
-			dst[i] = SprModifyLight(src[i], light);
+			dst[i] = lit[src[i]];
 		}
 		dst += 640;
 		src += 32;
@@ -136,6 +131,8 @@ void RenderFloorTileShadow(int x,int y,int t,char light)
 	byte *dst,*src;
 	int wid,hgt;
 	int darkpart;
+	const byte *lit = SprLightTable(light);
+	const byte *dark = SprLightTable(light - 4);
 
 	if(x<0)
 	{
@@ -190,7 +187,7 @@ void RenderFloorTileShadow(int x,int y,int t,char light)
 		hgt--;
 		for (int i = 0; i < wid; ++i)
 		{
-			dst[i] = SprModifyLight(src[i], light - 4 * (i > wid - darkpart));
+			dst[i] = (i > wid - darkpart ? dark : lit)[src[i]];
 		}
 		dst += 640;
 		src += 32;
@@ -256,6 +253,7 @@ void RenderFloorTileTrans(int x,int y,int t,char light)
 {
 	byte *dst,*src;
 	int wid,hgt;
+	const byte *lit = SprLightTable(light);
 
 	if(x<0)
 	{
@@ -303,7 +301,7 @@ void RenderFloorTileTrans(int x,int y,int t,char light)
 		hgt--;
 		for (int i = 0; i < wid; ++i)
 		{
-			if (src[i]) dst[i] = SprModifyLight(src[i], light);
+			if (src[i]) dst[i] = lit[src[i]];
 		}
 		dst += 640;
 		src += 32;
@@ -341,6 +339,8 @@ inline void GouraudBoxWater(int x,int y,byte *src,char light0,char light1,char l
 	int i,j,tmp;
 	byte *dst,b;
 	int curLight,dlx,dly1,dly2,firstLight,lastLight;
+	byte waterRow[GB_WID];
+	bool haveRow;
 
 	dst=tileMGL->GetScreen()+x+y*640;
 
@@ -359,6 +359,7 @@ inline void GouraudBoxWater(int x,int y,byte *src,char light0,char light1,char l
 			return;	// all done!
 		if(y+j>=0)
 		{
+			haveRow=false;
 			for(i=0;i<GB_WID;i++)
 			{
 				if(x+i>=0 && x+i<640)
@@ -366,7 +367,15 @@ inline void GouraudBoxWater(int x,int y,byte *src,char light0,char light1,char l
 					b=*src;
 
 					if(b==3*32+15)
-						b=WaterPixel(x+i,y+j);
+					{
+						// fetch the whole scanline of water at once, the first time it's needed
+						if(!haveRow)
+						{
+							WaterSpan(x,y+j,GB_WID,waterRow);
+							haveRow=true;
+						}
+						b=waterRow[i];
+					}
 
 					tmp=(b&31)+(curLight/FIXAMT);
 					if(tmp<0)
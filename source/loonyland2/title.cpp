@@ -180,7 +180,8 @@ void GetSavesForMenu(void)
 		}
 		else if(f)
 		{
-			fread(&p,sizeof(player_t),1,f);
+			if(!LoadSavedPlayer(f,&p))
+				memset(&p,0,sizeof(player_t));
 			fclose(f);
 			save[n].percentage=CalcPercent(&p);
 			save[n].newbie=0;
@@ -509,6 +510,7 @@ void DeleteCharacter(void)
 {
 	char s[64];
 
+	FinishSaveGame();
 	sprintf(s,"profiles/char%02d.loony",save[whoToDelete].realNum+1);
 	unlink(s);	// delete that file
 	GetSavesForMenu();
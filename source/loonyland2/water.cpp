@@ -88,41 +88,51 @@ void SetupWater(void)
 
 inline short GetWaterBit(int x,int y)
 {
-	if(config.shading==0)
-		return 0;
-
-	while(x<0)
-		x+=WATER_WIDTH;
-	while(x>=WATER_WIDTH)
-		x-=WATER_WIDTH;
-	while(y<0)
-		y+=WATER_HEIGHT;
-	while(y>=WATER_HEIGHT)
-		y-=WATER_HEIGHT;
-
-	return water1[x+y*WATER_WIDTH];
+	// WATER_WIDTH and WATER_HEIGHT are powers of two, so masking wraps
+	// negative and overlarge coordinates the same as repeated add/subtract
+	return water1[(x&(WATER_WIDTH-1))+(y&(WATER_HEIGHT-1))*WATER_WIDTH];
 }
 
 inline byte GetWaterBkgdBit(int x,int y)
 {
-	if(config.shading==0)
-		return 0;
+	return waterbkgd[(x&(WATER_WIDTH-1))+(y&(WATER_HEIGHT-1))*WATER_WIDTH];
+}
 
-	while(x<0)
-		x+=WATER_WIDTH;
-	while(x>=WATER_WIDTH)
-		x-=WATER_WIDTH;
-	while(y<0)
-		y+=WATER_HEIGHT;
-	while(y>=WATER_HEIGHT)
-		y-=WATER_HEIGHT;
+inline short WaterCell(short left,short right,short up,short down,short old)
+{
+	short s;
 
-	return waterbkgd[x+y*WATER_WIDTH];
+	s=(left+right+up+down)/2-old;
+	return s*WATERDAMPEN/WATERFIX;
 }
 
-void UpdateWater(void)
+// run the ripple simulation on rows [y0,y1).  Each cell only reads water1 and
+// its own water2 entry, so bands are independent of each other.
+static void UpdateWaterBand(int y0,int y1)
 {
 	int i,j;
+	const short *cur,*up,*down;
+	short *dst;
+
+	for(j=y0;j<y1;j++)
+	{
+		cur=&water1[j*WATER_WIDTH];
+		up=&water1[((j-1)&(WATER_HEIGHT-1))*WATER_WIDTH];
+		down=&water1[((j+1)&(WATER_HEIGHT-1))*WATER_WIDTH];
+		dst=&water2[j*WATER_WIDTH];
+
+		// the two edge columns wrap around, the rest is a straight run the
+		// compiler can vectorize
+		dst[0]=WaterCell(cur[WATER_WIDTH-1],cur[1],up[0],down[0],dst[0]);
+		for(i=1;i<WATER_WIDTH-1;i++)
+			dst[i]=WaterCell(cur[i-1],cur[i+1],up[i],down[i],dst[i]);
+		dst[WATER_WIDTH-1]=WaterCell(cur[WATER_WIDTH-2],cur[0],up[WATER_WIDTH-1],down[WATER_WIDTH-1],dst[WATER_WIDTH-1]);
+	}
+}
+
+void UpdateWater(void)
+{
+	int i;
 	short *tmp;
 
 	if(config.shading==0)
@@ -134,30 +144,17 @@ void UpdateWater(void)
 	for(i=0;i<40;i++)
 		WaterBlop((byte)Random(256),(byte)Random(256),(byte)Random(32));
 
-	for(i=0;i<WATER_WIDTH;i++)
-		for(j=0;j<WATER_HEIGHT;j++)
-		{
-			water2[i+j*WATER_WIDTH]=(GetWaterBit(i-1,j)+GetWaterBit(i+1,j)+GetWaterBit(i,j-1)+GetWaterBit(i,j+1))/2-water2[i+j*WATER_WIDTH];
-			water2[i+j*WATER_WIDTH]=water2[i+j*WATER_WIDTH]*WATERDAMPEN/WATERFIX;
-		}
+	UpdateWaterBand(0,WATER_HEIGHT);
 
 	tmp=water1;
 	water1=water2;
 	water2=tmp;	// swap the pointers
 }
 
-byte WaterPixel(int x,int y)
+inline byte CalcWaterPixel(int x,int y)
 {
-	int camx,camy;
 	short s,xofs,yofs;
 
-	if(config.shading==0)
-		return waterColor;
-
-	GetCamera(&camx,&camy);
-	x+=camx;
-	y+=camy;
-
 	x/=2;
 	y/=2;
 
@@ -173,7 +170,7 @@ byte WaterPixel(int x,int y)
 	s=GetWaterBkgdBit(x+xofs/WATERFIX-scrollX,y+yofs/WATERFIX-scrollY)&31;
 	s+=xofs/WATERFIX+waterAdj;	// shade it
 
-    if(s<0)
+	if(s<0)
 		s=0;
 	if(s>31)
 		s=31;
@@ -181,6 +178,34 @@ byte WaterPixel(int x,int y)
 	return (byte)(s+waterColor);
 }
 
+byte WaterPixel(int x,int y)
+{
+	int camx,camy;
+
+	if(config.shading==0)
+		return waterColor;
+
+	GetCamera(&camx,&camy);
+	return CalcWaterPixel(x+camx,y+camy);
+}
+
+void WaterSpan(int x,int y,int len,byte *dst)
+{
+	int i,camx,camy;
+
+	if(config.shading==0)
+	{
+		memset(dst,waterColor,len);
+		return;
+	}
+
+	GetCamera(&camx,&camy);
+	x+=camx;
+	y+=camy;
+	for(i=0;i<len;i++)
+		dst[i]=CalcWaterPixel(x+i,y);
+}
+
 void WaterRipple(int x,int y,short amt)
 {
 	int camx,camy;
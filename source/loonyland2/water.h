@@ -8,6 +8,8 @@ void InitWater(void);
 void ExitWater(void);
 void UpdateWater(void);
 byte WaterPixel(int x,int y);
+// fill dst with the water colors of len pixels starting at screen (x,y)
+void WaterSpan(int x,int y,int len,byte *dst);
 void WaterRipple(int x,int y,short amt);
 void WaterBlop(byte x,byte y,byte width);
 void SetupWater(void);
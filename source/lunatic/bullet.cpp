@@ -1,6 +1,10 @@
 #include "bullet.h"
 #include "guy.h"
 #include "player.h"
+#include "perf.h"
+#include "randstream.h"
+
+static RandomStream bulletRng(RAND_BULLET);
 
 enum {
 	SPR_FLAME = 0,
@@ -126,7 +130,7 @@ void BulletHitWallX(bullet_t *me, Map *map, world_t *world)
 			if (player.hammerFlags & HMR_REFLECT)
 			{
 				me->x -= me->dx;
-				me->facing = 84 + MGL_random(89);
+				me->facing = 84 + bulletRng.Int(89);
 				if (me->dx < 0)
 					me->facing = (me->facing + 128)&255;
 				me->dx = Cosine(me->facing)*11;
@@ -142,14 +146,14 @@ void BulletHitWallX(bullet_t *me, Map *map, world_t *world)
 			MakeSound(SND_BULLETREFLECT, me->x, me->y, SND_CUTOFF, 900);
 			me->x -= me->dx;
 			me->dx = -me->dx;
-			me->dy += -FIXAMT / 4 + MGL_random(FIXAMT / 2);
+			me->dy += -FIXAMT / 4 + bulletRng.Int(FIXAMT / 2);
 			me->facing = ((byte) (8 - me->facing))&15;
 			break;
 		case BLT_BOMB:
 			MakeSound(SND_BOMBREFLECT, me->x, me->y, SND_CUTOFF, 600);
 			me->x -= me->dx;
 			me->dx = -me->dx;
-			me->dy += -FIXAMT / 4 + MGL_random(FIXAMT / 2);
+			me->dy += -FIXAMT / 4 + bulletRng.Int(FIXAMT / 2);
 			me->facing = ((byte) (8 - me->facing))&15;
 			break;
 		case BLT_SLASH:
@@ -170,7 +174,7 @@ void BulletHitWallX(bullet_t *me, Map *map, world_t *world)
 		case BLT_FLAME:
 		case BLT_FLAME2:
 			me->x -= me->dx;
-			me->dy = ((3 - MGL_random(7)) << FIXSHIFT);
+			me->dy = ((3 - bulletRng.Int(7)) << FIXSHIFT);
 			me->dx = 0;
 			break;
 		case BLT_ROCK: // reflects off walls
@@ -245,7 +249,7 @@ void BulletHitWallY(bullet_t *me, Map *map, world_t *world)
 			if (player.hammerFlags & HMR_REFLECT)
 			{
 				me->y -= me->dy;
-				me->facing = 20 + MGL_random(89);
+				me->facing = 20 + bulletRng.Int(89);
 				if (me->dy > 0)
 					me->facing += 128;
 				me->dx = Cosine(me->facing)*11;
@@ -261,14 +265,14 @@ void BulletHitWallY(bullet_t *me, Map *map, world_t *world)
 			MakeSound(SND_BULLETREFLECT, me->x, me->y, SND_CUTOFF, 900);
 			me->y -= me->dy;
 			me->dy = -me->dy;
-			me->dx += -FIXAMT / 4 + MGL_random(FIXAMT / 2);
+			me->dx += -FIXAMT / 4 + bulletRng.Int(FIXAMT / 2);
 			me->facing = (16 - me->facing)&15;
 			break;
 		case BLT_BOMB:
 			MakeSound(SND_BOMBREFLECT, me->x, me->y, SND_CUTOFF, 600);
 			me->y -= me->dy;
 			me->dy = -me->dy;
-			me->dx += -FIXAMT / 4 + MGL_random(FIXAMT / 2);
+			me->dx += -FIXAMT / 4 + bulletRng.Int(FIXAMT / 2);
 			me->facing = (16 - me->facing)&15;
 			break;
 		case BLT_SLASH:
@@ -289,7 +293,7 @@ void BulletHitWallY(bullet_t *me, Map *map, world_t *world)
 		case BLT_FLAME:
 		case BLT_FLAME2:
 			me->y -= me->dy;
-			me->dx = ((3 - MGL_random(7)) << FIXSHIFT);
+			me->dx = ((3 - bulletRng.Int(7)) << FIXSHIFT);
 			me->dy = 0;
 			break;
 		case BLT_ROCK: // reflects off walls
@@ -626,8 +630,8 @@ void HitBadguys(bullet_t *me, Map *map, world_t *world)
 			}
 			break;
 		case BLT_LILBOOM:
-			if (FindVictims(me->x >> FIXSHIFT, me->y >> FIXSHIFT, 16, (8 - MGL_random(17)) << FIXSHIFT,
-					(8 - MGL_random(16)) << FIXSHIFT, 2, map, world, me->friendly))
+			if (FindVictims(me->x >> FIXSHIFT, me->y >> FIXSHIFT, 16, (8 - bulletRng.Int(17)) << FIXSHIFT,
+					(8 - bulletRng.Int(16)) << FIXSHIFT, 2, map, world, me->friendly))
 			{
 				// nothing much to do here, the victim will scream quite enough
 			}
@@ -691,23 +695,23 @@ void HitBadguys(bullet_t *me, Map *map, world_t *world)
 			}
 			break;
 		case BLT_BOOM:
-			if (FindVictims(me->x >> FIXSHIFT, me->y >> FIXSHIFT, 64, (8 - MGL_random(17)) << FIXSHIFT,
-					(8 - MGL_random(16)) << FIXSHIFT, 4, map, world, me->friendly))
+			if (FindVictims(me->x >> FIXSHIFT, me->y >> FIXSHIFT, 64, (8 - bulletRng.Int(17)) << FIXSHIFT,
+					(8 - bulletRng.Int(16)) << FIXSHIFT, 4, map, world, me->friendly))
 			{
 				// nothing much to do here, the victim will scream quite enough
 			}
 			break;
 		case BLT_BIGAXE:
-			if (FindVictims2(me->x >> FIXSHIFT, me->y >> FIXSHIFT, 32, (4 - MGL_random(9)) << FIXSHIFT,
-					(4 - MGL_random(9)) << FIXSHIFT, 5, map, world, me->friendly))
+			if (FindVictims2(me->x >> FIXSHIFT, me->y >> FIXSHIFT, 32, (4 - bulletRng.Int(9)) << FIXSHIFT,
+					(4 - bulletRng.Int(9)) << FIXSHIFT, 5, map, world, me->friendly))
 			{
 				ExplodeParticles2(PART_SNOW2, me->x, me->y, me->z, 10, 8);
 			}
 			break;
 		case BLT_YELBOOM:
 			i = 20 * (5 - (me->timer / 2)); // size expands as boom expands
-			if (FindVictim(me->x >> FIXSHIFT, me->y >> FIXSHIFT, i, (8 - MGL_random(17)) << FIXSHIFT,
-					(8 - MGL_random(16)) << FIXSHIFT, 2, map, world, me->friendly))
+			if (FindVictim(me->x >> FIXSHIFT, me->y >> FIXSHIFT, i, (8 - bulletRng.Int(17)) << FIXSHIFT,
+					(8 - bulletRng.Int(16)) << FIXSHIFT, 2, map, world, me->friendly))
 			{
 				// don't disappear because Bouapha needs to get multipounded
 			}
@@ -951,7 +955,7 @@ void UpdateBullet(bullet_t *me, Map *map, world_t *world)
 				HitBadguys(me, map, world);
 			else if (me->timer == 4)
 			{
-				b = (me->facing * 32 - 32 + MGL_random(65))&255;
+				b = (me->facing * 32 - 32 + bulletRng.Int(65))&255;
 				mapx = (me->x + Cosine(b)*32);
 				mapy = (me->y + Sine(b)*32);
 				FireBullet(mapx, mapy, me->facing, BLT_ICESPIKE, me->friendly);
@@ -1041,9 +1045,9 @@ void UpdateBullet(bullet_t *me, Map *map, world_t *world)
 				HitBadguys(me, map, world);
 			map->BrightTorch((me->x / TILE_WIDTH) >> FIXSHIFT,
 					(me->y / TILE_HEIGHT) >> FIXSHIFT, 8, 4);
-			me->dz += MGL_random(FIXAMT / 8); // anti gravity
-			me->dx += MGL_random(65535) - FIXAMT / 2;
-			me->dy += MGL_random(65535) - FIXAMT / 2;
+			me->dz += bulletRng.Int(FIXAMT / 8); // anti gravity
+			me->dx += bulletRng.Int(65535) - FIXAMT / 2;
+			me->dy += bulletRng.Int(65535) - FIXAMT / 2;
 			Dampen(&me->dx, FIXAMT / 4);
 			Dampen(&me->dy, FIXAMT / 4);
 			Clamp(&me->dx, FIXAMT * 10);
@@ -1157,10 +1161,10 @@ void UpdateBullet(bullet_t *me, Map *map, world_t *world)
 			{
 				// make sizzle around player if there was no target
 				LightningBolt(
-						goodguy->x - FIXAMT * 32 + MGL_randoml(FIXAMT * 64),
-						goodguy->y - FIXAMT * 52 + MGL_randoml(FIXAMT * 64),
-						goodguy->x - FIXAMT * 32 + MGL_randoml(FIXAMT * 64),
-						goodguy->y - FIXAMT * 52 + MGL_randoml(FIXAMT * 64));
+						goodguy->x - FIXAMT * 32 + bulletRng.Long(FIXAMT * 64),
+						goodguy->y - FIXAMT * 52 + bulletRng.Long(FIXAMT * 64),
+						goodguy->x - FIXAMT * 32 + bulletRng.Long(FIXAMT * 64),
+						goodguy->y - FIXAMT * 52 + bulletRng.Long(FIXAMT * 64));
 			}
 			me->type = BLT_NONE; // begone immediately
 			break;
@@ -1194,12 +1198,12 @@ void UpdateBullet(bullet_t *me, Map *map, world_t *world)
 		case BLT_BALLLIGHTNING:
 			x = me->x;
 			y = me->y - me->z;
-			v = MGL_random(256);
-			v2 = MGL_random(16) + 2;
+			v = bulletRng.Int(256);
+			v2 = bulletRng.Int(16) + 2;
 			x2 = (x + Cosine(v) * v2);
 			y2 = (y + Sine(v) * v2);
-			v = MGL_random(256);
-			v2 = MGL_random(16) + 2;
+			v = bulletRng.Int(256);
+			v2 = bulletRng.Int(16) + 2;
 			x = (x + Cosine(v) * v2);
 			y = (y + Sine(v) * v2);
 			LightningBolt(x, y, x2, y2);
@@ -1221,8 +1225,8 @@ void UpdateBullet(bullet_t *me, Map *map, world_t *world)
 				LightningBolt(
 						me->x,
 						me->y,
-						me->x - FIXAMT * 64 + MGL_randoml(FIXAMT * 128),
-						me->y - FIXAMT * 64 + MGL_randoml(FIXAMT * 128));
+						me->x - FIXAMT * 64 + bulletRng.Long(FIXAMT * 128),
+						me->y - FIXAMT * 64 + bulletRng.Long(FIXAMT * 128));
 			}
 			me->type = BLT_NONE; // begone immediately
 			break;
@@ -1232,7 +1236,7 @@ void UpdateBullet(bullet_t *me, Map *map, world_t *world)
 				me->anim = 0;
 
 			HitBadguys(me, map, world);
-			me->bright = (char) MGL_random(16);
+			me->bright = (char) bulletRng.Int(16);
 			break;
 		case BLT_REFLECT:
 			me->anim++;
@@ -1509,6 +1513,7 @@ void RenderBullet(bullet_t *me)
 void UpdateBullets(Map *map, world_t *world)
 {
 	int i;
+	PERF_SCOPE("bullets");
 
 	for (i = 0; i < MAX_BULLETS; i++)
 		if (bullet[i].type)
@@ -1600,12 +1605,12 @@ void FireMe(bullet_t *me, int x, int y, byte facing, byte type, byte friendly)
 			me->facing = facing * 2;
 			me->target = 65535;
 			f = me->facing;
-			f += MGL_random(5) - 2;
+			f += bulletRng.Int(5) - 2;
 			if (f < 0)
 				f += 16;
 			me->facing = (byte) (f & 15);
-			me->x += ((MGL_random(17) - 8) << FIXSHIFT);
-			me->y += ((MGL_random(17) - 8) << FIXSHIFT);
+			me->x += ((bulletRng.Int(17) - 8) << FIXSHIFT);
+			me->y += ((bulletRng.Int(17) - 8) << FIXSHIFT);
 			me->dx = Cosine(me->facing * 16)*4;
 			me->dy = Sine(me->facing * 16)*4;
 			MakeSound(SND_MISSILELAUNCH, me->x, me->y, SND_CUTOFF, 1100);
@@ -1623,10 +1628,10 @@ void FireMe(bullet_t *me, int x, int y, byte facing, byte type, byte friendly)
 		case BLT_FLAME:
 		case BLT_FLAME2:
 			me->anim = 0;
-			me->timer = 24 - MGL_random(4);
+			me->timer = 24 - bulletRng.Int(4);
 			me->z = FIXAMT * 20;
-			me->x += ((MGL_random(3) - 1) << FIXSHIFT) + Cosine(me->facing * 32)*5;
-			me->y += ((MGL_random(3) - 1) << FIXSHIFT) + Sine(me->facing * 32)*5;
+			me->x += ((bulletRng.Int(3) - 1) << FIXSHIFT) + Cosine(me->facing * 32)*5;
+			me->y += ((bulletRng.Int(3) - 1) << FIXSHIFT) + Sine(me->facing * 32)*5;
 			me->dx = Cosine(me->facing * 32)*10;
 			me->dy = Sine(me->facing * 32)*10;
 			me->dz = -FIXAMT / 2;
@@ -1635,12 +1640,12 @@ void FireMe(bullet_t *me, int x, int y, byte facing, byte type, byte friendly)
 		case BLT_LASER:
 			me->anim = 0;
 			me->timer = 30;
-			me->z = FIXAMT * 20 - MGL_random(65535);
-			me->x += ((MGL_random(3) - 1) << FIXSHIFT);
-			me->y += ((MGL_random(3) - 1) << FIXSHIFT);
-			me->x += FIXAMT / 2 - MGL_random(65535);
-			me->y += FIXAMT / 2 - MGL_random(65535);
-			me->facing = me->facing * 32 + 4 - MGL_random(9);
+			me->z = FIXAMT * 20 - bulletRng.Int(65535);
+			me->x += ((bulletRng.Int(3) - 1) << FIXSHIFT);
+			me->y += ((bulletRng.Int(3) - 1) << FIXSHIFT);
+			me->x += FIXAMT / 2 - bulletRng.Int(65535);
+			me->y += FIXAMT / 2 - bulletRng.Int(65535);
+			me->facing = me->facing * 32 + 4 - bulletRng.Int(9);
 			me->dx = Cosine(me->facing)*24;
 			me->dy = Sine(me->facing)*24;
 			me->facing /= 16;
@@ -1693,7 +1698,7 @@ void FireMe(bullet_t *me, int x, int y, byte facing, byte type, byte friendly)
 			me->anim = 0;
 			me->timer = 255;
 			me->z = FIXAMT * 80;
-			f = MGL_random(12) + 1;
+			f = bulletRng.Int(12) + 1;
 			me->dx = Cosine(me->facing) * f;
 			me->dy = Sine(me->facing) * f;
 			me->dz = FIXAMT * 20;
@@ -2026,7 +2031,7 @@ void HappyFire(int x, int y, byte facing)
 		BLT_GREEN};
 	byte b;
 
-	b = happyList[MGL_random(13)];
+	b = happyList[bulletRng.Int(13)];
 
 	FireBullet(x, y, facing, b, 1);
 }
@@ -2041,7 +2046,7 @@ void HappyLaunch(int x, int y, byte facing, byte count, byte flags)
 	if (count == 2 || count == 4) // these have slight off-angle double forward fire
 	{
 		HappyFire(x, y, facing);
-		if (MGL_random(2) == 0)
+		if (bulletRng.Int(2) == 0)
 			HappyFire(x, y, (facing - 1)&7);
 		else
 			HappyFire(x, y, (facing + 1)&7);
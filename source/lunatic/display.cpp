@@ -4,6 +4,7 @@
 #include "game.h"
 #include "options.h"
 #include "appdata.h"
+#include "perf.h"
 
 mfont_t *gameFont[2] = {NULL, NULL};
 MGLDraw *mgl = NULL;
@@ -42,6 +43,7 @@ bool InitDisplay(MGLDraw *mainmgl)
 	if (FontLoad("graphics/verdana.jft", gameFont[1]) != FONT_OK)
 		return false;
 	cursor[0] = RightBraceHack(gameFont[1]);
+	PerfSetFont(gameFont[1]);
 
 	dispList = new DisplayList();
 
@@ -50,6 +52,7 @@ bool InitDisplay(MGLDraw *mainmgl)
 
 void ExitDisplay(void)
 {
+	PerfSetFont(NULL);
 	if (gameFont[0])
 	{
 		FontFree(gameFont[0]);
@@ -484,9 +487,11 @@ void DisplayList::ClearList(void)
 
 void DisplayList::Render(void)
 {
-	int i;
+	int i, n;
+	PERF_SCOPE("sprite draw");
 
 	i = head;
+	n = 0;
 
 	while (i != -1)
 	{
@@ -551,7 +556,9 @@ void DisplayList::Render(void)
 			}
 		}
 		i = dispObj[i].next;
+		n++;
 	}
+	PerfCount("display objects", n);
 }
 
 void DrawBox(int x, int y, int x2, int y2, byte c)
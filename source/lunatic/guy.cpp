@@ -4,6 +4,7 @@
 #include "options.h"
 #include "editor.h"
 #include "log.h"
+#include "perf.h"
 
 Guy **guys;
 Guy *goodguy;
@@ -848,6 +849,16 @@ void Guy::GetShot(int dx, int dy, byte damage, Map *map, world_t *world)
 
 // -----------------------------------------------------------------------
 
+static int LiveGuys(void)
+{
+	int i, n = 0;
+
+	for (i = 0; i < maxGuys; i++)
+		if (guys[i]->type)
+			n++;
+	return n;
+}
+
 void InitGuys(int max)
 {
 	int i;
@@ -859,6 +870,7 @@ void InitGuys(int max)
 		guys[i] = new Guy();
 	goodguy = NULL;
 	oldPlayAs = opt.playAs;
+	PerfWatch("guys alive", LiveGuys);
 }
 
 void ExitGuys(void)
@@ -870,11 +882,13 @@ void ExitGuys(void)
 
 	free(guys);
 	opt.playAs = oldPlayAs;
+	PerfWatch("guys alive", NULL);
 }
 
 void UpdateGuys(Map *map, world_t *world)
 {
 	int i;
+	PERF_SCOPE("guys");
 
 	for (i = 0; i < maxGuys; i++)
 		if (guys[i]->type != MONS_NONE)
@@ -4,6 +4,7 @@
 #include "game.h"
 #include "guy.h"
 #include "options.h"
+#include "perf.h"
 
 const int NUM_STARS = 400;
 
@@ -202,6 +203,7 @@ void Map::Update(byte mode, world_t *world)
 	int i;
 	static byte timeToReset = 0;
 	static byte timeToAnim = 0;
+	PERF_SCOPE("map");
 
 	timeToReset++;
 	if (timeToReset < 2)
@@ -648,6 +650,7 @@ char* Map::MakeSmoothLighting(bool beZero, int x, int y)
 void Map::Render(world_t *world, int camX, int camY, byte flags)
 {
 	int i, j;
+	PERF_SCOPE("map draw");
 
 	int tileX, tileY;
 	int ofsX, ofsY;
@@ -1,6 +1,11 @@
 #include "particle.h"
 #include "bullet.h"
 #include "monster.h"
+#include "perf.h"
+#include "randstream.h"
+
+static RandomStream particleRng(RAND_PARTICLE);
+static RandomStream renderRng(RAND_RENDER);	// rolls made while drawing, so frames drawn or skipped don't move particleRng
 
 Particle **particleList;
 int maxParticles;
@@ -28,13 +33,13 @@ void Particle::Go(byte type, int x, int y, int z, byte angle, byte force)
 
 	if (fforce == 0)
 		fforce = 1;
-	this->x = x + MGL_randoml(32 << FIXSHIFT)-(16 << FIXSHIFT);
-	this->y = y + MGL_randoml(32 << FIXSHIFT)-(16 << FIXSHIFT);
+	this->x = x + particleRng.Long(32 << FIXSHIFT)-(16 << FIXSHIFT);
+	this->y = y + particleRng.Long(32 << FIXSHIFT)-(16 << FIXSHIFT);
 	this->z = z;
-	this->dx = Cosine(angle) * MGL_random(fforce);
-	this->dy = Sine(angle) * MGL_random(fforce);
-	this->dz = MGL_random(fforce * 2) << FIXSHIFT;
-	this->life = MGL_random(force) + 10;
+	this->dx = Cosine(angle) * particleRng.Int(fforce);
+	this->dy = Sine(angle) * particleRng.Int(fforce);
+	this->dz = particleRng.Int(fforce * 2) << FIXSHIFT;
+	this->life = particleRng.Int(force) + 10;
 }
 
 void Particle::GoLightning(int x, int y, int x2, int y2)
@@ -56,13 +61,13 @@ void Particle::GoRandom(byte type, int x, int y, int z, byte force)
 	if (force == 0)
 		return;
 
-	this->x = x + MGL_randoml(32 << FIXSHIFT)-(16 << FIXSHIFT);
-	this->y = y + MGL_randoml(32 << FIXSHIFT)-(16 << FIXSHIFT);
+	this->x = x + particleRng.Long(32 << FIXSHIFT)-(16 << FIXSHIFT);
+	this->y = y + particleRng.Long(32 << FIXSHIFT)-(16 << FIXSHIFT);
 	this->z = z;
-	this->dx = (MGL_random(force) - force / 2) << FIXSHIFT;
-	this->dy = (MGL_random(force) - force / 2) << FIXSHIFT;
-	this->dz = MGL_random(force * 2) << FIXSHIFT;
-	this->life = MGL_random(force) + 20;
+	this->dx = (particleRng.Int(force) - force / 2) << FIXSHIFT;
+	this->dy = (particleRng.Int(force) - force / 2) << FIXSHIFT;
+	this->dz = particleRng.Int(force * 2) << FIXSHIFT;
+	this->life = particleRng.Int(force) + 20;
 }
 
 void Particle::Update(Map *map)
@@ -96,8 +101,8 @@ void Particle::Update(Map *map)
 				dz += FIXAMT; // no gravity
 				z += FIXAMT;
 				size = (6 - life / 8);
-				dx += MGL_random(65535) - FIXAMT / 2;
-				dy += MGL_random(65535) - FIXAMT / 2;
+				dx += particleRng.Int(65535) - FIXAMT / 2;
+				dy += particleRng.Int(65535) - FIXAMT / 2;
 				Dampen(&dx, FIXAMT / 8);
 				Dampen(&dy, FIXAMT / 8);
 				break;
@@ -107,8 +112,8 @@ void Particle::Update(Map *map)
 				size = ((life / 2)&3);
 				if (size == 3)
 					size = 1;
-				dx += MGL_random(65535) - FIXAMT / 2;
-				dy += MGL_random(65535) - FIXAMT / 2;
+				dx += particleRng.Int(65535) - FIXAMT / 2;
+				dy += particleRng.Int(65535) - FIXAMT / 2;
 				Dampen(&dx, FIXAMT / 8);
 				Dampen(&dy, FIXAMT / 8);
 				break;
@@ -190,8 +195,8 @@ void Particle::Update(Map *map)
 					size = 1;
 				break;
 			case PART_SNOW:
-				dx += MGL_random(65535) - FIXAMT / 2;
-				dy += MGL_random(65535) - FIXAMT / 2;
+				dx += particleRng.Int(65535) - FIXAMT / 2;
+				dy += particleRng.Int(65535) - FIXAMT / 2;
 				Dampen(&dx, FIXAMT / 8);
 				Dampen(&dy, FIXAMT / 8);
 				dz += FIXAMT - 256; // not as much gravity as other things
@@ -289,6 +294,7 @@ void ExitParticles(void)
 void UpdateParticles(Map *map)
 {
 	int i;
+	PERF_SCOPE("particles");
 
 	snowCount = 0;
 	for (i = 0; i < maxParticles; i++)
@@ -402,12 +408,12 @@ void RenderLightningParticle(int x1, int y1, int x2, int y2, int range, byte bri
 			midx = x1 + (x2 - x1) / 2;
 		else
 			midx = x2 + (x1 - x2) / 2;
-		midx += MGL_random(range) - range / 2;
+		midx += renderRng.Int(range) - range / 2;
 		if (y1 < y2)
 			midy = y1 + (y2 - y1) / 2;
 		else
 			midy = y2 + (y1 - y2) / 2;
-		midy += MGL_random(range) - range / 2;
+		midy += renderRng.Int(range) - range / 2;
 		RenderLightningParticle(x1, y1, midx, midy, range * 3 / 4, bright, scrn);
 		RenderLightningParticle(midx, midy, x2, y2, range * 3 / 4, bright, scrn);
 	}
@@ -463,7 +469,7 @@ void BlowSmoke(int x, int y, int z, int dz)
 			particleList[i]->dx = 0;
 			particleList[i]->dy = 0;
 			particleList[i]->dz = dz;
-			particleList[i]->life = 6 * 4 - MGL_random(8);
+			particleList[i]->life = 6 * 4 - particleRng.Int(8);
 			particleList[i]->size = 6;
 			particleList[i]->color = 64;
 			particleList[i]->type = PART_SMOKE;
@@ -485,7 +491,7 @@ void StinkySteam(int x, int y, int z, int dz)
 			particleList[i]->dx = 0;
 			particleList[i]->dy = 0;
 			particleList[i]->dz = dz;
-			particleList[i]->life = 6 * 4 - MGL_random(8);
+			particleList[i]->life = 6 * 4 - particleRng.Int(8);
 			particleList[i]->size = 0;
 			particleList[i]->color = 64;
 			particleList[i]->type = PART_STINKY;
@@ -524,8 +530,8 @@ void BlowUpGuy(int x, int y, int x2, int y2, int z, byte amt)
 	{
 		if (!particleList[i]->Alive())
 		{
-			particleList[i]->x = (x + MGL_randoml(x2 - x)) << FIXSHIFT;
-			particleList[i]->y = (y + MGL_randoml(y2 - y)) << FIXSHIFT;
+			particleList[i]->x = (x + particleRng.Long(x2 - x)) << FIXSHIFT;
+			particleList[i]->y = (y + particleRng.Long(y2 - y)) << FIXSHIFT;
 			particleList[i]->z = z;
 			particleList[i]->dx = 0;
 			particleList[i]->dy = 0;
@@ -549,12 +555,12 @@ void GlassShatter(int x, int y, int x2, int y2, int z, byte amt)
 	{
 		if (!particleList[i]->Alive())
 		{
-			particleList[i]->x = (x + MGL_randoml(x2 - x)) << FIXSHIFT;
-			particleList[i]->y = (y + MGL_randoml(y2 - y)) << FIXSHIFT;
+			particleList[i]->x = (x + particleRng.Long(x2 - x)) << FIXSHIFT;
+			particleList[i]->y = (y + particleRng.Long(y2 - y)) << FIXSHIFT;
 			particleList[i]->z = z;
-			particleList[i]->GoRandom(PART_GLASS, (x + MGL_randoml(x2 - x)) << FIXSHIFT, (y + MGL_randoml(y2 - y)) << FIXSHIFT,
-					MGL_randoml(10 * FIXAMT), 20);
-			particleList[i]->color = MGL_random(8)*32 + 16;
+			particleList[i]->GoRandom(PART_GLASS, (x + particleRng.Long(x2 - x)) << FIXSHIFT, (y + particleRng.Long(y2 - y)) << FIXSHIFT,
+					particleRng.Long(10 * FIXAMT), 20);
+			particleList[i]->color = particleRng.Int(8)*32 + 16;
 			if (!(--amt))
 				break;
 		}
@@ -630,7 +636,7 @@ void MakeItSnow(Map *map)
 	int cx, cy;
 
 	// only 25% of particles may be snowflakes
-	if (MGL_random(100) > 30 || snowCount > maxParticles / 4)
+	if (particleRng.Int(100) > 30 || snowCount > maxParticles / 4)
 		return;
 
 	GetCamera(&cx, &cy);
@@ -641,14 +647,14 @@ void MakeItSnow(Map *map)
 		if (!particleList[i]->Alive())
 		{
 
-			particleList[i]->x = (MGL_random(640) + cx) << FIXSHIFT;
-			particleList[i]->y = (MGL_random(480) + cy) << FIXSHIFT;
-			particleList[i]->z = (300 + MGL_random(300)) << FIXSHIFT;
+			particleList[i]->x = (particleRng.Int(640) + cx) << FIXSHIFT;
+			particleList[i]->y = (particleRng.Int(480) + cy) << FIXSHIFT;
+			particleList[i]->z = (300 + particleRng.Int(300)) << FIXSHIFT;
 			particleList[i]->dx = 0;
 			particleList[i]->dy = 0;
 			particleList[i]->dz = 0;
 			particleList[i]->size = 2;
-			particleList[i]->life = 50 + MGL_random(50);
+			particleList[i]->life = 50 + particleRng.Int(50);
 			particleList[i]->type = PART_SNOW;
 			particleList[i]->color = 31;
 			break;
@@ -667,12 +673,12 @@ void SpecialSnow(int x, int y)
 
 			particleList[i]->x = x;
 			particleList[i]->y = y;
-			particleList[i]->z = (10 + MGL_random(20)) << FIXSHIFT;
+			particleList[i]->z = (10 + particleRng.Int(20)) << FIXSHIFT;
 			particleList[i]->dx = 0;
 			particleList[i]->dy = 0;
 			particleList[i]->dz = 0;
 			particleList[i]->size = 2;
-			particleList[i]->life = 20 + MGL_random(30);
+			particleList[i]->life = 20 + particleRng.Int(30);
 			particleList[i]->type = PART_SNOW;
 			break;
 		}
@@ -1,4 +1,5 @@
 #include "tile.h"
+#include "jamulspr.h"
 #include "options.h"
 
 tile_t tiles[NUMTILES];
@@ -45,17 +46,14 @@ void LoadTiles(FILE *f)
 }
 
 // --- RENDERING!
-// Helper shenanigans for C stuff, see jamulspr.cpp
-extern byte SprModifyColor(byte color, byte hue);
-extern byte SprGetColor(byte color);
-extern byte SprModifyLight(byte color, char bright);
-extern byte SprModifyGhost(byte src, byte dst, char bright);
-extern byte SprModifyGlow(byte src, byte dst, char bright);
-
-byte ModifyDiscoColor(byte color, byte disco)
+// disco mode keeps a colour's brightness but swaps in the disco hue, so a
+// pixel becomes (color & keep) | disco with what this returns as keep
+static inline byte DiscoMask(byte *disco)
 {
-	if (!opt.discoMode) return color;
-	else return (color & 31) | (disco);
+	if (opt.discoMode)
+		return 31;
+	*disco = 0;
+	return 255;
 }
 
 // Disco!
@@ -74,6 +72,8 @@ void RenderFloorTile(int x, int y, int t, char light)
 	byte *dst, *src;
 	int wid, hgt;
 	byte disco = PickDiscoColor();
+	byte keep = DiscoMask(&disco);
+	const byte *lit = SprLightTable(light);
 
 	if (light == 0 && !opt.discoMode)
 	{
@@ -141,7 +141,7 @@ void RenderFloorTile(int x, int y, int t, char light)
 			hgt--;
 			for (int i = 0; i < wid; ++i)
 			{
-				dst[i] = SprModifyLight(ModifyDiscoColor(src[i], disco), light);
+				dst[i] = lit[(src[i] & keep) | disco];
 			}
 			dst += 640;
 			src += 32;
@@ -154,6 +154,9 @@ void RenderFloorTileShadow(int x, int y, int t, char light)
 	byte *dst, *src;
 	int wid, hgt, darkpart;
 	byte disco = PickDiscoColor();
+	byte keep = DiscoMask(&disco);
+	const byte *lit = SprLightTable(light);
+	const byte *dark = SprLightTable(light - 4);
 
 	if (x < 0)
 	{
@@ -204,7 +207,7 @@ void RenderFloorTileShadow(int x, int y, int t, char light)
 		hgt--;
 		for (int i = 0; i < wid; ++i)
 		{
-			dst[i] = SprModifyLight(ModifyDiscoColor(src[i], disco), light - 4 * (i > wid - darkpart));
+			dst[i] = (i > wid - darkpart ? dark : lit)[(src[i] & keep) | disco];
 		}
 		dst += 640;
 		src += 32;
@@ -268,6 +271,8 @@ void RenderFloorTileTrans(int x, int y, int t, char light)
 	byte *dst, *src;
 	int wid, hgt;
 	byte disco = PickDiscoColor();
+	byte keep = DiscoMask(&disco);
+	const byte *lit = SprLightTable(light);
 
 	if (x < 0)
 	{
@@ -315,7 +320,7 @@ void RenderFloorTileTrans(int x, int y, int t, char light)
 		hgt--;
 		for (int i = 0; i < wid; ++i)
 		{
-			if (src[i]) dst[i] = SprModifyLight(ModifyDiscoColor(src[i], disco), light);
+			if (src[i]) dst[i] = lit[(src[i] & keep) | disco];
 		}
 		dst += 640;
 		src += 32;
@@ -4,6 +4,10 @@
 #include "fairy.h"
 #include "spell.h"
 #include "challenge.h"
+#include "perf.h"
+#include "randstream.h"
+
+static RandomStream bulletRng(RAND_BULLET);
 
 #define SPR_FLAME   0
 #define SPR_LASER   5
@@ -151,7 +155,7 @@ void BulletHitWallX(bullet_t *me,Map *map,world_t *world)
 			//MakeSound(SND_BULLETREFLECT,me->x,me->y,SND_CUTOFF|SND_ONE,100);
 			me->x-=me->dx;
 			me->dx=-me->dx;
-			me->dy+=-FIXAMT/4+MGL_random(FIXAMT/2);
+			me->dy+=-FIXAMT/4+bulletRng.Int(FIXAMT/2);
 			me->facing=((byte)(8-me->facing))&15;
 			break;
 		case BLT_BOMB:
@@ -160,7 +164,7 @@ void BulletHitWallX(bullet_t *me,Map *map,world_t *world)
 		case BLT_FLAME:
 		case BLT_FLAME2:
 			me->x-=me->dx;
-			me->dy=((3-MGL_random(7))<<FIXSHIFT);
+			me->dy=((3-bulletRng.Int(7))<<FIXSHIFT);
 			me->dx=0;
 			break;
 		case BLT_ROCK:	// reflects off walls
@@ -195,7 +199,7 @@ void BulletHitWallX(bullet_t *me,Map *map,world_t *world)
 			break;
 		case BLT_DEATHBEAM:
 			me->timer=8;
-			if(MGL_random(3)==0)
+			if(bulletRng.Int(3)==0)
 				me->type=BLT_DEATHBEAM2;
 			else
 				me->type=BLT_NONE;
@@ -266,7 +270,7 @@ void BulletHitWallY(bullet_t *me,Map *map,world_t *world)
 			//MakeSound(SND_BULLETREFLECT,me->x,me->y,SND_CUTOFF|SND_ONE,100);
 			me->y-=me->dy;
 			me->dy=-me->dy;
-			me->dx+=-FIXAMT/4+MGL_random(FIXAMT/2);
+			me->dx+=-FIXAMT/4+bulletRng.Int(FIXAMT/2);
 			me->facing=(16-me->facing)&15;
 			break;
 		case BLT_BOMB:
@@ -275,7 +279,7 @@ void BulletHitWallY(bullet_t *me,Map *map,world_t *world)
 		case BLT_FLAME:
 		case BLT_FLAME2:
 			me->y-=me->dy;
-			me->dx=((3-MGL_random(7))<<FIXSHIFT);
+			me->dx=((3-bulletRng.Int(7))<<FIXSHIFT);
 			me->dy=0;
 			break;
 		case BLT_ROCK:	// reflects off walls
@@ -310,7 +314,7 @@ void BulletHitWallY(bullet_t *me,Map *map,world_t *world)
 			break;
 		case BLT_DEATHBEAM:
 			me->timer=8;
-			if(MGL_random(3)==0)
+			if(bulletRng.Int(3)==0)
 				me->type=BLT_DEATHBEAM2;
 			else
 				me->type=BLT_NONE;
@@ -493,8 +497,8 @@ void HitBadguys(bullet_t *me,Map *map,world_t *world)
 	switch(me->type)
 	{
 		case BLT_COMETBOOM:
-			if(FindVictims(me->x>>FIXSHIFT,me->y>>FIXSHIFT,64,(8-MGL_random(17))<<FIXSHIFT,
-				(8-MGL_random(16))<<FIXSHIFT,10,map,world))
+			if(FindVictims(me->x>>FIXSHIFT,me->y>>FIXSHIFT,64,(8-bulletRng.Int(17))<<FIXSHIFT,
+				(8-bulletRng.Int(16))<<FIXSHIFT,10,map,world))
 			{
 				// nothing much to do here, the victim will scream quite enough
 			}
@@ -550,14 +554,14 @@ void HitBadguys(bullet_t *me,Map *map,world_t *world)
 			{
 				if(player.fairyOn==FAIRY_VAMPY)
 				{
-					if((!player.berserk && (MGL_random(2)==0)) ||
-						(player.berserk && (MGL_random(4)==0)))
+					if((!player.berserk && (bulletRng.Int(2)==0)) ||
+						(player.berserk && (bulletRng.Int(4)==0)))
 						PlayerHeal(1);	// heal 1 pt vampirism, 50% chance normally, 25% chance if berserk
 				}
 				me->lastHit=i;
 				if(player.gear&GEAR_BOUNCY)
 				{
-					me->facing=(byte)MGL_random(256);
+					me->facing=(byte)bulletRng.Int(256);
 					me->dx=Cosine(me->facing)*10;
 					me->dy=Sine(me->facing)*10;
 					if(me->type==BLT_SKULL)
@@ -651,8 +655,8 @@ void HitBadguys(bullet_t *me,Map *map,world_t *world)
 			}
 			break;
 		case BLT_LILBOOM:
-			if(FindVictims(me->x>>FIXSHIFT,me->y>>FIXSHIFT,16,(8-MGL_random(17))<<FIXSHIFT,
-				(8-MGL_random(16))<<FIXSHIFT,SpellLevel()/10+1,map,world))
+			if(FindVictims(me->x>>FIXSHIFT,me->y>>FIXSHIFT,16,(8-bulletRng.Int(17))<<FIXSHIFT,
+				(8-bulletRng.Int(16))<<FIXSHIFT,SpellLevel()/10+1,map,world))
 			{
 				// nothing much to do here, the victim will scream quite enough
 			}
@@ -717,16 +721,16 @@ void HitBadguys(bullet_t *me,Map *map,world_t *world)
 			}
 			break;
 		case BLT_BOOM:
-			if(FindVictims(me->x>>FIXSHIFT,me->y>>FIXSHIFT,64,(8-MGL_random(17))<<FIXSHIFT,
-				(8-MGL_random(16))<<FIXSHIFT,2,map,world))
+			if(FindVictims(me->x>>FIXSHIFT,me->y>>FIXSHIFT,64,(8-bulletRng.Int(17))<<FIXSHIFT,
+				(8-bulletRng.Int(16))<<FIXSHIFT,2,map,world))
 			{
 				// nothing much to do here, the victim will scream quite enough
 			}
 			break;
 		case BLT_YELBOOM:
 			i=20*(5-(me->timer/2));	// size expands as boom expands
-			if(FindGoodVictim(me->x>>FIXSHIFT,me->y>>FIXSHIFT,i,(8-MGL_random(17))<<FIXSHIFT,
-				(8-MGL_random(16))<<FIXSHIFT,5,map,world))
+			if(FindGoodVictim(me->x>>FIXSHIFT,me->y>>FIXSHIFT,i,(8-bulletRng.Int(17))<<FIXSHIFT,
+				(8-bulletRng.Int(16))<<FIXSHIFT,5,map,world))
 			{
 				// don't disappear because Bouapha needs to get multipounded
 			}
@@ -837,7 +841,7 @@ void UpdateBullet(bullet_t *me,Map *map,world_t *world)
 			if(me->anim>4)
 			{
 				me->anim=0;
-				AddParticle(me->x,me->y,me->z,-FIXAMT/2+MGL_randoml(FIXAMT),-FIXAMT/2+MGL_randoml(FIXAMT),0,
+				AddParticle(me->x,me->y,me->z,-FIXAMT/2+bulletRng.Long(FIXAMT),-FIXAMT/2+bulletRng.Long(FIXAMT),0,
 							10,PART_SHORTYELLOW,191);
 			}
 			HitBadguys(me,map,world);
@@ -868,7 +872,7 @@ void UpdateBullet(bullet_t *me,Map *map,world_t *world)
 			}
 			if(me->anim==4 && me->timer>13)
 			{
-				b=(me->facing-8+MGL_random(17))&255;
+				b=(me->facing-8+bulletRng.Int(17))&255;
 				FireExactBullet(me->x+Cosine(b)*16,me->y+Sine(b)*16,0,0,0,0,0,me->timer,b,BLT_LIQUIFY);
 			}
 			mapx=(me->x>>FIXSHIFT)/TILE_WIDTH;
@@ -907,7 +911,7 @@ void UpdateBullet(bullet_t *me,Map *map,world_t *world)
 				FireBulletAfter(me->x+Cosine(me->facing)*16,me->y+Sine(me->facing)*16,me->facing,BLT_ICEBEAM,me);
 			me->anim=1-me->anim;
 			if(me->anim==0)
-				BlowWigglySmoke(me->x,me->y,me->z-MGL_randoml(FIXAMT*4),0);
+				BlowWigglySmoke(me->x,me->y,me->z-bulletRng.Long(FIXAMT*4),0);
 			break;
 		case BLT_ICESPIKE:
 			if(me->timer>4)
@@ -918,7 +922,7 @@ void UpdateBullet(bullet_t *me,Map *map,world_t *world)
 				HitBadguys(me,map,world);
 			else if(me->timer==4)
 			{
-				b=(me->facing*32-32+MGL_random(65))&255;
+				b=(me->facing*32-32+bulletRng.Int(65))&255;
 				mapx=(me->x+Cosine(b)*32);
 				mapy=(me->y+Sine(b)*32);
 				FireBullet(mapx,mapy,me->facing,BLT_ICESPIKE);
@@ -1016,9 +1020,9 @@ void UpdateBullet(bullet_t *me,Map *map,world_t *world)
 				HitBadguys(me,map,world);
 			map->BrightTorch((me->x/TILE_WIDTH)>>FIXSHIFT,
 							 (me->y/TILE_HEIGHT)>>FIXSHIFT,8,4);
-			me->dz+=MGL_random(FIXAMT/8);		//anti gravity
-			me->dx+=MGL_random(65535)-FIXAMT/2;
-			me->dy+=MGL_random(65535)-FIXAMT/2;
+			me->dz+=bulletRng.Int(FIXAMT/8);		//anti gravity
+			me->dx+=bulletRng.Int(65535)-FIXAMT/2;
+			me->dy+=bulletRng.Int(65535)-FIXAMT/2;
 			Dampen(&me->dx,FIXAMT/4);
 			Dampen(&me->dy,FIXAMT/4);
 			Clamp(&me->dx,FIXAMT*10);
@@ -1040,7 +1044,7 @@ void UpdateBullet(bullet_t *me,Map *map,world_t *world)
 		case BLT_ICECLOUD:
 			me->anim=1-me->anim;
 			if(me->anim==0)
-				BlowWigglySmoke(me->x,me->y,me->z-MGL_randoml(FIXAMT*4),0);
+				BlowWigglySmoke(me->x,me->y,me->z-bulletRng.Long(FIXAMT*4),0);
 			HitBadguys(me,map,world);
 			break;
 		case BLT_MISSILE:
@@ -1411,6 +1415,7 @@ void RenderBullet(bullet_t *me)
 void UpdateBullets(Map *map,world_t *world)
 {
 	int i;
+	PERF_SCOPE("bullets");
 
 	for(i=0;i<MAX_BULLETS;i++)
 		if(bullet[i].type)
@@ -1441,9 +1446,9 @@ void FireMe(bullet_t *me,int x,int y,byte facing,byte type)
 	switch(me->type)
 	{
 		case BLT_COMET:
-			me->anim=(byte)MGL_random(8);
+			me->anim=(byte)bulletRng.Int(8);
 			me->timer=255;
-			me->z=400*FIXAMT+MGL_randoml(300*FIXAMT);
+			me->z=400*FIXAMT+bulletRng.Long(300*FIXAMT);
 			me->dx=0;
 			me->dy=0;
 			me->dz=-FIXAMT*50;
@@ -1508,13 +1513,13 @@ void FireMe(bullet_t *me,int x,int y,byte facing,byte type)
 			break;
 		case BLT_COIN:
 		case BLT_BIGCOIN:
-			me->facing=(byte)MGL_random(256);
-			f=MGL_randoml(3)+1;
-			me->dx=-FIXAMT*4+MGL_randoml(FIXAMT*8);
-			me->dy=-FIXAMT*4+MGL_randoml(FIXAMT*8);
-			me->dz=MGL_randoml(FIXAMT*6)+FIXAMT*4;
+			me->facing=(byte)bulletRng.Int(256);
+			f=bulletRng.Long(3)+1;
+			me->dx=-FIXAMT*4+bulletRng.Long(FIXAMT*8);
+			me->dy=-FIXAMT*4+bulletRng.Long(FIXAMT*8);
+			me->dz=bulletRng.Long(FIXAMT*6)+FIXAMT*4;
 			me->z=FIXAMT/2;
-			me->timer=30*9+MGL_random(30*4);
+			me->timer=30*9+bulletRng.Int(30*4);
 			break;
 		case BLT_BOOM:
 			me->dx=0;
@@ -1558,12 +1563,12 @@ void FireMe(bullet_t *me,int x,int y,byte facing,byte type)
 			me->facing=facing*2;
 			me->target=65535;
 			f=me->facing;
-			f+=MGL_random(5)-2;
+			f+=bulletRng.Int(5)-2;
 			if(f<0)
 				f+=16;
 			me->facing=(byte)(f&15);
-			me->x+=((MGL_random(17)-8)<<FIXSHIFT);
-			me->y+=((MGL_random(17)-8)<<FIXSHIFT);
+			me->x+=((bulletRng.Int(17)-8)<<FIXSHIFT);
+			me->y+=((bulletRng.Int(17)-8)<<FIXSHIFT);
 			me->dx=Cosine(me->facing*16)*4;
 			me->dy=Sine(me->facing*16)*4;
 			MakeSound(SND_MISSILELAUNCH,me->x,me->y,SND_CUTOFF,1100);
@@ -1589,10 +1594,10 @@ void FireMe(bullet_t *me,int x,int y,byte facing,byte type)
 			break;
 		case BLT_FLAME:
 			me->anim=0;
-			me->timer=(SpellLevel()/2)+10-MGL_random(4);
+			me->timer=(SpellLevel()/2)+10-bulletRng.Int(4);
 			me->z=FIXAMT*20;
-			me->x+=((MGL_random(3)-1)<<FIXSHIFT)+Cosine(me->facing*32)*5;
-			me->y+=((MGL_random(3)-1)<<FIXSHIFT)+Sine(me->facing*32)*5;
+			me->x+=((bulletRng.Int(3)-1)<<FIXSHIFT)+Cosine(me->facing*32)*5;
+			me->y+=((bulletRng.Int(3)-1)<<FIXSHIFT)+Sine(me->facing*32)*5;
 			me->dx=Cosine(me->facing*32)*10;
 			me->dy=Sine(me->facing*32)*10;
 			me->dz=-FIXAMT/2;
@@ -1600,10 +1605,10 @@ void FireMe(bullet_t *me,int x,int y,byte facing,byte type)
 			break;
 		case BLT_FLAME2:
 			me->anim=0;
-			me->timer=24-MGL_random(4);
+			me->timer=24-bulletRng.Int(4);
 			me->z=FIXAMT*20;
-			me->x+=((MGL_random(3)-1)<<FIXSHIFT)+Cosine(me->facing)*5;
-			me->y+=((MGL_random(3)-1)<<FIXSHIFT)+Sine(me->facing)*5;
+			me->x+=((bulletRng.Int(3)-1)<<FIXSHIFT)+Cosine(me->facing)*5;
+			me->y+=((bulletRng.Int(3)-1)<<FIXSHIFT)+Sine(me->facing)*5;
 			me->dx=Cosine(me->facing)*10;
 			me->dy=Sine(me->facing)*10;
 			me->dz=-FIXAMT/2;
@@ -1612,12 +1617,12 @@ void FireMe(bullet_t *me,int x,int y,byte facing,byte type)
 		case BLT_LASER:
 			me->anim=0;
 			me->timer=30;
-			me->z=FIXAMT*20-MGL_random(65535);
-			me->x+=((MGL_random(3)-1)<<FIXSHIFT);
-			me->y+=((MGL_random(3)-1)<<FIXSHIFT);
-			me->x+=FIXAMT/2-MGL_random(65535);
-			me->y+=FIXAMT/2-MGL_random(65535);
-			me->facing=me->facing*32+4-MGL_random(9);
+			me->z=FIXAMT*20-bulletRng.Int(65535);
+			me->x+=((bulletRng.Int(3)-1)<<FIXSHIFT);
+			me->y+=((bulletRng.Int(3)-1)<<FIXSHIFT);
+			me->x+=FIXAMT/2-bulletRng.Int(65535);
+			me->y+=FIXAMT/2-bulletRng.Int(65535);
+			me->facing=me->facing*32+4-bulletRng.Int(9);
 			me->dx=Cosine(me->facing)*(12+(SpellLevel()/10));
 			me->dy=Sine(me->facing)*(12+(SpellLevel()/10));
 			me->facing/=16;
@@ -1670,7 +1675,7 @@ void FireMe(bullet_t *me,int x,int y,byte facing,byte type)
 			me->anim=0;
 			me->timer=255;
 			me->z=FIXAMT*80;
-			f=MGL_random(12)+1;
+			f=bulletRng.Int(12)+1;
 			me->dx=Cosine(me->facing)*f;
 			me->dy=Sine(me->facing)*f;
 			me->dz=FIXAMT*20;
@@ -1917,8 +1922,8 @@ void SkullLaunch(int x,int y,byte facing,byte count,byte flags)
 
 void Armageddon(Map *map,int x,int y)
 {
-	x=x-400*FIXAMT+MGL_randoml(800*FIXAMT);
-	y=y-300*FIXAMT+MGL_randoml(600*FIXAMT);
+	x=x-400*FIXAMT+bulletRng.Long(800*FIXAMT);
+	y=y-300*FIXAMT+bulletRng.Long(600*FIXAMT);
 
 	if(x<0 || y<0 || x>=map->width*TILE_WIDTH*FIXAMT || y>=map->height*TILE_HEIGHT*FIXAMT)
 		return;
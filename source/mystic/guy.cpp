@@ -4,6 +4,7 @@
 #include "fairy.h"
 #include "spell.h"
 #include "challenge.h"
+#include "perf.h"
 
 Guy **guys;
 Guy *goodguy;
@@ -1251,6 +1252,17 @@ void Guy::GetShot(int dx,int dy,int damage,Map *map,world_t *world)
 
 //-----------------------------------------------------------------------
 
+static int LiveGuys(void)
+{
+	int i,n;
+
+	n=0;
+	for(i=0;i<maxGuys;i++)
+		if(guys[i]->type)
+			n++;
+	return n;
+}
+
 void InitGuys(int max)
 {
 	int i;
@@ -1261,6 +1273,7 @@ void InitGuys(int max)
 	for(i=0;i<maxGuys;i++)
 		guys[i]=new Guy();
 	goodguy=NULL;
+	PerfWatch("guys alive",LiveGuys);
 }
 
 void ExitGuys(void)
@@ -1271,11 +1284,13 @@ void ExitGuys(void)
 		delete guys[i];
 
 	free(guys);
+	PerfWatch("guys alive",NULL);
 }
 
 void UpdateGuys(Map *map,world_t *world)
 {
 	int i;
+	PERF_SCOPE("guys");
 
 	badguys=0;
 	for(i=0;i<maxGuys;i++)
@@ -2,6 +2,7 @@
 #include "display.h"
 #include "particle.h"
 #include "challenge.h"
+#include "perf.h"
 
 sprite_set_t *itmSpr;
 static byte glowism;
@@ -19,6 +20,7 @@ void ExitItems(void)
 
 void UpdateItems(void)
 {
+	PERF_SCOPE("items");
 	glowism++;
 }
 
@@ -5,6 +5,7 @@
 #include "guy.h"
 #include "water.h"
 #include "challenge.h"
+#include "perf.h"
 
 int totalBrains;
 static world_t *world;
@@ -257,6 +258,7 @@ void Map::Update(byte mode,world_t *world)
 	int i,x,y;
 	static byte timeToReset=0;
 	static byte timeToAnim=0;
+	PERF_SCOPE("map");
 
 	timeToReset++;
 	if(timeToReset<2)
@@ -667,6 +669,7 @@ void Map::LightSpecial(int x,int y,char brt,byte size)
 void Map::Render(world_t *world,int camX,int camY,byte flags)
 {
 	int i,j,endX,endY;
+	PERF_SCOPE("map draw");
 
 	int tileX,tileY;
 	int ofsX,ofsY;
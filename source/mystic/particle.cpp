@@ -2,6 +2,10 @@
 #include "bullet.h"
 #include "monster.h"
 #include "player.h"
+#include "perf.h"
+#include "randstream.h"
+
+static RandomStream particleRng(RAND_PARTICLE);
 
 Particle **particleList;
 int		maxParticles;
@@ -29,13 +33,13 @@ void Particle::Go(byte type,int x,int y,int z,byte angle,byte force)
 
 	if(fforce==0)
 		fforce=1;
-	this->x=x+MGL_randoml(32<<FIXSHIFT)-(16<<FIXSHIFT);
-	this->y=y+MGL_randoml(32<<FIXSHIFT)-(16<<FIXSHIFT);
+	this->x=x+particleRng.Long(32<<FIXSHIFT)-(16<<FIXSHIFT);
+	this->y=y+particleRng.Long(32<<FIXSHIFT)-(16<<FIXSHIFT);
 	this->z=z;
-	this->dx=Cosine(angle)*MGL_random(fforce);
-	this->dy=Sine(angle)*MGL_random(fforce);
-	this->dz=MGL_random(fforce*2)<<FIXSHIFT;
-	this->life=MGL_random(force)+10;
+	this->dx=Cosine(angle)*particleRng.Int(fforce);
+	this->dy=Sine(angle)*particleRng.Int(fforce);
+	this->dz=particleRng.Int(fforce*2)<<FIXSHIFT;
+	this->life=particleRng.Int(force)+10;
 }
 
 void Particle::GoRandom(byte type,int x,int y,int z,byte force)
@@ -45,13 +49,13 @@ void Particle::GoRandom(byte type,int x,int y,int z,byte force)
 	if(force==0)
 		return;
 
-	this->x=x+MGL_randoml(32<<FIXSHIFT)-(16<<FIXSHIFT);
-	this->y=y+MGL_randoml(32<<FIXSHIFT)-(16<<FIXSHIFT);
+	this->x=x+particleRng.Long(32<<FIXSHIFT)-(16<<FIXSHIFT);
+	this->y=y+particleRng.Long(32<<FIXSHIFT)-(16<<FIXSHIFT);
 	this->z=z;
-	this->dx=(MGL_random(force)-force/2)<<FIXSHIFT;
-	this->dy=(MGL_random(force)-force/2)<<FIXSHIFT;
-	this->dz=MGL_random(force*2)<<FIXSHIFT;
-	this->life=MGL_random(force)+20;
+	this->dx=(particleRng.Int(force)-force/2)<<FIXSHIFT;
+	this->dy=(particleRng.Int(force)-force/2)<<FIXSHIFT;
+	this->dz=particleRng.Int(force*2)<<FIXSHIFT;
+	this->life=particleRng.Int(force)+20;
 }
 
 void Particle::Update(Map *map)
@@ -78,10 +82,10 @@ void Particle::Update(Map *map)
 			case PART_FLOATER:
 				x-=dx;
 				y-=dy;	// it doesn't move that way
-				dz+=FIXAMT+MGL_random(FIXAMT/4);	// no gravity and going up
+				dz+=FIXAMT+particleRng.Int(FIXAMT/4);	// no gravity and going up
 				x-=Cosine(size)*dx;
 				y-=Sine(size)*dx;
-				size+=MGL_random(12);
+				size+=particleRng.Int(12);
 				x+=Cosine(size)*dx;
 				y+=Sine(size)*dx;
 				dx+=dy;
@@ -106,8 +110,8 @@ void Particle::Update(Map *map)
 				dz+=FIXAMT;	// no gravity
 				z+=FIXAMT;
 				size=(6-life/8);
-				dx+=MGL_random(65535)-FIXAMT/2;
-				dy+=MGL_random(65535)-FIXAMT/2;
+				dx+=particleRng.Int(65535)-FIXAMT/2;
+				dy+=particleRng.Int(65535)-FIXAMT/2;
 				Dampen(&dx,FIXAMT/8);
 				Dampen(&dy,FIXAMT/8);
 				break;
@@ -226,8 +230,8 @@ void Particle::Update(Map *map)
 					size=1;
 				break;
 			case PART_SNOW:
-				dx+=MGL_random(65535)-FIXAMT/2;
-				dy+=MGL_random(65535)-FIXAMT/2;
+				dx+=particleRng.Int(65535)-FIXAMT/2;
+				dy+=particleRng.Int(65535)-FIXAMT/2;
 				Dampen(&dx,FIXAMT/8);
 				Dampen(&dy,FIXAMT/8);
 				dz+=FIXAMT-256;	// not as much gravity as other things
@@ -320,6 +324,7 @@ void ExitParticles(void)
 void UpdateParticles(Map *map)
 {
 	int i;
+	PERF_SCOPE("particles");
 
 	snowCount=0;
 	for(i=0;i<maxParticles;i++)
@@ -439,7 +444,7 @@ void BlowSmoke(int x,int y,int z,int dz)
 			particleList[i]->dx=0;
 			particleList[i]->dy=0;
 			particleList[i]->dz=dz;
-			particleList[i]->life=6*4-MGL_random(8);
+			particleList[i]->life=6*4-particleRng.Int(8);
 			particleList[i]->size=16;
 			particleList[i]->color=64;
 			particleList[i]->type=PART_SMOKE;
@@ -455,13 +460,13 @@ void BlowWigglySmoke(int x,int y,int z,int dz)
 	{
 		if(!particleList[i]->Alive())
 		{
-			particleList[i]->x=x+MGL_randoml(FIXAMT*4)-FIXAMT*2;
-			particleList[i]->y=y+MGL_randoml(FIXAMT*4)-FIXAMT*2;
+			particleList[i]->x=x+particleRng.Long(FIXAMT*4)-FIXAMT*2;
+			particleList[i]->y=y+particleRng.Long(FIXAMT*4)-FIXAMT*2;
 			particleList[i]->z=z;
-			particleList[i]->dx=MGL_randoml(FIXAMT*2)-FIXAMT;
-			particleList[i]->dy=MGL_randoml(FIXAMT*2)-FIXAMT;
+			particleList[i]->dx=particleRng.Long(FIXAMT*2)-FIXAMT;
+			particleList[i]->dy=particleRng.Long(FIXAMT*2)-FIXAMT;
 			particleList[i]->dz=dz;
-			particleList[i]->life=6*4-MGL_random(8);
+			particleList[i]->life=6*4-particleRng.Int(8);
 			particleList[i]->size=16;
 			particleList[i]->color=64;
 			particleList[i]->type=PART_SMOKE;
@@ -478,8 +483,8 @@ void BlowUpGuy(int x,int y,int x2,int y2,int z,byte amt)
 	{
 		if(!particleList[i]->Alive())
 		{
-			particleList[i]->x=(x+MGL_randoml(x2-x))<<FIXSHIFT;
-			particleList[i]->y=(y+MGL_randoml(y2-y))<<FIXSHIFT;
+			particleList[i]->x=(x+particleRng.Long(x2-x))<<FIXSHIFT;
+			particleList[i]->y=(y+particleRng.Long(y2-y))<<FIXSHIFT;
 			particleList[i]->z=z;
 			particleList[i]->dx=0;
 			particleList[i]->dy=0;
@@ -569,7 +574,7 @@ void ManaParticles(int x,int y)
 		if(!particleList[i]->Alive())
 		{
 			particleList[i]->GoRandom(PART_MANA,x,y,FIXAMT*10,2);
-			particleList[i]->dz=-((int)MGL_randoml(FIXAMT));
+			particleList[i]->dz=-((int)particleRng.Long(FIXAMT));
 			if(!--num)
 				break;
 		}
@@ -628,7 +633,7 @@ void MakeItSnow(Map *map)
 	int cx,cy;
 
 	// only 25% of particles may be snowflakes
-	if(MGL_random(100)>30 || snowCount>maxParticles/4)
+	if(particleRng.Int(100)>30 || snowCount>maxParticles/4)
 		return;
 
 	GetCamera(&cx,&cy);
@@ -639,14 +644,14 @@ void MakeItSnow(Map *map)
 		if(!particleList[i]->Alive())
 		{
 
-			particleList[i]->x=(MGL_random(640)+cx)<<FIXSHIFT;
-			particleList[i]->y=(MGL_random(480)+cy)<<FIXSHIFT;
-			particleList[i]->z=(300+MGL_random(300))<<FIXSHIFT;
+			particleList[i]->x=(particleRng.Int(640)+cx)<<FIXSHIFT;
+			particleList[i]->y=(particleRng.Int(480)+cy)<<FIXSHIFT;
+			particleList[i]->z=(300+particleRng.Int(300))<<FIXSHIFT;
 			particleList[i]->dx=0;
 			particleList[i]->dy=0;
 			particleList[i]->dz=0;
 			particleList[i]->size=2;
-			particleList[i]->life=50+MGL_random(50);
+			particleList[i]->life=50+particleRng.Int(50);
 			particleList[i]->type=PART_SNOW;
 			particleList[i]->color=31;
 			break;
@@ -665,12 +670,12 @@ void SpecialSnow(int x,int y)
 
 			particleList[i]->x=x;
 			particleList[i]->y=y;
-			particleList[i]->z=(10+MGL_random(20))<<FIXSHIFT;
+			particleList[i]->z=(10+particleRng.Int(20))<<FIXSHIFT;
 			particleList[i]->dx=0;
 			particleList[i]->dy=0;
 			particleList[i]->dz=0;
 			particleList[i]->size=2;
-			particleList[i]->life=20+MGL_random(30);
+			particleList[i]->life=20+particleRng.Int(30);
 			particleList[i]->type=PART_SNOW;
 			break;
 		}
@@ -690,7 +695,7 @@ void CompassTrail(int sx,int sy,int ex,int ey)
 	incx=(ex-sx)/10;
 	incy=(ey-sy)/10;
 
-	n=MGL_randoml(FIXAMT);
+	n=particleRng.Long(FIXAMT);
 	sx=sx+(incx/FIXAMT)*n;
 	sy=sy+(incy/FIXAMT)*n;
 
@@ -715,7 +720,7 @@ void FloaterParticles(int x,int y,byte color,int radius,int spread,byte count)
 	int i;
 	byte ang,numLeft;
 
-	ang=(byte)MGL_random(256);
+	ang=(byte)particleRng.Int(256);
 	numLeft=count;
 	for(i=0;i<maxParticles;i++)
 	{
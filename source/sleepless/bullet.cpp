@@ -6,6 +6,10 @@
 #include "editor.h"
 #include "shop.h"
 #include "config.h"
+#include "perf.h"
+#include "randstream.h"
+
+static RandomStream bulletRng(RAND_BULLET);
 
 #define SPR_FLAME   0
 #define SPR_LASER   5
@@ -260,7 +264,7 @@ void BulletHitWallX(bullet_t *me,Map *map,world_t *world)
 	{
 		case BLT_HAMMER:
 		case BLT_LUNA:
-			if((player.hammerFlags&HMR_BLAST) && Random(10)==0)
+			if((player.hammerFlags&HMR_BLAST) && bulletRng.Random(10)==0)
 			{
 				MakeSound(SND_MISSILEBOOM,me->x,me->y,SND_CUTOFF,1500);
 				me->type=BLT_LILBOOM;
@@ -310,7 +314,7 @@ void BulletHitWallX(bullet_t *me,Map *map,world_t *world)
 			if(player.hammerFlags&HMR_REFLECT)
 			{
 				me->x-=me->dx;
-				me->facing=84+Random(89);
+				me->facing=84+bulletRng.Random(89);
 				if(me->dx<0)
 					me->facing=(me->facing+128)&255;
 				me->dx=Cosine(me->facing)*11;
@@ -331,7 +335,7 @@ void BulletHitWallX(bullet_t *me,Map *map,world_t *world)
 			MakeSound(SND_BOMBREFLECT,me->x,me->y,SND_CUTOFF,600);
 			me->x-=me->dx;
 			me->dx=-me->dx;
-			me->dy+=-FIXAMT/4+Random(FIXAMT/2);
+			me->dy+=-FIXAMT/4+bulletRng.Random(FIXAMT/2);
 			me->facing=((byte)(8-me->facing))&15;
 			break;
 		case BLT_SLASH:
@@ -360,7 +364,7 @@ void BulletHitWallX(bullet_t *me,Map *map,world_t *world)
 		case BLT_FLAME2:
 		case BLT_FLAME3:
 			me->x-=me->dx;
-			me->dy=((3-Random(7))<<FIXSHIFT);
+			me->dy=((3-bulletRng.Random(7))<<FIXSHIFT);
 			me->dx=0;
 			break;
 		case BLT_SITFLAME:
@@ -422,7 +426,7 @@ void BulletHitWallY(bullet_t *me,Map *map,world_t *world)
 	{
 		case BLT_HAMMER:
 		case BLT_LUNA:
-			if((player.hammerFlags&HMR_BLAST) && Random(10)==0)
+			if((player.hammerFlags&HMR_BLAST) && bulletRng.Random(10)==0)
 			{
 				MakeSound(SND_MISSILEBOOM,me->x,me->y,SND_CUTOFF,1500);
 				me->type=BLT_LILBOOM;
@@ -472,7 +476,7 @@ void BulletHitWallY(bullet_t *me,Map *map,world_t *world)
 			if(player.hammerFlags&HMR_REFLECT)
 			{
 				me->y-=me->dy;
-				me->facing=20+Random(89);
+				me->facing=20+bulletRng.Random(89);
 				if(me->dy>0)
 					me->facing+=128;
 				me->dx=Cosine(me->facing)*11;
@@ -493,7 +497,7 @@ void BulletHitWallY(bullet_t *me,Map *map,world_t *world)
 			MakeSound(SND_BOMBREFLECT,me->x,me->y,SND_CUTOFF,600);
 			me->y-=me->dy;
 			me->dy=-me->dy;
-			me->dx+=-FIXAMT/4+Random(FIXAMT/2);
+			me->dx+=-FIXAMT/4+bulletRng.Random(FIXAMT/2);
 			me->facing=(16-me->facing)&15;
 			break;
 		case BLT_SLASH:
@@ -522,7 +526,7 @@ void BulletHitWallY(bullet_t *me,Map *map,world_t *world)
 		case BLT_FLAME2:
 		case BLT_FLAME3:
 			me->y-=me->dy;
-			me->dx=((3-Random(7))<<FIXSHIFT);
+			me->dx=((3-bulletRng.Random(7))<<FIXSHIFT);
 			me->dy=0;
 			break;
 		case BLT_SITFLAME:
@@ -971,7 +975,7 @@ void HitBadguys(bullet_t *me,Map *map,world_t *world)
 			{
 				if(!reflect)
 				{
-					if((player.hammerFlags&HMR_BLAST) && Random(10)==0)
+					if((player.hammerFlags&HMR_BLAST) && bulletRng.Random(10)==0)
 					{
 						MakeSound(SND_MISSILEBOOM,me->x,me->y,SND_CUTOFF,1500);
 						me->type=BLT_LILBOOM;
@@ -1079,8 +1083,8 @@ void HitBadguys(bullet_t *me,Map *map,world_t *world)
 			}
 			break;
 		case BLT_LILBOOM:
-			if(FindVictims(me->x>>FIXSHIFT,me->y>>FIXSHIFT,16,(8-Random(17))<<FIXSHIFT,
-				(8-Random(16))<<FIXSHIFT,2,map,world,me->friendly))
+			if(FindVictims(me->x>>FIXSHIFT,me->y>>FIXSHIFT,16,(8-bulletRng.Random(17))<<FIXSHIFT,
+				(8-bulletRng.Random(16))<<FIXSHIFT,2,map,world,me->friendly))
 			{
 				// nothing much to do here, the victim will scream quite enough
 			}
@@ -1158,15 +1162,15 @@ void HitBadguys(bullet_t *me,Map *map,world_t *world)
 			}
 			break;
 		case BLT_BOOM:
-			if(FindVictims(me->x>>FIXSHIFT,me->y>>FIXSHIFT,64,(8-Random(17))<<FIXSHIFT,
-				(8-Random(16))<<FIXSHIFT,4,map,world,me->friendly))
+			if(FindVictims(me->x>>FIXSHIFT,me->y>>FIXSHIFT,64,(8-bulletRng.Random(17))<<FIXSHIFT,
+				(8-bulletRng.Random(16))<<FIXSHIFT,4,map,world,me->friendly))
 			{
 				// nothing much to do here, the victim will scream quite enough
 			}
 			break;
 		case BLT_BIGAXE:
-			if(FindVictims2(me->x>>FIXSHIFT,me->y>>FIXSHIFT,55,(4-Random(9))<<FIXSHIFT,
-				(4-Random(9))<<FIXSHIFT,5+player.weaponLvl[WPN_SONIC-1]*2,map,world,me->friendly))
+			if(FindVictims2(me->x>>FIXSHIFT,me->y>>FIXSHIFT,55,(4-bulletRng.Random(9))<<FIXSHIFT,
+				(4-bulletRng.Random(9))<<FIXSHIFT,5+player.weaponLvl[WPN_SONIC-1]*2,map,world,me->friendly))
 			{
 				if(!reflect)
 					ExplodeParticles2(PART_SNOW2,me->x,me->y,me->z,10,8);
@@ -1182,8 +1186,8 @@ void HitBadguys(bullet_t *me,Map *map,world_t *world)
 			break;
 		case BLT_YELBOOM:
 			i=20*(5-(me->timer/2));	// size expands as boom expands
-			if(FindVictim(me->x>>FIXSHIFT,me->y>>FIXSHIFT,i,(8-Random(17))<<FIXSHIFT,
-				(8-Random(16))<<FIXSHIFT,2,map,world,me->friendly))
+			if(FindVictim(me->x>>FIXSHIFT,me->y>>FIXSHIFT,i,(8-bulletRng.Random(17))<<FIXSHIFT,
+				(8-bulletRng.Random(16))<<FIXSHIFT,2,map,world,me->friendly))
 			{
 				// don't disappear because Bouapha needs to get multipounded
 			}
@@ -1287,8 +1291,8 @@ void HitBadguys(bullet_t *me,Map *map,world_t *world)
 		case BLT_REFLECT:
 			ReflectBullets(me->x,me->y,40+10*player.weaponLvl[WPN_REFLECT-1],me->friendly);
 			/*
-			if(FindVictimsRand(me->x>>FIXSHIFT,me->y>>FIXSHIFT,40+10*player.weaponLvl[WPN_REFLECT-1],(8-Random(17))<<FIXSHIFT,
-			(8-Random(17))<<FIXSHIFT,1,map,world,me->friendly))
+			if(FindVictimsRand(me->x>>FIXSHIFT,me->y>>FIXSHIFT,40+10*player.weaponLvl[WPN_REFLECT-1],(8-bulletRng.Random(17))<<FIXSHIFT,
+			(8-bulletRng.Random(17))<<FIXSHIFT,1,map,world,me->friendly))
 			{
 
 			}	used to do damage
@@ -1479,20 +1483,20 @@ void UpdateBullet(bullet_t *me,Map *map,world_t *world)
 			SuckParticle(me->x,me->y,FIXAMT*20);
 			map->BrightTorch(mapx,mapy,-10,2);
 			SuckInEvil(me->x,me->y);
-			if(Random(2)==0)
+			if(bulletRng.Random(2)==0)
 				HitBadguys(me,map,world);
 			break;
 		case BLT_LIFEBLIP:
 		case BLT_AMMOBLIP:
-			if(Random(2)==0)
+			if(bulletRng.Random(2)==0)
 			{
 				if(me->type==BLT_LIFEBLIP)
 					ColorDrop(1,me->x,me->y,me->z);
 				else
 					ColorDrop(3,me->x,me->y,me->z);
 			}
-			me->dx+=Random(FIXAMT/4+1)-FIXAMT/8;
-			me->dy+=Random(FIXAMT/4+1)-FIXAMT/8;
+			me->dx+=bulletRng.Random(FIXAMT/4+1)-FIXAMT/8;
+			me->dy+=bulletRng.Random(FIXAMT/4+1)-FIXAMT/8;
 			if(abs(me->x-goodguy->x)<96*FIXAMT && abs(me->y-goodguy->y)<72*FIXAMT)
 			{
 				if(me->x>goodguy->x)
@@ -1530,7 +1534,7 @@ void UpdateBullet(bullet_t *me,Map *map,world_t *world)
 			me->anim++;
 			if(me->anim>7)
 				me->anim=0;
-			me->facing+=6-Random(13);
+			me->facing+=6-bulletRng.Random(13);
 			me->dx=Cosine(me->facing)*16;
 			me->dy=Sine(me->facing)*16;
 			HitBadguys(me,map,world);
@@ -1604,7 +1608,7 @@ void UpdateBullet(bullet_t *me,Map *map,world_t *world)
 				HitBadguys(me,map,world);
 			else if(me->timer==4)
 			{
-				b=(me->facing*32-32+Random(65))&255;
+				b=(me->facing*32-32+bulletRng.Random(65))&255;
 				mapx=(me->x+Cosine(b)*32);
 				mapy=(me->y+Sine(b)*32);
 				FireBullet(mapx,mapy,me->facing,me->type,me->friendly);
@@ -1708,9 +1712,9 @@ void UpdateBullet(bullet_t *me,Map *map,world_t *world)
 				HitBadguys(me,map,world);
 			map->BrightTorch((me->x/TILE_WIDTH)>>FIXSHIFT,
 							 (me->y/TILE_HEIGHT)>>FIXSHIFT,8,4);
-			me->dz+=Random(FIXAMT/8);		//anti gravity
-			me->dx+=Random(FIXAMT)-FIXAMT/2;
-			me->dy+=Random(FIXAMT)-FIXAMT/2;
+			me->dz+=bulletRng.Random(FIXAMT/8);		//anti gravity
+			me->dx+=bulletRng.Random(FIXAMT)-FIXAMT/2;
+			me->dy+=bulletRng.Random(FIXAMT)-FIXAMT/2;
 			Dampen(&me->dx,FIXAMT/4);
 			Dampen(&me->dy,FIXAMT/4);
 			Clamp(&me->dx,FIXAMT*10);
@@ -1723,9 +1727,9 @@ void UpdateBullet(bullet_t *me,Map *map,world_t *world)
 			BurnHay(me->x,me->y);
 			map->BrightTorch((me->x/TILE_WIDTH)>>FIXSHIFT,
 							 (me->y/TILE_HEIGHT)>>FIXSHIFT,8,4);
-			me->dz+=Random(FIXAMT/8);		//anti gravity
-			me->dx+=Random(FIXAMT)-FIXAMT/2;
-			me->dy+=Random(FIXAMT)-FIXAMT/2;
+			me->dz+=bulletRng.Random(FIXAMT/8);		//anti gravity
+			me->dx+=bulletRng.Random(FIXAMT)-FIXAMT/2;
+			me->dy+=bulletRng.Random(FIXAMT)-FIXAMT/2;
 			Dampen(&me->dx,FIXAMT/4);
 			Dampen(&me->dy,FIXAMT/4);
 			Clamp(&me->dx,FIXAMT*10);
@@ -1748,7 +1752,7 @@ void UpdateBullet(bullet_t *me,Map *map,world_t *world)
 			Dampen(&me->dy,FIXAMT/8);
 			Clamp(&me->dx,FIXAMT*10);
 			Clamp(&me->dy,FIXAMT*10);
-			me->anim=Random(5);
+			me->anim=bulletRng.Random(5);
 			break;
 		case BLT_IGNITE:
 			HitBadguys(me,map,world);
@@ -1941,10 +1945,10 @@ void UpdateBullet(bullet_t *me,Map *map,world_t *world)
 			{
 				// make sizzle around player if there was no target
 				LightningBolt(
-					goodguy->x-FIXAMT*32+Random(FIXAMT*64),
-					goodguy->y-FIXAMT*52+Random(FIXAMT*64),
-					goodguy->x-FIXAMT*32+Random(FIXAMT*64),
-					goodguy->y-FIXAMT*52+Random(FIXAMT*64));
+					goodguy->x-FIXAMT*32+bulletRng.Random(FIXAMT*64),
+					goodguy->y-FIXAMT*52+bulletRng.Random(FIXAMT*64),
+					goodguy->x-FIXAMT*32+bulletRng.Random(FIXAMT*64),
+					goodguy->y-FIXAMT*52+bulletRng.Random(FIXAMT*64));
 			}
 			me->type=BLT_NONE;	// begone immediately
 			break;
@@ -2005,12 +2009,12 @@ void UpdateBullet(bullet_t *me,Map *map,world_t *world)
 		case BLT_BALLLIGHTNING:
 			x=me->x;
 			y=me->y-me->z;
-			v=Random(256);
-			v2=Random(16)+2;
+			v=bulletRng.Random(256);
+			v2=bulletRng.Random(16)+2;
 			x2=(x+Cosine(v)*v2);
 			y2=(y+Sine(v)*v2);
-			v=Random(256);
-			v2=Random(16)+2;
+			v=bulletRng.Random(256);
+			v2=bulletRng.Random(16)+2;
 			x=(x+Cosine(v)*v2);
 			y=(y+Sine(v)*v2);
 			LightningBolt(x,y,x2,y2);
@@ -2032,8 +2036,8 @@ void UpdateBullet(bullet_t *me,Map *map,world_t *world)
 				LightningBolt(
 					me->x,
 					me->y,
-					me->x-FIXAMT*64+Random(FIXAMT*128),
-					me->y-FIXAMT*64+Random(FIXAMT*128));
+					me->x-FIXAMT*64+bulletRng.Random(FIXAMT*128),
+					me->y-FIXAMT*64+bulletRng.Random(FIXAMT*128));
 			}
 			me->type=BLT_NONE;	// begone immediately
 			break;
@@ -2043,7 +2047,7 @@ void UpdateBullet(bullet_t *me,Map *map,world_t *world)
 				me->anim=0;
 
 			HitBadguys(me,map,world);
-			me->bright=(char)Random(16);
+			me->bright=(char)bulletRng.Random(16);
 			break;
 		case BLT_REFLECT:
 			me->anim++;
@@ -2211,8 +2215,8 @@ void RenderBullet(bullet_t *me)
 			for(v=0;v<3;v++)
 			{
 				z=me->z;//+Random(FIXAMT*8);
-				x=me->x-FIXAMT*10+Random(FIXAMT*20+1);
-				y=me->y-FIXAMT*10+Random(FIXAMT*20+1);
+				x=me->x-FIXAMT*10+bulletRng.Random(FIXAMT*20+1);
+				y=me->y-FIXAMT*10+bulletRng.Random(FIXAMT*20+1);
 
 				SprDraw(x>>FIXSHIFT,y>>FIXSHIFT,z>>FIXSHIFT,255,me->bright,curSpr,
 						DISPLAY_DRAWME|DISPLAY_GLOW);
@@ -2466,6 +2470,7 @@ void RenderBullet(bullet_t *me)
 void UpdateBullets(Map *map,world_t *world)
 {
 	int i;
+	PERF_SCOPE("bullets");
 
 	for(i=0;i<config.numBullets;i++)
 		if(bullet[i].type)
@@ -2504,7 +2509,7 @@ void FireMe(bullet_t *me,int x,int y,byte facing,byte type,byte friendly)
 			break;
 		case BLT_AMMOBLIP:
 		case BLT_LIFEBLIP:
-			me->facing=Random(256);
+			me->facing=bulletRng.Random(256);
 			me->dx=Cosine(me->facing);
 			me->dy=Sine(me->facing);
 			me->dz=0;
@@ -2513,7 +2518,7 @@ void FireMe(bullet_t *me,int x,int y,byte facing,byte type,byte friendly)
 			me->timer=255;
 			break;
 		case BLT_SCANSHOT:
-			me->facing=(byte)(me->facing-32+Random(65));
+			me->facing=(byte)(me->facing-32+bulletRng.Random(65));
 			me->dx=Cosine(me->facing)*2;
 			me->dy=Sine(me->facing)*2;
 			me->dz=0;
@@ -2616,28 +2621,28 @@ void FireMe(bullet_t *me,int x,int y,byte facing,byte type,byte friendly)
 			me->facing=facing*2;
 			me->target=65535;
 			f=me->facing;
-			f+=Random(5)-2;
+			f+=bulletRng.Random(5)-2;
 			if(f<0)
 				f+=16;
 			me->facing=(byte)(f&15);
-			me->x+=((Random(17)-8)<<FIXSHIFT);
-			me->y+=((Random(17)-8)<<FIXSHIFT);
+			me->x+=((bulletRng.Random(17)-8)<<FIXSHIFT);
+			me->y+=((bulletRng.Random(17)-8)<<FIXSHIFT);
 			me->dx=Cosine(me->facing*16)*4;
 			me->dy=Sine(me->facing*16)*4;
 			break;
 		case BLT_TORPEDO:
-			me->anim=Random(8);
+			me->anim=bulletRng.Random(8);
 			me->timer=60;
 			me->z=FIXAMT*20;
-			me->dz=-6+Random(13);
+			me->dz=-6+bulletRng.Random(13);
 			f=facing*32*16;
-			f+=Random(33)-16;
+			f+=bulletRng.Random(33)-16;
 			if(f<0)
 				f+=256*16;
 			me->target=f%(256*16);
 			me->facing=me->target/256;
-			me->x+=((Random(17)-8)<<FIXSHIFT);
-			me->y+=((Random(17)-8)<<FIXSHIFT);
+			me->x+=((bulletRng.Random(17)-8)<<FIXSHIFT);
+			me->y+=((bulletRng.Random(17)-8)<<FIXSHIFT);
 			me->dx=0;
 			me->dy=0;
 			break;
@@ -2664,23 +2669,23 @@ void FireMe(bullet_t *me,int x,int y,byte facing,byte type,byte friendly)
 		case BLT_FLAME:
 		case BLT_FLAME2:
 			me->anim=0;
-			me->timer=24-Random(4);
+			me->timer=24-bulletRng.Random(4);
 			me->z=FIXAMT*20;
-			me->x+=((Random(3)-1)<<FIXSHIFT)+Cosine(me->facing*32)*5;
-			me->y+=((Random(3)-1)<<FIXSHIFT)+Sine(me->facing*32)*5;
+			me->x+=((bulletRng.Random(3)-1)<<FIXSHIFT)+Cosine(me->facing*32)*5;
+			me->y+=((bulletRng.Random(3)-1)<<FIXSHIFT)+Sine(me->facing*32)*5;
 			me->dx=Cosine(me->facing*32)*10;
 			me->dy=Sine(me->facing*32)*10;
 			me->dz=-FIXAMT/2;
-			if(Random(5)==0)
+			if(bulletRng.Random(5)==0)
 				MakeSound(SND_FLAMEGO,me->x,me->y,SND_CUTOFF,1100);
 			break;
 		case BLT_FLAME3:
 			me->anim=4;
-			me->timer=24-Random(4);
+			me->timer=24-bulletRng.Random(4);
 			me->z=FIXAMT*20;
-			me->facing=Random(256);
-			me->x+=((Random(3)-1)<<FIXSHIFT)+Cosine(me->facing)*5;
-			me->y+=((Random(3)-1)<<FIXSHIFT)+Sine(me->facing)*5;
+			me->facing=bulletRng.Random(256);
+			me->x+=((bulletRng.Random(3)-1)<<FIXSHIFT)+Cosine(me->facing)*5;
+			me->y+=((bulletRng.Random(3)-1)<<FIXSHIFT)+Sine(me->facing)*5;
 			me->dx=Cosine(me->facing);
 			me->dy=Sine(me->facing);
 			me->dz=FIXAMT/2;
@@ -2688,15 +2693,15 @@ void FireMe(bullet_t *me,int x,int y,byte facing,byte type,byte friendly)
 		case BLT_SITFLAME:
 		case BLT_BADSITFLAME:
 			me->anim=0;
-			me->timer=30+Random(30*15);
+			me->timer=30+bulletRng.Random(30*15);
 			me->z=FIXAMT*20;
-			me->facing=Random(256);
-			me->x+=((Random(3)-1)<<FIXSHIFT)+Cosine(me->facing)*5;
-			me->y+=((Random(3)-1)<<FIXSHIFT)+Sine(me->facing)*5;
-			f=Random(FIXAMT*6)+FIXAMT;
+			me->facing=bulletRng.Random(256);
+			me->x+=((bulletRng.Random(3)-1)<<FIXSHIFT)+Cosine(me->facing)*5;
+			me->y+=((bulletRng.Random(3)-1)<<FIXSHIFT)+Sine(me->facing)*5;
+			f=bulletRng.Random(FIXAMT*6)+FIXAMT;
 			me->dx=Cosine(me->facing)*f/FIXAMT;
 			me->dy=Sine(me->facing)*f/FIXAMT;
-			me->dz=Random(FIXAMT*4)+FIXAMT;
+			me->dz=bulletRng.Random(FIXAMT*4)+FIXAMT;
 			MakeSound(SND_FLAMEGO,me->x,me->y,SND_CUTOFF,1100);
 			break;
 		case BLT_LASER:
@@ -2705,8 +2710,8 @@ void FireMe(bullet_t *me,int x,int y,byte facing,byte type,byte friendly)
 			me->facing=me->facing*32;
 			me->dx=Cosine(me->facing)*32;
 			me->dy=Sine(me->facing)*24;
-			me->x+=Cosine(me->facing)*(Random(10));
-			me->y+=Sine(me->facing)*(Random(8));
+			me->x+=Cosine(me->facing)*(bulletRng.Random(10));
+			me->y+=Sine(me->facing)*(bulletRng.Random(8));
 			me->dz=0;
 			me->target=255+255*256;
 			break;
@@ -2757,7 +2762,7 @@ void FireMe(bullet_t *me,int x,int y,byte facing,byte type,byte friendly)
 			me->anim=0;
 			me->timer=255;
 			me->z=FIXAMT*80;
-			f=Random(12)+1;
+			f=bulletRng.Random(12)+1;
 			me->dx=Cosine(me->facing)*f;
 			me->dy=Sine(me->facing)*f;
 			me->dz=FIXAMT*20;
@@ -2910,7 +2915,7 @@ void FireMe(bullet_t *me,int x,int y,byte facing,byte type,byte friendly)
 			break;
 		case BLT_BUBBLE:
 			me->anim=0;
-			me->timer=40+Random(30);
+			me->timer=40+bulletRng.Random(30);
 			me->z=FIXAMT*20;
 			me->dx=Cosine(me->facing)*5;
 			me->dy=Sine(me->facing)*5;
@@ -3023,7 +3028,7 @@ void FireScanShots(Guy *victim)
 	for(i=0;i<config.numBullets;i++)
 		if(!bullet[i].type)
 		{
-			FireMe(&bullet[i],goodguy->x,goodguy->y,(byte)Random(256),BLT_SCANSHOT,goodguy->friendly);
+			FireMe(&bullet[i],goodguy->x,goodguy->y,(byte)bulletRng.Random(256),BLT_SCANSHOT,goodguy->friendly);
 			bullet[i].target=victim->ID;
 			count++;
 			if(count==8)
@@ -3102,7 +3107,7 @@ void HammerLaunch(int x,int y,byte facing,byte count,byte flags)
 
 	// sproingy spring is only 25% effective
 	if(flags&HMR_REFLECT)
-		if(Random(100)>=25)
+		if(bulletRng.Random(100)>=25)
 			flags&=(~HMR_REFLECT);
 
 	if(player.cheesePower)
@@ -3186,7 +3191,7 @@ void HammerLaunch(int x,int y,byte facing,byte count,byte flags)
 			face=newfacing;
 		FireExactBullet(x,y,height,Cosine(angle)*spd,Sine(angle)*spd,dz,0,timer,face,type,1);
 	}
-	if((flags&HMR_REVERSE) && Random(100)<25)
+	if((flags&HMR_REVERSE) && bulletRng.Random(100)<25)
 	{
 		newfacing=((byte)(facing-4))%8;
 		HammerLaunch(x,y,newfacing,count,flags&(~HMR_REVERSE));
@@ -3200,7 +3205,7 @@ void HappyFire(int x,int y,byte facing)
 					  BLT_GREEN,BLT_TORPEDO,BLT_BUBBLE,BLT_LUNA};
 	byte b;
 
-	b=happyList[Random(16)];
+	b=happyList[bulletRng.Random(16)];
 	if(b==BLT_BOMB || b==BLT_GREEN || b==BLT_BIGSHELL || b==BLT_BUBBLE)
 		facing*=32;
 	FireBullet(x,y,facing,b,1);
@@ -3216,7 +3221,7 @@ void HappyLaunch(int x,int y,byte facing,byte count,byte flags)
 	if(count==2 || count==4)	// these have slight off-angle double forward fire
 	{
 		HappyFire(x,y,facing);
-		if(Random(2)==0)
+		if(bulletRng.Random(2)==0)
 			HappyFire(x,y,(facing-1)&7);
 		else
 			HappyFire(x,y,(facing+1)&7);
@@ -3244,7 +3249,7 @@ void ShroomFire(int x,int y,byte facing)
 
 	for(i=0;i<3;i++)
 	{
-		a=(facing*32+16-Random(33))&255;
+		a=(facing*32+16-bulletRng.Random(33))&255;
 		FireExactBullet(x,y,FIXAMT*16,Cosine(a)*6,Sine(a)*6,0,0,20,a,BLT_SPORE,1);
 	}
 }
@@ -3260,7 +3265,7 @@ void ShroomSpew(int x,int y,byte facing,byte count,byte flags)
 	if(count==2 || count==4)	// these have slight off-angle double forward fire
 	{
 		ShroomFire(x,y,facing);
-		if(Random(2)==0)
+		if(bulletRng.Random(2)==0)
 			ShroomFire(x,y,(facing-1)&7);
 		else
 			ShroomFire(x,y,(facing+1)&7);
@@ -22,6 +22,7 @@ void LoadConfig(void)
 	config.hiscores=1;
 	config.camera=1;
 	config.shading=1;
+	config.thinkThreads=0;
 
 	f=AppdataOpen("config.txt","rt");
 	if(!f)
@@ -91,6 +92,12 @@ void LoadConfig(void)
 			{
 				config.shading=(byte)n;
 			}
+			if(!strcmp(buf,"thinkthreads"))
+			{
+				if(n<0)
+					n=0;
+				config.thinkThreads=n;
+			}
 		}
 		fclose(f);
 	}
@@ -14,6 +14,7 @@ typedef struct config_t
 	int numGuys;
 	int numBullets;
 	int numParticles;
+	int thinkThreads;	// 0 = monsters think one at a time, else the parallel think on this many threads
 } config_t;
 
 extern config_t config;
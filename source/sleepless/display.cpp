@@ -10,6 +10,7 @@
 #include "message.h"
 #include "customworld.h"
 #include "appdata.h"
+#include "perf.h"
 
 mfont_t  *gameFont[3]={NULL,NULL,NULL};
 MGLDraw  *mgl=NULL;
@@ -48,6 +49,7 @@ bool InitDisplay(MGLDraw *mainmgl)
 	if(FontLoad("graphics/verdana.jft",gameFont[1])!=FONT_OK)
 		return false;
 	cursor[0] = RightBraceHack(gameFont[1]);
+	PerfSetFont(gameFont[1]);
 
 	gameFont[2]=(mfont_t *)malloc(sizeof(mfont_t));
 	if(!gameFont[2])
@@ -63,6 +65,7 @@ bool InitDisplay(MGLDraw *mainmgl)
 
 void ExitDisplay(void)
 {
+	PerfSetFont(NULL);
 	if(gameFont[0])
 	{
 		FontFree(gameFont[0]);
@@ -569,9 +572,11 @@ void DisplayList::ClearList(void)
 
 void DisplayList::Render(void)
 {
-	int i;
+	int i,n;
+	PERF_SCOPE("sprite draw");
 
 	i=head;
+	n=0;
 
 	while(i!=-1)
 	{
@@ -650,7 +655,9 @@ void DisplayList::Render(void)
 			}
 		}
 		i=dispObj[i].next;
+		n++;
 	}
+	PerfCount("display objects",n);
 }
 
 void DrawBox(int x,int y,int x2,int y2,byte c)
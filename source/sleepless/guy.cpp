@@ -7,6 +7,8 @@
 #include "goal.h"
 #include "dialogbits.h"
 #include "customworld.h"
+#include "perf.h"
+#include "think.h"
 
 Guy **guys;
 Guy *goodguy;
@@ -1039,6 +1041,8 @@ void Guy::MonsterControl(Map *map,world_t *world)
 	if(type==MONS_NONE)
 		return;
 
+	if(ApplyThought(this,map,world))
+		return;
 	if(aiType!=255 && GetMonsterType(aiType)->AI)
 		GetMonsterType(aiType)->AI(this,map,world,target);
 }
@@ -1262,6 +1266,17 @@ void Guy::GetShot(int dx,int dy,byte damage,Map *map,world_t *world)
 
 //-----------------------------------------------------------------------
 
+static int LiveGuys(void)
+{
+	int i,n;
+
+	n=0;
+	for(i=0;i<maxGuys;i++)
+		if(guys[i]->type)
+			n++;
+	return n;
+}
+
 void InitGuys(int max)
 {
 	int i;
@@ -1272,7 +1287,9 @@ void InitGuys(int max)
 	guys=(Guy **)malloc(sizeof(Guy *)*maxGuys);
 	for(i=0;i<maxGuys;i++)
 		guys[i]=new Guy();
+	InitThink(maxGuys);
 	goodguy=NULL;
+	PerfWatch("guys alive",LiveGuys);
 }
 
 void ExitGuys(void)
@@ -1281,15 +1298,18 @@ void ExitGuys(void)
 
 	for(i=0;i<maxGuys;i++)
 		delete guys[i];
+	ExitThink();
 
 	free(changed);
 	free(guys);
+	PerfWatch("guys alive",NULL);
 }
 
 void UpdateGuys(Map *map,world_t *world)
 {
 	int i;
 	static byte speedClock=0;
+	PERF_SCOPE("guys");
 
 	speedClock++;
 
@@ -1387,6 +1407,7 @@ void UpdateGuys(Map *map,world_t *world)
 			player.combo=0;
 	}
 	ShouldCheckControls(1);
+	ThinkAll(map,world);
 	for(i=0;i<maxGuys;i++)
 		if(guys[i]->type!=MONS_NONE)
 		{
@@ -11,6 +11,7 @@
 #include "journal.h"
 #include "customworld.h"
 #include <ctype.h>
+#include "perf.h"
 
 item_t baseItems[]={
 	{"None",0,0,0,0,0,0,0,0,0,0,0,0,"",0},
@@ -1012,6 +1013,7 @@ word NumItems(void)
 void UpdateItems(void)
 {
 	glowism++;
+	PERF_SCOPE("items");
 
 	if(editing==1)
 	{
@@ -5,6 +5,7 @@
 #include "game.h"
 #include "guy.h"
 #include "config.h"
+#include "perf.h"
 
 #define NUM_STARS 400
 
@@ -349,6 +350,7 @@ void Map::Update(byte mode,world_t *world)
 	int i;
 	static byte timeToReset=0;
 	static byte timeToAnim=0;
+	PERF_SCOPE("map");
 
 	dottedLineOfs++;
 	if(dottedLineOfs>7)
@@ -1080,6 +1082,7 @@ int Map::ItemCountInRect(byte itm,int x,int y,int x2,int y2)
 void Map::Render(world_t *world,int camX,int camY,byte flags)
 {
 	int i,j;
+	PERF_SCOPE("map draw");
 
 	int tileX,tileY;
 	int ofsX,ofsY;
@@ -6,6 +6,7 @@
 #include "editor.h"
 #include "goal.h"
 #include "fishing.h"
+#include "think.h"
 
 /*
  -MT_GOOD	 -MT_EVIL		 -MT_SPOOKY		-MT_ZOMBIE	 -MT_VAMPIRE	-MT_SPIDER -MT_PYGMY
@@ -380,6 +381,17 @@ dword MonsterTheme(byte type)
 	return monsType[type].theme;
 }
 
+Monster_ThinkFunc MonsterThink(byte type)
+{
+	if(type>=NUM_MONSTERS)
+		return NULL;
+	if(monsType[type].AI==AI_Bonehead)
+		return Think_Bonehead;
+	if(monsType[type].AI==AI_Zombie)
+		return Think_Zombie;
+	return NULL;
+}
+
 // AI auxiliary functions to make it simple
 //---------------------------------------------
 
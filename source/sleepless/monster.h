@@ -324,6 +324,8 @@
 #define NUM_MONSTHEMES	(24)
 
 typedef void (*Monster_AIFunc)(Guy *,Map *,world_t *,Guy *);
+struct thought_t;
+typedef void (*Monster_ThinkFunc)(Guy *,Map *,world_t *,Guy *,thought_t *);
 
 typedef struct monsterType_t
 {
@@ -366,7 +368,13 @@ int InstaRenderScannedMonster(int x,int y,byte type,char bright,MGLDraw *mgl);
 sprite_t *GetMonsterSprite(byte type,byte seq,byte frm,byte facing);
 int RangeToTarget(Guy *me,Guy *goodguy);
 
+Monster_ThinkFunc MonsterThink(byte type);	// NULL unless its AI can run in the parallel think, see think.h
+
 // ai functions for each monster type
+// the ones with a Think_ version are their AI_ version, worked so it can
+// run in the parallel think
+void Think_Bonehead(Guy *me,Map *map,world_t *world,Guy *goodguy,thought_t *t);
+void Think_Zombie(Guy *me,Map *map,world_t *world,Guy *goodguy,thought_t *t);
 void AI_Bonehead(Guy *me,Map *map,world_t *world,Guy *goodguy);
 void AI_Bat(Guy *me,Map *map,world_t *world,Guy *goodguy);
 void AI_Spider(Guy *me,Map *map,world_t *world,Guy *goodguy);
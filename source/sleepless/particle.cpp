@@ -5,6 +5,11 @@
 #include "progress.h"
 #include "shop.h"
 #include "player.h"
+#include "perf.h"
+#include "randstream.h"
+
+static RandomStream particleRng(RAND_PARTICLE);
+static RandomStream renderRng(RAND_RENDER);	// rolls made while drawing, so frames drawn or skipped don't move particleRng
 
 Particle **particleList;
 int		maxParticles;
@@ -32,13 +37,13 @@ void Particle::SpurtGo(byte type,int x,int y,int z,byte angle,byte force)
 
 	if(fforce==0)
 		fforce=1;
-	this->x=x+Random(4<<FIXSHIFT)-(2<<FIXSHIFT);
-	this->y=y+Random(4<<FIXSHIFT)-(2<<FIXSHIFT);
+	this->x=x+particleRng.Random(4<<FIXSHIFT)-(2<<FIXSHIFT);
+	this->y=y+particleRng.Random(4<<FIXSHIFT)-(2<<FIXSHIFT);
 	this->z=z;
-	this->dx=Cosine(angle)*Random(fforce);
-	this->dy=Sine(angle)*Random(fforce);
-	this->dz=Random(fforce*2)<<FIXSHIFT;
-	this->life=Random(force)+10;
+	this->dx=Cosine(angle)*particleRng.Random(fforce);
+	this->dy=Sine(angle)*particleRng.Random(fforce);
+	this->dz=particleRng.Random(fforce*2)<<FIXSHIFT;
+	this->life=particleRng.Random(force)+10;
 }
 
 void Particle::Go(byte type,int x,int y,int z,byte angle,byte force)
@@ -57,13 +62,13 @@ void Particle::Go(byte type,int x,int y,int z,byte angle,byte force)
 
 	if(fforce==0)
 		fforce=1;
-	this->x=x+Random(32<<FIXSHIFT)-(16<<FIXSHIFT);
-	this->y=y+Random(32<<FIXSHIFT)-(16<<FIXSHIFT);
+	this->x=x+particleRng.Random(32<<FIXSHIFT)-(16<<FIXSHIFT);
+	this->y=y+particleRng.Random(32<<FIXSHIFT)-(16<<FIXSHIFT);
 	this->z=z;
-	this->dx=Cosine(angle)*Random(fforce);
-	this->dy=Sine(angle)*Random(fforce);
-	this->dz=Random(fforce*2)<<FIXSHIFT;
-	this->life=Random(force)+10;
+	this->dx=Cosine(angle)*particleRng.Random(fforce);
+	this->dy=Sine(angle)*particleRng.Random(fforce);
+	this->dz=particleRng.Random(fforce*2)<<FIXSHIFT;
+	this->life=particleRng.Random(force)+10;
 }
 
 void Particle::GoExact(byte type,int x,int y,int z,byte angle,byte force)
@@ -89,7 +94,7 @@ void Particle::GoExact(byte type,int x,int y,int z,byte angle,byte force)
 	this->dy=Sine(angle)*force;
 	this->dz=force*FIXAMT*2;
 	this->life=25;
-	this->color=(Random(7)+1)*32+16;
+	this->color=(particleRng.Random(7)+1)*32+16;
 	if(this->color==32*2+16)
 		this->color=32*7+16;
 }
@@ -113,13 +118,13 @@ void Particle::GoRandom(byte type,int x,int y,int z,byte force)
 	if(force==0)
 		return;
 
-	this->x=x+Random(32<<FIXSHIFT)-(16<<FIXSHIFT);
-	this->y=y+Random(32<<FIXSHIFT)-(16<<FIXSHIFT);
+	this->x=x+particleRng.Random(32<<FIXSHIFT)-(16<<FIXSHIFT);
+	this->y=y+particleRng.Random(32<<FIXSHIFT)-(16<<FIXSHIFT);
 	this->z=z;
-	this->dx=(Random(force)-force/2)<<FIXSHIFT;
-	this->dy=(Random(force)-force/2)<<FIXSHIFT;
-	this->dz=Random(force*2)<<FIXSHIFT;
-	this->life=Random(force)+20;
+	this->dx=(particleRng.Random(force)-force/2)<<FIXSHIFT;
+	this->dy=(particleRng.Random(force)-force/2)<<FIXSHIFT;
+	this->dz=particleRng.Random(force*2)<<FIXSHIFT;
+	this->life=particleRng.Random(force)+20;
 	if(profile.progress.purchase[modeShopNum[MODE_SPLATTER]]&SIF_ACTIVE)
 		size=20;
 }
@@ -130,13 +135,13 @@ void Particle::GoRandomColor(byte color,int x,int y,int z,byte force)
 	if(force==0)
 		return;
 
-	this->x=x+Random(32<<FIXSHIFT)-(16<<FIXSHIFT);
-	this->y=y+Random(32<<FIXSHIFT)-(16<<FIXSHIFT);
+	this->x=x+particleRng.Random(32<<FIXSHIFT)-(16<<FIXSHIFT);
+	this->y=y+particleRng.Random(32<<FIXSHIFT)-(16<<FIXSHIFT);
 	this->z=z;
-	this->dx=(Random(force)-force/2)<<FIXSHIFT;
-	this->dy=(Random(force)-force/2)<<FIXSHIFT;
-	this->dz=Random(force*2)<<FIXSHIFT;
-	this->life=Random(force)+20;
+	this->dx=(particleRng.Random(force)-force/2)<<FIXSHIFT;
+	this->dy=(particleRng.Random(force)-force/2)<<FIXSHIFT;
+	this->dz=particleRng.Random(force*2)<<FIXSHIFT;
+	this->life=particleRng.Random(force)+20;
 	this->size=this->life/2;
 	if(profile.progress.purchase[modeShopNum[MODE_SPLATTER]]&SIF_ACTIVE)
 		size=20;
@@ -220,8 +225,8 @@ void Particle::Update(Map *map)
 				dz+=FIXAMT;	// no gravity
 				z+=FIXAMT;
 				size=(6-life/8);
-				dx+=Random(FIXAMT)-FIXAMT/2;
-				dy+=Random(FIXAMT)-FIXAMT/2;
+				dx+=particleRng.Random(FIXAMT)-FIXAMT/2;
+				dy+=particleRng.Random(FIXAMT)-FIXAMT/2;
 				Dampen(&dx,FIXAMT/8);
 				Dampen(&dy,FIXAMT/8);
 				break;
@@ -229,8 +234,8 @@ void Particle::Update(Map *map)
 				dz+=FIXAMT;	// no gravity
 				z+=FIXAMT;
 				size=(3-life/8);
-				dx+=Random(FIXAMT*2)-FIXAMT;
-				dy+=Random(FIXAMT*2)-FIXAMT;
+				dx+=particleRng.Random(FIXAMT*2)-FIXAMT;
+				dy+=particleRng.Random(FIXAMT*2)-FIXAMT;
 				Dampen(&dx,FIXAMT/8);
 				Dampen(&dy,FIXAMT/8);
 				if(life==0)
@@ -251,8 +256,8 @@ void Particle::Update(Map *map)
 				size=((life/2)&3);
 				if(size==3)
 					size=1;
-				dx+=Random(FIXAMT)-FIXAMT/2;
-				dy+=Random(FIXAMT)-FIXAMT/2;
+				dx+=particleRng.Random(FIXAMT)-FIXAMT/2;
+				dy+=particleRng.Random(FIXAMT)-FIXAMT/2;
 				Dampen(&dx,FIXAMT/8);
 				Dampen(&dy,FIXAMT/8);
 				break;
@@ -342,7 +347,7 @@ void Particle::Update(Map *map)
 				if(z<=0)
 				{
 					life=0;
-					ExplodeParticles2(PART_WATER,x,y,z,1+Random(5),3);
+					ExplodeParticles2(PART_WATER,x,y,z,1+particleRng.Random(5),3);
 				}
 				break;
 			case PART_SLIME:
@@ -360,8 +365,8 @@ void Particle::Update(Map *map)
 					size=life/4;
 				break;
 			case PART_SNOW:
-				dx+=Random(FIXAMT)-FIXAMT/2;
-				dy+=Random(FIXAMT)-FIXAMT/2;
+				dx+=particleRng.Random(FIXAMT)-FIXAMT/2;
+				dy+=particleRng.Random(FIXAMT)-FIXAMT/2;
 				Dampen(&dx,FIXAMT/8);
 				Dampen(&dy,FIXAMT/8);
 				dz+=FIXAMT-1;	// not as much gravity as other things
@@ -462,6 +467,7 @@ void ExitParticles(void)
 void UpdateParticles(Map *map)
 {
 	int i;
+	PERF_SCOPE("particles");
 
 	snowCount=0;
 	for(i=0;i<maxParticles;i++)
@@ -741,12 +747,12 @@ void RenderLightningParticle(int x1,int y1,int x2,int y2,int range,byte bright,b
 			midx=x1+(x2-x1)/2;
 		else
 			midx=x2+(x1-x2)/2;
-		midx+=Random(range)-range/2;
+		midx+=renderRng.Random(range)-range/2;
 		if(y1<y2)
 			midy=y1+(y2-y1)/2;
 		else
 			midy=y2+(y1-y2)/2;
-		midy+=Random(range)-range/2;
+		midy+=renderRng.Random(range)-range/2;
 		RenderLightningParticle(x1,y1,midx,midy,range*3/4,bright,scrn);
 		RenderLightningParticle(midx,midy,x2,y2,range*3/4,bright,scrn);
 	}
@@ -811,7 +817,7 @@ int BlowSmoke(int x,int y,int z,int dz)
 			particleList[i]->dx=0;
 			particleList[i]->dy=0;
 			particleList[i]->dz=dz;
-			particleList[i]->life=6*4-Random(8);
+			particleList[i]->life=6*4-particleRng.Random(8);
 			particleList[i]->size=6;
 			particleList[i]->color=64;
 			particleList[i]->type=PART_SMOKE;
@@ -827,11 +833,11 @@ void SmokeTile(int x,int y)
 
 	for(i=0;i<3;i++)
 	{
-		j=BlowSmoke((x*TILE_WIDTH+Random(TILE_WIDTH))*FIXAMT,(y*TILE_HEIGHT+Random(TILE_HEIGHT))*FIXAMT,0,FIXAMT/8);
+		j=BlowSmoke((x*TILE_WIDTH+particleRng.Random(TILE_WIDTH))*FIXAMT,(y*TILE_HEIGHT+particleRng.Random(TILE_HEIGHT))*FIXAMT,0,FIXAMT/8);
 		if(j!=-1)
 		{
-			particleList[j]->dx=-FIXAMT*2+Random(FIXAMT*4+1);
-			particleList[j]->dy=-FIXAMT*2+Random(FIXAMT*4+1);
+			particleList[j]->dx=-FIXAMT*2+particleRng.Random(FIXAMT*4+1);
+			particleList[j]->dy=-FIXAMT*2+particleRng.Random(FIXAMT*4+1);
 		}
 	}
 }
@@ -847,10 +853,10 @@ void BlowBubble(int x,int y,int z,int dz)
 			particleList[i]->x=x;
 			particleList[i]->y=y;
 			particleList[i]->z=z;
-			particleList[i]->dx=-FIXAMT+Random(FIXAMT*2);
-			particleList[i]->dy=-FIXAMT+Random(FIXAMT*2);
+			particleList[i]->dx=-FIXAMT+particleRng.Random(FIXAMT*2);
+			particleList[i]->dy=-FIXAMT+particleRng.Random(FIXAMT*2);
 			particleList[i]->dz=dz;
-			particleList[i]->life=3*8+7-Random(8);
+			particleList[i]->life=3*8+7-particleRng.Random(8);
 			particleList[i]->size=0;
 			particleList[i]->color=64;
 			particleList[i]->type=PART_BUBBLE;
@@ -870,10 +876,10 @@ void MindControlSparks(int x,int y,int z,int dz)
 			particleList[i]->x=x;
 			particleList[i]->y=y;
 			particleList[i]->z=z;
-			particleList[i]->dx=-FIXAMT*3+Random(FIXAMT*6);
-			particleList[i]->dy=-FIXAMT*3+Random(FIXAMT*6);
+			particleList[i]->dx=-FIXAMT*3+particleRng.Random(FIXAMT*6);
+			particleList[i]->dy=-FIXAMT*3+particleRng.Random(FIXAMT*6);
 			particleList[i]->dz=dz;
-			particleList[i]->life=20+Random(20);
+			particleList[i]->life=20+particleRng.Random(20);
 			particleList[i]->size=0;
 			particleList[i]->color=64;
 			particleList[i]->type=PART_MINDCONTROL;
@@ -894,7 +900,7 @@ void StinkySteam(int x,int y,int z,int dz)
 			particleList[i]->dx=0;
 			particleList[i]->dy=0;
 			particleList[i]->dz=dz;
-			particleList[i]->life=6*4-Random(8);
+			particleList[i]->life=6*4-particleRng.Random(8);
 			particleList[i]->size=0;
 			particleList[i]->color=64;
 			particleList[i]->type=PART_STINKY;
@@ -933,8 +939,8 @@ void BlowUpGuy(int x,int y,int x2,int y2,int z,byte amt)
 	{
 		if(!particleList[i]->Alive())
 		{
-			particleList[i]->x=(x+Random(x2-x))<<FIXSHIFT;
-			particleList[i]->y=(y+Random(y2-y))<<FIXSHIFT;
+			particleList[i]->x=(x+particleRng.Random(x2-x))<<FIXSHIFT;
+			particleList[i]->y=(y+particleRng.Random(y2-y))<<FIXSHIFT;
 			particleList[i]->z=z;
 			particleList[i]->dx=0;
 			particleList[i]->dy=0;
@@ -958,12 +964,12 @@ void GlassShatter(int x,int y,int x2,int y2,int z,byte amt)
 	{
 		if(!particleList[i]->Alive())
 		{
-			particleList[i]->x=(x+Random(x2-x))<<FIXSHIFT;
-			particleList[i]->y=(y+Random(y2-y))<<FIXSHIFT;
+			particleList[i]->x=(x+particleRng.Random(x2-x))<<FIXSHIFT;
+			particleList[i]->y=(y+particleRng.Random(y2-y))<<FIXSHIFT;
 			particleList[i]->z=z;
-			particleList[i]->GoRandom(PART_GLASS,(x+Random(x2-x))<<FIXSHIFT,(y+Random(y2-y))<<FIXSHIFT,
-					Random(10*FIXAMT),20);
-			particleList[i]->color=Random(8)*32+16;
+			particleList[i]->GoRandom(PART_GLASS,(x+particleRng.Random(x2-x))<<FIXSHIFT,(y+particleRng.Random(y2-y))<<FIXSHIFT,
+					particleRng.Random(10*FIXAMT),20);
+			particleList[i]->color=particleRng.Random(8)*32+16;
 			if(!(--amt))
 				break;
 		}
@@ -1111,7 +1117,7 @@ void HealRing(byte color,int x,int y,int z,byte num,byte force)
 		force*=2;
 	}
 
-	a=Random(256);
+	a=particleRng.Random(256);
 	aPlus=256/num;
 
 	for(i=0;i<maxParticles;i++)
@@ -1123,7 +1129,7 @@ void HealRing(byte color,int x,int y,int z,byte num,byte force)
 			particleList[i]->y+=particleList[i]->dy*10;
 			particleList[i]->dx/=2;//+=-(force/4)+Random(force/2+1);
 			particleList[i]->dy/=2;//+=-(force/4)+Random(force/2+1);
-			particleList[i]->dz=FIXAMT*5-Random(FIXAMT*3);
+			particleList[i]->dz=FIXAMT*5-particleRng.Random(FIXAMT*3);
 			particleList[i]->color=color*32+16;
 			particleList[i]->tx=x;
 			particleList[i]->life=50;
@@ -1185,9 +1191,9 @@ void ColorDrop(byte color,int x,int y,int z)
 			particleList[i]->color=color*32+16;
 			particleList[i]->size=50;
 			particleList[i]->life=15;
-			particleList[i]->dx=-64+Random(129);
-			particleList[i]->dy=-64+Random(129);
-			particleList[i]->dz=-64+Random(129);
+			particleList[i]->dx=-64+particleRng.Random(129);
+			particleList[i]->dy=-64+particleRng.Random(129);
+			particleList[i]->dz=-64+particleRng.Random(129);
 			particleList[i]->x=x;
 			particleList[i]->y=y;
 			particleList[i]->z=z;
@@ -1202,7 +1208,7 @@ void MakeItSnow(Map *map)
 	int cx,cy;
 
 	// only 25% of particles may be snowflakes
-	if(Random(100)>30 || snowCount>maxParticles/4)
+	if(particleRng.Random(100)>30 || snowCount>maxParticles/4)
 		return;
 
 	GetCamera(&cx,&cy);
@@ -1213,14 +1219,14 @@ void MakeItSnow(Map *map)
 		if(!particleList[i]->Alive())
 		{
 
-			particleList[i]->x=(Random(640)+cx)<<FIXSHIFT;
-			particleList[i]->y=(Random(480)+cy)<<FIXSHIFT;
-			particleList[i]->z=(300+Random(300))<<FIXSHIFT;
+			particleList[i]->x=(particleRng.Random(640)+cx)<<FIXSHIFT;
+			particleList[i]->y=(particleRng.Random(480)+cy)<<FIXSHIFT;
+			particleList[i]->z=(300+particleRng.Random(300))<<FIXSHIFT;
 			particleList[i]->dx=0;
 			particleList[i]->dy=0;
 			particleList[i]->dz=0;
 			particleList[i]->size=2;
-			particleList[i]->life=50+Random(50);
+			particleList[i]->life=50+particleRng.Random(50);
 			particleList[i]->type=PART_SNOW;
 			particleList[i]->color=31;
 			break;
@@ -1234,7 +1240,7 @@ void MakeItRain(Map *map)
 	int cx,cy;
 
 	// only 25% of particles may be rain
-	if(Random(100)>30 || snowCount>maxParticles/4)
+	if(particleRng.Random(100)>30 || snowCount>maxParticles/4)
 		return;
 
 	GetCamera(&cx,&cy);
@@ -1245,14 +1251,14 @@ void MakeItRain(Map *map)
 		if(!particleList[i]->Alive())
 		{
 
-			particleList[i]->x=(Random(640)+cx)<<FIXSHIFT;
-			particleList[i]->y=(Random(480)+cy)<<FIXSHIFT;
-			particleList[i]->z=(300+Random(300))<<FIXSHIFT;
+			particleList[i]->x=(particleRng.Random(640)+cx)<<FIXSHIFT;
+			particleList[i]->y=(particleRng.Random(480)+cy)<<FIXSHIFT;
+			particleList[i]->z=(300+particleRng.Random(300))<<FIXSHIFT;
 			particleList[i]->dx=0;
 			particleList[i]->dy=0;
 			particleList[i]->dz=-FIXAMT*2;
 			particleList[i]->size=2;
-			particleList[i]->life=50+Random(50);
+			particleList[i]->life=50+particleRng.Random(50);
 			particleList[i]->type=PART_RAIN;
 			particleList[i]->color=3*32+16;
 			break;
@@ -1271,12 +1277,12 @@ void SpecialSnow(int x,int y)
 
 			particleList[i]->x=x;
 			particleList[i]->y=y;
-			particleList[i]->z=(10+Random(20))<<FIXSHIFT;
+			particleList[i]->z=(10+particleRng.Random(20))<<FIXSHIFT;
 			particleList[i]->dx=0;
 			particleList[i]->dy=0;
 			particleList[i]->dz=0;
 			particleList[i]->size=2;
-			particleList[i]->life=20+Random(30);
+			particleList[i]->life=20+particleRng.Random(30);
 			particleList[i]->type=PART_SNOW;
 			break;
 		}
@@ -1310,17 +1316,17 @@ void WeathermanWeather(int x,int y)
 	{
 		if(!particleList[i]->Alive())
 		{
-			a=Random(256);
+			a=particleRng.Random(256);
 
-			particleList[i]->x=x+Cosine(a)*Random(FIXAMT*60)/FIXAMT;
-			particleList[i]->y=y+Sine(a)*Random(FIXAMT*50)/FIXAMT;
-			particleList[i]->z=(300+Random(300))<<FIXSHIFT;
+			particleList[i]->x=x+Cosine(a)*particleRng.Random(FIXAMT*60)/FIXAMT;
+			particleList[i]->y=y+Sine(a)*particleRng.Random(FIXAMT*50)/FIXAMT;
+			particleList[i]->z=(300+particleRng.Random(300))<<FIXSHIFT;
 			particleList[i]->dx=0;
 			particleList[i]->dy=0;
 			particleList[i]->dz=0;
 			particleList[i]->size=2;
-			particleList[i]->life=50+Random(50);
-			if(Random(2)==0)
+			particleList[i]->life=50+particleRng.Random(50);
+			if(particleRng.Random(2)==0)
 			{
 				particleList[i]->type=PART_SNOW;
 				particleList[i]->color=31;
@@ -1348,16 +1354,16 @@ void JackFrostWeather(int x,int y)
 	{
 		if(!particleList[i]->Alive())
 		{
-			a=Random(256);
+			a=particleRng.Random(256);
 
-			particleList[i]->x=x+Cosine(a)*Random(FIXAMT*60)/FIXAMT;
-			particleList[i]->y=y+Sine(a)*Random(FIXAMT*50)/FIXAMT;
-			particleList[i]->z=(10+Random(100))<<FIXSHIFT;
-			particleList[i]->dx=-FIXAMT+Random(FIXAMT*2+1);
-			particleList[i]->dy=-FIXAMT+Random(FIXAMT*2+1);
+			particleList[i]->x=x+Cosine(a)*particleRng.Random(FIXAMT*60)/FIXAMT;
+			particleList[i]->y=y+Sine(a)*particleRng.Random(FIXAMT*50)/FIXAMT;
+			particleList[i]->z=(10+particleRng.Random(100))<<FIXSHIFT;
+			particleList[i]->dx=-FIXAMT+particleRng.Random(FIXAMT*2+1);
+			particleList[i]->dy=-FIXAMT+particleRng.Random(FIXAMT*2+1);
 			particleList[i]->dz=0;
 			particleList[i]->size=2;
-			particleList[i]->life=50+Random(50);
+			particleList[i]->life=50+particleRng.Random(50);
 			particleList[i]->type=PART_SNOW;
 			particleList[i]->color=31;
 			break;
@@ -1397,7 +1403,7 @@ void SuckParticle(int x,int y,int z)
 	{
 		if(!particleList[i]->Alive())
 		{
-			ang=Random(256);
+			ang=particleRng.Random(256);
 			particleList[i]->x=x+Cosine(ang)*64;
 			particleList[i]->y=y+Sine(ang)*64;
 			particleList[i]->tx=x;
@@ -7,12 +7,26 @@
 #include "customworld.h"
 #include "editor.h"
 #include "appdata.h"
+#include <vector>
 
 static char prfName[64];
 static byte firstTime;
 profile_t profile;
 byte modeShopNum[10];
 
+// An index over profile.progress.world, so finding a world's or a level's progress
+// doesn't mean checking every world ever played.  It's kept up to date by the
+// functions here, and rebuilt whenever the world list gets replaced from outside
+// them (like loading a profile right over it).  None of it is saved.
+#define LEVEL_SLOTS	256		// one for every levelNum
+
+static std::vector<int> worldHash;	// index in profile.progress.world, -1 if empty
+static std::vector<byte> levelSlot;	// LEVEL_SLOTS per world: where that levelNum is in its level array, +1
+static worldData_t *idxWorld;	// the list the index is for
+static int idxCount,worldCap;
+
+static void IndexProgress(void);
+
 void ApplyControlSettings()
 {
 	SetKeyboardBindings(0, 6, profile.control[0]);
@@ -108,6 +122,18 @@ void SaveProfile(void)
 	firstTime=0;
 }
 
+// level arrays are always allocated this big for how many levels they hold, so
+// adding one only needs a realloc every time the count doubles
+static int LevelCapacity(int levels)
+{
+	int cap;
+
+	cap=4;
+	while(cap<levels)
+		cap*=2;
+	return cap;
+}
+
 void LoadPlayLists(FILE *f)
 {
 	int i;
@@ -144,6 +170,7 @@ void LoadProfile(const char *name)
 	if(!f)	// file doesn't exist
 	{
 		DefaultProfile(name);
+		IndexProgress();
 		return;
 	}
 	fread(&profile,sizeof(profile_t),1,f);
@@ -158,7 +185,7 @@ void LoadProfile(const char *name)
 		for(i=0;i<profile.progress.num_worlds;i++)
 		{
 			fread(&profile.progress.world[i],sizeof(worldData_t),1,f);
-			profile.progress.world[i].level=(levelData_t *)malloc(sizeof(levelData_t)*profile.progress.world[i].levels);
+			profile.progress.world[i].level=(levelData_t *)malloc(sizeof(levelData_t)*LevelCapacity(profile.progress.world[i].levels));
 			for(j=0;j<profile.progress.world[i].levels;j++)
 			{
 				fread(&profile.progress.world[i].level[j],sizeof(levelData_t),1,f);
@@ -166,6 +193,7 @@ void LoadProfile(const char *name)
 		}
 	}
 	fclose(f);
+	IndexProgress();
 }
 
 byte FirstTime(void)
@@ -304,32 +332,142 @@ void DefaultLevelProgress(levelData_t *me,byte levelNum)
 	me->recordDestroy=0;
 }
 
-levelData_t *GetLevelProgress(const char *fname,byte levelNum)
+static dword HashName(const char *s)
 {
-	worldData_t *w;
+	dword h;
+
+	h=2166136261u;
+	while(*s)
+	{
+		h^=(byte)*s++;
+		h*=16777619u;
+	}
+	return h;
+}
+
+static void HashWorld(int w)
+{
+	dword h,mask;
+
+	mask=(dword)worldHash.size()-1;
+	h=HashName(profile.progress.world[w].filename)&mask;
+	while(worldHash[h]!=-1)
+		h=(h+1)&mask;
+	worldHash[h]=w;
+}
+
+static void HashWorlds(void)
+{
+	int i,size;
+
+	size=16;
+	while(size<profile.progress.num_worlds*2)
+		size*=2;
+	worldHash.assign(size,-1);
+	for(i=0;i<profile.progress.num_worlds;i++)
+		HashWorld(i);
+}
+
+static void IndexLevels(int w)
+{
+	worldData_t *me;
+	byte *slot;
 	int i;
 
-	w=GetWorldProgress(fname);
+	me=&profile.progress.world[w];
+	slot=&levelSlot[w*LEVEL_SLOTS];
+	memset(slot,0,LEVEL_SLOTS);
+	for(i=me->levels-1;i>=0;i--)	// so the first one wins if a level is in there twice
+		slot[me->level[i].levelNum]=(byte)(i+1);
+}
+
+static void IndexProgress(void)
+{
+	int i;
+
+	HashWorlds();
+	levelSlot.resize(profile.progress.num_worlds*LEVEL_SLOTS);
+	for(i=0;i<profile.progress.num_worlds;i++)
+		IndexLevels(i);
+	idxWorld=profile.progress.world;
+	idxCount=profile.progress.num_worlds;
+	worldCap=idxCount;	// all that can be assumed about how it was allocated
+}
+
+static void CheckIndex(void)
+{
+	if(worldHash.empty() || idxWorld!=profile.progress.world || idxCount!=profile.progress.num_worlds)
+		IndexProgress();
+}
+
+static int FindWorld(const char *fname)
+{
+	dword h,mask;
+
+	CheckIndex();
 
-	for(i=0;i<w->levels;i++)
+	mask=(dword)worldHash.size()-1;
+	h=HashName(fname)&mask;
+	while(worldHash[h]!=-1)
 	{
-		if(w->level[i].levelNum==levelNum)
-		{
-			return &w->level[i];
-		}
+		if(!strcmp(profile.progress.world[worldHash[h]].filename,fname))
+			return worldHash[h];
+		h=(h+1)&mask;
 	}
+	return -1;
+}
+
+// which of profile.progress.world this is, or -1 if it isn't one of them
+static int WorldNumber(worldData_t *w)
+{
+	CheckIndex();
+	if(w<profile.progress.world || w>=profile.progress.world+profile.progress.num_worlds)
+		return -1;
+	return (int)(w-profile.progress.world);
+}
+
+static levelData_t *FindLevel(worldData_t *w,byte levelNum)
+{
+	int i,n;
+
+	n=WorldNumber(w);
+	if(n==-1)
+	{
+		for(i=0;i<w->levels;i++)
+			if(w->level[i].levelNum==levelNum)
+				return &w->level[i];
+		return NULL;
+	}
+	i=levelSlot[n*LEVEL_SLOTS+levelNum];
+	if(i==0)
+		return NULL;
+	return &w->level[i-1];
+}
+
+levelData_t *GetLevelProgress(const char *fname,byte levelNum)
+{
+	worldData_t *w;
+	levelData_t *l;
+	int n;
+
+	w=GetWorldProgress(fname);
+
+	l=FindLevel(w,levelNum);
+	if(l)
+		return l;
 
 	// if you got here, the progress for this level is not stored
+	if(w->level==NULL || LevelCapacity(w->levels+1)!=LevelCapacity(w->levels))
+	{
+		w->level=(levelData_t *)realloc(w->level,sizeof(levelData_t)*LevelCapacity(w->levels+1));
+		if(w->level==NULL)
+			FatalError("Out of memory!!");
+	}
 	w->levels++;
-	if(w->level==NULL)
-		w->level=(levelData_t *)malloc(sizeof(levelData_t));
-	else
-		w->level=(levelData_t *)realloc(w->level,sizeof(levelData_t)*w->levels);
-
-	if(w->level==NULL)
-		FatalError("Out of memory!!");
 
 	DefaultLevelProgress(&w->level[w->levels-1],levelNum);
+	n=WorldNumber(w);
+	levelSlot[n*LEVEL_SLOTS+levelNum]=w->levels;
 
 	return &w->level[w->levels-1];
 }
@@ -350,6 +488,10 @@ void DefaultWorldProgress(worldData_t *me,const char *fname)
 
 	for(i=0;i<8;i++)
 		me->var[i]=0;
+
+	i=WorldNumber(me);
+	if(i!=-1)
+		memset(&levelSlot[i*LEVEL_SLOTS],0,LEVEL_SLOTS);
 }
 
 void ClearTestProgress(void)
@@ -359,46 +501,46 @@ void ClearTestProgress(void)
 
 worldData_t *GetWorldProgress(const char *fname)
 {
-	int i;
+	worldData_t *w;
+	int n;
 
-	for(i=0;i<profile.progress.num_worlds;i++)
-	{
-		if(!strcmp(profile.progress.world[i].filename,fname))
-		{
-			return &profile.progress.world[i];
-		}
-	}
+	n=FindWorld(fname);
+	if(n!=-1)
+		return &profile.progress.world[n];
 
 	// if you got here, the world is not in the list
-	profile.progress.num_worlds++;
-	if(profile.progress.world==NULL)
-		profile.progress.world=(worldData_t *)malloc(sizeof(worldData_t));
+	if(profile.progress.num_worlds==worldCap)
+	{
+		worldCap=(worldCap<8) ? 8 : worldCap*2;
+		profile.progress.world=(worldData_t *)realloc(profile.progress.world,sizeof(worldData_t)*worldCap);
+		if(profile.progress.world==NULL)
+			FatalError("Out of memory!!");
+	}
+	n=profile.progress.num_worlds++;
+	idxWorld=profile.progress.world;
+	idxCount=profile.progress.num_worlds;
+	levelSlot.resize(idxCount*LEVEL_SLOTS);
+	w=&profile.progress.world[n];
+	w->level=NULL;
+	DefaultWorldProgress(w,fname);
+
+	// and into the index with it
+	if(idxCount*2>(int)worldHash.size())
+		HashWorlds();
 	else
-		profile.progress.world=(worldData_t *)realloc(profile.progress.world,sizeof(worldData_t)*profile.progress.num_worlds);
-
-	if(profile.progress.world==NULL)
-		FatalError("Out of memory!!");
+		HashWorld(n);
 
-	profile.progress.world[profile.progress.num_worlds-1].level=NULL;
-	DefaultWorldProgress(&profile.progress.world[profile.progress.num_worlds-1],fname);
-
-	return &profile.progress.world[profile.progress.num_worlds-1];
+	return w;
 }
 
 worldData_t *GetWorldProgressNoCreate(char *fname)
 {
-	int i;
+	int n;
 
-	for(i=0;i<profile.progress.num_worlds;i++)
-	{
-		if(!strcmp(profile.progress.world[i].filename,fname))
-		{
-			return &profile.progress.world[i];
-		}
-	}
-
-	// if you got here, the world is not in the list
-	return NULL;
+	n=FindWorld(fname);
+	if(n==-1)
+		return NULL;	// the world is not in the list
+	return &profile.progress.world[n];
 }
 
 byte LevelsPassed(worldData_t *world)
@@ -415,16 +557,13 @@ byte LevelsPassed(worldData_t *world)
 
 byte LevelIsPassed(worldData_t *world,byte level)
 {
-	int i;
+	levelData_t *l;
 
 	if(world==NULL)
 		return 0;
 
-	for(i=0;i<world->levels;i++)
-		if(world->level[i].levelNum==level && (world->level[i].flags&LF_PASSED))
-			return 1;
-
-	return 0;
+	l=FindLevel(world,level);
+	return (l && (l->flags&LF_PASSED));
 }
 
 void StoreWorldResults(worldData_t *me,world_t *world)
@@ -484,13 +623,7 @@ void EraseWorldProgress(char *fname)
 {
 	int i,me;
 
-	me=-1;
-	for(i=0;i<profile.progress.num_worlds;i++)
-		if(!strcmp(profile.progress.world[i].filename,fname))
-		{
-			me=i;
-			break;
-		}
+	me=FindWorld(fname);
 	if(me==-1)
 		return;	// world isn't stored anyway
 
@@ -502,6 +635,7 @@ void EraseWorldProgress(char *fname)
 	}
 	profile.progress.num_worlds--;
 	profile.progress.world=(worldData_t *)realloc(profile.progress.world,sizeof(worldData_t)*profile.progress.num_worlds);
+	IndexProgress();
 	SaveProfile();
 }
 
@@ -14,6 +14,7 @@
 #include "goal.h"
 #include "ledger.h"
 #include "palettes.h"
+#include "perf.h"
 
 static special_t *spcl;
 static byte numSpecials;
@@ -1755,6 +1756,7 @@ void SpecialEffect(special_t *me,Map *map)
 void CheckSpecials(Map *map)
 {
 	int i;
+	PERF_SCOPE("specials");
 
 	if(tagged && tagged->hp==0)
 		tagged=NULL;
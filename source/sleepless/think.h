@@ -0,0 +1,63 @@
+#ifndef THINK_H
+#define THINK_H
+
+#include "guy.h"
+#include "randstream.h"
+
+// The parallel think.  With config.thinkThreads above 0, monsters whose AI has
+// a Think_ version (see MonsterThink) have it run for all of them at the start
+// of the tick, split over that many threads, each on a copy of itself and
+// against where everyone stood then.  Nothing is touched while they think:
+// sounds, bullets and hits are written down in the thought instead, and each
+// monster's Random() comes from its own RandomStream, keyed by its number and
+// the tick.  When the monster's turn comes in
+// UpdateGuys, the thought is copied back and what it wrote down is done, in
+// guy order.  So the result is the same for any number of threads, though
+// not the same game as with it off, since nobody sees what the monsters
+// before them did this tick.  Anything that happens to a monster between
+// thinking and its turn (being hit, moved, frozen or changed) throws the
+// thought away and its AI runs the ordinary way instead.
+
+#define MAX_INTENTS	4
+
+#define INTENT_SOUND	0
+#define INTENT_SHOOT	1
+#define INTENT_HIT		2
+
+typedef struct intent_t
+{
+	byte what;	// INTENT_*
+	int x,y;	// where the sound or bullet is, or the push for a hit
+	int n;		// sound, bullet type or damage
+	int flags,priority;	// sound
+	byte facing,friendly;	// bullet
+	Guy *him;	// who gets hit
+} intent_t;
+
+typedef struct thought_t
+{
+	Guy *me;	// the copy the AI ran on
+	byte valid;
+	byte numIntents;
+	byte overflow;
+	RandomStream rng;
+	int x,y;	// how it stood when it thought, to tell if anything got to it since
+	byte mapx,mapy;
+	int hp;
+	byte seq,frm,action,ouch;
+	intent_t intent[MAX_INTENTS];
+} thought_t;
+
+void InitThink(int maxGuys);
+void ExitThink(void);
+void ThinkAll(Map *map,world_t *world);	// before the guys update
+byte ApplyThought(Guy *me,Map *map,world_t *world);	// in place of its AI, 0 if there's no thought to apply
+
+// what the Think_ AIs use in place of Random, MakeSound, FireBullet and
+// GetShot.  With t NULL they're just those, for the ordinary AI_ versions.
+dword ThoughtRandom(thought_t *t,dword range);
+void ThoughtSound(thought_t *t,int snd,int x,int y,int flags,int priority);
+void ThoughtShoot(thought_t *t,int x,int y,byte facing,byte type,byte friendly);
+void ThoughtHit(thought_t *t,Guy *him,int dx,int dy,byte damage,Map *map,world_t *world);
+
+#endif
@@ -1,5 +1,6 @@
 #include "winpch.h"
 #include "tile.h"
+#include "jamulspr.h"
 #include "display.h"
 #include "progress.h"
 #include "shop.h"
@@ -307,17 +308,14 @@ static inline byte PickDiscoColor(void)
 }
 
 // --- RENDERING!
-// Helper shenanigans for C stuff, see jamulspr.cpp
-extern byte SprModifyColor(byte color, byte hue);
-extern byte SprGetColor(byte color);
-extern byte SprModifyLight(byte color, char bright);
-extern byte SprModifyGhost(byte src, byte dst, char bright);
-extern byte SprModifyGlow(byte src, byte dst, char bright);
-
-byte ModifyDiscoColor(byte color, byte disco)
+// disco mode keeps a colour's brightness but swaps in the disco hue, so a
+// pixel becomes (color & keep) | disco with what this returns as keep
+static inline byte DiscoMask(byte *disco)
 {
-	if (profile.progress.purchase[modeShopNum[MODE_DISCO]]&SIF_ACTIVE) return (color & 31) | disco;
-	else return color;
+	if (profile.progress.purchase[modeShopNum[MODE_DISCO]]&SIF_ACTIVE)
+		return 31;
+	*disco = 0;
+	return 255;
 }
 
 // Rendering for real!
@@ -327,6 +325,8 @@ void RenderFloorTile(int x, int y, int t, char light)
 	byte *dst, *src;
 	int wid, hgt;
 	byte disco = PickDiscoColor();
+	byte keep = DiscoMask(&disco);
+	const byte *lit = SprLightTable(light);
 
 	if (t >= numTiles) {
 		return RenderEmptyTile(x, y, 0);
@@ -398,7 +398,7 @@ void RenderFloorTile(int x, int y, int t, char light)
 			hgt--;
 			for (int i = 0; i < wid; ++i)
 			{
-				dst[i] = SprModifyLight(ModifyDiscoColor(src[i], disco), light);
+				dst[i] = lit[(src[i] & keep) | disco];
 			}
 			dst += 640;
 			src += 32;
@@ -411,6 +411,9 @@ void RenderFloorTileShadow(int x, int y, int t, char light)
 	byte *dst, *src;
 	int wid, hgt, darkpart;
 	byte disco = PickDiscoColor();
+	byte keep = DiscoMask(&disco);
+	const byte *lit = SprLightTable(light);
+	const byte *dark = SprLightTable(light - 4);
 
 	if (t >= numTiles) {
 		return RenderEmptyTile(x, y, 0);
@@ -465,7 +468,7 @@ void RenderFloorTileShadow(int x, int y, int t, char light)
 		hgt--;
 		for (int i = 0; i < wid; ++i)
 		{
-			dst[i] = SprModifyLight(ModifyDiscoColor(src[i], disco), light - 4 * (i > wid - darkpart));
+			dst[i] = (i > wid - darkpart ? dark : lit)[(src[i] & keep) | disco];
 		}
 		dst += 640;
 		src += 32;
@@ -533,6 +536,8 @@ void RenderFloorTileTrans(int x, int y, int t, char light)
 	byte *dst, *src;
 	int wid, hgt;
 	byte disco = PickDiscoColor();
+	byte keep = DiscoMask(&disco);
+	const byte *lit = SprLightTable(light);
 
 	if (t >= numTiles) {
 		return RenderEmptyTile(x, y, 0);
@@ -584,7 +589,7 @@ void RenderFloorTileTrans(int x, int y, int t, char light)
 		hgt--;
 		for (int i = 0; i < wid; ++i)
 		{
-			if (src[i]) dst[i] = SprModifyLight(ModifyDiscoColor(src[i], disco), light);
+			if (src[i]) dst[i] = lit[(src[i] & keep) | disco];
 		}
 		dst += 640;
 		src += 32;
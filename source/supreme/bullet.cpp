@@ -6,6 +6,12 @@
 #include "editor.h"
 #include "shop.h"
 #include "config.h"
+#include "perf.h"
+#include "randstream.h"
+#include "tilebits.h"
+#include <vector>
+
+static RandomStream bulletRng(RAND_BULLET);
 
 #define SPR_FLAME   0
 #define SPR_LASER   5
@@ -45,6 +51,13 @@ sprite_set_t *bulletSpr;
 byte reflect=0;
 byte attackType;
 int activeBulDX,activeBulDY;
+dword bulletUpdatesRun;
+
+// which slots might have a bullet in them, a bit each, so the update and the
+// render can skip the empty ones 32 at a time.  A slot's bit goes on when a
+// bullet is fired into it, and only goes off when the walk finds the slot
+// empty, since bullets die all over the place.
+static std::vector<uint32_t> liveSlot;
 
 void GetBulletDeltas(int *bdx,int *bdy)
 {
@@ -58,18 +71,30 @@ void InitBullets(void)
 
 	bullet=(bullet_t *)malloc(sizeof(bullet_t)*config.numBullets);
 	memset(bullet,0,config.numBullets*sizeof(bullet_t));
+	liveSlot.assign((config.numBullets+31)/32,0);
 }
 
 void ExitBullets(void)
 {
 	free(bullet);
 	delete bulletSpr;
+	liveSlot.clear();
+}
+
+static inline void SlotLive(bullet_t *me)
+{
+	int i=(int)(me-bullet);
+
+	liveSlot[i>>5]|=(1u<<(i&31));
 }
 
 byte Bulletable(byte type,Map *map,int x,int y)
 {
 	mapTile_t *tile;
 
+	if(TileBit(map,TB_SHOTCLEAR,x,y))
+		return 1;	// nothing there to hit
+
 	tile=map->GetTile(x,y);
 	if(tile->wall==65535)
 		return 0;
@@ -84,6 +109,7 @@ byte Bulletable(byte type,Map *map,int x,int y)
 		}
 		if(curWorld.terrain[tile->floor].flags&TF_DESTRUCT)
 			tile->floor=curWorld.terrain[tile->floor].next;
+		TileBitsChanged(tile);
 		return 0;
 	}
 
@@ -115,6 +141,10 @@ byte BulletCanGo(byte type,int xx,int yy,Map *map,byte size,byte friendly)
 	mapx2=(xx+size)/TILE_WIDTH;
 	mapy2=(yy+size)/TILE_HEIGHT;
 
+	if(mapx1>=0 && mapy1>=0 && mapx2<map->width && mapy2<map->height &&
+		TileBitsRect(map,TB_SHOTCLEAR,mapx1,mapy1,mapx2,mapy2))
+		return 1;	// all clear, nothing for Bulletable to set off
+
 	result=(mapx1>=0 && mapy1>=0 && mapx2<map->width && mapy2<map->height &&
 		(Bulletable(type,map,mapx,mapy1)) &&
 		(Bulletable(type,map,mapx,mapy2)) &&
@@ -172,7 +202,7 @@ void BulletHitWallX(bullet_t *me,Map *map,world_t *world)
 			if(player.hammerFlags&HMR_REFLECT)
 			{
 				me->x-=me->dx;
-				me->facing=84+Random(89);
+				me->facing=84+bulletRng.Random(89);
 				if(me->dx<0)
 					me->facing=(me->facing+128)&255;
 				me->dx=Cosine(me->facing)*11;
@@ -188,14 +218,14 @@ void BulletHitWallX(bullet_t *me,Map *map,world_t *world)
 			MakeSound(SND_BULLETREFLECT,me->x,me->y,SND_CUTOFF,900);
 			me->x-=me->dx;
 			me->dx=-me->dx;
-			me->dy+=-FIXAMT/4+Random(FIXAMT/2);
+			me->dy+=-FIXAMT/4+bulletRng.Random(FIXAMT/2);
 			me->facing=((byte)(8-me->facing))&15;
 			break;
 		case BLT_BOMB:
 			MakeSound(SND_BOMBREFLECT,me->x,me->y,SND_CUTOFF,600);
 			me->x-=me->dx;
 			me->dx=-me->dx;
-			me->dy+=-FIXAMT/4+Random(FIXAMT/2);
+			me->dy+=-FIXAMT/4+bulletRng.Random(FIXAMT/2);
 			me->facing=((byte)(8-me->facing))&15;
 			break;
 		case BLT_SLASH:
@@ -223,7 +253,7 @@ void BulletHitWallX(bullet_t *me,Map *map,world_t *world)
 		case BLT_FLAME:
 		case BLT_FLAME2:
 			me->x-=me->dx;
-			me->dy=((3-Random(7))<<FIXSHIFT);
+			me->dy=((3-bulletRng.Random(7))<<FIXSHIFT);
 			me->dx=0;
 			break;
 		case BLT_ROCK:	// reflects off walls
@@ -314,7 +344,7 @@ void BulletHitWallY(bullet_t *me,Map *map,world_t *world)
 			if(player.hammerFlags&HMR_REFLECT)
 			{
 				me->y-=me->dy;
-				me->facing=20+Random(89);
+				me->facing=20+bulletRng.Random(89);
 				if(me->dy>0)
 					me->facing+=128;
 				me->dx=Cosine(me->facing)*11;
@@ -330,14 +360,14 @@ void BulletHitWallY(bullet_t *me,Map *map,world_t *world)
 			MakeSound(SND_BULLETREFLECT,me->x,me->y,SND_CUTOFF,900);
 			me->y-=me->dy;
 			me->dy=-me->dy;
-			me->dx+=-FIXAMT/4+Random(FIXAMT/2);
+			me->dx+=-FIXAMT/4+bulletRng.Random(FIXAMT/2);
 			me->facing=(16-me->facing)&15;
 			break;
 		case BLT_BOMB:
 			MakeSound(SND_BOMBREFLECT,me->x,me->y,SND_CUTOFF,600);
 			me->y-=me->dy;
 			me->dy=-me->dy;
-			me->dx+=-FIXAMT/4+Random(FIXAMT/2);
+			me->dx+=-FIXAMT/4+bulletRng.Random(FIXAMT/2);
 			me->facing=(16-me->facing)&15;
 			break;
 		case BLT_SLASH:
@@ -365,7 +395,7 @@ void BulletHitWallY(bullet_t *me,Map *map,world_t *world)
 		case BLT_FLAME:
 		case BLT_FLAME2:
 			me->y-=me->dy;
-			me->dx=((3-Random(7))<<FIXSHIFT);
+			me->dx=((3-bulletRng.Random(7))<<FIXSHIFT);
 			me->dy=0;
 			break;
 		case BLT_ROCK:	// reflects off walls
@@ -805,8 +835,8 @@ void HitBadguys(bullet_t *me,Map *map,world_t *world)
 			}
 			break;
 		case BLT_LILBOOM:
-			if(FindVictims(me->x>>FIXSHIFT,me->y>>FIXSHIFT,16,(8-Random(17))<<FIXSHIFT,
-				(8-Random(16))<<FIXSHIFT,2,map,world,me->friendly))
+			if(FindVictims(me->x>>FIXSHIFT,me->y>>FIXSHIFT,16,(8-bulletRng.Random(17))<<FIXSHIFT,
+				(8-bulletRng.Random(16))<<FIXSHIFT,2,map,world,me->friendly))
 			{
 				// nothing much to do here, the victim will scream quite enough
 			}
@@ -871,23 +901,23 @@ void HitBadguys(bullet_t *me,Map *map,world_t *world)
 			}
 			break;
 		case BLT_BOOM:
-			if(FindVictims(me->x>>FIXSHIFT,me->y>>FIXSHIFT,64,(8-Random(17))<<FIXSHIFT,
-				(8-Random(16))<<FIXSHIFT,4,map,world,me->friendly))
+			if(FindVictims(me->x>>FIXSHIFT,me->y>>FIXSHIFT,64,(8-bulletRng.Random(17))<<FIXSHIFT,
+				(8-bulletRng.Random(16))<<FIXSHIFT,4,map,world,me->friendly))
 			{
 				// nothing much to do here, the victim will scream quite enough
 			}
 			break;
 		case BLT_BIGAXE:
-			if(FindVictims2(me->x>>FIXSHIFT,me->y>>FIXSHIFT,32,(4-Random(9))<<FIXSHIFT,
-				(4-Random(9))<<FIXSHIFT,5,map,world,me->friendly))
+			if(FindVictims2(me->x>>FIXSHIFT,me->y>>FIXSHIFT,32,(4-bulletRng.Random(9))<<FIXSHIFT,
+				(4-bulletRng.Random(9))<<FIXSHIFT,5,map,world,me->friendly))
 			{
 				ExplodeParticles2(PART_SNOW2,me->x,me->y,me->z,10,8);
 			}
 			break;
 		case BLT_YELBOOM:
 			i=20*(5-(me->timer/2));	// size expands as boom expands
-			if(FindVictim(me->x>>FIXSHIFT,me->y>>FIXSHIFT,i,(8-Random(17))<<FIXSHIFT,
-				(8-Random(16))<<FIXSHIFT,2,map,world,me->friendly))
+			if(FindVictim(me->x>>FIXSHIFT,me->y>>FIXSHIFT,i,(8-bulletRng.Random(17))<<FIXSHIFT,
+				(8-bulletRng.Random(16))<<FIXSHIFT,2,map,world,me->friendly))
 			{
 				// don't disappear because Bouapha needs to get multipounded
 			}
@@ -1152,7 +1182,7 @@ void UpdateBullet(bullet_t *me,Map *map,world_t *world)
 			me->anim++;
 			if(me->anim>7)
 				me->anim=0;
-			me->facing+=6-Random(13);
+			me->facing+=6-bulletRng.Random(13);
 			me->dx=Cosine(me->facing)*16;
 			me->dy=Sine(me->facing)*16;
 			HitBadguys(me,map,world);
@@ -1227,7 +1257,7 @@ void UpdateBullet(bullet_t *me,Map *map,world_t *world)
 				HitBadguys(me,map,world);
 			else if(me->timer==4)
 			{
-				b=(me->facing*32-32+Random(65))&255;
+				b=(me->facing*32-32+bulletRng.Random(65))&255;
 				mapx=(me->x+Cosine(b)*32);
 				mapy=(me->y+Sine(b)*32);
 				FireBullet(mapx,mapy,me->facing,me->type,me->friendly);
@@ -1330,9 +1360,9 @@ void UpdateBullet(bullet_t *me,Map *map,world_t *world)
 				HitBadguys(me,map,world);
 			map->BrightTorch((me->x/TILE_WIDTH)>>FIXSHIFT,
 							 (me->y/TILE_HEIGHT)>>FIXSHIFT,8,4);
-			me->dz+=Random(FIXAMT/8);		//anti gravity
-			me->dx+=Random(FIXAMT)-FIXAMT/2;
-			me->dy+=Random(FIXAMT)-FIXAMT/2;
+			me->dz+=bulletRng.Random(FIXAMT/8);		//anti gravity
+			me->dx+=bulletRng.Random(FIXAMT)-FIXAMT/2;
+			me->dy+=bulletRng.Random(FIXAMT)-FIXAMT/2;
 			Dampen(&me->dx,FIXAMT/4);
 			Dampen(&me->dy,FIXAMT/4);
 			Clamp(&me->dx,FIXAMT*10);
@@ -1503,10 +1533,10 @@ void UpdateBullet(bullet_t *me,Map *map,world_t *world)
 			{
 				// make sizzle around player if there was no target
 				LightningBolt(
-					goodguy->x-FIXAMT*32+Random(FIXAMT*64),
-					goodguy->y-FIXAMT*52+Random(FIXAMT*64),
-					goodguy->x-FIXAMT*32+Random(FIXAMT*64),
-					goodguy->y-FIXAMT*52+Random(FIXAMT*64));
+					goodguy->x-FIXAMT*32+bulletRng.Random(FIXAMT*64),
+					goodguy->y-FIXAMT*52+bulletRng.Random(FIXAMT*64),
+					goodguy->x-FIXAMT*32+bulletRng.Random(FIXAMT*64),
+					goodguy->y-FIXAMT*52+bulletRng.Random(FIXAMT*64));
 			}
 			me->type=BLT_NONE;	// begone immediately
 			break;
@@ -1567,12 +1597,12 @@ void UpdateBullet(bullet_t *me,Map *map,world_t *world)
 		case BLT_BALLLIGHTNING:
 			x=me->x;
 			y=me->y-me->z;
-			v=Random(256);
-			v2=Random(16)+2;
+			v=bulletRng.Random(256);
+			v2=bulletRng.Random(16)+2;
 			x2=(x+Cosine(v)*v2);
 			y2=(y+Sine(v)*v2);
-			v=Random(256);
-			v2=Random(16)+2;
+			v=bulletRng.Random(256);
+			v2=bulletRng.Random(16)+2;
 			x=(x+Cosine(v)*v2);
 			y=(y+Sine(v)*v2);
 			LightningBolt(x,y,x2,y2);
@@ -1594,8 +1624,8 @@ void UpdateBullet(bullet_t *me,Map *map,world_t *world)
 				LightningBolt(
 					me->x,
 					me->y,
-					me->x-FIXAMT*64+Random(FIXAMT*128),
-					me->y-FIXAMT*64+Random(FIXAMT*128));
+					me->x-FIXAMT*64+bulletRng.Random(FIXAMT*128),
+					me->y-FIXAMT*64+bulletRng.Random(FIXAMT*128));
 			}
 			me->type=BLT_NONE;	// begone immediately
 			break;
@@ -1605,7 +1635,7 @@ void UpdateBullet(bullet_t *me,Map *map,world_t *world)
 				me->anim=0;
 
 			HitBadguys(me,map,world);
-			me->bright=(char)Random(16);
+			me->bright=(char)bulletRng.Random(16);
 			break;
 		case BLT_REFLECT:
 			me->anim++;
@@ -1989,22 +2019,41 @@ void RenderBullet(bullet_t *me)
 	}
 }
 
+// in slot order, as going through every slot did.  The word is read again
+// each time, so a bullet fired into a later slot mid-update still gets its
+// turn this tick, and one fired into an earlier slot still doesn't.
 void UpdateBullets(Map *map,world_t *world)
 {
-	int i;
+	int w,j,i;
+	PERF_SCOPE("bullets");
 
-	for(i=0;i<config.numBullets;i++)
-		if(bullet[i].type)
-			UpdateBullet(&bullet[i],map,world);
+	for(w=0;w<(int)liveSlot.size();w++)
+		for(j=0;j<32 && (liveSlot[w]>>j);j++)
+			if(liveSlot[w]&(1u<<j))
+			{
+				i=w*32+j;
+				if(bullet[i].type)
+				{
+					UpdateBullet(&bullet[i],map,world);
+					bulletUpdatesRun++;
+				}
+				else
+					liveSlot[w]&=~(1u<<j);
+			}
 }
 
 void RenderBullets(void)
 {
-	int i;
+	int w,j,i;
 
-	for(i=0;i<config.numBullets;i++)
-		if(bullet[i].type)
-			RenderBullet(&bullet[i]);
+	for(w=0;w<(int)liveSlot.size();w++)
+		for(j=0;j<32 && (liveSlot[w]>>j);j++)
+			if(liveSlot[w]&(1u<<j))
+			{
+				i=w*32+j;
+				if(bullet[i].type)
+					RenderBullet(&bullet[i]);
+			}
 }
 
 void FireMe(bullet_t *me,int x,int y,byte facing,byte type,byte friendly)
@@ -2017,11 +2066,12 @@ void FireMe(bullet_t *me,int x,int y,byte facing,byte type,byte friendly)
 	me->y=y;
 	me->facing=facing;
 	me->bright=0;
+	SlotLive(me);
 
 	switch(me->type)
 	{
 		case BLT_SCANSHOT:
-			me->facing=Random(256);
+			me->facing=bulletRng.Random(256);
 			me->dx=Cosine(me->facing)*4;
 			me->dy=Sine(me->facing)*4;
 			me->dz=0;
@@ -2115,29 +2165,29 @@ void FireMe(bullet_t *me,int x,int y,byte facing,byte type,byte friendly)
 			me->facing=facing*2;
 			me->target=65535;
 			f=me->facing;
-			f+=Random(5)-2;
+			f+=bulletRng.Random(5)-2;
 			if(f<0)
 				f+=16;
 			me->facing=(byte)(f&15);
-			me->x+=((Random(17)-8)<<FIXSHIFT);
-			me->y+=((Random(17)-8)<<FIXSHIFT);
+			me->x+=((bulletRng.Random(17)-8)<<FIXSHIFT);
+			me->y+=((bulletRng.Random(17)-8)<<FIXSHIFT);
 			me->dx=Cosine(me->facing*16)*4;
 			me->dy=Sine(me->facing*16)*4;
 			MakeSound(SND_MISSILELAUNCH,me->x,me->y,SND_CUTOFF,1100);
 			break;
 		case BLT_TORPEDO:
-			me->anim=Random(8);
+			me->anim=bulletRng.Random(8);
 			me->timer=60;
 			me->z=FIXAMT*20;
-			me->dz=-6+Random(13);
+			me->dz=-6+bulletRng.Random(13);
 			f=facing*32*16;
-			f+=Random(33)-16;
+			f+=bulletRng.Random(33)-16;
 			if(f<0)
 				f+=256*16;
 			me->target=f%(256*16);
 			me->facing=me->target/256;
-			me->x+=((Random(17)-8)<<FIXSHIFT);
-			me->y+=((Random(17)-8)<<FIXSHIFT);
+			me->x+=((bulletRng.Random(17)-8)<<FIXSHIFT);
+			me->y+=((bulletRng.Random(17)-8)<<FIXSHIFT);
 			me->dx=0;
 			me->dy=0;
 			break;
@@ -2164,25 +2214,25 @@ void FireMe(bullet_t *me,int x,int y,byte facing,byte type,byte friendly)
 		case BLT_FLAME:
 		case BLT_FLAME2:
 			me->anim=0;
-			me->timer=24-Random(4);
+			me->timer=24-bulletRng.Random(4);
 			me->z=FIXAMT*20;
-			me->x+=((Random(3)-1)<<FIXSHIFT)+Cosine(me->facing*32)*5;
-			me->y+=((Random(3)-1)<<FIXSHIFT)+Sine(me->facing*32)*5;
+			me->x+=((bulletRng.Random(3)-1)<<FIXSHIFT)+Cosine(me->facing*32)*5;
+			me->y+=((bulletRng.Random(3)-1)<<FIXSHIFT)+Sine(me->facing*32)*5;
 			me->dx=Cosine(me->facing*32)*10;
 			me->dy=Sine(me->facing*32)*10;
 			me->dz=-FIXAMT/2;
-			if(Random(5)==0)
+			if(bulletRng.Random(5)==0)
 				MakeSound(SND_FLAMEGO,me->x,me->y,SND_CUTOFF,1100);
 			break;
 		case BLT_LASER:
 			me->anim=0;
 			me->timer=30;
-			me->z=FIXAMT*20-Random(FIXAMT);
-			me->x+=((Random(3)-1)<<FIXSHIFT);
-			me->y+=((Random(3)-1)<<FIXSHIFT);
-			me->x+=FIXAMT/2-Random(FIXAMT);
-			me->y+=FIXAMT/2-Random(FIXAMT);
-			me->facing=me->facing*32+4-Random(9);
+			me->z=FIXAMT*20-bulletRng.Random(FIXAMT);
+			me->x+=((bulletRng.Random(3)-1)<<FIXSHIFT);
+			me->y+=((bulletRng.Random(3)-1)<<FIXSHIFT);
+			me->x+=FIXAMT/2-bulletRng.Random(FIXAMT);
+			me->y+=FIXAMT/2-bulletRng.Random(FIXAMT);
+			me->facing=me->facing*32+4-bulletRng.Random(9);
 			me->dx=Cosine(me->facing)*24;
 			me->dy=Sine(me->facing)*24;
 			me->facing/=16;
@@ -2236,7 +2286,7 @@ void FireMe(bullet_t *me,int x,int y,byte facing,byte type,byte friendly)
 			me->anim=0;
 			me->timer=255;
 			me->z=FIXAMT*80;
-			f=Random(12)+1;
+			f=bulletRng.Random(12)+1;
 			me->dx=Cosine(me->facing)*f;
 			me->dy=Sine(me->facing)*f;
 			me->dz=FIXAMT*20;
@@ -2388,7 +2438,7 @@ void FireMe(bullet_t *me,int x,int y,byte facing,byte type,byte friendly)
 			break;
 		case BLT_BUBBLE:
 			me->anim=0;
-			me->timer=40+Random(30);
+			me->timer=40+bulletRng.Random(30);
 			me->z=FIXAMT*20;
 			me->dx=Cosine(me->facing)*5;
 			me->dy=Sine(me->facing)*5;
@@ -2421,6 +2471,7 @@ void QuadMissile(int x,int y,byte facing,byte friendly)
 		{
 			me=&bullet[i];
 			me->type=BLT_MISSILE;
+			SlotLive(me);
 			me->friendly=friendly;
 			me->x=x;
 			me->y=y;
@@ -2467,6 +2518,7 @@ void SpitAcid(int x,int y,byte facing,byte type,byte friendly)
 		{
 			bullet[i].friendly=friendly;
 			bullet[i].type=type;
+			SlotLive(&bullet[i]);
 			bullet[i].x=x;
 			bullet[i].y=y;
 			bullet[i].facing=facing;
@@ -2502,7 +2554,7 @@ void FireScanShots(Guy *victim)
 	for(i=0;i<config.numBullets;i++)
 		if(!bullet[i].type)
 		{
-			FireMe(&bullet[i],goodguy->x,goodguy->y,(byte)Random(256),BLT_SCANSHOT,goodguy->friendly);
+			FireMe(&bullet[i],goodguy->x,goodguy->y,(byte)bulletRng.Random(256),BLT_SCANSHOT,goodguy->friendly);
 			bullet[i].target=victim->ID;
 			count++;
 			if(count==8)
@@ -2569,6 +2621,7 @@ void FireExactBullet(int x,int y,int z,int dx,int dy,int dz,byte anim,byte timer
 			bullet[i].facing=facing;
 			bullet[i].type=type;
 			bullet[i].target=65535;
+			SlotLive(&bullet[i]);
 			break;
 		}
 }
@@ -2676,7 +2729,7 @@ void HappyFire(int x,int y,byte facing)
 					  BLT_GREEN,BLT_TORPEDO,BLT_BUBBLE,BLT_LUNA};
 	byte b;
 
-	b=happyList[Random(16)];
+	b=happyList[bulletRng.Random(16)];
 	if(b==BLT_BOMB || b==BLT_GREEN || b==BLT_BIGSHELL || b==BLT_BUBBLE)
 		facing*=32;
 	FireBullet(x,y,facing,b,1);
@@ -2692,7 +2745,7 @@ void HappyLaunch(int x,int y,byte facing,byte count,byte flags)
 	if(count==2 || count==4)	// these have slight off-angle double forward fire
 	{
 		HappyFire(x,y,facing);
-		if(Random(2)==0)
+		if(bulletRng.Random(2)==0)
 			HappyFire(x,y,(facing-1)&7);
 		else
 			HappyFire(x,y,(facing+1)&7);
@@ -2720,7 +2773,7 @@ void ShroomFire(int x,int y,byte facing)
 
 	for(i=0;i<3;i++)
 	{
-		a=(facing*32+16-Random(33))&255;
+		a=(facing*32+16-bulletRng.Random(33))&255;
 		FireExactBullet(x,y,FIXAMT*16,Cosine(a)*6,Sine(a)*6,0,0,20,a,BLT_SPORE,1);
 	}
 }
@@ -2736,7 +2789,7 @@ void ShroomSpew(int x,int y,byte facing,byte count,byte flags)
 	if(count==2 || count==4)	// these have slight off-angle double forward fire
 	{
 		ShroomFire(x,y,facing);
-		if(Random(2)==0)
+		if(bulletRng.Random(2)==0)
 			ShroomFire(x,y,(facing-1)&7);
 		else
 			ShroomFire(x,y,(facing+1)&7);
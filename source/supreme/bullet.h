@@ -90,6 +90,8 @@ typedef struct bullet_t
 	byte friendly;
 } bullet_t;
 
+extern dword bulletUpdatesRun;	// how many bullet updates ran, for the headless report
+
 void InitBullets(void);
 void ExitBullets(void);
 
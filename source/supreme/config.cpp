@@ -22,6 +22,12 @@ void LoadConfig(void)
 	config.hiscores=1;
 	config.camera=1;
 	config.shading=1;
+	config.viewWidth=640;
+	config.viewHeight=480;
+	config.spriteBudget=32768;
+	config.simRadius=24;
+	config.simPeriod=8;
+	config.thinkThreads=0;
 
 	f=AppdataOpen("config.txt","rt");
 	if(!f)
@@ -91,6 +97,38 @@ void LoadConfig(void)
 			{
 				config.shading=(byte)n;
 			}
+			if(!strcmp(buf,"viewwidth"))
+			{
+				config.viewWidth=n;
+			}
+			if(!strcmp(buf,"viewheight"))
+			{
+				config.viewHeight=n;
+			}
+			if(!strcmp(buf,"simradius"))
+			{
+				if(n<1)
+					n=1;
+				config.simRadius=n;
+			}
+			if(!strcmp(buf,"simperiod"))
+			{
+				if(n<1)
+					n=1;
+				config.simPeriod=n;
+			}
+			if(!strcmp(buf,"thinkthreads"))
+			{
+				if(n<0)
+					n=0;
+				config.thinkThreads=n;
+			}
+			if(!strcmp(buf,"spritebudget"))
+			{
+				if(n<0)
+					n=0;
+				config.spriteBudget=n;
+			}
 		}
 		fclose(f);
 	}
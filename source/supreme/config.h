@@ -14,6 +14,11 @@ typedef struct config_t
 	int numGuys;
 	int numBullets;
 	int numParticles;
+	int viewWidth,viewHeight;	// game view size while playing, 640x480 or bigger
+	int spriteBudget;	// KB of monster sprites kept loaded between levels
+	int simRadius;	// on MAP_SIMLOD levels, monsters further than this many tiles from the player doze,
+	int simPeriod;	// and only update one tick in this many
+	int thinkThreads;	// 0 = monsters think one at a time, else the parallel think on this many threads
 } config_t;
 
 extern config_t config;
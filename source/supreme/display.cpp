@@ -9,12 +9,15 @@
 #include "config.h"
 #include "message.h"
 #include "appdata.h"
+#include "trace.h"
+#include "perf.h"
 
 mfont_t  *gameFont[3]={NULL,NULL,NULL};
 MGLDraw  *mgl=NULL;
 
 int scrx=320,scry=240,scrdx=0,scrdy=0;
 int rscrx=320<<FIXSHIFT,rscry=240<<FIXSHIFT;
+int viewWid=SCRWID,viewHei=SCRHEI;
 
 byte shakeTimer=0;
 
@@ -48,6 +51,7 @@ bool InitDisplay(MGLDraw *mainmgl)
 		return false;
 
 	cursor[0] = RightBraceHack(gameFont[1]);
+	PerfSetFont(gameFont[1]);
 
 	gameFont[2]=(mfont_t *)malloc(sizeof(mfont_t));
 	if(!gameFont[2])
@@ -63,6 +67,7 @@ bool InitDisplay(MGLDraw *mainmgl)
 
 void ExitDisplay(void)
 {
+	PerfSetFont(NULL);
 	if(gameFont[0])
 	{
 		FontFree(gameFont[0]);
@@ -82,6 +87,37 @@ void ExitDisplay(void)
 	delete dispList;
 }
 
+void SetGameView(byte on)
+{
+	int w,h;
+
+	w=SCRWID;
+	h=SCRHEI;
+	if(on)
+	{
+		w=config.viewWidth;
+		h=config.viewHeight;
+		if(w<SCRWID)
+			w=SCRWID;
+		if(h<SCRHEI)
+			h=SCRHEI;
+		if(w>MAX_VIEWWID)
+			w=MAX_VIEWWID;
+		if(h>MAX_VIEWHEI)
+			h=MAX_VIEWHEI;
+	}
+	if(w==viewWid && h==viewHei)
+		return;
+
+	mgl->ResizeBuffer(w,h);
+	mgl->ClearScreen();
+	viewWid=w;
+	viewHei=h;
+	SetSpriteConstraints(0,0,viewWid-1,viewHei-1);
+	// roughly as many things fit on screen as there's screen to put them on
+	dispList->Resize(MAX_DISPLAY_OBJS*((viewWid*viewHei+SCRWID*SCRHEI-1)/(SCRWID*SCRHEI)));
+}
+
 void LoadText(const char *nm,byte mode)
 {
 	FILE *f;
@@ -251,14 +287,14 @@ void UpdateCamera(int x,int y,int dx,int dy,Map *map)
 	rscrx+=scrdx;
 	rscry+=scrdy;
 
-	if(rscrx<320<<FIXSHIFT)
-		rscrx=320<<FIXSHIFT;
-	if(rscrx>((map->width*TILE_WIDTH-320)<<FIXSHIFT))
-		rscrx=(map->width*TILE_WIDTH-320)<<FIXSHIFT;
-	if(rscry<(240-TILE_HEIGHT)<<FIXSHIFT)
-		rscry=(240-TILE_HEIGHT)<<FIXSHIFT;
-	if(rscry>((map->height*TILE_HEIGHT-240)<<FIXSHIFT))
-		rscry=(map->height*TILE_HEIGHT-240)<<FIXSHIFT;
+	if(rscrx<(viewWid/2)<<FIXSHIFT)
+		rscrx=(viewWid/2)<<FIXSHIFT;
+	if(rscrx>((map->width*TILE_WIDTH-viewWid/2)<<FIXSHIFT))
+		rscrx=(map->width*TILE_WIDTH-viewWid/2)<<FIXSHIFT;
+	if(rscry<(viewHei/2-TILE_HEIGHT)<<FIXSHIFT)
+		rscry=(viewHei/2-TILE_HEIGHT)<<FIXSHIFT;
+	if(rscry>((map->height*TILE_HEIGHT-viewHei/2)<<FIXSHIFT))
+		rscry=(map->height*TILE_HEIGHT-viewHei/2)<<FIXSHIFT;
 
 	if(scrx>desiredX+10)
 		scrdx=-((scrx-(desiredX+10))*FIXAMT/16);
@@ -379,12 +415,16 @@ void ShakeScreen(byte howlong)
 
 void RenderItAll(world_t *world,Map *map,byte flags)
 {
+	TRACE_SCOPE("RenderItAll");
+
 	if(shakeTimer)
 	{
 		shakeTimer--;
 		scrx+=-2+Random(5);
 		scry+=-2+Random(5);
 	}
+	// menus drawn over the game last time may have left the clipping at 640x480
+	SetSpriteConstraints(0,0,viewWid-1,viewHei-1);
 	if(editing==1)
 	{
 		map->RenderEdit(world,scrx,scry,flags);
@@ -392,12 +432,12 @@ void RenderItAll(world_t *world,Map *map,byte flags)
 	else
 		map->Render(world,scrx,scry,flags);
 
-	scrx-=320;
-	scry-=240;
+	scrx-=viewWid/2;
+	scry-=viewHei/2;
 	dispList->Render();
 	dispList->ClearList();
-	scrx+=320;
-	scry+=240;
+	scrx+=viewWid/2;
+	scry+=viewHei/2;
 
 	if(editing==1)
 		map->RenderSelect(world,scrx,scry,flags);
@@ -449,25 +489,35 @@ void LightningDraw(int x,int y,int x2,int y2,byte bright,char range)
 
 DisplayList::DisplayList(void)
 {
-	ClearList();
+	dispObj=NULL;
+	Resize(MAX_DISPLAY_OBJS);
 }
 
 DisplayList::~DisplayList(void)
 {
-	// nothin
+	free(dispObj);
 }
 
-int DisplayList::GetOpenSlot(void)
+void DisplayList::Resize(int size)
 {
-	int i;
+	displayObj_t *d;
 
-	for(i=0;i<MAX_DISPLAY_OBJS;i++)
-	{
-		if(dispObj[i].flags==0)
-			return i;
-	}
+	d=(displayObj_t *)realloc(dispObj,sizeof(displayObj_t)*size);
+	if(!d)
+		return;	// keep the old one, things will just get dropped sooner
+	dispObj=d;
+	maxObjs=size;
+	nextfree=maxObjs;	// so ClearList goes over all of it
+	ClearList();
+}
 
-	return -1;
+int DisplayList::GetOpenSlot(void)
+{
+	// slots only get freed all at once by ClearList, so they're always handed out in order
+	if(nextfree>=maxObjs)
+		return -1;
+
+	return nextfree++;
 }
 
 void DisplayList::HookIn(int me)
@@ -526,8 +576,8 @@ bool DisplayList::DrawSprite(int x,int y,int z,int z2,word hue,char bright,sprit
 {
 	int i;
 
-	if((x-scrx+320)<-DISPLAY_XBORDER || (x-scrx+320)>640+DISPLAY_XBORDER ||
-	   (y-scry+240)<-DISPLAY_YBORDER || (y-scry+240)>480+DISPLAY_YBORDER)
+	if((x-scrx+viewWid/2)<-DISPLAY_XBORDER || (x-scrx+viewWid/2)>viewWid+DISPLAY_XBORDER ||
+	   (y-scry+viewHei/2)<-DISPLAY_YBORDER || (y-scry+viewHei/2)>viewHei+DISPLAY_YBORDER)
 		return true;
 	i=GetOpenSlot();
 	if(i==-1)
@@ -551,7 +601,7 @@ void DisplayList::ClearList(void)
 {
 	int i;
 
-	for(i=0;i<MAX_DISPLAY_OBJS;i++)
+	for(i=0;i<nextfree;i++)
 	{
 		dispObj[i].prev=-1;
 		dispObj[i].next=-1;
@@ -563,9 +613,11 @@ void DisplayList::ClearList(void)
 
 void DisplayList::Render(void)
 {
-	int i;
+	int i,n;
+	PERF_SCOPE("sprite draw");
 
 	i=head;
+	n=0;
 
 	while(i!=-1)
 	{
@@ -644,7 +696,9 @@ void DisplayList::Render(void)
 			}
 		}
 		i=dispObj[i].next;
+		n++;
 	}
+	PerfCount("display objects",n);
 }
 
 void DrawBox(int x,int y,int x2,int y2,byte c)
@@ -654,10 +708,10 @@ void DrawBox(int x,int y,int x2,int y2,byte c)
 
 void DrawDebugBox(int x,int y,int x2,int y2)
 {
-	x-=scrx-320;
-	y-=scry-240;
-	x2-=scrx-320;
-	y2-=scry-240;
+	x-=scrx-viewWid/2;
+	y-=scry-viewHei/2;
+	x2-=scrx-viewWid/2;
+	y2-=scry-viewHei/2;
 	mgl->Box(x,y,x2,y2,255);
 	mgl->Flip();
 }
@@ -683,9 +737,9 @@ void DrawLine(int x,int y,int x2,int y2,byte col)
 		return;
 	if(y<0 && y2<0)
 		return;
-	if(x>=SCRWID && x2>=SCRWID)
+	if(x>=viewWid && x2>=viewWid)
 		return;
-	if(y>=SCRHEI && y2>=SCRHEI)
+	if(y>=viewHei && y2>=viewHei)
 		return;
 
 
@@ -710,7 +764,7 @@ void DrawLine(int x,int y,int x2,int y2,byte col)
 
 		while(i>0)
 		{
-			if(x>=0 && y>=0 && x<SCRWID && y<SCRHEI)
+			if(x>=0 && y>=0 && x<viewWid && y<viewHei)
 				*scrn=col;
 
 			scrn+=xDir;
@@ -730,7 +784,7 @@ void DrawLine(int x,int y,int x2,int y2,byte col)
 		i=dy;
 		while(i>0)
 		{
-			if(x>=0 && y>=0 && x<SCRWID && y<SCRHEI)
+			if(x>=0 && y>=0 && x<viewWid && y<viewHei)
 				*scrn=col;
 
 			scrn+=pitchAdj;
@@ -12,7 +12,11 @@
    don't have to pass the mgldraw object everywhere, and also handles the display
    list and camera, so everything is drawn in sorted order (or not drawn). */
 
-#define MAX_DISPLAY_OBJS 1024
+#define MAX_DISPLAY_OBJS 1024	// for a 640x480 view, scaled up by area for bigger ones
+
+// the largest the game view can be set to (config viewwidth/viewheight)
+#define MAX_VIEWWID	3840
+#define MAX_VIEWHEI	2160
 
 #define DISPLAY_XBORDER 128
 #define DISPLAY_YBORDER 128
@@ -54,6 +58,8 @@ class DisplayList
 		DisplayList(void);
 		~DisplayList(void);
 
+		void Resize(int size);
+
 		bool DrawSprite(int x,int y,int z,int z2,word hue,char bright,sprite_t *spr,word flags);
 		void ClearList(void);
 		void Render(void);
@@ -63,12 +69,17 @@ class DisplayList
 		int GetOpenSlot(void);
 
 
-		displayObj_t dispObj[MAX_DISPLAY_OBJS];
+		displayObj_t *dispObj;
+		int maxObjs;
 		int head,nextfree;
 };
 
+extern int viewWid,viewHei;	// size of the game view, which is the whole screen while playing
+
 bool InitDisplay(MGLDraw *mainmgl);
 void ExitDisplay(void);
+// on=1 switches the screen to the configured game view size, on=0 back to 640x480 for menus
+void SetGameView(byte on);
 
 byte *GetDisplayScreen(void);
 
@@ -121,9 +121,10 @@ char helpTxt[NUM_HELPS][612]={
 	"monsters it creates will drop the same item!",
 	// sound edit
 	"Click 'Add New Sound' to put your own custom sound in.  This lets you choose "
-	"from any WAV files which are in the 'user' folder.  Then give it a name.  The "
+	"from any WAV or OGG files which are in the 'user' folder.  OGGs take far less "
+	"room in the DLW, so use them for long sounds.  Then give it a name.  The "
 	"name is just for your use so you recognize it when editing.  You can delete any "
-	"sound you create, rename it, or reload it.  Reload means to load a new wav file "
+	"sound you create, rename it, or reload it.  Reload means to load a new sound file "
 	"to replace the one you already had.  The sounds you add are saved into the DLW "
 	"file, so don't need to be included separately.  You can't rename, delete, or "
 	"reload any of the original sounds.",
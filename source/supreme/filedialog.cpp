@@ -19,6 +19,30 @@ static byte asking,yesNo;
 static char question[64];
 static byte exitCode;
 
+// filter is ".wav" or ".wav;*.ogg" and so on, any one of them will do
+static bool MatchFilter(const char *name, const char *filter)
+{
+	char ext[16];
+	const char *end;
+
+	while(true)
+	{
+		end=strchr(filter,';');
+		if(!end)
+			return strstr(name,filter)!=NULL;
+		if(end-filter<(int)sizeof(ext))
+		{
+			memcpy(ext,filter,end-filter);
+			ext[end-filter]='\0';
+			if(strstr(name,ext))
+				return true;
+		}
+		filter=end+1;
+		if(*filter=='*')
+			filter++;
+	}
+}
+
 void ObtainFilenames(const char *fileSpec)
 {
 	int i;
@@ -62,7 +86,7 @@ void ObtainFilenames(const char *fileSpec)
 		if((menuItems&FM_NOWAVS) && !strcmp(&name[strlen(name)-3],"wav"))
 			continue;	// ignore wavs
 
-		if(filter && !strstr(name, filter))
+		if(filter && !MatchFilter(name, filter))
 			continue;
 
 		strncpy(&fnames[numFiles*FNAMELEN],name,FNAMELEN);
@@ -0,0 +1,123 @@
+#include "flowfield.h"
+#include "guy.h"
+#include "items.h"
+#include "world.h"
+#include "perf.h"
+#include <vector>
+
+#define FLOW_RANGE		64	// steps out from the player before giving up
+#define FLOW_REFRESH	30	// ticks between redoing it when the player stands still
+#define FLOW_NONE		0xFFFF
+
+static std::vector<word> dist;
+static std::vector<int> queue;
+static int flowWidth,flowHeight;
+static int playerX,playerY;
+static int refreshClock;
+
+static byte Passable(Map *map,world_t *world,int x,int y)
+{
+	mapTile_t *m=map->GetTile(x,y);
+
+	if(m->wall)
+		return 0;
+	if(GetTerrain(world,m->floor)->flags&(TF_SOLID|TF_WATER|TF_LAVA|TF_NOENEMY))
+		return 0;
+	if(m->item && (GetItem(m->item)->flags&IF_SOLID))
+		return 0;
+	return 1;
+}
+
+void InitFlowField(Map *map)
+{
+	flowWidth=map->width;
+	flowHeight=map->height;
+	dist.assign(flowWidth*flowHeight,FLOW_NONE);
+	queue.resize(flowWidth*flowHeight);
+	playerX=-1;
+	playerY=-1;
+	refreshClock=0;
+}
+
+static void Flood(Map *map,world_t *world)
+{
+	int head,tail;
+	int x,y,i,pos;
+	static const int nx[4]={1,-1,0,0},ny[4]={0,0,1,-1};
+	PERF_SCOPE("flow field");
+
+	dist.assign(flowWidth*flowHeight,FLOW_NONE);
+	pos=playerX+playerY*flowWidth;
+	dist[pos]=0;
+	queue[0]=pos;
+	head=0;
+	tail=1;
+	while(head<tail)
+	{
+		pos=queue[head++];
+		if(dist[pos]>=FLOW_RANGE)
+			continue;
+		x=pos%flowWidth;
+		y=pos/flowWidth;
+		for(i=0;i<4;i++)
+		{
+			if(x+nx[i]<0 || x+nx[i]>=flowWidth || y+ny[i]<0 || y+ny[i]>=flowHeight)
+				continue;
+			if(dist[pos+nx[i]+ny[i]*flowWidth]!=FLOW_NONE || !Passable(map,world,x+nx[i],y+ny[i]))
+				continue;
+			dist[pos+nx[i]+ny[i]*flowWidth]=dist[pos]+1;
+			queue[tail++]=pos+nx[i]+ny[i]*flowWidth;
+		}
+	}
+}
+
+void UpdateFlowField(Map *map,world_t *world)
+{
+	if(!goodguy || map->width!=flowWidth || map->height!=flowHeight)
+		return;
+	if(goodguy->mapx>=flowWidth || goodguy->mapy>=flowHeight)
+		return;
+
+	refreshClock++;
+	if(goodguy->mapx==playerX && goodguy->mapy==playerY && refreshClock<FLOW_REFRESH)
+		return;
+
+	playerX=goodguy->mapx;
+	playerY=goodguy->mapy;
+	refreshClock=0;
+	Flood(map,world);
+}
+
+static word Dist(int x,int y)
+{
+	if(x<0 || y<0 || x>=flowWidth || y>=flowHeight)
+		return FLOW_NONE;
+	return dist[x+y*flowWidth];
+}
+
+byte FlowNextTile(int mapx,int mapy,int *nextx,int *nexty)
+{
+	word here,best,d;
+	int i;
+	// orthogonals first, so a diagonal has to be strictly better to win
+	static const int nx[8]={1,-1,0,0,1,-1,1,-1},ny[8]={0,0,1,-1,1,1,-1,-1};
+
+	here=Dist(mapx,mapy);
+	if(here==FLOW_NONE || here==0)
+		return 0;
+
+	best=here;
+	for(i=0;i<8;i++)
+	{
+		d=Dist(mapx+nx[i],mapy+ny[i]);
+		if(d>=best)
+			continue;
+		// no cutting corners: both tiles beside a diagonal must be open too
+		if(i>=4 && (Dist(mapx+nx[i],mapy)==FLOW_NONE || Dist(mapx,mapy+ny[i])==FLOW_NONE))
+			continue;
+		best=d;
+		*nextx=mapx+nx[i];
+		*nexty=mapy+ny[i];
+	}
+	return best<here;
+}
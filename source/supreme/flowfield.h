@@ -0,0 +1,20 @@
+#ifndef FLOWFIELD_H
+#define FLOWFIELD_H
+
+#include "map.h"
+
+// On MAP_FLOWCHASE levels, a map of how many steps each tile is from the
+// player, walking.  It's worked out once for everyone, so a crowd of chasers
+// can each ask which way is closer instead of walking into the same wall.
+// It's redone when the player moves to another tile, and now and then anyway
+// in case a wall or door changed.  Tiles too far away to bother with have no
+// way to go.
+
+void InitFlowField(Map *map);	// when a level starts
+void UpdateFlowField(Map *map,world_t *world);	// each tick, before the guys
+
+// the tile to head for next from (mapx,mapy).  0 if there's no path, or
+// (mapx,mapy) is the player's tile.
+byte FlowNextTile(int mapx,int mapy,int *nextx,int *nexty);
+
+#endif
@@ -3,6 +3,7 @@
 #include "game.h"
 #include "control.h"
 #include "appdata.h"
+#include "tilebits.h"
 #include <stdlib.h>
 
 galpic_t *galpix;
@@ -86,6 +87,7 @@ void SetupGalPix(Map *map)
 		if(profile.progress.goal[i])
 			map->GetTile(galpix[i].x,galpix[i].y)->floor=i+268;
 	}
+	AllTileBitsChanged(map);
 }
 
 void InitGallery(Map *map)
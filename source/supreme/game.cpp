@@ -15,6 +15,9 @@
 #include "log.h"
 #include "palettes.h"
 #include "appdata.h"
+#include "trace.h"
+#include "flowfield.h"
+#include "tilebits.h"
 
 byte showStats=0;
 dword gameStartTime,visFrameCount,updFrameCount;
@@ -43,6 +46,9 @@ word windingDown;
 byte windingUp;
 byte windDownReason;
 static byte idleGame=0,pictureNoKey;
+byte headless=0;
+Uint64 tickTime[TT_MAX];
+const char *tickTimeName[TT_MAX]={"map","guys","items","bullets","specials","particles","draw"};
 
 void LunaticInit(MGLDraw *mgl)
 {
@@ -119,8 +125,10 @@ byte InitLevel(byte map)
 	if(curWorld.numMaps<=map)
 		return 0;	// can't go to illegal map
 
+	SetGameView(1);
 	// make a copy of the map to be played
 	curMap=new Map(curWorld.map[map]);
+	ResetFloorLayer();
 
 	verified=VerifyLevel(curMap);
 
@@ -152,6 +160,9 @@ byte InitLevel(byte map)
 
 	GetSpecialsFromMap(curMap->special);
 	InitSpecialsForPlay();
+	PreloadLevelSprites(curMap);
+	InitGuyDozing(curMap);
+	InitFlowField(curMap);
 	PlaySong(curMap->song);
 
 	ScoreEvent(SE_INIT,curMap->width*curMap->height);
@@ -163,6 +174,7 @@ byte InitLevel(byte map)
 		SetupShops(curMap);
 		InitGallery(curMap);
 	}
+	InitTileBits(curMap);
 
 	LocateKeychains(&curWorld);
 	RestoreGameplayGfx();
@@ -180,8 +192,10 @@ void ExitLevel(void)
 
 	// exit everything
 	ExitPauseMenu();
+	SetGameView(0);
 	ExitGuys();
 	ExitBullets();
+	ExitTileBits();
 	ExitParticles();
 
 	player.vehicle=0;
@@ -189,7 +203,7 @@ void ExitLevel(void)
 	player.hammers=0;
 
 	delete curMap;
-	PurgeMonsterSprites();
+	ReleaseLevelSprites();
 	gamemgl->RealizePalette();
 	if(shopping)
 		ExitGallery();
@@ -263,239 +277,290 @@ void EnterRage(void)
 	SetRageFace();
 }
 
-byte LunaticRun(int *lastTime)
+static Uint64 TickTime(byte slot,Uint64 start)
 {
-	byte frmsToRun;
-
-	numRunsToMakeUp=0;
-	if(*lastTime>TIME_PER_FRAME*5)
-		*lastTime=TIME_PER_FRAME*5;
+	Uint64 now;
 
-	frmsToRun=(*lastTime/TIME_PER_FRAME);
+	now=SDL_GetPerformanceCounter();
+	tickTime[slot]+=now-start;
+	TraceSpan(tickTimeName[slot],start,now);
+	return now;
+}
 
-	*lastTime-=frmsToRun*TIME_PER_FRAME;
+void ResetTickTimes(void)
+{
+	memset(tickTime,0,sizeof(tickTime));
+}
 
-	if(gameMode==GAMEMODE_PLAY && (profile.progress.purchase[modeShopNum[MODE_MANIC]]&SIF_ACTIVE))
-		frmsToRun*=2;	// run twice as many frames
+// one tick of the game, whatever mode it's in
+byte LunaticUpdate(void)
+{
+	Uint64 t;
+	TRACE_SCOPE("LunaticUpdate");
 
-	while(frmsToRun--)//(*lastTime>=TIME_PER_FRAME)
+	if(gameMode==GAMEMODE_PLAY)
 	{
-		if(!gamemgl->Process())
+		if(!editing && !player.cheated && verified)
 		{
-			mapToGoTo=255;
-			return LEVEL_ABORT;
+			profile.progress.totalTime++;
+			if((curMap->flags&(MAP_UNDERWATER|MAP_LAVA)) && player.weapon!=WPN_MINISUB)
+				profile.progress.underwaterTime++;
 		}
 
-		if(gameMode==GAMEMODE_PLAY)
+		UpdateInterface(curMap);
+		UpdateUnpaused();
+		t=SDL_GetPerformanceCounter();
+		// update everything here
+		if(!windingDown)
 		{
-			if(!editing && !player.cheated && verified)
-			{
-				profile.progress.totalTime++;
-				if((curMap->flags&(MAP_UNDERWATER|MAP_LAVA)) && player.weapon!=WPN_MINISUB)
-					profile.progress.underwaterTime++;
-			}
-
-			UpdateInterface(curMap);
-			UpdateUnpaused();
-			// update everything here
-			if(!windingDown)
-			{
-				if(windingUp)
-				{
-					curMap->Update(UPDATE_FADEIN,&curWorld);
-					EditorUpdateGuys(curMap);
-					windingUp--;
-				}
-				else
-				{
-					curMap->Update(UPDATE_GAME,&curWorld);
-					UpdateGuys(curMap,&curWorld);
-					UpdateItems();
-					UpdateBullets(curMap,&curWorld);
-					CheckSpecials(curMap);
-				}
-			}
-			else
+			if(windingUp)
 			{
-				curMap->Update(UPDATE_FADE,&curWorld);
+				curMap->Update(UPDATE_FADEIN,&curWorld);
+				t=TickTime(TT_MAP,t);
 				EditorUpdateGuys(curMap);
+				t=TickTime(TT_GUYS,t);
+				windingUp--;
 			}
-			UpdateParticles(curMap);
-			UpdateMessage();
-
-			if(curMap->flags&MAP_SNOWING)
-				MakeItSnow(curMap);
-			if(curMap->flags&MAP_RAIN)
-			{
-				MakeItRain(curMap);
-				MakeItRain(curMap);
-				MakeItRain(curMap);
-			}
-
-			if(windingDown)
+			else
 			{
-				windingDown--;
-				if(!windingDown)
-				{
-					PrintToLog("Wound Down",0);
-					return windDownReason;
-				}
+				curMap->Update(UPDATE_GAME,&curWorld);
+				t=TickTime(TT_MAP,t);
+				UpdateGuys(curMap,&curWorld);
+				t=TickTime(TT_GUYS,t);
+				UpdateItems();
+				t=TickTime(TT_ITEMS,t);
+				UpdateBullets(curMap,&curWorld);
+				t=TickTime(TT_BULLETS,t);
+				CheckSpecials(curMap);
+				t=TickTime(TT_SPECIALS,t);
 			}
 		}
-		else if(gameMode==GAMEMODE_MENU)
+		else
 		{
-			switch(UpdatePauseMenu(gamemgl))
-			{
-				case PAUSE_PAUSED:
-					break;
-				case PAUSE_CONTINUE:
-					lastKey=0;
-					gameMode=GAMEMODE_PLAY;
-					break;
-				case PAUSE_GIVEUP:
-					SetPlayerStart(-1,-1);
-					if(mapNum)
-						mapToGoTo=0;
-					else
-						mapToGoTo=255;
-					lastKey=0;
-					gameMode=GAMEMODE_PLAY;
-					return LEVEL_ABORT;
-					break;
-				case PAUSE_WORLDSEL:
-					mapToGoTo=255;
-					lastKey=0;
-					gameMode=GAMEMODE_PLAY;
-					return WORLD_ABORT;	// dump out altogether
-					break;
-				case PAUSE_RETRY:
-					mapToGoTo=player.levelNum;	// repeat this level
-					lastKey=0;
-					gameMode=GAMEMODE_PLAY;
-					return LEVEL_ABORT;
-					break;
-				case PAUSE_EXIT:
-					mapToGoTo=255;
-					lastKey=0;
-					gameMode=GAMEMODE_PLAY;
-					return WORLD_QUITGAME;
-					break;
-				case PAUSE_SHOP:
-					mapToGoTo=255;
-					lastKey=0;
-					gameMode=GAMEMODE_PLAY;
-					return WORLD_SHOP;
-					break;
-			}
+			curMap->Update(UPDATE_FADE,&curWorld);
+			t=TickTime(TT_MAP,t);
+			EditorUpdateGuys(curMap);
+			t=TickTime(TT_GUYS,t);
 		}
-		else if(gameMode==GAMEMODE_PIC)	// gamemode_pic
+		UpdateParticles(curMap);
+		UpdateMessage();
+
+		if(curMap->flags&MAP_SNOWING)
+			MakeItSnow(curMap);
+		if(curMap->flags&MAP_RAIN)
 		{
-			if(pictureNoKey)
-				pictureNoKey--;
-			else
-			{
-				if(GetTaps()&(CONTROL_B1|CONTROL_B2))
-				{
-					gameMode=GAMEMODE_PLAY;
-					// restore the palette
-					gamemgl->LoadBMP("graphics/title.bmp");
-					RestoreGameplayGfx();
-				}
-			}
+			MakeItRain(curMap);
+			MakeItRain(curMap);
+			MakeItRain(curMap);
 		}
-		else if(gameMode==GAMEMODE_SCAN)
+		TickTime(TT_PARTICLES,t);
+
+		if(windingDown)
 		{
-			if(!UpdateScan(gamemgl))
+			windingDown--;
+			if(!windingDown)
 			{
-				gameMode=GAMEMODE_PLAY;
-				RestoreGameplayGfx();
+				PrintToLog("Wound Down",0);
+				return windDownReason;
 			}
 		}
-		else if(gameMode==GAMEMODE_SHOP)
+	}
+	else if(gameMode==GAMEMODE_MENU)
+	{
+		switch(UpdatePauseMenu(gamemgl))
 		{
-			if(!UpdateShopping(gamemgl))
-			{
+			case PAUSE_PAUSED:
+				break;
+			case PAUSE_CONTINUE:
+				lastKey=0;
 				gameMode=GAMEMODE_PLAY;
-				RestoreGameplayGfx();
-			}
+				break;
+			case PAUSE_GIVEUP:
+				SetPlayerStart(-1,-1);
+				if(mapNum)
+					mapToGoTo=0;
+				else
+					mapToGoTo=255;
+				lastKey=0;
+				gameMode=GAMEMODE_PLAY;
+				return LEVEL_ABORT;
+				break;
+			case PAUSE_WORLDSEL:
+				mapToGoTo=255;
+				lastKey=0;
+				gameMode=GAMEMODE_PLAY;
+				return WORLD_ABORT;	// dump out altogether
+				break;
+			case PAUSE_RETRY:
+				mapToGoTo=player.levelNum;	// repeat this level
+				lastKey=0;
+				gameMode=GAMEMODE_PLAY;
+				return LEVEL_ABORT;
+				break;
+			case PAUSE_EXIT:
+				mapToGoTo=255;
+				lastKey=0;
+				gameMode=GAMEMODE_PLAY;
+				return WORLD_QUITGAME;
+				break;
+			case PAUSE_SHOP:
+				mapToGoTo=255;
+				lastKey=0;
+				gameMode=GAMEMODE_PLAY;
+				return WORLD_SHOP;
+				break;
 		}
-		else // gamemode_rage
+	}
+	else if(gameMode==GAMEMODE_PIC)	// gamemode_pic
+	{
+		if(pictureNoKey)
+			pictureNoKey--;
+		else
 		{
-			UpdateRage(gamemgl);
-			if(player.rageClock)
-			{
-				player.rageClock--;
-				if(goodguy)
-					goodguy->facing=(goodguy->facing+1)&7;
-			}
-			else
+			if(GetTaps()&(CONTROL_B1|CONTROL_B2))
 			{
 				gameMode=GAMEMODE_PLAY;
-				StartRaging();
+				// restore the palette
+				gamemgl->LoadBMP("graphics/title.bmp");
+				RestoreGameplayGfx();
 			}
 		}
-
-		if(msgFromOtherModules==MSG_GOTOMAP)
-		{
-			GoalTimeDist();
-			mapToGoTo=msgContent;
-			windingDown=30;
-			windDownReason=LEVEL_ABORT;
-			msgFromOtherModules=MSG_NONE;
-		}
-		else if(msgFromOtherModules==MSG_WINLEVEL)
+	}
+	else if(gameMode==GAMEMODE_SCAN)
+	{
+		if(!UpdateScan(gamemgl))
 		{
-			PrintToLog("Level Win!",0);
-			GoalTimeDist();
-			PrintToLog("GoalTimeDist Done",0);
-			mapToGoTo=msgContent;
-			windingDown=40;
-			windDownReason=LEVEL_WIN;
-			msgFromOtherModules=MSG_NONE;
-			player.boredom=0;
+			gameMode=GAMEMODE_PLAY;
+			RestoreGameplayGfx();
 		}
-		else if(msgFromOtherModules==MSG_RESET)
+	}
+	else if(gameMode==GAMEMODE_SHOP)
+	{
+		if(!UpdateShopping(gamemgl))
 		{
-			GoalTimeDist();
-			NewBigMessage("Try Again!",30);
-			windingDown=30;
-			windDownReason=LEVEL_RESET;
-			msgFromOtherModules=MSG_NONE;
+			gameMode=GAMEMODE_PLAY;
+			RestoreGameplayGfx();
 		}
-		else if(msgFromOtherModules==MSG_SCANMONSTER)
+	}
+	else // gamemode_rage
+	{
+		UpdateRage(gamemgl);
+		if(player.rageClock)
 		{
-			msgFromOtherModules=MSG_NONE;
-			gameMode=GAMEMODE_SCAN;
+			player.rageClock--;
+			if(goodguy)
+				goodguy->facing=(goodguy->facing+1)&7;
 		}
-		else if(msgFromOtherModules==MSG_SHOPNOW)
+		else
 		{
-			GoalTimeDist();
-			msgFromOtherModules=MSG_NONE;
-			gameMode=GAMEMODE_SHOP;
+			gameMode=GAMEMODE_PLAY;
+			StartRaging();
 		}
-		else if(msgFromOtherModules==MSG_WINGAME)
+	}
+
+	if(msgFromOtherModules==MSG_GOTOMAP)
+	{
+		GoalTimeDist();
+		mapToGoTo=msgContent;
+		windingDown=30;
+		windDownReason=LEVEL_ABORT;
+		msgFromOtherModules=MSG_NONE;
+	}
+	else if(msgFromOtherModules==MSG_WINLEVEL)
+	{
+		PrintToLog("Level Win!",0);
+		GoalTimeDist();
+		PrintToLog("GoalTimeDist Done",0);
+		mapToGoTo=msgContent;
+		windingDown=40;
+		windDownReason=LEVEL_WIN;
+		msgFromOtherModules=MSG_NONE;
+		player.boredom=0;
+	}
+	else if(msgFromOtherModules==MSG_RESET)
+	{
+		GoalTimeDist();
+		NewBigMessage("Try Again!",30);
+		windingDown=30;
+		windDownReason=LEVEL_RESET;
+		msgFromOtherModules=MSG_NONE;
+	}
+	else if(msgFromOtherModules==MSG_SCANMONSTER)
+	{
+		msgFromOtherModules=MSG_NONE;
+		gameMode=GAMEMODE_SCAN;
+	}
+	else if(msgFromOtherModules==MSG_SHOPNOW)
+	{
+		GoalTimeDist();
+		msgFromOtherModules=MSG_NONE;
+		gameMode=GAMEMODE_SHOP;
+	}
+	else if(msgFromOtherModules==MSG_WINGAME)
+	{
+		GoalTimeDist();
+		mapToGoTo=0;
+		windingDown=1;
+		windDownReason=LEVEL_WIN;
+		msgFromOtherModules=MSG_NONE;
+		if(!headless)
 		{
-			GoalTimeDist();
-			mapToGoTo=0;
-			windingDown=1;
-			windDownReason=LEVEL_WIN;
-			msgFromOtherModules=MSG_NONE;
 			VictoryText(gamemgl);
 			Credits(gamemgl);
-			player.boredom=0;
 		}
+		player.boredom=0;
+	}
+
+	return LEVEL_PLAYING;
+}
+
+byte LunaticRun(int *lastTime)
+{
+	byte frmsToRun,result;
+	TRACE_SCOPE("LunaticRun");
+
+	numRunsToMakeUp=0;
+	if(*lastTime>TIME_PER_FRAME*5)
+		*lastTime=TIME_PER_FRAME*5;
+
+	frmsToRun=(*lastTime/TIME_PER_FRAME);
+
+	*lastTime-=frmsToRun*TIME_PER_FRAME;
+
+	if(gameMode==GAMEMODE_PLAY && (profile.progress.purchase[modeShopNum[MODE_MANIC]]&SIF_ACTIVE))
+		frmsToRun*=2;	// run twice as many frames
+
+	result=LEVEL_PLAYING;
+	BeginSoundBatch();
+	while(frmsToRun--)//(*lastTime>=TIME_PER_FRAME)
+	{
+		if(!gamemgl->Process())
+		{
+			mapToGoTo=255;
+			result=LEVEL_ABORT;
+			break;
+		}
+
+		result=LunaticUpdate();
+		if(result!=LEVEL_PLAYING)
+			break;
+
 		//*lastTime-=TIME_PER_FRAME;
 		numRunsToMakeUp++;
 		updFrameCount++;
 	}
+	EndSoundBatch();
 
-	return LEVEL_PLAYING;
+	return result;
 }
 
 void LunaticDraw(void)
 {
 	char s[128];
 	dword d;
+	TRACE_SCOPE("LunaticDraw");
+
+	AgeMonsterSprites();
 
 	// add all the sprites to the list
 	if(gameMode!=GAMEMODE_PIC && gameMode!=GAMEMODE_SCAN)
@@ -702,6 +767,7 @@ byte PlayALevel(byte map)
 	if(exitcode==LEVEL_WIN)
 	{
 		PlayerWinLevel(0);
+		SetGameView(0);
 		PrintToLog("Tally",0);
 		Tally(gamemgl,lastLevelName,0);
 	}
@@ -58,10 +58,23 @@
 #define WORLD_QUITGAME 9
 #define WORLD_SHOP	10
 
+// where the time in a tick goes, see tickTime
+#define TT_MAP		0
+#define TT_GUYS		1
+#define TT_ITEMS	2
+#define TT_BULLETS	3
+#define TT_SPECIALS	4
+#define TT_PARTICLES 5	// and messages and weather
+#define TT_DRAW		6	// only the headless runner times this one
+#define TT_MAX		7
+
 extern Map *curMap;
 extern world_t curWorld;
 extern byte shopping,tutorial,verified;
 extern byte doShop;
+extern byte headless;	// no one's watching: skip anything that waits for a keypress
+extern Uint64 tickTime[TT_MAX];	// performance counter ticks spent in each part, since ResetTickTimes
+extern const char *tickTimeName[TT_MAX];
 
 // these are the major inits, just at the beginning and ending of a whole game
 void LunaticInit(MGLDraw *mgl);
@@ -76,7 +89,9 @@ byte GameStartup(void);
 void EnterRage(void);
 void EnterPictureDisplay(void);
 
+byte LunaticUpdate(void);
 byte LunaticRun(int *lastTime);
+void ResetTickTimes(void);
 void LunaticDraw(void);
 
 byte PlayALevel(byte map);
@@ -6,10 +6,17 @@
 #include "hiscore.h"
 #include "shop.h"
 #include "goal.h"
+#include "perf.h"
+#include "config.h"
+#include "flowfield.h"
+#include "think.h"
+#include "tilebits.h"
 
 Guy **guys;
 Guy *goodguy;
 int maxGuys;
+dword guyUpdatesRun,guyUpdatesDozed;
+dword canWalkCalls;
 Guy *guyHit;
 Guy *nobody;
 byte *changed;
@@ -25,7 +32,7 @@ Guy::Guy(void)
 
 Guy::~Guy(void)
 {
-	if (customSpr) delete customSpr;
+	FreeCustomSprites(customSpr);
 }
 
 byte Guy::CoconutBonk(int xx,int yy,Guy *him)
@@ -138,11 +145,8 @@ void TryToPush(Guy *me,int x,int y,Map *map,world_t *world)
 		return;	// can't push off edge of map
 	tile=map->GetTile(destx,desty);
 
-	if(tile->wall)
-		return;	// can't push into a wall
-	if(tile->item)
-		return;	// can't push into any item
-	if(GetTerrain(world,tile->floor)->flags&TF_PUSHON)
+	// can't push into a wall or any item, and only onto pushon floor
+	if(TileBit(map,TB_PUSHON,destx,desty))
 	{
 		// it passed every single test. the only thing left is to see if it would overlap
 		// any badguys, which would not be good
@@ -160,10 +164,12 @@ void TryToPush(Guy *me,int x,int y,Map *map,world_t *world)
 		tile->floor=map->GetTile(x,y)->floor;
 		map->GetTile(x,y)->floor=GetTerrain(world,tile->floor)->next;
 		map->GetTile(x,y)->wall=0;
+		TileBitsChanged(tile);
+		TileBitsChanged(map->GetTile(x,y));
 	}
 }
 
-byte TryToPushItem(int x,int y,int destx,int desty,Map *map,world_t *world)
+byte TryToPushItem(int x,int y,int destx,int desty,Map *map)
 {
 	int i;
 	int xx,yy;
@@ -173,11 +179,8 @@ byte TryToPushItem(int x,int y,int destx,int desty,Map *map,world_t *world)
 		return 0;	// can't push off edge of map
 	tile=map->GetTile(destx,desty);
 
-	if(tile->wall)
-		return 0;	// can't push into a wall
-	if(tile->item)
-		return 0;	// can't push into any item
-	if(GetTerrain(world,tile->floor)->flags&TF_PUSHON)
+	// can't push into a wall or any item, and only onto pushon floor
+	if(TileBit(map,TB_PUSHON,destx,desty))
 	{
 		// it passed every single test. the only thing left is to see if it would overlap
 		// any badguys, which would not be good
@@ -192,6 +195,8 @@ byte TryToPushItem(int x,int y,int destx,int desty,Map *map,world_t *world)
 		// the floor is pushonable, let's do it
 		tile->item=map->GetTile(x,y)->item;
 		map->GetTile(x,y)->item=0;
+		TileBitsChanged(tile);
+		TileBitsChanged(map->GetTile(x,y));
 		return 1;
 	}
 	else
@@ -255,10 +260,11 @@ byte Walkable(Guy *me,int x,int y,Map *map,world_t *world)
 
 byte Guy::CanWalk(int xx,int yy,Map *map,world_t *world)
 {
-	byte result;
+	byte result,walkBits;
 	int mapx1,mapx2,mapy1,mapy2;
 	int i,j;
 
+	canWalkCalls++;
 	xx>>=FIXSHIFT;
 	yy>>=FIXSHIFT;
 
@@ -271,20 +277,24 @@ byte Guy::CanWalk(int xx,int yy,Map *map,world_t *world)
 	if(mapx1<0 || mapy1<0 || mapx2>=map->width || mapy2>=map->height || xx<0 || yy<0)
 		return 0;
 
+	// tiles it's sure to walk onto with nothing happening can skip Walkable,
+	// and if they're all like that, so can the whole lot
 	result=1;
-	for(i=mapx1;i<=mapx2;i++)
-	{
-		for(j=mapy1;j<=mapy2;j++)
+	walkBits=WalkBits(this);
+	if(!TileBitsRect(map,walkBits,mapx1,mapy1,mapx2,mapy2))
+		for(i=mapx1;i<=mapx2;i++)
 		{
-			if(!Walkable(this,i,j,map,world))
+			for(j=mapy1;j<=mapy2;j++)
 			{
-				result=0;
-				break;
+				if(!TileBit(map,walkBits,i,j) && !Walkable(this,i,j,map,world))
+				{
+					result=0;
+					break;
+				}
 			}
+			if(result==0)
+				break;
 		}
-		if(result==0)
-			break;
-	}
 
 	if(MonsterFlags(type,aiType)&MF_FREEWALK)
 		return result;	// can't have a guy collision
@@ -741,6 +751,7 @@ void Guy::Update(Map *map,world_t *world)
 			(GetTerrain(world,map->GetTile(mapx,mapy)->floor)->flags&TF_STEP))
 		{
 			map->GetTile(mapx,mapy)->floor=GetTerrain(world,map->GetTile(mapx,mapy)->floor)->next;
+			TileBitsChanged(map->GetTile(mapx,mapy));
 		}
 	}
 	if((oldmapx!=mapx || oldmapy!=mapy) && type!=MONS_NOBODY)
@@ -895,8 +906,10 @@ void Guy::MonsterControl(Map *map,world_t *world)
 	if(type==MONS_NONE)
 		return;
 
-	if(GetMonsterType(aiType)->AI)
-		GetMonsterType(aiType)->AI(this,map,world,target);
+	if(ApplyThought(this,map,world))
+		return;
+	if(MonsterAI(aiType))
+		MonsterAI(aiType)(this,map,world,target);
 }
 
 void Guy::GetShot(int dx,int dy,byte damage,Map *map,world_t *world)
@@ -1040,7 +1053,10 @@ void Guy::GetShot(int dx,int dy,byte damage,Map *map,world_t *world)
 		{
 			if(mind3!=0)	// drop what you stole!
 				if(!map->DropItem(mapx,mapy,mind3))
+				{
 					map->GetTile(mapx,mapy)->item=mind3;
+					TileBitsChanged(map->GetTile(mapx,mapy));
+				}
 							// if the drop failed, just force it
 		}
 		if(aiType!=MONS_CRAZYPANTS || mind==3)
@@ -1053,7 +1069,10 @@ void Guy::GetShot(int dx,int dy,byte damage,Map *map,world_t *world)
 			else if(item!=ITM_NONE)
 			{
 				if(!map->DropItem(mapx,mapy,item))
+				{
 					map->GetTile(mapx,mapy)->item=item;	// force the drop if it failed
+					TileBitsChanged(map->GetTile(mapx,mapy));
+				}
 			}
 		}
 
@@ -1111,9 +1130,121 @@ void Guy::GetShot(int dx,int dy,byte damage,Map *map,world_t *world)
 }
 
 //-----------------------------------------------------------------------
+// On MAP_SIMLOD levels, monsters more than config.simRadius tiles from the
+// player doze: they get one update in config.simPeriod ticks, staggered so
+// they don't all wake on the same one.  Bosses, the tagged monster, dying
+// monsters, vehicles, and any type the level's specials ask about or act on
+// always update.  A special that asks about any goodguy, badguy or the like
+// can mean a monster of any type, so then nothing dozes.  Parts of a monster
+// (tails, segments) go with whatever the monster they belong to does.
+
+static byte dozeExempt[NUM_MONSTERS];
+static dword dozeClock;
+
+static void ExemptType(int type)
+{
+	switch(type)
+	{
+		case MONS_GOODGUY:
+		case MONS_BADGUY:
+		case MONS_ANYBODY:
+		case MONS_NONPLAYER:
+			memset(dozeExempt,1,sizeof(dozeExempt));	// friendliness goes by the guy, not the type
+			break;
+		case MONS_TAGGED:
+		case MONS_PLAYER:
+			break;	// never doze anyway
+		default:
+			if(type>0 && type<NUM_MONSTERS)
+				dozeExempt[type]=1;
+			break;
+	}
+}
+
+void InitGuyDozing(Map *map)
+{
+	int i,j;
+	special_t *s;
+
+	dozeClock=0;	// so who dozes when plays out the same from the level's start
+	memset(dozeExempt,0,sizeof(dozeExempt));
+	for(i=1;i<NUM_MONSTERS;i++)
+		if(GetMonsterType(i)->theme&(MT_BOSS|MT_MINIBOSS))
+			dozeExempt[i]=1;
+
+	for(i=0;i<MAX_SPECIAL;i++)
+	{
+		s=&map->special[i];
+		if(s->x==255)
+			continue;
+		for(j=0;j<NUM_TRIGGERS;j++)
+			switch(s->trigger[j].type)
+			{
+				case TRG_STEP:
+				case TRG_STEPRECT:
+				case TRG_STEPTILE:
+				case TRG_MONSTER:
+				case TRG_KILL:
+				case TRG_LIFE:
+				case TRG_AWAKE:
+				case TRG_MONSINRECT:
+				case TRG_MONSCOLOR:
+					ExemptType(s->trigger[j].value);
+					break;
+			}
+		for(j=0;j<NUM_EFFECTS;j++)
+			switch(s->effect[j].type)
+			{
+				case EFF_KILLMONS:
+				case EFF_CHANGETEAM:
+				case EFF_LIFE:
+				case EFF_TAGMONS:
+				case EFF_MONSITEM:
+				case EFF_LIFEAMT:
+				case EFF_NAME:
+				case EFF_COLOR:
+				case EFF_MONSBRIGHT:
+				case EFF_MONSGRAPHICS:
+				case EFF_SUMMON:
+					ExemptType(s->effect[j].value);
+					break;
+				case EFF_CHANGEMONS:
+				case EFF_AI:
+					ExemptType(s->effect[j].value);
+					ExemptType(s->effect[j].value2);
+					break;
+			}
+	}
+}
+
+byte Dozing(Guy *me)
+{
+	int i;
+
+	for(i=0;i<8 && me->parent && me->parent!=me;i++)
+		me=me->parent;
+
+	if(me->aiType==MONS_BOUAPHA || me->hp==0 || dozeExempt[me->type] || me==TaggedMonster() ||
+		me->aiType==MONS_MINECART || me->aiType==MONS_RAFT || me->aiType==MONS_YUGO)
+		return 0;
+	if(abs(me->mapx-goodguy->mapx)<=config.simRadius && abs(me->mapy-goodguy->mapy)<=config.simRadius)
+		return 0;
+	return ((dozeClock+me->ID)%config.simPeriod)!=0;
+}
 
 byte oldPlayAs;
 
+static int LiveGuys(void)
+{
+	int i,n;
+
+	n=0;
+	for(i=0;i<maxGuys;i++)
+		if(guys[i]->type)
+			n++;
+	return n;
+}
+
 void InitGuys(int max)
 {
 	int i;
@@ -1124,8 +1255,10 @@ void InitGuys(int max)
 	guys=(Guy **)malloc(sizeof(Guy *)*maxGuys);
 	for(i=0;i<maxGuys;i++)
 		guys[i]=new Guy();
+	InitThink(maxGuys);
 	goodguy=NULL;
 	oldPlayAs=profile.playAs;
+	PerfWatch("guys alive",LiveGuys);
 }
 
 void ExitGuys(void)
@@ -1134,16 +1267,20 @@ void ExitGuys(void)
 
 	for(i=0;i<maxGuys;i++)
 		delete guys[i];
+	ExitThink();
 
 	free(changed);
 	free(guys);
 	profile.playAs=oldPlayAs;
+	PerfWatch("guys alive",NULL);
 }
 
 void UpdateGuys(Map *map,world_t *world)
 {
 	int i;
+	byte doze;
 	static byte speedClock=0;
+	PERF_SCOPE("guys");
 
 	speedClock++;
 
@@ -1236,9 +1373,20 @@ void UpdateGuys(Map *map,world_t *world)
 			player.combo=0;
 	}
 	ShouldCheckControls(1);
+	if(map->flags&MAP_FLOWCHASE)
+		UpdateFlowField(map,world);
+	doze=(map->flags&MAP_SIMLOD) && goodguy;
+	dozeClock++;
+	ThinkAll(map,world,doze);
 	for(i=0;i<maxGuys;i++)
 		if(guys[i]->type!=MONS_NONE)
 		{
+			if(doze && Dozing(guys[i]))
+			{
+				guyUpdatesDozed++;
+				continue;
+			}
+			guyUpdatesRun++;
 			if(guys[i]->aiType==MONS_BOUAPHA && player.speed>0)
 			{
 				guys[i]->Update(map,world);
@@ -2481,20 +2629,32 @@ void KillMonster(int x,int y,int type,byte nofx)
 			if(guys[i]->type==MONS_ZOMBIE || guys[i]->type==MONS_MUTANT)	// zombies always drop a brain
 			{
 				if(!curMap->DropItem(guys[i]->mapx,guys[i]->mapy,ITM_BRAIN))
+				{
 					curMap->GetTile(guys[i]->mapx,guys[i]->mapy)->item=ITM_BRAIN;	// force the drop if it failed
+					TileBitsChanged(curMap->GetTile(guys[i]->mapx,guys[i]->mapy));
+				}
 			}
 			else if(guys[i]->type==MONS_SUPERZOMBIE)	// super zombies always drop 2 brains
 			{
 				if(!curMap->DropItem(guys[i]->mapx,guys[i]->mapy,ITM_BRAIN))
+				{
 					curMap->GetTile(guys[i]->mapx,guys[i]->mapy)->item=ITM_BRAIN;	// force the drop if it failed
+					TileBitsChanged(curMap->GetTile(guys[i]->mapx,guys[i]->mapy));
+				}
 				if(!curMap->DropItem(guys[i]->mapx,guys[i]->mapy+1,ITM_BRAIN) && guys[i]->mapy+1<curMap->height)
+				{
 					curMap->GetTile(guys[i]->mapx,guys[i]->mapy+1)->item=ITM_BRAIN;	// hope there's a legal coordinate and non-wall below me!
+					TileBitsChanged(curMap->GetTile(guys[i]->mapx,guys[i]->mapy+1));
+				}
 			}
 			if(guys[i]->aiType==MONS_GNOME)
 			{
 				if(guys[i]->mind3!=0)	// drop what you stole!
 					if(!curMap->DropItem(guys[i]->mapx,guys[i]->mapy,guys[i]->mind3))
+					{
 						curMap->GetTile(guys[i]->mapx,guys[i]->mapy)->item=guys[i]->mind3;	// force the drop if it failed
+						TileBitsChanged(curMap->GetTile(guys[i]->mapx,guys[i]->mapy));
+					}
 			}
 
 			if(guys[i]->item==ITM_RANDOM)
@@ -2505,7 +2665,10 @@ void KillMonster(int x,int y,int type,byte nofx)
 			else if(guys[i]->item!=ITM_NONE)
 			{
 				if(!curMap->DropItem(guys[i]->mapx,guys[i]->mapy,guys[i]->item))
+				{
 					curMap->GetTile(guys[i]->mapx,guys[i]->mapy)->item=guys[i]->item;	// force the drop if it failed
+					TileBitsChanged(curMap->GetTile(guys[i]->mapx,guys[i]->mapy));
+				}
 			}
 			if(!nofx)
 				BlowUpGuy((guys[i]->x>>FIXSHIFT)-32,(guys[i]->y>>FIXSHIFT)-24,
@@ -2735,18 +2898,8 @@ void SetMonsterGraphics(byte fx,int x,int y,int type,char *name)
 			char buf[64];
 			sprintf(buf,"user/%s", name);
 
-			if (guys[i]->customSpr) delete guys[i]->customSpr;
-
-			sprite_set_t* spr = new sprite_set_t();
-			if (spr->Load(buf))
-			{
-				guys[i]->customSpr = spr;
-			}
-			else
-			{
-				delete spr;
-				guys[i]->customSpr = NULL;
-			}
+			FreeCustomSprites(guys[i]->customSpr);
+			guys[i]->customSpr = LoadCustomSprites(buf);
 		}
 	}
 }
@@ -3117,6 +3270,7 @@ void ChangeMonsItem(byte fx,int x,int y,int type,int newItem)
 				curMap->GetTile(guys[i]->mapx,guys[i]->mapy)->item=newItem;
 				TriggerItem(guys[i],curMap->GetTile(guys[i]->mapx,guys[i]->mapy),guys[i]->mapx,guys[i]->mapy);
 				curMap->GetTile(guys[i]->mapx,guys[i]->mapy)->item=oldItem;
+				TileBitsChanged(curMap->GetTile(guys[i]->mapx,guys[i]->mapy));
 			}
 			else
 				guys[i]->item=newItem;
@@ -3596,20 +3750,32 @@ void Telefrag(Guy *g)
 				if(guys[i]->type==MONS_ZOMBIE || guys[i]->type==MONS_MUTANT)	// zombies always drop a brain
 				{
 					if(!curMap->DropItem(guys[i]->mapx,guys[i]->mapy,ITM_BRAIN))
+					{
 						curMap->GetTile(guys[i]->mapx,guys[i]->mapy)->item=ITM_BRAIN;	// force the drop if it failed
+						TileBitsChanged(curMap->GetTile(guys[i]->mapx,guys[i]->mapy));
+					}
 				}
 				else if(guys[i]->type==MONS_SUPERZOMBIE)	// super zombies always drop 2 brains
 				{
 					if(!curMap->DropItem(guys[i]->mapx,guys[i]->mapy,ITM_BRAIN))
+					{
 						curMap->GetTile(guys[i]->mapx,guys[i]->mapy)->item=ITM_BRAIN;	// force the drop if it failed
+						TileBitsChanged(curMap->GetTile(guys[i]->mapx,guys[i]->mapy));
+					}
 					if(!curMap->DropItem(guys[i]->mapx,guys[i]->mapy+1,ITM_BRAIN) && guys[i]->mapy+1<curMap->height)
+					{
 						curMap->GetTile(guys[i]->mapx,guys[i]->mapy+1)->item=ITM_BRAIN;	// hope there's a legal coordinate and non-wall below me!
+						TileBitsChanged(curMap->GetTile(guys[i]->mapx,guys[i]->mapy+1));
+					}
 				}
 				if(guys[i]->aiType==MONS_GNOME)
 				{
 					if(guys[i]->mind3!=0)	// drop what you stole!
 						if(!curMap->DropItem(guys[i]->mapx,guys[i]->mapy,guys[i]->mind3))
+						{
 							curMap->GetTile(guys[i]->mapx,guys[i]->mapy)->item=guys[i]->mind3;	// force the drop if it failed
+							TileBitsChanged(curMap->GetTile(guys[i]->mapx,guys[i]->mapy));
+						}
 				}
 				if(guys[i]->item==ITM_RANDOM)
 				{
@@ -3619,7 +3785,10 @@ void Telefrag(Guy *g)
 				else if(guys[i]->item!=ITM_NONE)
 				{
 					if(!curMap->DropItem(guys[i]->mapx,guys[i]->mapy,guys[i]->item))
+					{
 						curMap->GetTile(guys[i]->mapx,guys[i]->mapy)->item=guys[i]->item;	// force the drop if it failed
+						TileBitsChanged(curMap->GetTile(guys[i]->mapx,guys[i]->mapy));
+					}
 				}
 
 				guys[i]->type=MONS_NONE;
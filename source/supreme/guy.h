@@ -72,10 +72,14 @@ class Guy
 };
 
 extern Guy *goodguy;
+extern dword guyUpdatesRun,guyUpdatesDozed;	// how many guy updates ran and were skipped for dozing
+extern dword canWalkCalls;	// how many times a guy checked where it could step
 
 void InitGuys(int max);
 void ExitGuys(void);
 void UpdateGuys(Map *map,world_t *world);
+void InitGuyDozing(Map *map);	// after the specials are in, for MAP_SIMLOD
+byte Dozing(Guy *me);	// on MAP_SIMLOD levels, whether it sits this tick out
 void EditorUpdateGuys(Map *map);
 void RenderGuys(byte light);
 Guy *AddGuy(int x,int y,int z,int type,byte friendly);
@@ -113,7 +117,7 @@ Guy *GetGuyOfType(int type);
 void RemoveGuy(Guy *g);
 void Telefrag(Guy *g);
 byte FreezeGuy(Guy *me);
-byte TryToPushItem(int x,int y,int destx,int desty,Map *map,world_t *world);
+byte TryToPushItem(int x,int y,int destx,int desty,Map *map);
 void ChangeMonster(byte fx,int x,int y,int type,int newtype);
 void ChangeMonsterAI(byte fx,int x,int y,int type,int newtype);
 void ChangeTeam(byte fx,int x,int y,int type,byte team);
@@ -0,0 +1,480 @@
+#include "headless.h"
+#include "game.h"
+#include "editor.h"
+#include "progress.h"
+#include "config.h"
+#include "control.h"
+#include "appdata.h"
+#include "trace.h"
+#include "tilebits.h"
+#include <vector>
+
+// the replay file starts with one text line:
+//   SUPREPLAY 1 <level> <seed> <world>
+// then has one byte of GetControls() per tick
+#define REPLAY_VERSION	1
+
+extern Guy **guys;
+extern int maxGuys;
+extern bullet_t *bullet;
+
+extern byte mapToGoTo;
+
+static std::vector<byte> input;
+static FILE *recFile;
+static dword tick;
+static dword stateSum;
+static int bulletHell;
+static dword walkBenchCalls;
+static Uint64 walkBenchTime;
+
+byte BenchArgs(int argc,char *argv[],benchOpt_t *opt)
+{
+	int i;
+	byte want;
+
+	memset(opt,0,sizeof(benchOpt_t));
+	opt->seed=1;
+	opt->simLod=-1;
+	opt->flowChase=-1;
+	want=0;
+	for(i=1;i<argc;i++)
+	{
+		if(!strcmp(argv[i],"bench"))
+			want=1;
+		else if(!strcmp(argv[i],"record"))
+		{
+			want=1;
+			opt->record=1;
+		}
+		else if(!strcmp(argv[i],"render"))
+			opt->render=1;
+		else if(!strncmp(argv[i],"world=",6))
+			SDL_strlcpy(opt->world,&argv[i][6],sizeof(opt->world));
+		else if(!strncmp(argv[i],"replay=",7))
+			SDL_strlcpy(opt->replay,&argv[i][7],sizeof(opt->replay));
+		else if(!strncmp(argv[i],"level=",6))
+			opt->level=(byte)atoi(&argv[i][6]);
+		else if(!strncmp(argv[i],"ticks=",6))
+			opt->ticks=strtoul(&argv[i][6],NULL,10);
+		else if(!strncmp(argv[i],"seed=",5))
+			opt->seed=strtoul(&argv[i][5],NULL,10);
+		else if(!strncmp(argv[i],"simlod=",7))
+			opt->simLod=(atoi(&argv[i][7])!=0);
+		else if(!strncmp(argv[i],"threads=",8))
+			opt->threads=atoi(&argv[i][8]);
+		else if(!strncmp(argv[i],"bullethell=",11))
+			opt->bulletHell=atoi(&argv[i][11]);
+		else if(!strncmp(argv[i],"walkers=",8))
+			opt->walkers=atoi(&argv[i][8]);
+		else if(!strncmp(argv[i],"walkbench=",10))
+			opt->walkBench=atoi(&argv[i][10]);
+		else if(!strncmp(argv[i],"flowchase=",10))
+			opt->flowChase=(atoi(&argv[i][10])!=0);
+		else if(!strncmp(argv[i],"view=",5))
+			sscanf(&argv[i][5],"%dx%d",&opt->viewWidth,&opt->viewHeight);
+	}
+	return want;
+}
+
+static byte LoadReplay(benchOpt_t *opt)
+{
+	FILE *f;
+	int ver,level,c;
+	unsigned long seed;
+	char line[64];
+
+	f=AppdataOpen(opt->replay,"rb");
+	if(!f)
+		return 0;
+	if(fscanf(f,"SUPREPLAY %d %d %lu ",&ver,&level,&seed)!=3 || ver!=REPLAY_VERSION ||
+		!fgets(line,sizeof(line),f))
+	{
+		fclose(f);
+		return 0;
+	}
+	line[strcspn(line,"\r\n")]='\0';
+	SDL_strlcpy(opt->world,line,sizeof(opt->world));
+	opt->level=(byte)level;
+	opt->seed=seed;
+
+	input.clear();
+	while((c=fgetc(f))!=EOF)
+		input.push_back((byte)c);
+	fclose(f);
+	return 1;
+}
+
+//--------------------------------------------------------------------------
+// state checksum, FNV-1a over everything that should come out the same
+
+static void Sum(int v)
+{
+	int i;
+
+	for(i=0;i<4;i++)
+	{
+		stateSum^=(byte)(v>>(i*8));
+		stateSum*=16777619u;
+	}
+}
+
+static dword StateChecksum(void)
+{
+	int i;
+
+	stateSum=2166136261u;
+	for(i=0;i<maxGuys;i++)
+		if(guys[i]->type)
+		{
+			Sum(i);
+			Sum(guys[i]->type);
+			Sum(guys[i]->x);
+			Sum(guys[i]->y);
+			Sum(guys[i]->z);
+			Sum(guys[i]->dx);
+			Sum(guys[i]->dy);
+			Sum(guys[i]->dz);
+			Sum(guys[i]->hp);
+			Sum(guys[i]->facing);
+			Sum(guys[i]->seq);
+			Sum(guys[i]->frm);
+			Sum(guys[i]->action);
+			Sum(guys[i]->mind);
+			Sum(guys[i]->mind1);
+			Sum(guys[i]->mind2);
+			Sum(guys[i]->mind3);
+			Sum(guys[i]->reload);
+		}
+	for(i=0;i<config.numBullets;i++)
+		if(bullet[i].type)
+		{
+			Sum(i);
+			Sum(bullet[i].type);
+			Sum(bullet[i].x);
+			Sum(bullet[i].y);
+			Sum(bullet[i].z);
+			Sum(bullet[i].timer);
+			Sum(bullet[i].facing);
+			Sum(bullet[i].target);
+		}
+	Sum(player.life);
+	Sum(player.brains);
+	Sum(player.candles);
+	Sum(player.coins);
+	Sum(player.score);
+	Sum(player.weapon);
+	Sum(player.ammo);
+	Sum(player.kills);
+	for(i=0;i<4;i++)
+		Sum(player.keys[i]);
+	for(i=0;i<curMap->width*curMap->height;i++)
+	{
+		Sum(curMap->map[i].floor);
+		Sum(curMap->map[i].wall);
+		Sum(curMap->map[i].item);
+	}
+	return stateSum;
+}
+
+//--------------------------------------------------------------------------
+
+// the player's share of a bullet hell, a ring that turns a bit each tick
+static void BulletHell(void)
+{
+	int i;
+
+	for(i=0;i<bulletHell;i++)
+		FireBullet(goodguy->x,goodguy->y,(byte)(i*256/bulletHell+tick*7),BLT_ENERGY,goodguy->friendly);
+}
+
+static byte BenchTick(MGLDraw *mgl)
+{
+	byte c;
+
+	TraceFrame();	// headless never flips, so mark the ticks instead
+	if(!mgl->Process())
+	{
+		mapToGoTo=255;
+		return WORLD_ABORT;
+	}
+
+	if(recFile)
+	{
+		ForceControls(-1);
+		c=GetControls();
+		fputc(c,recFile);
+	}
+	else if(tick<input.size())
+		c=input[tick];
+	else
+		c=0;
+	ForceControls(c);	// recording too, so taps work out exactly as they will on replay
+	if(bulletHell && goodguy)
+		BulletHell();
+	tick++;
+
+	return LunaticUpdate();
+}
+
+// a crowd of boneheads on open ground away from the player, spread out the
+// same way every time
+static void AddWalkers(int n)
+{
+	int pos,tries,size,x,y;
+
+	size=curMap->width*curMap->height;
+	pos=0;
+	for(tries=0;tries<size && n>0;tries++)
+	{
+		pos=(pos+7919)%size;
+		x=pos%curMap->width;
+		y=pos/curMap->width;
+		if(goodguy && abs(x-goodguy->mapx)<8 && abs(y-goodguy->mapy)<8)
+			continue;
+		if(!TileBit(curMap,TB_PLAIN,x,y))
+			continue;
+		if(AddGuy((x*TILE_WIDTH+TILE_WIDTH/2)*FIXAMT,(y*TILE_HEIGHT+TILE_HEIGHT/2)*FIXAMT,0,MONS_BONEHEAD,0))
+			n--;
+	}
+}
+
+// every guy checks where it stands and a step each way, reps times over
+static void WalkBench(int reps)
+{
+	int r,i,d;
+	dword oldCalls;
+	Uint64 t;
+	static const int ox[9]={0,1,-1,0,0,1,1,-1,-1},oy[9]={0,0,0,1,-1,1,-1,1,-1};
+
+	oldCalls=canWalkCalls;
+	t=SDL_GetPerformanceCounter();
+	for(r=0;r<reps;r++)
+		for(i=0;i<maxGuys;i++)
+			if(guys[i]->type!=MONS_NONE && guys[i]->hp>0)
+				for(d=0;d<9;d++)
+				{
+					guys[i]->CanWalk(guys[i]->x+ox[d]*4*FIXAMT,guys[i]->y+oy[d]*4*FIXAMT,curMap,&curWorld);
+					walkBenchCalls++;
+				}
+	walkBenchTime+=SDL_GetPerformanceCounter()-t;
+	canWalkCalls=oldCalls;	// the report's count is the game's own
+}
+
+static byte BenchLevel(MGLDraw *mgl,byte map,benchOpt_t *opt)
+{
+	byte result;
+	int lastTime;
+	Uint64 t;
+
+	if(!InitLevel(map))
+	{
+		mapToGoTo=255;
+		return LEVEL_ABORT;
+	}
+
+	if(opt->simLod==1)
+		curMap->flags|=MAP_SIMLOD;
+	else if(opt->simLod==0)
+		curMap->flags&=~MAP_SIMLOD;
+	if(opt->flowChase==1)
+		curMap->flags|=MAP_FLOWCHASE;
+	else if(opt->flowChase==0)
+		curMap->flags&=~MAP_FLOWCHASE;
+	if(opt->walkers>0)
+		AddWalkers(opt->walkers);
+	result=LEVEL_PLAYING;
+	UpdateGuys(curMap,&curWorld);	// puts the camera in place, as PlayALevel does
+	lastTime=1;
+	while(result==LEVEL_PLAYING && tick<opt->ticks)
+	{
+		if(opt->record)
+		{
+			// real time, just like PlayALevel
+			lastTime+=TimeLength();
+			StartClock();
+			if(lastTime>TIME_PER_FRAME*5)
+				lastTime=TIME_PER_FRAME*5;
+			while(lastTime>=TIME_PER_FRAME && result==LEVEL_PLAYING)
+			{
+				lastTime-=TIME_PER_FRAME;
+				result=BenchTick(mgl);
+			}
+			if(result==LEVEL_PLAYING)
+				LunaticDraw();
+			if(mgl->LastKeyPressed()==27)
+			{
+				mapToGoTo=255;
+				result=WORLD_ABORT;
+			}
+			EndClock();
+		}
+		else
+		{
+			result=BenchTick(mgl);
+			if(opt->render && result==LEVEL_PLAYING)
+			{
+				t=SDL_GetPerformanceCounter();
+				LunaticDraw();
+				tickTime[TT_DRAW]+=SDL_GetPerformanceCounter()-t;
+			}
+		}
+	}
+	stateSum=StateChecksum();
+	if(opt->walkBench>0 && result==LEVEL_PLAYING)
+		WalkBench(opt->walkBench);	// out of ticks, so nothing after this counts
+	if(result==LEVEL_WIN)
+		PlayerWinLevel(0);
+	ExitLevel();
+	return result;
+}
+
+static void BenchReport(benchOpt_t *opt,Uint64 total)
+{
+	double freq;
+	int i;
+
+	freq=(double)SDL_GetPerformanceFrequency();
+	printf("%s level %d seed %lu view %dx%d: %lu ticks in %.1f ms (%.0f ticks/sec)\n",opt->world,opt->level,(unsigned long)opt->seed,
+		viewWid,viewHei,(unsigned long)tick,total*1000.0/freq,tick ? tick/(total/freq) : 0.0);
+	for(i=0;i<TT_MAX;i++)
+		if(i!=TT_DRAW || opt->render)
+			printf("  %-10s %10.2f ms %8.2f us/tick\n",tickTimeName[i],tickTime[i]*1000.0/freq,tick ? tickTime[i]*1000000.0/freq/tick : 0.0);
+	printf("  guy updates %lu run, %lu dozed, %.3f us each\n",(unsigned long)guyUpdatesRun,(unsigned long)guyUpdatesDozed,
+		guyUpdatesRun ? tickTime[TT_GUYS]*1000000.0/freq/guyUpdatesRun : 0.0);
+	printf("  CanWalk calls %lu\n",(unsigned long)canWalkCalls);
+	printf("  bullet updates %lu, %.3f us each\n",(unsigned long)bulletUpdatesRun,
+		bulletUpdatesRun ? tickTime[TT_BULLETS]*1000000.0/freq/bulletUpdatesRun : 0.0);
+	if(walkBenchCalls)
+		printf("  CanWalk bench %lu calls, %.2f million a second\n",(unsigned long)walkBenchCalls,
+			walkBenchTime ? walkBenchCalls/(walkBenchTime/freq)/1000000.0 : 0.0);
+	if(config.thinkThreads>0)
+		printf("  parallel think on %d threads\n",config.thinkThreads);
+	printf("  checksum %08lx\n",(unsigned long)stateSum);
+	fflush(stdout);
+}
+
+// one go at the world, from loading it to the report
+static int BenchRun(MGLDraw *mgl,benchOpt_t *opt)
+{
+	char fullName[64];
+	byte map,result;
+	Uint64 start;
+
+	MGL_srand(opt->seed);
+
+	sprintf(fullName,"worlds/%s",opt->world);
+	if(!LoadWorld(&curWorld,fullName))
+	{
+		printf("can't load %s\n",fullName);
+		return 1;
+	}
+
+	// play it the way the editor's test does, so no real progress gets touched
+	editing=2;
+	ClearTestProgress();
+	InitWorld(&curWorld);
+	GetWorldProgress("TEST")->levelOn=opt->level;
+	InitPlayer(opt->level,"TEST");
+	SetPlayerStart(-1,-1);
+
+	ResetTickTimes();
+	guyUpdatesRun=0;
+	guyUpdatesDozed=0;
+	canWalkCalls=0;
+	bulletUpdatesRun=0;
+	walkBenchCalls=0;
+	walkBenchTime=0;
+	tick=0;
+	stateSum=0;
+	map=opt->level;
+	start=SDL_GetPerformanceCounter();
+	while(tick<opt->ticks)
+	{
+		result=BenchLevel(mgl,map,opt);
+		if(result==LEVEL_ABORT)
+		{
+			if(mapToGoTo<255)
+				map=mapToGoTo;
+			else
+				break;
+		}
+		else if(result==LEVEL_WIN)
+			map=mapToGoTo;
+		else if(result!=LEVEL_RESET)
+			break;	// out of ticks, or the world is over
+	}
+	BenchReport(opt,SDL_GetPerformanceCounter()-start);
+
+	ForceControls(-1);
+	FreeWorld(&curWorld);
+	editing=0;
+	return 0;
+}
+
+int RunBench(MGLDraw *mgl,benchOpt_t *opt)
+{
+	int i,err,oldThreads,oldBullets;
+
+	input.clear();
+	recFile=NULL;
+	if(opt->record)
+	{
+		if(!opt->replay[0] || !opt->world[0])
+		{
+			printf("record needs world= and replay=\n");
+			return 1;
+		}
+		recFile=AppdataOpen(opt->replay,"wb");
+		if(!recFile)
+		{
+			printf("can't write %s\n",opt->replay);
+			return 1;
+		}
+		fprintf(recFile,"SUPREPLAY %d %d %lu %s\n",REPLAY_VERSION,opt->level,(unsigned long)opt->seed,opt->world);
+		if(opt->ticks==0)
+			opt->ticks=0xFFFFFFFF;
+	}
+	else
+	{
+		if(opt->replay[0] && !LoadReplay(opt))
+		{
+			printf("can't read replay %s\n",opt->replay);
+			return 1;
+		}
+		if(opt->ticks==0)
+			opt->ticks=input.empty() ? 30*60 : (dword)input.size();
+	}
+
+	if(opt->viewWidth>0 && opt->viewHeight>0)
+	{
+		config.viewWidth=opt->viewWidth;
+		config.viewHeight=opt->viewHeight;
+	}
+	headless=!opt->record;
+	bulletHell=opt->record ? 0 : opt->bulletHell;
+	oldBullets=config.numBullets;
+	if(config.numBullets<bulletHell*32)
+		config.numBullets=bulletHell*32;	// an energy ball lasts 30 ticks
+	if(opt->threads>0 && !opt->record)
+	{
+		// the same run on 1 to N threads, to see how the parallel think scales
+		oldThreads=config.thinkThreads;
+		err=0;
+		for(i=1;i<=opt->threads && !err;i++)
+		{
+			config.thinkThreads=i;
+			err=BenchRun(mgl,opt);
+		}
+		config.thinkThreads=oldThreads;
+	}
+	else
+		err=BenchRun(mgl,opt);
+
+	if(recFile)
+		fclose(recFile);
+	headless=0;
+	bulletHell=0;
+	config.numBullets=oldBullets;
+	return err;
+}
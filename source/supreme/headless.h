@@ -0,0 +1,53 @@
+#ifndef HEADLESS_H
+#define HEADLESS_H
+
+#include "mgldraw.h"
+
+// Running a world from the command line, for checking that a change didn't
+// alter gameplay and for timing it:
+//   bench world=foo.dlw [level=n] [ticks=n] [seed=n] [replay=file] [render] [view=WxH] [simlod=0|1] [flowchase=0|1] [threads=n] [bullethell=n]
+//         [walkers=n] [walkbench=n]
+//     runs with no window or sound, as fast as it can, then prints where the
+//     time went and a checksum of the game state.  With a replay, the world,
+//     level and seed come from the replay and the controls are fed from it.
+//     view= overrides the config's view size, to time drawing at that size.
+//     simlod= turns far monster dozing on or off for every level, whatever the
+//     level's flag says, so a busy map can be timed both ways.
+//     flowchase= does the same for walkers chasing along the flow field.
+//     threads= runs it all n times, with the parallel think on 1 thread, then
+//     2, and so on up to n, so the reports show how it scales.  The
+//     checksums should all match.
+//     bullethell= has the player shoot n energy balls a tick in a turning
+//     ring, with the bullet list made big enough to hold them all, to time
+//     bullets when there are lots of them.
+//     walkers= adds n boneheads to each level, spread over its open ground, to
+//     time lots of walking (with flowchase=1, lots of walking the right way).
+//     walkbench= times CanWalk by itself once the run is out of ticks: every
+//     guy checks where it stands and a step each way, n times over.  That's
+//     after the checksum, so whatever it sets off doesn't change it.
+//   record world=foo.dlw [level=n] [seed=n] replay=file
+//     plays normally in a window, writing the controls to the replay.  Esc stops.
+// Add trace=file.json to either to save a Chrome trace of the run, see trace.h.
+
+typedef struct benchOpt_t
+{
+	char world[32];
+	byte level;
+	dword ticks;	// 0 = as long as the replay, or a minute
+	dword seed;
+	char replay[64];
+	byte record;
+	byte render;	// draw every tick too (headless, so it's never shown)
+	int viewWidth,viewHeight;	// 0 = what the config says
+	char simLod;	// -1 = as each level says
+	char flowChase;	// likewise
+	int threads;	// 0 = just once, as the config says
+	int bulletHell;	// bullets fired a tick, 0 = none
+	int walkers;	// boneheads added to each level
+	int walkBench;	// times over for the CanWalk timing, 0 = none
+} benchOpt_t;
+
+byte BenchArgs(int argc,char *argv[],benchOpt_t *opt);	// 1 if the command line asks for one
+int RunBench(MGLDraw *mgl,benchOpt_t *opt);
+
+#endif
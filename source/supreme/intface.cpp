@@ -171,6 +171,8 @@ void ExitInterface(void)
 
 void ResetInterface(void)
 {
+	int i;
+
 	comboY=-22;
 	curCombo=0;
 	intfFlip=0;
@@ -178,6 +180,20 @@ void ResetInterface(void)
 	monsTimer=0;
 	curBrains=0;
 	memcpy(intf,defaultSetup,sizeof(intface_t)*NUM_INTF);
+	// the setup is for 640x480, so whatever hangs off the right or bottom goes with that edge
+	for(i=0;i<NUM_INTF;i++)
+	{
+		if(intf[i].tx>=SCRWID/2)
+		{
+			intf[i].x+=viewWid-SCRWID;
+			intf[i].tx+=viewWid-SCRWID;
+		}
+		if(intf[i].ty>=SCRHEI/2)
+		{
+			intf[i].y+=viewHei-SCRHEI;
+			intf[i].ty+=viewHei-SCRHEI;
+		}
+	}
 }
 
 void DrawLifeMeter(int x,int y,byte amt)
@@ -321,12 +337,12 @@ void ShowEnemyLife(char *name,byte formerLife,byte life,byte alive)
 	strcpy(monsName,name);
 	monsTimer=90;	// 3 seconds
 	monsAlive=alive;
-	intf[INTF_ENEMY].ty=479;
+	intf[INTF_ENEMY].ty=viewHei-1;
 }
 
 void RenderRage(byte size,MGLDraw *mgl)
 {
-	intfaceSpr->GetSprite(SPR_RAGE+size)->Draw(320,240,mgl);
+	intfaceSpr->GetSprite(SPR_RAGE+size)->Draw(viewWid/2,viewHei/2,mgl);
 }
 
 void DrawBigMeter(int x,int y,int value,int length,MGLDraw *mgl)
@@ -488,7 +504,7 @@ void DrawPULightning(int x,int y,int height,byte color,MGLDraw *mgl)
 		db=-1;
 	for(i=0;i<height;i++)
 	{
-		if(x+x2>=0 && x+x2<639 && y>=0 && y<480)
+		if(x+x2>=0 && x+x2<viewWid-1 && y>=0 && y<viewHei)
 		{
 			scrn[x2]=color+b;
 			scrn[x2+1]=color+b;
@@ -713,35 +729,35 @@ void UpdateInterface(Map *map)
 	// now do the same stuff for the other side of the screen
 	if(player.brains>=map->numBrains)
 	{
-		intf[INTF_BRAINS].tx=640+30;
+		intf[INTF_BRAINS].tx=viewWid+30;
 		intf[INTF_BRAINS].ty=25;
 	}
 	else
 	{
-		intf[INTF_BRAINS].tx=639;
+		intf[INTF_BRAINS].tx=viewWid-1;
 		intf[INTF_BRAINS].ty=25;
 	}
 	if(player.weapon)
 	{
-		intf[INTF_WEAPON].tx=639;
+		intf[INTF_WEAPON].tx=viewWid-1;
 		intf[INTF_WEAPON].ty=9;
 	}
 	else
 	{
-		intf[INTF_WEAPON].tx=639;
+		intf[INTF_WEAPON].tx=viewWid-1;
 		intf[INTF_WEAPON].ty=-10;
 		intf[INTF_BRAINS].ty-=10;
 	}
 
 	if(player.coins)
 	{
-		intf[INTF_COINS].tx=639;
-		intf[INTF_COINS].ty=479;
+		intf[INTF_COINS].tx=viewWid-1;
+		intf[INTF_COINS].ty=viewHei-1;
 	}
 	else
 	{
-		intf[INTF_COINS].tx=639;
-		intf[INTF_COINS].ty=480+20;
+		intf[INTF_COINS].tx=viewWid-1;
+		intf[INTF_COINS].ty=viewHei+20;
 	}
 
 	intfFlip=1-intfFlip;
@@ -814,12 +830,12 @@ void UpdateInterface(Map *map)
 					}
 					intf[i].vDesired=curMonsLife*intf[i].valueLength/128;
 					intf[i].value=curMonsLife*intf[i].valueLength/128;
-					intf[i].ty=479;
+					intf[i].ty=viewHei-1;
 				}
 				else
 				{
 					intf[i].vDesired=0;
-					intf[i].ty=479+30;
+					intf[i].ty=viewHei-1+30;
 				}
 				break;
 		}
@@ -860,21 +876,21 @@ void RenderInterface(MGLDraw *mgl)
 
 	if(shopping)	// special mutant interface when shopping
 	{
-		InstaRenderItem(639-TILE_WIDTH/2,479-8,ITM_COIN,0,mgl);
+		InstaRenderItem(viewWid-1-TILE_WIDTH/2,viewHei-1-8,ITM_COIN,0,mgl);
 		sprintf(combo,"%lu",profile.progress.totalCoins-profile.progress.coinsSpent);
-		Print(639-TILE_WIDTH-GetStrLength(combo,2)-1,479-18,combo,-32,2);
-		Print(639-TILE_WIDTH-GetStrLength(combo,2)+1,479-18,combo,-32,2);
-		Print(639-TILE_WIDTH-GetStrLength(combo,2),479-18+1,combo,-32,2);
-		Print(639-TILE_WIDTH-GetStrLength(combo,2),479-18-1,combo,-32,2);
-		PrintGlow(639-TILE_WIDTH-GetStrLength(combo,2),479-18,combo,0,2);
+		Print(viewWid-1-TILE_WIDTH-GetStrLength(combo,2)-1,viewHei-1-18,combo,-32,2);
+		Print(viewWid-1-TILE_WIDTH-GetStrLength(combo,2)+1,viewHei-1-18,combo,-32,2);
+		Print(viewWid-1-TILE_WIDTH-GetStrLength(combo,2),viewHei-1-18+1,combo,-32,2);
+		Print(viewWid-1-TILE_WIDTH-GetStrLength(combo,2),viewHei-1-18-1,combo,-32,2);
+		PrintGlow(viewWid-1-TILE_WIDTH-GetStrLength(combo,2),viewHei-1-18,combo,0,2);
 
-		InstaRenderItem(639-TILE_WIDTH/2,479-38,ITM_LOONYKEY,0,mgl);
+		InstaRenderItem(viewWid-1-TILE_WIDTH/2,viewHei-1-38,ITM_LOONYKEY,0,mgl);
 		sprintf(combo,"%lu",profile.progress.loonyKeys-profile.progress.loonyKeysUsed);
-		Print(639-TILE_WIDTH-GetStrLength(combo,2)-1,479-38,combo,-32,2);
-		Print(639-TILE_WIDTH-GetStrLength(combo,2)+1,479-38,combo,-32,2);
-		Print(639-TILE_WIDTH-GetStrLength(combo,2),479-38+1,combo,-32,2);
-		Print(639-TILE_WIDTH-GetStrLength(combo,2),479-38-1,combo,-32,2);
-		PrintGlow(639-TILE_WIDTH-GetStrLength(combo,2),479-38,combo,0,2);
+		Print(viewWid-1-TILE_WIDTH-GetStrLength(combo,2)-1,viewHei-1-38,combo,-32,2);
+		Print(viewWid-1-TILE_WIDTH-GetStrLength(combo,2)+1,viewHei-1-38,combo,-32,2);
+		Print(viewWid-1-TILE_WIDTH-GetStrLength(combo,2),viewHei-1-38+1,combo,-32,2);
+		Print(viewWid-1-TILE_WIDTH-GetStrLength(combo,2),viewHei-1-38-1,combo,-32,2);
+		PrintGlow(viewWid-1-TILE_WIDTH-GetStrLength(combo,2),viewHei-1-38,combo,0,2);
 		return;
 	}
 
@@ -935,7 +951,7 @@ void RenderInterface(MGLDraw *mgl)
 	}
 
 	sprintf(combo,"Combo x%d",curCombo);
-	PrintGlow(240,comboY,combo,0,2);
+	PrintGlow(viewWid/2-80,comboY,combo,0,2);
 }
 
 void RenderCollectedStuff(int x,int y,MGLDraw *mgl)
@@ -10,6 +10,8 @@
 #include "goal.h"
 #include "worldstitch.h"
 #include <ctype.h>
+#include "perf.h"
+#include "tilebits.h"
 
 item_t baseItems[]={
 	{"None",0,0,0,0,0,0,0,0,0,0,0,0,"",0},
@@ -1008,6 +1010,7 @@ word NumItems(void)
 void UpdateItems(void)
 {
 	glowism++;
+	PERF_SCOPE("items");
 
 	if(editing==1)
 	{
@@ -1257,6 +1260,7 @@ byte TriggerItem(Guy *me,mapTile_t *m,int x,int y)
 			ExplodeParticlesColor(items[m->item].effectAmt,(x*TILE_WIDTH+TILE_WIDTH/2)*FIXAMT,
 				(y*TILE_HEIGHT+TILE_HEIGHT/2)*FIXAMT,FIXAMT*5,8,8);
 			m->item=ITM_NONE;
+			TileBitsChanged(m);
 			return 1;
 			break;
 		case IE_HEAL:
@@ -1470,11 +1474,13 @@ byte TriggerItem(Guy *me,mapTile_t *m,int x,int y)
 			break;
 		case IE_BECOME:
 			m->item=items[m->item].effectAmt;
+			TileBitsChanged(m);
 			return 1;
 			break;
 		case IE_SUMMON:
 			AddGuy((x*TILE_WIDTH+TILE_WIDTH/2)*FIXAMT,(y*TILE_HEIGHT+TILE_HEIGHT/2)*FIXAMT,10*FIXAMT,items[m->item].effectAmt,2);
 			m->item=ITM_NONE;
+			TileBitsChanged(m);
 			return 1;
 			break;
 		case IE_POWERUP:
@@ -1512,6 +1518,7 @@ byte TriggerItem(Guy *me,mapTile_t *m,int x,int y)
 				if(items[m->item].effectAmt==0)	// yellow keys get used up
 					player.keys[items[m->item].effectAmt]--;
 				m->item=ITM_NONE;
+				TileBitsChanged(m);
 				ScoreEvent(SE_DOOR,1);
 				if(!editing && !player.cheated && verified)
 				{
@@ -1557,16 +1564,16 @@ byte TriggerItem(Guy *me,mapTile_t *m,int x,int y)
 					if(abs(bdx)>abs(bdy))
 					{
 						if(bdx>0)
-							i=TryToPushItem(x,y,x+1,y,curMap,&curWorld);
+							i=TryToPushItem(x,y,x+1,y,curMap);
 						else
-							i=TryToPushItem(x,y,x-1,y,curMap,&curWorld);
+							i=TryToPushItem(x,y,x-1,y,curMap);
 					}
 					else if(bdx!=0 && bdy!=0)	// don't do anything for non-moving bullets
 					{
 						if(bdy>0)
-							i=TryToPushItem(x,y,x,y+1,curMap,&curWorld);
+							i=TryToPushItem(x,y,x,y+1,curMap);
 						else
-							i=TryToPushItem(x,y,x,y-1,curMap,&curWorld);
+							i=TryToPushItem(x,y,x,y-1,curMap);
 					}
 				}
 				return i;
@@ -1609,16 +1616,16 @@ byte TriggerItem(Guy *me,mapTile_t *m,int x,int y)
 				switch(i)
 				{
 					case 0:
-						return TryToPushItem(x,y,x+1,y,curMap,&curWorld);
+						return TryToPushItem(x,y,x+1,y,curMap);
 						break;
 					case 1:
-						return TryToPushItem(x,y,x,y+1,curMap,&curWorld);
+						return TryToPushItem(x,y,x,y+1,curMap);
 						break;
 					case 2:
-						return TryToPushItem(x,y,x-1,y,curMap,&curWorld);
+						return TryToPushItem(x,y,x-1,y,curMap);
 						break;
 					case 3:
-						return TryToPushItem(x,y,x,y-1,curMap,&curWorld);
+						return TryToPushItem(x,y,x,y-1,curMap);
 						break;
 				}
 			}
@@ -1649,16 +1656,16 @@ void MoveMovableItem(int x,int y,Map *map,world_t *world)
 	switch(items[map->map[x+y*map->width].item].effectAmt)
 	{
 		case 0:
-			yes=TryToPushItem(x,y,x+1,y,curMap,&curWorld);
+			yes=TryToPushItem(x,y,x+1,y,curMap);
 			break;
 		case 1:
-			yes=TryToPushItem(x,y,x,y+1,curMap,&curWorld);
+			yes=TryToPushItem(x,y,x,y+1,curMap);
 			break;
 		case 2:
-			yes=TryToPushItem(x,y,x-1,y,curMap,&curWorld);
+			yes=TryToPushItem(x,y,x-1,y,curMap);
 			break;
 		case 3:
-			yes=TryToPushItem(x,y,x,y-1,curMap,&curWorld);
+			yes=TryToPushItem(x,y,x,y-1,curMap);
 			break;
 		default:
 			yes=0;
@@ -1709,6 +1716,7 @@ byte InteractWithItem(Guy *me,mapTile_t *m,int x,int y)
 
 			ItemGetEffect(x,y);
 			m->item=ITM_NONE;
+			TileBitsChanged(m);
 			EventOccur(EVT_GET,type,x,y,me);
 			return 1;
 		}
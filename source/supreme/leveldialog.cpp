@@ -37,7 +37,7 @@
 #define DLG_X		(100)
 #define DLG_Y		(60)
 #define DLG_X2		(639-100)
-#define DLG_Y2		(380)
+#define DLG_Y2		(412)
 
 static byte asking,yesNo;
 static char question[64];
@@ -47,7 +47,7 @@ static byte mapNum,mode;
 static world_t *world;
 
 static word flagNum[]={MAP_SNOWING,MAP_RAIN,MAP_HUB,MAP_SECRET,MAP_TORCHLIT,MAP_WELLLIT,
-				MAP_STARS,MAP_UNDERWATER,MAP_LAVA,MAP_STEALTH,MAP_WAVY,MAP_OXYGEN};
+				MAP_STARS,MAP_UNDERWATER,MAP_LAVA,MAP_STEALTH,MAP_WAVY,MAP_OXYGEN,MAP_SIMLOD,MAP_FLOWCHASE};
 static char flagName[][16]={
 	"Snowing",
 	"Raining",
@@ -61,6 +61,8 @@ static char flagName[][16]={
 	"Stealth",
 	"Wavy",
 	"Oxygen Meter",
+	"Far Mons Doze",
+	"Smart Chasers",
 };
 
 static byte *mapZoom;
@@ -361,18 +363,18 @@ void LevelDialogButtons(void)
 	sprintf(s,"%d",world->map[mapNum]->height);
 	MakeButton(BTN_STATIC,ID_STATIC,0,DLG_X2-211+162,DLG_Y2-240,50,15,s,NULL);
 
-	MakeButton(BTN_NORMAL,ID_ITEMDROP,0,DLG_X+2,DLG_Y+262,75,15,"Item Drops",ItemDropClick);
+	MakeButton(BTN_NORMAL,ID_ITEMDROP,0,DLG_X+2,DLG_Y+294,75,15,"Item Drops",ItemDropClick);
 	sprintf(s,"%0.2f%%",(float)world->map[mapNum]->itemDrops/(float)FIXAMT);
-	MakeButton(BTN_STATIC,ID_STATIC,0,DLG_X+81,DLG_Y+262,40,15,s,NULL);
+	MakeButton(BTN_STATIC,ID_STATIC,0,DLG_X+81,DLG_Y+294,40,15,s,NULL);
 
-	MakeButton(BTN_NORMAL,ID_BRAINS,0,DLG_X+2,DLG_Y+280,55,15,"Brains",BrainsClick);
+	MakeButton(BTN_NORMAL,ID_BRAINS,0,DLG_X+2,DLG_Y+312,55,15,"Brains",BrainsClick);
 	sprintf(s,"%d",world->map[mapNum]->numBrains);
-	MakeButton(BTN_STATIC,ID_STATIC,0,DLG_X+59,DLG_Y+280,40,15,s,NULL);
-	MakeButton(BTN_NORMAL,ID_AUTOBRAIN,0,DLG_X+110,DLG_Y+280,40,15,"Auto",AutoBrainsClick);
-	MakeButton(BTN_NORMAL,ID_BRAINS,0,DLG_X+2,DLG_Y+298,55,15,"Candles",CandlesClick);
+	MakeButton(BTN_STATIC,ID_STATIC,0,DLG_X+59,DLG_Y+312,40,15,s,NULL);
+	MakeButton(BTN_NORMAL,ID_AUTOBRAIN,0,DLG_X+110,DLG_Y+312,40,15,"Auto",AutoBrainsClick);
+	MakeButton(BTN_NORMAL,ID_BRAINS,0,DLG_X+2,DLG_Y+330,55,15,"Candles",CandlesClick);
 	sprintf(s,"%d",world->map[mapNum]->numCandles);
-	MakeButton(BTN_STATIC,ID_STATIC,0,DLG_X+59,DLG_Y+298,40,15,s,NULL);
-	MakeButton(BTN_NORMAL,ID_AUTOCANDLE,0,DLG_X+110,DLG_Y+298,40,15,"Auto",AutoCandlesClick);
+	MakeButton(BTN_STATIC,ID_STATIC,0,DLG_X+59,DLG_Y+330,40,15,s,NULL);
+	MakeButton(BTN_NORMAL,ID_AUTOCANDLE,0,DLG_X+110,DLG_Y+330,40,15,"Auto",AutoCandlesClick);
 }
 
 byte ZoomTileColor(int x,int y)
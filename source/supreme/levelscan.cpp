@@ -21,6 +21,10 @@ static char lvlFlagName[][16]={
 	"Underwater",
 	"Underlava",
 	"Stealth",
+	"Wavy",
+	"Oxygen Meter",
+	"Far Mons Doze",
+	"Smart Chasers",
 };
 
 static char wpnName[][16]={
@@ -29,6 +29,8 @@
 #include "log.h"
 #include "netmenu.h"
 #include "internet.h"
+#include "headless.h"
+#include "trace.h"
 
 #ifdef _WIN32
 #include <shellapi.h>
@@ -42,11 +44,23 @@ const char* AppdataFolderName()
 int main(int argc, char* argv[])
 {
 	bool windowedGame=false;
+	benchOpt_t bench;
 
 	for (int i = 1; i < argc; ++i)
 	{
 		if (!strcmp(argv[i], "window"))
 			windowedGame=true;
+		else if (!strncmp(argv[i], "trace=", 6))
+			TraceStart(&argv[i][6]);	// a Chrome trace of the whole run, saved on exit
+	}
+
+	byte benching=BenchArgs(argc, argv, &bench);
+	if(benching && !bench.record)
+	{
+		// nothing to see or hear
+		SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+		SDL_setenv("SDL_AUDIODRIVER", "dummy", 1);
+		windowedGame=true;
 	}
 
 	LoadConfig();
@@ -56,6 +70,14 @@ int main(int argc, char* argv[])
 
 	LunaticInit(mainmgl);
 
+	if(benching)
+	{
+		int result=RunBench(mainmgl, &bench);
+		LunaticExit();
+		delete mainmgl;
+		return result;
+	}
+
 	//CryptoTest();
 #ifdef ARCADETOWN
 	SplashScreen(mainmgl,"graphics/at_presents.bmp",32,0);
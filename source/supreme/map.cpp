@@ -6,6 +6,8 @@
 #include "guy.h"
 #include "config.h"
 #include "log.h"
+#include "perf.h"
+#include "tilebits.h"
 
 #define NUM_STARS 400
 
@@ -15,6 +17,10 @@ word starX[NUM_STARS],starY[NUM_STARS];
 byte starCol[NUM_STARS];
 static byte dottedLineOfs;
 
+// whose floor the shaded floor layer below is holding, and when
+static Map *layerMap;
+static dword layerTileGen;	// TileGeneration when the layer was last emptied
+
 Map::Map(FILE *f)
 {
 	byte count;
@@ -104,6 +110,8 @@ Map::Map(Map *m)
 Map::~Map(void)
 {
 	free(map);
+	if(layerMap==this)
+		layerMap=NULL;	// the next Map could well be put right here
 }
 
 void Map::SaveMapData(FILE *f)
@@ -295,8 +303,8 @@ void Map::Init(world_t *wrld)
 
 	for(i=0;i<NUM_STARS;i++)
 	{
-		starX[i]=Random(640);
-		starY[i]=Random(480);
+		starX[i]=Random(viewWid);
+		starY[i]=Random(viewHei);
 		starCol[i]=(byte)Random(32);
 	}
 
@@ -367,6 +375,7 @@ void Map::Update(byte mode,world_t *world)
 	int i;
 	static byte timeToReset=0;
 	static byte timeToAnim=0;
+	PERF_SCOPE("map");
 
 	dottedLineOfs++;
 	if(dottedLineOfs>7)
@@ -427,9 +436,15 @@ void Map::Update(byte mode,world_t *world)
 			if(timeToAnim==2)
 			{
 				if(GetTerrain(world,map[i].floor)->flags&TF_ANIM)
+				{
 					map[i].floor=GetTerrain(world,map[i].floor)->next;
+					TileBitsChanged(&map[i]);
+				}
 				if(map[i].wall!=0 && GetTerrain(world,map[i].wall)->flags&TF_ANIM)
+				{
 					map[i].wall=GetTerrain(world,map[i].wall)->next;
+					TileBitsChanged(&map[i]);
+				}
 				if(map[i].item!=ITM_NONE)
 					UpdateItem(&map[i],width,i);
 			}
@@ -703,6 +718,7 @@ byte PlaceItemCallback(int x,int y,int cx,int cy,int value,Map *map)
 		return 1;
 
 	map->GetTile(x,y)->item=(byte)value;
+	TileBitsChanged(map->GetTile(x,y));
 	if(value!=ITM_BRAIN && (GetItem(value)->flags&IF_PICKUP))
 		MakeSound(SND_ITEMDROP,(x*TILE_WIDTH)<<FIXSHIFT,(y*TILE_HEIGHT)<<FIXSHIFT,SND_CUTOFF,500);
 	return 0;	// all done, you placed the item
@@ -964,6 +980,7 @@ void Map::Swap(int sx,int sy,int blkwidth,int blkheight,int dx,int dy)
 	}
 
 	free(tempMap);
+	AllTileBitsChanged(this);
 
 	// move all specials that are in the target zone
 	for(i=0;i<MAX_SPECIAL;i++)
@@ -1005,6 +1022,7 @@ void Map::Copy(int sx,int sy,int blkwidth,int blkheight,int dx,int dy)
 	{
 		memcpy(&map[(i+dy)*width+dx],&map[(i+sy)*width+sx],sizeof(mapTile_t)*blkwidth);
 	}
+	AllTileBitsChanged(this);
 
 	// move all specials that are in the target zone
 	for(i=0;i<MAX_SPECIAL;i++)
@@ -1049,104 +1067,223 @@ int Map::ItemCountInRect(byte itm,int x,int y,int x2,int y2)
 	return cnt;
 }
 
+// The floor under the camera gets shaded into this layer and kept there, so a
+// tile is only shaded again when its floor, shadow or lights change.  Slots
+// wrap around the map, so the layer just needs to be bigger than the screen.
+#define LAYER_MIN	32	// in tiles, the layer is a power of 2 that size or bigger
+#define LAYER_PITCH	(layerTW*TILE_WIDTH)
+
+typedef struct floorSlot_t
+{
+	int x,y;	// which map tile is shaded here, -1 if none
+	word floor;
+	byte shadow;
+	char lites[9];
+} floorSlot_t;
+
+static byte *floorLayer;
+static floorSlot_t *floorSlot;
+static int layerTW,layerTH;
+
+static int LayerSize(int tiles)
+{
+	int n;
+
+	n=LAYER_MIN;
+	while(n<tiles)
+		n*=2;
+	return n;
+}
+
+void ResetFloorLayer(void)
+{
+	int i,tw,th;
+
+	// as many tiles as Render can touch for the current view
+	tw=LayerSize(viewWid/TILE_WIDTH+4);
+	th=LayerSize(viewHei/TILE_HEIGHT+6);
+	if(tw!=layerTW || th!=layerTH)
+	{
+		free(floorLayer);
+		free(floorSlot);
+		layerTW=tw;
+		layerTH=th;
+		floorLayer=(byte *)malloc(LAYER_PITCH*layerTH*TILE_HEIGHT);
+		floorSlot=(floorSlot_t *)malloc(sizeof(floorSlot_t)*layerTW*layerTH);
+		if(!floorLayer || !floorSlot)
+		{
+			free(floorLayer);
+			free(floorSlot);
+			floorLayer=NULL;
+			floorSlot=NULL;
+			layerTW=layerTH=0;
+		}
+	}
+	for(i=0;i<layerTW*layerTH;i++)
+		floorSlot[i].x=-1;
+	layerMap=NULL;
+	layerTileGen=TileGeneration();
+}
+
+static void RenderLayerFloor(int tx,int ty,int scrX,int scrY,word floor,byte shadow,const char *lites)
+{
+	floorSlot_t *slot;
+	byte *pix;
+
+	if(scrX<=-TILE_WIDTH || scrY<=-TILE_HEIGHT || scrX>=viewWid || scrY>=viewHei)
+		return;
+
+	slot=&floorSlot[(tx&(layerTW-1))+(ty&(layerTH-1))*layerTW];
+	pix=&floorLayer[(tx&(layerTW-1))*TILE_WIDTH+(ty&(layerTH-1))*TILE_HEIGHT*LAYER_PITCH];
+	if(slot->x!=tx || slot->y!=ty || slot->floor!=floor || slot->shadow!=shadow || memcmp(slot->lites,lites,9))
+	{
+		if(!ShadeFloorTile(pix,LAYER_PITCH,floor,shadow,lites))
+		{
+			slot->x=-1;
+			RenderFloorTileFancy(scrX,scrY,floor,shadow,lites);
+			return;
+		}
+		slot->x=tx;
+		slot->y=ty;
+		slot->floor=floor;
+		slot->shadow=shadow;
+		memcpy(slot->lites,lites,9);
+	}
+	RenderShadedTile(scrX,scrY,pix,LAYER_PITCH);
+}
+
+// the light of the 8 tiles around x,y and x,y itself, for shading.  Off the edge
+// of the map, the nearest tile that's on it stands in.
+void Map::GetLights(int x,int y,char *lites)
+{
+	int dx,dy,nx,ny;
+	byte okX,okY;
+
+	for(dy=-1;dy<=1;dy++)
+		for(dx=-1;dx<=1;dx++)
+		{
+			nx=x+dx;
+			ny=y+dy;
+			okX=(nx>=0 && nx<width);
+			okY=(ny>=0 && ny<height);
+			if(!okX)
+				nx=x;
+			if(!okY)
+				ny=y;
+			lites[(dx+1)+(dy+1)*3]=map[nx+ny*width].templight;
+		}
+}
+
+// which way the walls around x,y throw a shadow onto its floor
+byte Map::FloorShadow(world_t *world,int x,int y)
+{
+	// Shadow wall macro: used to determine both a wall is there and it's not marked shadowless
+#define SHADOW_WALL(WALL) ((WALL) && !(GetTerrain(world, (WALL))->flags&TF_TRANS))
+	if(config.shading==0)
+	{
+		if(x<width-1 && SHADOW_WALL(map[x+1+y*width].wall))
+			return 1;
+		return 0;
+	}
+
+	if(y<height-1 && SHADOW_WALL(map[x+(y+1)*width].wall))
+	{
+		if(x<width-1 && SHADOW_WALL(map[x+1+y*width].wall))
+			return 6;
+		if(x<width-1 && SHADOW_WALL(map[x+1+(y+1)*width].wall))
+			return 4;
+		return 7;
+	}
+	if(x<width-1)
+	{
+		if(SHADOW_WALL(map[x+1+y*width].wall))
+		{
+			if(y<height-1 && SHADOW_WALL(map[x+1+(y+1)*width].wall))
+				return 1;
+			return 2;
+		}
+		if(y<height-1 && SHADOW_WALL(map[x+1+(y+1)*width].wall))
+			return 3;
+	}
+	return 0;
+}
+
 void Map::Render(world_t *world,int camX,int camY,byte flags)
 {
 	int i,j;
+	PERF_SCOPE("map draw");
 
 	int tileX,tileY;
 	int ofsX,ofsY;
 	int scrX,scrY;
 	mapTile_t *m;
-	char lite;
 	char lites[9];
-	byte shdw;
+	byte keep;
 
-	camX-=320;
-	camY-=240;
+	camX-=viewWid/2;
+	camY-=viewHei/2;
 
 	tileX=(camX/TILE_WIDTH)-1;
 	tileY=(camY/TILE_HEIGHT)-1;
 	ofsX=camX%TILE_WIDTH;
 	ofsY=camY%TILE_HEIGHT;
 
-	scrX=-ofsX-TILE_WIDTH;
-	for(i=tileX;i<tileX+(640/TILE_WIDTH+4);i++)
+	if(layerMap!=this || layerTileGen!=TileGeneration())
 	{
-		scrY=-ofsY-TILE_HEIGHT;
-		for(j=tileY;j<tileY+(480/TILE_HEIGHT+6);j++)
+		ResetFloorLayer();
+		layerMap=this;
+	}
+	keep=(floorLayer && CanShadeFloorTiles());
+
+	// the floor goes straight onto the screen, a row at a time to suit the map
+	scrY=-ofsY-TILE_HEIGHT;
+	for(j=tileY;j<tileY+(viewHei/TILE_HEIGHT+6);j++)
+	{
+		scrX=-ofsX-TILE_WIDTH;
+		for(i=tileX;i<tileX+(viewWid/TILE_WIDTH+4);i++)
 		{
 			if(i>=0 && i<width && j>=0 && j<height)
 			{
 				m=&map[i+j*width];
 
-				lite=m->templight;
-
-				lites[4]=lite;
-				if(i>0 && j>0)
-					lites[0]=map[i-1+(j-1)*width].templight;
-				else
+				// if there is a wall on the tile below this one, no
+				// point in rendering this floor (unless it is transparent)
+				if(!m->wall && (j==height-1 || !map[i+(j+1)*width].wall ||
+					(GetTerrain(world,map[i+(j+1)*width].floor)->flags&TF_TRANS)))
 				{
-					if(i>0)
-						lites[0]=map[i-1+(j)*width].templight;
-					else if(j>0)
-						lites[0]=map[i+(j-1)*width].templight;
+					GetLights(i,j,lites);
+					if(keep)
+						RenderLayerFloor(i,j,scrX,scrY,m->floor,FloorShadow(world,i,j),lites);
 					else
-						lites[0]=lite;
-				}
-				if(j>0)
-					lites[1]=map[i+(j-1)*width].templight;
-				else
-					lites[1]=lite;
-				if(i<width-1 && j>0)
-					lites[2]=map[i+1+(j-1)*width].templight;
-				else
-				{
-					if(i<width-1)
-						lites[2]=map[i+1+(j)*width].templight;
-					else if(j>0)
-						lites[2]=map[i+(j-1)*width].templight;
-					else
-						lites[2]=lite;
-				}
-				if(i>0)
-					lites[3]=map[i-1+j*width].templight;
-				else
-					lites[3]=lite;
-				if(i<width-1)
-					lites[5]=map[i+1+(j)*width].templight;
-				else
-					lites[5]=lite;
-				if(i>0 && j<height-1)
-					lites[6]=map[i-1+(j+1)*width].templight;
-				else
-				{
-					if(i>0)
-						lites[6]=map[i-1+(j)*width].templight;
-					else if(j<height-1)
-						lites[6]=map[i+(j+1)*width].templight;
-					else
-						lites[6]=lite;
-				}
-				if(j<height-1)
-					lites[7]=map[i+(j+1)*width].templight;
-				else
-					lites[7]=lite;
-				if(i<width-1 && j<height-1)
-					lites[8]=map[i+1+(j+1)*width].templight;
-				else
-				{
-					if(i<width-1)
-						lites[8]=map[i+1+(j)*width].templight;
-					else if(j<height-1)
-						lites[8]=map[i+(j+1)*width].templight;
-					else
-						lites[8]=lite;
+						RenderFloorTileFancy(scrX,scrY,m->floor,FloorShadow(world,i,j),lites);
 				}
+			}
+			else
+			{
+				// put black in empty spaces
+				DrawFillBox(scrX,scrY,scrX+TILE_WIDTH-1,scrY+TILE_HEIGHT-1,0);
+			}
+			scrX+=TILE_WIDTH;
+		}
+		scrY+=TILE_HEIGHT;
+	}
 
-				RenderItem(scrX+camX+(TILE_WIDTH/2),scrY+camY+(TILE_HEIGHT/2)-1,m->item,lite,flags);
+	// items and walls get sorted in the display list, so they go in the order they always have
+	scrX=-ofsX-TILE_WIDTH;
+	for(i=tileX;i<tileX+(viewWid/TILE_WIDTH+4);i++)
+	{
+		scrY=-ofsY-TILE_HEIGHT;
+		for(j=tileY;j<tileY+(viewHei/TILE_HEIGHT+6);j++)
+		{
+			if(i>=0 && i<width && j>=0 && j<height)
+			{
+				m=&map[i+j*width];
+
+				RenderItem(scrX+camX+(TILE_WIDTH/2),scrY+camY+(TILE_HEIGHT/2)-1,m->item,m->templight,flags);
 
 				if(m->wall)	// there is a wall on this tile
 				{
+					GetLights(i,j,lites);
 					if(j<height-1)
 					{
 						// if the tile below this one is also a wall, don't waste the
@@ -1179,76 +1316,6 @@ void Map::Render(world_t *world,int camX,int camY,byte flags)
 								DISPLAY_DRAWME|DISPLAY_WALLTILE);
 					}
 				}
-				else
-				{
-					// Shadow wall macro: used to determine both a wall is there and it's not marked shadowless
-#define SHADOW_WALL(WALL) ((WALL) && !(GetTerrain(world, (WALL))->flags&TF_TRANS))
-					if(config.shading==0)
-					{
-						if(i<width-1 && SHADOW_WALL(map[i+1+j*width].wall))
-							shdw=1;
-						else
-							shdw=0;
-					}
-					else
-					{
-						if(j<height-1 && SHADOW_WALL(map[i+(j+1)*width].wall))
-						{
-							if(i<width-1 && SHADOW_WALL(map[i+1+j*width].wall))
-							{
-								shdw=6;
-							}
-							else
-							{
-								if(i<width-1 && SHADOW_WALL(map[i+1+(j+1)*width].wall))
-									shdw=4;
-								else
-									shdw=7;
-							}
-						}
-						else
-						{
-							if(i<width-1)
-							{
-								if(SHADOW_WALL(map[i+1+(j)*width].wall))
-								{
-									if(j<height-1 && SHADOW_WALL(map[i+1+(j+1)*width].wall))
-										shdw=1;
-									else
-										shdw=2;
-								}
-								else
-								{
-									if(j<height-1 && SHADOW_WALL(map[i+1+(j+1)*width].wall))
-										shdw=3;
-									else
-										shdw=0;
-								}
-							}
-							else
-								shdw=0;
-						}
-					}
-
-					if(j<height-1)
-					{
-						// if there is a wall on the tile below this one, no
-						// point in rendering this floor (unless it is transparent
-						if((!map[i+(j+1)*width].wall) ||
-							(GetTerrain(world,map[i+(j+1)*width].floor)->flags&TF_TRANS))
-							RenderFloorTileFancy(scrX,scrY,m->floor,shdw,lites);
-					}
-					else
-					{
-						// if there's a wall to the right, draw a shadow on this tile
-						RenderFloorTileFancy(scrX,scrY,m->floor,shdw,lites);
-					}
-				}
-			}
-			else
-			{
-				// put black in empty spaces
-				DrawFillBox(scrX,scrY,scrX+TILE_WIDTH-1,scrY+TILE_HEIGHT-1,0);
 			}
 			scrY+=TILE_HEIGHT;
 		}
@@ -1287,8 +1354,8 @@ void Map::RenderEdit(world_t *world,int camX,int camY,byte flags)
 	char lite,lites[9];
 	byte shdw;
 
-	camX-=320;
-	camY-=240;
+	camX-=viewWid/2;
+	camY-=viewHei/2;
 
 	tileX=(camX/TILE_WIDTH)-1;
 	tileY=(camY/TILE_HEIGHT)-1;
@@ -1296,10 +1363,10 @@ void Map::RenderEdit(world_t *world,int camX,int camY,byte flags)
 	ofsY=camY%TILE_HEIGHT;
 
 	scrX=-ofsX-TILE_WIDTH;
-	for(i=tileX;i<tileX+(640/TILE_WIDTH+4);i++)
+	for(i=tileX;i<tileX+(viewWid/TILE_WIDTH+4);i++)
 	{
 		scrY=-ofsY-TILE_HEIGHT;
-		for(j=tileY;j<tileY+(480/TILE_HEIGHT+6);j++)
+		for(j=tileY;j<tileY+(viewHei/TILE_HEIGHT+6);j++)
 		{
 			if(i>=0 && i<width && j>=0 && j<height)
 			{
@@ -1533,8 +1600,8 @@ void Map::RenderSelect(world_t *world,int camX,int camY,byte flags)
 	if(flags&MAP_SHOWSELECT)
 		return;
 
-	camX-=320;
-	camY-=240;
+	camX-=viewWid/2;
+	camY-=viewHei/2;
 
 	tileX=(camX/TILE_WIDTH)-1;
 	tileY=(camY/TILE_HEIGHT)-1;
@@ -1542,10 +1609,10 @@ void Map::RenderSelect(world_t *world,int camX,int camY,byte flags)
 	ofsY=camY%TILE_HEIGHT;
 
 	scrX=-ofsX-TILE_WIDTH;
-	for(i=tileX;i<tileX+(640/TILE_WIDTH+4);i++)
+	for(i=tileX;i<tileX+(viewWid/TILE_WIDTH+4);i++)
 	{
 		scrY=-ofsY-TILE_HEIGHT;
-		for(j=tileY;j<tileY+(480/TILE_HEIGHT+6);j++)
+		for(j=tileY;j<tileY+(viewHei/TILE_HEIGHT+6);j++)
 		{
 			if(i>=0 && i<width && j>=0 && j<height)
 			{
@@ -1606,6 +1673,7 @@ byte Map::ItemChange(int x,int y,byte item,byte fx)
 
 	i=map[x+y*width].item;
 	map[x+y*width].item=item;
+	TileBitsChanged(&map[x+y*width]);
 
 	if(fx && i!=item)
 		SmokeTile(x,y);
@@ -1624,6 +1692,7 @@ void Map::TileChange(int x,int y,int floor,int wall,byte fx)
 	preWall=map[x+y*width].wall;
 	map[x+y*width].floor=floor;
 	map[x+y*width].wall=wall;
+	TileBitsChanged(&map[x+y*width]);
 
 	if(fx && (preFloor!=floor || preWall!=wall))
 		SmokeTile(x,y);
@@ -1645,6 +1714,7 @@ byte Map::ContiguousItemChange(int x,int y,byte item,byte fx)
 		SmokeTile(x,y);
 
 	map[x+y*width].item=item;
+	TileBitsChanged(&map[x+y*width]);
 
 	if(x>0 && map[x-1+y*width].item==i)
 		ContiguousItemChange(x-1,y,item,fx);
@@ -1680,6 +1750,7 @@ byte Map::AllItemChange(int x,int y,byte item,byte fx)
 				SmokeTile(j%width,j/width);
 		}
 	}
+	AllTileBitsChanged(this);
 
 	return i;
 }
@@ -1702,6 +1773,7 @@ void Map::ContiguousTileChange(int x,int y,int floor,int wall,byte fx)
 
 	map[x+y*width].floor=floor;
 	map[x+y*width].wall=wall;
+	TileBitsChanged(&map[x+y*width]);
 
 	if(x>0 && map[x-1+y*width].wall==preWall &&
 		map[x-1+y*width].floor==preFloor)
@@ -1741,6 +1813,7 @@ void Map::AllTileChange(int x,int y,int floor,int wall,byte fx)
 				SmokeTile(i%width,i/width);
 		}
 	}
+	AllTileBitsChanged(this);
 }
 
 void Map::LightRect(int x,int y,int x2,int y2,char brt,byte perm)
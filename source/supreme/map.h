@@ -40,8 +40,10 @@
 #define MAP_STEALTH		(1<<9)
 #define MAP_WAVY		(1<<10)
 #define MAP_OXYGEN		(1<<11)
+#define MAP_SIMLOD		(1<<12)	// monsters far from the player only update now and then
+#define MAP_FLOWCHASE	(1<<13)	// some chasers follow the path to the player instead of a beeline
 
-#define NUM_LVL_FLAGS	12
+#define NUM_LVL_FLAGS	14
 
 // map updating modes
 #define UPDATE_GAME		0
@@ -147,8 +149,12 @@ class Map
 		special_t   special[MAX_SPECIAL];
 	private:
 		void LOSPoints(int x,int y,int curx,int cury,int *p1x,int *p1y,int *p2x,int *p2y);
+		void GetLights(int x,int y,char *lites);
+		byte FloorShadow(world_t *world,int x,int y);
 };
 
+void ResetFloorLayer(void);	// forget every shaded floor tile kept by Map::Render
+
 byte PlaceItemCallback(int x,int y,int cx,int cy,int value,Map *map);
 byte TorchCallback(int x,int y,int cx,int cy,int value,Map *map);
 byte TempTorchCallback(int x,int y,int cx,int cy,int value,Map *map);
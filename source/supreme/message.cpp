@@ -86,7 +86,7 @@ void InitMessage(void)
 void NewBigMessage(const char *txt,int time)
 {
 	strncpy(bigMessage.msg,VariableMsg(txt),32);
-	bigMessage.x=320-GetStrLength(bigMessage.msg,0)/2;
+	bigMessage.x=viewWid/2-GetStrLength(bigMessage.msg,0)/2;
 	bigMessage.y=-100;
 	bigMessage.dy=0;
 	bigMessage.timer=time;
@@ -100,7 +100,7 @@ void NewMessage(const char *txt,int time,byte priority)
 		return;	// can't override it
 	strncpy(message.msg,VariableMsg(txt),32);
 	message.x=2;
-	message.y=484;
+	message.y=viewHei+4;
 	message.dy=-13;
 	message.timer=time;
 	message.bright=-32;
@@ -130,9 +130,9 @@ void UpdateBigMessage(void)
 	// while time still remains, don't start falling offscreen
 	if(bigMessage.timer)
 	{
-		if(bigMessage.y>200)
+		if(bigMessage.y>viewHei/2-40)
 		{
-			bigMessage.y=200;
+			bigMessage.y=viewHei/2-40;
 			bigMessage.dy=-bigMessage.dy/2;
 			if(bigMessage.dy>-2)
 				bigMessage.dy=0;
@@ -147,7 +147,7 @@ void UpdateBigMessage(void)
 	}
 	else	// go ahead and fall
 	{
-		if(bigMessage.y>480)
+		if(bigMessage.y>viewHei)
 		{
 			bigMessage.msg[0]='\0';
 			bigMessage.y=0;
@@ -185,7 +185,7 @@ void UpdateMessage(void)
 	}
 	else	// go ahead and fall
 	{
-		if(message.y>480)
+		if(message.y>viewHei)
 		{
 			message.msg[0]='\0';
 			message.y=0;
@@ -5,6 +5,12 @@
 #include "shop.h"
 #include "editor.h"
 #include "goal.h"
+#include "config.h"
+#include "log.h"
+#include "perf.h"
+#include "flowfield.h"
+#include "think.h"
+#include <vector>
 
 /*
  -MT_GOOD	 -MT_EVIL		 -MT_SPOOKY		-MT_ZOMBIE	 -MT_VAMPIRE	-MT_SPIDER -MT_PYGMY
@@ -15,6 +21,123 @@
 */
 #include "monsterlist.cpp"
 
+monsterHot_t monsHot[NUM_MONSTERS];
+
+// Monster sprite sets live in a pool keyed by file name, so every monster
+// drawn from the same .jsp ('!' repeats, and custom graphics handed to many
+// guys) shares one copy.  A set with refs is held: Bouapha's always, the ones
+// the level preloaded until it ends, and custom graphics while a guy wears
+// them.  The rest stay loaded after they're used, and the least recently
+// drawn go when the pool is over config.spriteBudget.  A set drawn in the
+// last frame is never dropped, since the display list may still point at it.
+typedef struct sprPool_t
+{
+	char name[64];
+	sprite_set_t *set;
+	dword bytes;
+	int refs;
+	dword lastUse;
+} sprPool_t;
+
+static std::vector<sprPool_t> sprPool;
+static short sprSlot[NUM_MONSTERS];	// monsType[i].spr is sprPool[sprSlot[i]].set
+static std::vector<int> levelPins;
+static dword sprClock;
+static dword sprBytes,sprPeak;
+
+static int FindSprSlot(const char *name)
+{
+	int i;
+	sprPool_t p;
+
+	for(i=0;i<(int)sprPool.size();i++)
+		if(!strcmp(sprPool[i].name,name))
+			return i;
+
+	memset(&p,0,sizeof(sprPool_t));
+	SDL_strlcpy(p.name,name,sizeof(p.name));
+	sprPool.push_back(p);
+	return (int)sprPool.size()-1;
+}
+
+static void DropSprSlot(int slot)
+{
+	int i;
+
+	for(i=0;i<NUM_MONSTERS;i++)
+		if(sprSlot[i]==slot)
+			monsType[i].spr=NULL;
+	sprBytes-=sprPool[slot].bytes;
+	delete sprPool[slot].set;
+	sprPool[slot].set=NULL;
+	sprPool[slot].bytes=0;
+}
+
+// drop unheld sets, oldest first, until the pool fits in budget bytes
+static void TrimSprites(dword budget,dword olderThan)
+{
+	int i,oldest;
+
+	while(sprBytes>budget)
+	{
+		oldest=-1;
+		for(i=0;i<(int)sprPool.size();i++)
+			if(sprPool[i].set && sprPool[i].refs==0 && sprPool[i].lastUse+1<olderThan &&
+				(oldest==-1 || sprPool[i].lastUse<sprPool[oldest].lastUse))
+				oldest=i;
+		if(oldest==-1)
+			return;	// everything left is held or in use
+		DropSprSlot(oldest);
+	}
+}
+
+static dword SpriteBudget(void)
+{
+	return (dword)config.spriteBudget*1024;
+}
+
+// loads the set in slot if it isn't, 0 if it can't be
+static byte LoadSprSlot(int slot)
+{
+	sprite_set_t *set;
+
+	sprPool[slot].lastUse=sprClock;
+	if(sprPool[slot].set)
+		return 1;
+
+	TrimSprites(SpriteBudget(),sprClock);
+	set=new sprite_set_t();
+	if(!set->Load(sprPool[slot].name))
+	{
+		delete set;
+		return 0;
+	}
+	sprPool[slot].set=set;
+	sprPool[slot].bytes=set->GetMemSize();
+	sprBytes+=sprPool[slot].bytes;
+	if(sprBytes>sprPeak)
+		sprPeak=sprBytes;
+	return 1;
+}
+
+// which slot a monster type draws from, following '!' repeats
+static int MonsterSprSlot(dword type)
+{
+	if(sprSlot[type]==-1)
+	{
+		if(monsType[type].sprName[0]=='!')
+			sprSlot[type]=(short)MonsterSprSlot(atoi(&monsType[type].sprName[1]));
+		else
+			sprSlot[type]=(short)FindSprSlot(monsType[type].sprName);
+	}
+	return sprSlot[type];
+}
+
+static int MonsterSpriteKB(void)
+{
+	return (int)(sprBytes/1024);
+}
+
 void InitMonsters(void)
 {
 	int i,j,k;
@@ -23,6 +146,12 @@ void InitMonsters(void)
 	for(i=0;i<NUM_MONSTERS;i++)
 	{
 		monsType[i].spr=NULL;
+		sprSlot[i]=-1;
+		monsHot[i].AI=monsType[i].AI;
+		monsHot[i].flags=monsType[i].flags;
+		monsHot[i].hp=monsType[i].hp;
+		monsHot[i].size=monsType[i].size;
+		monsHot[i].framesPerDir=monsType[i].framesPerDir;
 		for(j=0;j<NUM_ANIMS;j++)
 		{
 			done=0;
@@ -39,21 +168,23 @@ void InitMonsters(void)
 		}
 	}
 	// just keep bouapha perma-loaded
-	monsType[MONS_BOUAPHA].spr=new sprite_set_t(monsType[MONS_BOUAPHA].sprName);
+	i=MonsterSprSlot(MONS_BOUAPHA);
+	sprPool[i].refs++;
+	LoadSprSlot(i);
+	monsType[MONS_BOUAPHA].spr=sprPool[i].set;
+	PerfWatch("monster sprite KB",MonsterSpriteKB);
 }
 
 void ExitMonsters(void)
 {
 	int i;
 
-	for(i=1;i<NUM_MONSTERS;i++)
-	{
-		if(monsType[i].sprName[0]=='!')
-			monsType[i].spr=NULL;
-		else if(monsType[i].spr)
-			delete monsType[i].spr;
-		monsType[i].spr=NULL;
-	}
+	PerfWatch("monster sprite KB",NULL);
+	for(i=0;i<(int)sprPool.size();i++)
+		if(sprPool[i].set)
+			DropSprSlot(i);
+	sprPool.clear();
+	levelPins.clear();
 }
 
 monsterType_t *GetMonsterType(dword type)
@@ -71,54 +202,122 @@ void PurgeMonsterSprites(void)
 {
 	int i;
 
-	// note this starts at 2, skipping bouapha
-	for(i=2;i<NUM_MONSTERS;i++)
+	// held ones stay, which is always bouapha
+	for(i=0;i<(int)sprPool.size();i++)
+		if(sprPool[i].set && sprPool[i].refs==0)
+			DropSprSlot(i);
+}
+
+static void PinSprSlot(int slot)
+{
+	if(!LoadSprSlot(slot))
+		return;
+	sprPool[slot].refs++;
+	levelPins.push_back(slot);
+}
+
+void PreloadLevelSprites(Map *map)
+{
+	int i,j;
+	std::vector<byte> want(NUM_MONSTERS,0);
+	effect_t *eff;
+	char name[64];
+
+	for(i=0;i<MAX_MAPMONS;i++)
+		if(map->badguy[i].type>0 && map->badguy[i].type<NUM_MONSTERS)
+			want[map->badguy[i].type]=1;
+
+	// and whatever the specials can bring in
+	for(i=0;i<MAX_SPECIAL;i++)
 	{
-		// repeat graphics monsters do not delete their sprites
-		if(monsType[i].sprName[0]=='!')
-			monsType[i].spr=NULL;
-		else if(monsType[i].spr)
-			delete monsType[i].spr;
-		monsType[i].spr=NULL;
+		if(map->special[i].x==255)
+			continue;
+		for(j=0;j<NUM_EFFECTS;j++)
+		{
+			eff=&map->special[i].effect[j];
+			if(eff->type==EFF_SUMMON && eff->value>0 && eff->value<NUM_MONSTERS)
+				want[eff->value]=1;
+			else if(eff->type==EFF_CHANGEMONS && eff->value2>0 && eff->value2<NUM_MONSTERS)
+				want[eff->value2]=1;
+			else if(eff->type==EFF_MONSGRAPHICS && eff->text[0])
+			{
+				sprintf(name,"user/%s",eff->text);
+				PinSprSlot(FindSprSlot(name));
+			}
+		}
 	}
+
+	for(i=1;i<NUM_MONSTERS;i++)
+		if(want[i])
+		{
+			PinSprSlot(MonsterSprSlot(i));
+			monsType[i].spr=sprPool[sprSlot[i]].set;
+		}
+
+	sprPeak=sprBytes;
+	LogDebug("%s: %d monster sprite sets held, %lu KB loaded (budget %d KB)",map->name,(int)levelPins.size(),
+		(unsigned long)(sprBytes/1024),config.spriteBudget);
 }
 
-byte MonsterSize(dword type)
+void ReleaseLevelSprites(void)
 {
-	return monsType[type].size;
+	size_t i;
+
+	for(i=0;i<levelPins.size();i++)
+		sprPool[levelPins[i]].refs--;
+	levelPins.clear();
+
+	LogDebug("monster sprites peaked at %lu KB this level",(unsigned long)(sprPeak/1024));
+	TrimSprites(SpriteBudget(),sprClock+2);
 }
 
-byte *MonsterAnim(dword type,byte anim)
+void AgeMonsterSprites(void)
 {
-	return monsType[type].anim[anim];
+	sprClock++;
 }
 
-word MonsterFlags(dword type,byte aiType)
+sprite_set_t *LoadCustomSprites(const char *fname)
 {
-	if(aiType==MONS_BOUAPHA && player.weapon==WPN_PWRARMOR)
-		return monsType[MONS_PWRBOUAPHA].flags;
-	if(aiType==MONS_BOUAPHA && player.weapon==WPN_MINISUB)
-		return monsType[MONS_MINISUB].flags;
-	return monsType[type].flags;
+	int slot;
+
+	slot=FindSprSlot(fname);
+	if(!LoadSprSlot(slot))
+		return NULL;
+	sprPool[slot].refs++;
+	return sprPool[slot].set;
 }
 
-byte MonsterFrames(dword type,byte aiType)
+void FreeCustomSprites(sprite_set_t *set)
 {
-	if(aiType==MONS_BOUAPHA && player.weapon==WPN_PWRARMOR)
-		return monsType[MONS_PWRBOUAPHA].framesPerDir;
-	if(aiType==MONS_BOUAPHA && player.weapon==WPN_MINISUB)
-		return monsType[MONS_MINISUB].framesPerDir;
-	return monsType[type].framesPerDir;
+	int i;
+
+	if(!set)
+		return;
+	for(i=0;i<(int)sprPool.size();i++)
+		if(sprPool[i].set==set)
+		{
+			sprPool[i].refs--;
+			return;
+		}
 }
 
-word MonsterPoints(dword type)
+byte *MonsterAnim(dword type,byte anim)
 {
-	return monsType[type].points;
+	return monsType[type].anim[anim];
 }
 
-word MonsterHP(dword type)
+dword BouaphaBody(dword type)
 {
-	return monsType[type].hp;
+	if(player.weapon==WPN_PWRARMOR)
+		return MONS_PWRBOUAPHA;
+	if(player.weapon==WPN_MINISUB)
+		return MONS_MINISUB;
+	return type;
+}
+
+word MonsterPoints(dword type)
+{
+	return monsType[type].points;
 }
 
 char *MonsterName(short type)
@@ -146,32 +345,26 @@ char *MonsterName(short type)
 void SetMonsterFlags(dword type,word flags)
 {
 	monsType[type].flags=flags;
+	monsHot[type].flags=flags;
 }
 
 void LoadMySprite(dword type)
 {
-	int v;
+	int slot;
 
 	if(type==0 || type>=NUM_MONSTERS)
 		return;
 
 	if(monsType[type].spr==NULL)
 	{
-		if(monsType[type].sprName[0]=='!')
-		{
-			// it's a repeat of someone else's sprite
-			v=atoi(&monsType[type].sprName[1]);
-			if(!monsType[v].spr)
-				monsType[v].spr=new sprite_set_t(monsType[v].sprName);
-
-			monsType[type].spr=monsType[v].spr;
-		}
-		else
-			monsType[type].spr=new sprite_set_t(monsType[type].sprName);
-
-		if(monsType[type].spr==NULL || monsType[type].spr->GetSprite(0)==NULL)
+		// repeats of someone else's sprite share their set
+		slot=MonsterSprSlot(type);
+		if(!LoadSprSlot(slot) || sprPool[slot].set->GetSprite(0)==NULL)
 			FatalError("Out of memory or sprites missing!");
+		monsType[type].spr=sprPool[slot].set;
 	}
+	else
+		sprPool[sprSlot[type]].lastUse=sprClock;
 }
 
 sprite_t *GetMonsterSprite(dword type,byte seq,byte frm,byte facing)
@@ -207,18 +400,18 @@ sprite_t *GetMonsterSprite(dword type,byte seq,byte frm,byte facing)
 	if(v==254)
 		return NULL;	// 254 means no sprite for this frame
 
-	if(!(monsType[type].flags&MF_ONEFACE))
-		v+=facing*monsType[type].framesPerDir;
+	if(!(monsHot[type].flags&MF_ONEFACE))
+		v+=facing*monsHot[type].framesPerDir;
 
 	if(type==MONS_BOUAPHA)
 	{
 		if(PlayerHasHammer())
-			v+=8*monsType[type].framesPerDir;
+			v+=8*monsHot[type].framesPerDir;
 	}
 	if(type==MONS_EVILCLONE)
-		v+=8*monsType[type].framesPerDir;
+		v+=8*monsHot[type].framesPerDir;
 
-	if(monsType[type].flags&MF_FACECMD)
+	if(monsHot[type].flags&MF_FACECMD)
 		v+=facing;
 
 	return monsType[type].spr->GetSprite(v);
@@ -266,13 +459,13 @@ void MonsterDraw(int x,int y,int z,dword type,dword aiType,byte seq,byte frm,byt
 	if(v==254 || v==255)
 		return;	// don't draw this frame
 
-	if(!(monsType[type].flags&MF_ONEFACE))
-		v+=facing*monsType[type].framesPerDir;
+	if(!(monsHot[type].flags&MF_ONEFACE))
+		v+=facing*monsHot[type].framesPerDir;
 
 	if(isBouapha)
 	{
 		if(type==MONS_BOUAPHA && PlayerHasHammer())
-			v+=8*monsType[type].framesPerDir;
+			v+=8*monsHot[type].framesPerDir;
 		shld=PlayerShield();
 		if((shld<16) && (shld&2))	// it blinks when there is 1/2 second left
 			shld=0;
@@ -286,7 +479,7 @@ void MonsterDraw(int x,int y,int z,dword type,dword aiType,byte seq,byte frm,byt
 			curSpr=set->GetSprite(v);
 			if(!curSpr)
 				return;
-			if(!(monsType[type].flags&MF_NOSHADOW))
+			if(!(monsHot[type].flags&MF_NOSHADOW))
 				SprDraw(x>>FIXSHIFT,y>>FIXSHIFT,0,255,0,curSpr,DISPLAY_DRAWME|DISPLAY_SHADOW);
 			if(ouch==0)
 				SprDraw(x>>FIXSHIFT,y>>FIXSHIFT,z>>FIXSHIFT,7,bright+4,curSpr,DISPLAY_DRAWME);	// aqua
@@ -299,7 +492,7 @@ void MonsterDraw(int x,int y,int z,dword type,dword aiType,byte seq,byte frm,byt
 			curSpr=set->GetSprite(v);
 			if(!curSpr)
 				return;
-			if(!(monsType[type].flags&MF_NOSHADOW))
+			if(!(monsHot[type].flags&MF_NOSHADOW))
 				SprDraw(x>>FIXSHIFT,y>>FIXSHIFT,0,255,0,curSpr,DISPLAY_DRAWME|DISPLAY_SHADOW);
 			if(ouch==0)
 				SprDraw(x>>FIXSHIFT,y>>FIXSHIFT,z>>FIXSHIFT,1,bright-4,curSpr,DISPLAY_DRAWME);	// green
@@ -318,16 +511,16 @@ void MonsterDraw(int x,int y,int z,dword type,dword aiType,byte seq,byte frm,byt
 	}
 
 	if(type==MONS_EVILCLONE)
-		v+=8*monsType[type].framesPerDir;
+		v+=8*monsHot[type].framesPerDir;
 
-	if(monsType[type].flags&MF_FACECMD)
+	if(monsHot[type].flags&MF_FACECMD)
 		v+=facing;
 
 	curSpr=set->GetSprite(v);
 	if(!curSpr)
 		return;
 
-	if(!(monsType[type].flags&MF_NOSHADOW))
+	if(!(monsHot[type].flags&MF_NOSHADOW))
 		SprDraw(x>>FIXSHIFT,y>>FIXSHIFT,0,255,0,curSpr,DISPLAY_DRAWME|DISPLAY_SHADOW);
 
 	if(ouch==0)
@@ -336,7 +529,7 @@ void MonsterDraw(int x,int y,int z,dword type,dword aiType,byte seq,byte frm,byt
 			SprDraw(x>>FIXSHIFT,y>>FIXSHIFT,z>>FIXSHIFT,7,bright+4,curSpr,DISPLAY_DRAWME);
 		else if(poison)
 			SprDraw(x>>FIXSHIFT,y>>FIXSHIFT,z>>FIXSHIFT,1,bright,curSpr,DISPLAY_DRAWME);
-		else if(!(monsType[type].flags&(MF_GHOST|MF_GLOW)))
+		else if(!(monsHot[type].flags&(MF_GHOST|MF_GLOW)))
 		{
 			if(monsType[type].fromCol==255)
 				SprDraw(x>>FIXSHIFT,y>>FIXSHIFT,z>>FIXSHIFT,255,bright+monsType[type].brtChg,curSpr,DISPLAY_DRAWME);
@@ -346,9 +539,9 @@ void MonsterDraw(int x,int y,int z,dword type,dword aiType,byte seq,byte frm,byt
 					bright+monsType[type].brtChg,curSpr,DISPLAY_DRAWME);
 			}
 		}
-		else if(monsType[type].flags&MF_GHOST)
+		else if(monsHot[type].flags&MF_GHOST)
 			SprDraw(x>>FIXSHIFT,y>>FIXSHIFT,z>>FIXSHIFT,255,bright+monsType[type].brtChg,curSpr,DISPLAY_DRAWME|DISPLAY_GHOST);
-		else if(monsType[type].flags&MF_GLOW)
+		else if(monsHot[type].flags&MF_GLOW)
 			SprDraw(x>>FIXSHIFT,y>>FIXSHIFT,z>>FIXSHIFT,255,bright+monsType[type].brtChg,curSpr,DISPLAY_DRAWME|DISPLAY_GLOW);
 	}
 	else
@@ -372,8 +565,8 @@ void InstaRenderMonster(int x,int y,dword type,char bright,MGLDraw *mgl)
 	LoadMySprite(type);
 
 	v=monsType[type].anim[ANIM_IDLE][0];
-	if(!(monsType[type].flags&MF_ONEFACE))
-		v+=2*monsType[type].framesPerDir;
+	if(!(monsHot[type].flags&MF_ONEFACE))
+		v+=2*monsHot[type].framesPerDir;
 
 	curSpr=monsType[type].spr->GetSprite(v);
 	if(!curSpr)
@@ -395,8 +588,8 @@ int InstaRenderScannedMonster(int x,int y,dword type,char bright,MGLDraw *mgl)
 	LoadMySprite(type);
 
 	v=monsType[type].anim[ANIM_IDLE][0];
-	if(!(monsType[type].flags&MF_ONEFACE))
-		v+=2*monsType[type].framesPerDir;
+	if(!(monsHot[type].flags&MF_ONEFACE))
+		v+=2*monsHot[type].framesPerDir;
 
 	curSpr=monsType[type].spr->GetSprite(v);
 	if(!curSpr)
@@ -412,6 +605,15 @@ dword MonsterTheme(dword type)
 	return monsType[type].theme;
 }
 
+Monster_ThinkFunc MonsterThink(dword type)
+{
+	if(monsHot[type].AI==AI_Bonehead)
+		return Think_Bonehead;
+	if(monsHot[type].AI==AI_Zombie)
+		return Think_Zombie;
+	return NULL;
+}
+
 // AI auxiliary functions to make it simple
 //---------------------------------------------
 
@@ -449,6 +651,50 @@ int RangeToTarget(Guy *me,Guy *goodguy)
 	return abs(me->x-goodguy->x)+abs(me->y-goodguy->y);
 }
 
+// FaceGoodguy for walkers, who go around walls on MAP_FLOWCHASE levels by
+// heading for the middle of the next tile on the way to the player.  Close
+// up, or with no way through, it's just FaceGoodguy.
+inline void ChaseGoodguy(Guy *me,Guy *goodguy,Map *map)
+{
+	int nextx,nexty,tx,ty;
+
+	if(goodguy!=::goodguy || !(map->flags&MAP_FLOWCHASE) ||
+		(MonsterFlags(me->type,me->aiType)&(MF_FLYING|MF_WALLWALK|MF_AQUATIC|MF_WATERWALK)) ||
+		RangeToTarget(me,goodguy)<(TILE_WIDTH*2*FIXAMT) || !FlowNextTile(me->mapx,me->mapy,&nextx,&nexty))
+	{
+		FaceGoodguy(me,goodguy);
+		return;
+	}
+
+	tx=(nextx*TILE_WIDTH+TILE_WIDTH/2)*FIXAMT;
+	ty=(nexty*TILE_HEIGHT+TILE_HEIGHT/2)*FIXAMT;
+	if(tx<me->x-FIXAMT*4)
+	{
+		if(ty<me->y-FIXAMT*4)
+			me->facing=5;
+		else if(ty>me->y+FIXAMT*4)
+			me->facing=3;
+		else
+			me->facing=4;
+	}
+	else if(tx>me->x+FIXAMT*4)
+	{
+		if(ty<me->y-FIXAMT*4)
+			me->facing=7;
+		else if(ty>me->y+FIXAMT*4)
+			me->facing=1;
+		else
+			me->facing=0;
+	}
+	else
+	{
+		if(ty<me->y-FIXAMT*4)
+			me->facing=6;
+		else if(ty>me->y+FIXAMT*4)
+			me->facing=2;
+	}
+}
+
 // this version doesn't insta-face, it rotates toward the right facing, and it has much
 // more leeway than the 16 pixels of the other (it's for bigger creatures)
 inline void FaceGoodguy2(Guy *me,Guy *goodguy)
@@ -318,6 +318,8 @@
 #define NUM_MONSTHEMES	(28)
 
 typedef void (*Monster_AIFunc)(Guy *,Map *,world_t *,Guy *);
+struct thought_t;
+typedef void (*Monster_ThinkFunc)(Guy *,Map *,world_t *,Guy *,thought_t *);
 
 typedef struct monsterType_t
 {
@@ -336,22 +338,39 @@ typedef struct monsterType_t
 	byte anim[NUM_ANIMS][ANIM_LENGTH];
 } monsterType_t;
 
+// The fields collision and the AIs look at every tick, copied out of monsType
+// by InitMonsters so they sit 16 bytes apart instead of 300.  This copy is the
+// one that counts while playing: SetMonsterFlags changes both, anything that
+// changes a monster's flags for a moment changes only this.
+typedef struct monsterHot_t
+{
+	Monster_AIFunc AI;
+	word flags;
+	word hp;
+	byte size;
+	byte framesPerDir;
+} monsterHot_t;
+
+extern monsterHot_t monsHot[NUM_MONSTERS];
+
 void InitMonsters(void);
 void ExitMonsters(void);
 
-void PurgeMonsterSprites(void);
+void PurgeMonsterSprites(void);	// free every monster sprite set nothing holds
+void PreloadLevelSprites(Map *map);	// load and hold the sets the level's monsters and specials use
+void ReleaseLevelSprites(void);	// stop holding them, keep what fits config.spriteBudget
+void AgeMonsterSprites(void);	// once a drawn frame
+// custom graphics shared out of the same pool, NULL if the file won't load
+sprite_set_t *LoadCustomSprites(const char *fname);
+void FreeCustomSprites(sprite_set_t *set);
 
 monsterType_t *GetMonsterType(dword type);
 
 void ChangeOffColor(dword type,byte from,byte to);
-byte MonsterSize(dword type);
 byte *MonsterAnim(dword type,byte anim);
-word MonsterFlags(dword type,byte aiType);
 dword MonsterTheme(dword type);
 void SetMonsterFlags(dword type,word flags);
-byte MonsterFrames(dword type);
-byte MonsterFrames(dword type,byte aiType);
-word MonsterHP(dword type);
+dword BouaphaBody(dword type);	// the type whose flags and frames Bouapha has right now
 word MonsterPoints(dword type);
 char *MonsterName(short type);
 void MonsterDraw(int x,int y,int z,dword type,dword aiType,byte seq,byte frm,byte facing,char bright,byte ouch,byte poison,byte frozen,sprite_set_t* set);
@@ -360,7 +379,42 @@ int InstaRenderScannedMonster(int x,int y,dword type,char bright,MGLDraw *mgl);
 sprite_t *GetMonsterSprite(dword type,byte seq,byte frm,byte facing);
 int RangeToTarget(Guy *me,Guy *goodguy);
 
+Monster_ThinkFunc MonsterThink(dword type);	// NULL unless its AI can run in the parallel think, see think.h
+
+inline Monster_AIFunc MonsterAI(dword type)
+{
+	return monsHot[type].AI;
+}
+
+inline byte MonsterSize(dword type)
+{
+	return monsHot[type].size;
+}
+
+inline word MonsterFlags(dword type,byte aiType)
+{
+	if(aiType==MONS_BOUAPHA)
+		type=BouaphaBody(type);
+	return monsHot[type].flags;
+}
+
+inline byte MonsterFrames(dword type,byte aiType)
+{
+	if(aiType==MONS_BOUAPHA)
+		type=BouaphaBody(type);
+	return monsHot[type].framesPerDir;
+}
+
+inline word MonsterHP(dword type)
+{
+	return monsHot[type].hp;
+}
+
 // ai functions for each monster type
+// the ones with a Think_ version are their AI_ version, worked so it can
+// run in the parallel think
+void Think_Bonehead(Guy *me,Map *map,world_t *world,Guy *goodguy,thought_t *t);
+void Think_Zombie(Guy *me,Map *map,world_t *world,Guy *goodguy,thought_t *t);
 void AI_Bonehead(Guy *me,Map *map,world_t *world,Guy *goodguy);
 void AI_Bat(Guy *me,Map *map,world_t *world,Guy *goodguy);
 void AI_Spider(Guy *me,Map *map,world_t *world,Guy *goodguy);
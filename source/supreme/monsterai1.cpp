@@ -1,6 +1,6 @@
 int pickupX,pickupY;
 
-void AI_Bonehead(Guy *me,Map *map,world_t *world,Guy *goodguy)
+void Think_Bonehead(Guy *me,Map *map,world_t *world,Guy *goodguy,thought_t *t)
 {
 	int x,y;
 
@@ -10,9 +10,9 @@ void AI_Bonehead(Guy *me,Map *map,world_t *world,Guy *goodguy)
 	if(me->ouch==4)
 	{
 		if(me->hp>0)
-			MakeSound(SND_SKELOUCH,me->x,me->y,SND_CUTOFF,1200);
+			ThoughtSound(t,SND_SKELOUCH,me->x,me->y,SND_CUTOFF,1200);
 		else
-			MakeSound(SND_SKELDIE,me->x,me->y,SND_CUTOFF,1200);
+			ThoughtSound(t,SND_SKELDIE,me->x,me->y,SND_CUTOFF,1200);
 	}
 
 	if(me->action==ACTION_BUSY)
@@ -22,14 +22,14 @@ void AI_Bonehead(Guy *me,Map *map,world_t *world,Guy *goodguy)
 			x=me->x+Cosine(me->facing*32)*16;
 			y=me->y+Sine(me->facing*32)*16;
 			if(me->AttackCheck(16,x>>FIXSHIFT,y>>FIXSHIFT,goodguy))
-				goodguy->GetShot(Cosine(me->facing*32)*4,Sine(me->facing*32)*4,4,map,world);
+				ThoughtHit(t,goodguy,Cosine(me->facing*32)*4,Sine(me->facing*32)*4,4,map,world);
 			me->reload=5;
 		}
 		if(me->seq==ANIM_A1 && me->frm==3 && me->reload==0 && goodguy)
 		{
 			x=me->x+Cosine(me->facing*32)*16;
 			y=me->y+Sine(me->facing*32)*16;
-			FireBullet(x,y,me->facing*32,BLT_ENERGY,me->friendly);
+			ThoughtShoot(t,x,y,me->facing*32,BLT_ENERGY,me->friendly);
 			me->reload=5;
 			me->mind1=1;
 		}
@@ -38,7 +38,7 @@ void AI_Bonehead(Guy *me,Map *map,world_t *world,Guy *goodguy)
 
 	// randomly decide to point at Bouapha to unnerve him
 	// (but only if in pursuit mode, because otherwise you'd point the wrong way)
-	if((!Random(100)) && me->mind==0)
+	if((!ThoughtRandom(t,100)) && me->mind==0)
 	{
 		me->seq=ANIM_A2;
 		me->frm=0;
@@ -54,10 +54,10 @@ void AI_Bonehead(Guy *me,Map *map,world_t *world,Guy *goodguy)
 	{
 		if(goodguy)
 		{
-			if(RangeToTarget(me,goodguy)<(48*FIXAMT) && Random(8)==0)
+			if(RangeToTarget(me,goodguy)<(48*FIXAMT) && ThoughtRandom(t,8)==0)
 			{
 				// get him!
-				MakeSound(SND_SKELKICK,me->x,me->y,SND_CUTOFF,1200);
+				ThoughtSound(t,SND_SKELKICK,me->x,me->y,SND_CUTOFF,1200);
 				me->seq=ANIM_ATTACK;
 				me->frm=0;
 				me->frmTimer=0;
@@ -68,7 +68,7 @@ void AI_Bonehead(Guy *me,Map *map,world_t *world,Guy *goodguy)
 				me->reload=0;
 				return;
 			}
-			FaceGoodguy(me,goodguy);
+			ChaseGoodguy(me,goodguy,map);
 
 			me->dx=Cosine(me->facing*32)*4;
 			me->dy=Sine(me->facing*32)*4;
@@ -79,7 +79,7 @@ void AI_Bonehead(Guy *me,Map *map,world_t *world,Guy *goodguy)
 				me->frmTimer=0;
 				me->frmAdvance=128;
 			}
-			if(Random(64)==0)
+			if(ThoughtRandom(t,64)==0)
 			{
 				me->mind=1;		// occasionally wander
 				me->mind1=1;
@@ -95,10 +95,10 @@ void AI_Bonehead(Guy *me,Map *map,world_t *world,Guy *goodguy)
 	{
 		if(goodguy)
 		{
-			if(RangeToTarget(me,goodguy)<(512*FIXAMT) && Random(32)==0)
+			if(RangeToTarget(me,goodguy)<(512*FIXAMT) && ThoughtRandom(t,32)==0)
 			{
 				// spit at him
-				MakeSound(SND_SKELSHOOT,me->x,me->y,SND_CUTOFF,1200);
+				ThoughtSound(t,SND_SKELSHOOT,me->x,me->y,SND_CUTOFF,1200);
 				me->seq=ANIM_A1;
 				me->frm=0;
 				me->frmTimer=0;
@@ -113,11 +113,11 @@ void AI_Bonehead(Guy *me,Map *map,world_t *world,Guy *goodguy)
 		}
 		if(!(me->mind1--))	// time to get a new direction
 		{
-			if((goodguy) && Random(3)==0)
+			if((goodguy) && ThoughtRandom(t,3)==0)
 				me->mind=0;	// get back on track
 			else
-				me->facing=(byte)Random(8);
-			me->mind1=Random(40)+1;
+				me->facing=(byte)ThoughtRandom(t,8);
+			me->mind1=ThoughtRandom(t,40)+1;
 		}
 
 		me->dx=Cosine(me->facing*32)*4;
@@ -132,6 +132,11 @@ void AI_Bonehead(Guy *me,Map *map,world_t *world,Guy *goodguy)
 	}
 }
 
+void AI_Bonehead(Guy *me,Map *map,world_t *world,Guy *goodguy)
+{
+	Think_Bonehead(me,map,world,goodguy,NULL);
+}
+
 void AI_Bat(Guy *me,Map *map,world_t *world,Guy *goodguy)
 {
 	int x,y;
@@ -382,7 +387,7 @@ void AI_BigSpider(Guy *me,Map *map,world_t *world,Guy *goodguy)
 	}
 }
 
-void AI_Zombie(Guy *me,Map *map,world_t *world,Guy *goodguy)
+void Think_Zombie(Guy *me,Map *map,world_t *world,Guy *goodguy,thought_t *t)
 {
 	int x,y;
 
@@ -392,9 +397,9 @@ void AI_Zombie(Guy *me,Map *map,world_t *world,Guy *goodguy)
 	if(me->ouch==4)
 	{
 		if(me->hp>0)
-			MakeSound(SND_ZOMBIEOUCH,me->x,me->y,SND_CUTOFF,1200);
+			ThoughtSound(t,SND_ZOMBIEOUCH,me->x,me->y,SND_CUTOFF,1200);
 		else
-			MakeSound(SND_ZOMBIEDIE,me->x,me->y,SND_CUTOFF,1200);
+			ThoughtSound(t,SND_ZOMBIEDIE,me->x,me->y,SND_CUTOFF,1200);
 	}
 
 	if(me->action==ACTION_BUSY)
@@ -415,7 +420,7 @@ void AI_Zombie(Guy *me,Map *map,world_t *world,Guy *goodguy)
 			y=me->y+Sine(me->facing*32)*16;
 			if(me->AttackCheck(8,x>>FIXSHIFT,y>>FIXSHIFT,goodguy))
 			{
-				goodguy->GetShot(Cosine(me->facing*32)*4,Sine(me->facing*32)*4,1,map,world);
+				ThoughtHit(t,goodguy,Cosine(me->facing*32)*4,Sine(me->facing*32)*4,1,map,world);
 				me->reload=2;
 			}
 		}
@@ -426,10 +431,10 @@ void AI_Zombie(Guy *me,Map *map,world_t *world,Guy *goodguy)
 	{
 		if(goodguy)
 		{
-			if(RangeToTarget(me,goodguy)<(128*FIXAMT) && Random(32)==0)
+			if(RangeToTarget(me,goodguy)<(128*FIXAMT) && ThoughtRandom(t,32)==0)
 			{
 				// get him!
-				MakeSound(SND_ZOMBIELEAP,me->x,me->y,SND_CUTOFF,1200);
+				ThoughtSound(t,SND_ZOMBIELEAP,me->x,me->y,SND_CUTOFF,1200);
 				me->seq=ANIM_ATTACK;
 				me->frm=0;
 				me->frmTimer=0;
@@ -441,7 +446,7 @@ void AI_Zombie(Guy *me,Map *map,world_t *world,Guy *goodguy)
 				return;
 			}
 
-			FaceGoodguy(me,goodguy);
+			ChaseGoodguy(me,goodguy,map);
 
 			me->dx=Cosine(me->facing*32)*1;
 			me->dy=Sine(me->facing*32)*1;
@@ -452,7 +457,7 @@ void AI_Zombie(Guy *me,Map *map,world_t *world,Guy *goodguy)
 				me->frmTimer=0;
 				me->frmAdvance=64;
 			}
-			if(Random(64)==0)
+			if(ThoughtRandom(t,64)==0)
 			{
 				me->mind=1;		// occasionally wander
 				me->mind1=1;
@@ -468,11 +473,11 @@ void AI_Zombie(Guy *me,Map *map,world_t *world,Guy *goodguy)
 	{
 		if(!(me->mind1--))	// time to get a new direction
 		{
-			if((goodguy) && Random(3)==0)
+			if((goodguy) && ThoughtRandom(t,3)==0)
 				me->mind=0;	// get back on track
 			else
-				me->facing=(byte)Random(8);
-			me->mind1=Random(40)+1;
+				me->facing=(byte)ThoughtRandom(t,8);
+			me->mind1=ThoughtRandom(t,40)+1;
 		}
 
 		me->dx=Cosine(me->facing*32)*1;
@@ -487,6 +492,11 @@ void AI_Zombie(Guy *me,Map *map,world_t *world,Guy *goodguy)
 	}
 }
 
+void AI_Zombie(Guy *me,Map *map,world_t *world,Guy *goodguy)
+{
+	Think_Zombie(me,map,world,goodguy,NULL);
+}
+
 void AI_EggSac(Guy *me,Map *map,world_t *world,Guy *goodguy)
 {
 	Guy *g;
@@ -388,10 +388,10 @@ void AI_Vampire(Guy *me,Map *map,world_t *world,Guy *goodguy)
 		// get burned by the light!
 		if(map->GetTile(me->mapx,me->mapy)->light>0 && me->ouch==0 && me->hp>0)
 		{
-			d=monsType[me->type].flags;
-			monsType[me->type].flags=0;
+			d=monsHot[me->type].flags;
+			monsHot[me->type].flags=0;
 			me->GetShot(0,0,map->GetTile(me->mapx,me->mapy)->light,map,world);
-			monsType[me->type].flags=d;
+			monsHot[me->type].flags=d;
 			BlowSmoke(me->x,me->y,FIXAMT*10,Random(6)*FIXAMT);
 			BlowSmoke(me->x,me->y,FIXAMT*10,Random(6)*FIXAMT);
 			BlowSmoke(me->x,me->y,FIXAMT*10,Random(6)*FIXAMT);
@@ -4,6 +4,11 @@
 #include "monster.h"
 #include "progress.h"
 #include "shop.h"
+#include "perf.h"
+#include "randstream.h"
+
+static RandomStream particleRng(RAND_PARTICLE);
+static RandomStream renderRng(RAND_RENDER);	// rolls made while drawing, so frames drawn or skipped don't move particleRng
 
 Particle **particleList;
 int		maxParticles;
@@ -31,13 +36,13 @@ void Particle::SpurtGo(byte type,int x,int y,int z,byte angle,byte force)
 
 	if(fforce==0)
 		fforce=1;
-	this->x=x+Random(4<<FIXSHIFT)-(2<<FIXSHIFT);
-	this->y=y+Random(4<<FIXSHIFT)-(2<<FIXSHIFT);
+	this->x=x+particleRng.Random(4<<FIXSHIFT)-(2<<FIXSHIFT);
+	this->y=y+particleRng.Random(4<<FIXSHIFT)-(2<<FIXSHIFT);
 	this->z=z;
-	this->dx=Cosine(angle)*Random(fforce);
-	this->dy=Sine(angle)*Random(fforce);
-	this->dz=Random(fforce*2)<<FIXSHIFT;
-	this->life=Random(force)+10;
+	this->dx=Cosine(angle)*particleRng.Random(fforce);
+	this->dy=Sine(angle)*particleRng.Random(fforce);
+	this->dz=particleRng.Random(fforce*2)<<FIXSHIFT;
+	this->life=particleRng.Random(force)+10;
 }
 
 void Particle::Go(byte type,int x,int y,int z,byte angle,byte force)
@@ -56,13 +61,13 @@ void Particle::Go(byte type,int x,int y,int z,byte angle,byte force)
 
 	if(fforce==0)
 		fforce=1;
-	this->x=x+Random(32<<FIXSHIFT)-(16<<FIXSHIFT);
-	this->y=y+Random(32<<FIXSHIFT)-(16<<FIXSHIFT);
+	this->x=x+particleRng.Random(32<<FIXSHIFT)-(16<<FIXSHIFT);
+	this->y=y+particleRng.Random(32<<FIXSHIFT)-(16<<FIXSHIFT);
 	this->z=z;
-	this->dx=Cosine(angle)*Random(fforce);
-	this->dy=Sine(angle)*Random(fforce);
-	this->dz=Random(fforce*2)<<FIXSHIFT;
-	this->life=Random(force)+10;
+	this->dx=Cosine(angle)*particleRng.Random(fforce);
+	this->dy=Sine(angle)*particleRng.Random(fforce);
+	this->dz=particleRng.Random(fforce*2)<<FIXSHIFT;
+	this->life=particleRng.Random(force)+10;
 }
 
 void Particle::GoExact(byte type,int x,int y,int z,byte angle,byte force)
@@ -88,7 +93,7 @@ void Particle::GoExact(byte type,int x,int y,int z,byte angle,byte force)
 	this->dy=Sine(angle)*force;
 	this->dz=force*FIXAMT*2;
 	this->life=25;
-	this->color=(Random(7)+1)*32+16;
+	this->color=(particleRng.Random(7)+1)*32+16;
 	if(this->color==32*2+16)
 		this->color=32*7+16;
 }
@@ -107,35 +112,41 @@ void Particle::GoLightning(int x,int y,int x2,int y2)
 
 void Particle::GoRandom(byte type,int x,int y,int z,byte force)
 {
+	dword r[6];
+
 	this->type=type;
 	size=2;
 	if(force==0)
 		return;
 
-	this->x=x+Random(32<<FIXSHIFT)-(16<<FIXSHIFT);
-	this->y=y+Random(32<<FIXSHIFT)-(16<<FIXSHIFT);
+	particleRng.Fill(r,6);	// these go off by the dozen, so all six at once
+	this->x=x+RandomStream::Scale(r[0],32<<FIXSHIFT)-(16<<FIXSHIFT);
+	this->y=y+RandomStream::Scale(r[1],32<<FIXSHIFT)-(16<<FIXSHIFT);
 	this->z=z;
-	this->dx=(Random(force)-force/2)<<FIXSHIFT;
-	this->dy=(Random(force)-force/2)<<FIXSHIFT;
-	this->dz=Random(force*2)<<FIXSHIFT;
-	this->life=Random(force)+20;
+	this->dx=(RandomStream::Scale(r[2],force)-force/2)<<FIXSHIFT;
+	this->dy=(RandomStream::Scale(r[3],force)-force/2)<<FIXSHIFT;
+	this->dz=RandomStream::Scale(r[4],force*2)<<FIXSHIFT;
+	this->life=RandomStream::Scale(r[5],force)+20;
 	if(profile.progress.purchase[modeShopNum[MODE_SPLATTER]]&SIF_ACTIVE)
 		size=20;
 }
 
 void Particle::GoRandomColor(byte color,int x,int y,int z,byte force)
 {
+	dword r[6];
+
 	this->type=type;
 	if(force==0)
 		return;
 
-	this->x=x+Random(32<<FIXSHIFT)-(16<<FIXSHIFT);
-	this->y=y+Random(32<<FIXSHIFT)-(16<<FIXSHIFT);
+	particleRng.Fill(r,6);
+	this->x=x+RandomStream::Scale(r[0],32<<FIXSHIFT)-(16<<FIXSHIFT);
+	this->y=y+RandomStream::Scale(r[1],32<<FIXSHIFT)-(16<<FIXSHIFT);
 	this->z=z;
-	this->dx=(Random(force)-force/2)<<FIXSHIFT;
-	this->dy=(Random(force)-force/2)<<FIXSHIFT;
-	this->dz=Random(force*2)<<FIXSHIFT;
-	this->life=Random(force)+20;
+	this->dx=(RandomStream::Scale(r[2],force)-force/2)<<FIXSHIFT;
+	this->dy=(RandomStream::Scale(r[3],force)-force/2)<<FIXSHIFT;
+	this->dz=RandomStream::Scale(r[4],force*2)<<FIXSHIFT;
+	this->life=RandomStream::Scale(r[5],force)+20;
 	this->size=this->life/2;
 	if(profile.progress.purchase[modeShopNum[MODE_SPLATTER]]&SIF_ACTIVE)
 		size=20;
@@ -177,8 +188,8 @@ void Particle::Update(Map *map)
 				dz+=FIXAMT;	// no gravity
 				z+=FIXAMT;
 				size=(6-life/8);
-				dx+=Random(FIXAMT)-FIXAMT/2;
-				dy+=Random(FIXAMT)-FIXAMT/2;
+				dx+=particleRng.Random(FIXAMT)-FIXAMT/2;
+				dy+=particleRng.Random(FIXAMT)-FIXAMT/2;
 				Dampen(&dx,FIXAMT/8);
 				Dampen(&dy,FIXAMT/8);
 				break;
@@ -186,8 +197,8 @@ void Particle::Update(Map *map)
 				dz+=FIXAMT;	// no gravity
 				z+=FIXAMT;
 				size=(3-life/8);
-				dx+=Random(FIXAMT*2)-FIXAMT;
-				dy+=Random(FIXAMT*2)-FIXAMT;
+				dx+=particleRng.Random(FIXAMT*2)-FIXAMT;
+				dy+=particleRng.Random(FIXAMT*2)-FIXAMT;
 				Dampen(&dx,FIXAMT/8);
 				Dampen(&dy,FIXAMT/8);
 				if(life==0)
@@ -208,8 +219,8 @@ void Particle::Update(Map *map)
 				size=((life/2)&3);
 				if(size==3)
 					size=1;
-				dx+=Random(FIXAMT)-FIXAMT/2;
-				dy+=Random(FIXAMT)-FIXAMT/2;
+				dx+=particleRng.Random(FIXAMT)-FIXAMT/2;
+				dy+=particleRng.Random(FIXAMT)-FIXAMT/2;
 				Dampen(&dx,FIXAMT/8);
 				Dampen(&dy,FIXAMT/8);
 				break;
@@ -292,7 +303,7 @@ void Particle::Update(Map *map)
 				if(z<=0)
 				{
 					life=0;
-					ExplodeParticles2(PART_WATER,x,y,z,1+Random(5),3);
+					ExplodeParticles2(PART_WATER,x,y,z,1+particleRng.Random(5),3);
 				}
 				break;
 			case PART_SLIME:
@@ -310,8 +321,8 @@ void Particle::Update(Map *map)
 					size=life/4;
 				break;
 			case PART_SNOW:
-				dx+=Random(FIXAMT)-FIXAMT/2;
-				dy+=Random(FIXAMT)-FIXAMT/2;
+				dx+=particleRng.Random(FIXAMT)-FIXAMT/2;
+				dy+=particleRng.Random(FIXAMT)-FIXAMT/2;
 				Dampen(&dx,FIXAMT/8);
 				Dampen(&dy,FIXAMT/8);
 				dz+=FIXAMT-1;	// not as much gravity as other things
@@ -412,6 +423,7 @@ void ExitParticles(void)
 void UpdateParticles(Map *map)
 {
 	int i;
+	PERF_SCOPE("particles");
 
 	snowCount=0;
 	for(i=0;i<maxParticles;i++)
@@ -422,13 +434,13 @@ void RenderParticle(int x,int y,byte *scrn,byte color,byte size)
 {
 	byte c1,c2;
 
-	if(x<0 || x>=SCRWID || y<0 || y>=SCRHEI)
+	if(x<0 || x>=viewWid || y<0 || y>=viewHei)
 		return;
 
 	switch(size)
 	{
 		case 2:	// big particle
-			if(x<2 || x>=SCRWID-2 || y<2 || y>=SCRHEI-2)
+			if(x<2 || x>=viewWid-2 || y<2 || y>=viewHei-2)
 				return;
 
 			if((color&31)>1)
@@ -440,42 +452,42 @@ void RenderParticle(int x,int y,byte *scrn,byte color,byte size)
 			else
 				c2=c1;
 
-			scrn+=(x+(y-2)*SCRWID);
+			scrn+=(x+(y-2)*viewWid);
 			*scrn=c2;
-			scrn+=SCRWID-1;
+			scrn+=viewWid-1;
 			*scrn++=c1;
 			*scrn++=color;
 			*scrn=c1;
-			scrn+=SCRWID-3;
+			scrn+=viewWid-3;
 			*scrn++=c2;
 			*scrn++=c1;
 			*scrn++=color;
 			*scrn++=c1;
 			*scrn=c2;
-			scrn+=SCRWID-3;
+			scrn+=viewWid-3;
 			*scrn++=c1;
 			*scrn++=color;
 			*scrn=c1;
-			*(scrn+SCRWID-1)=c2;
+			*(scrn+viewWid-1)=c2;
 			break;
 		case 1:	// normal particle
-			if(x<1 || x>SCRWID-2 || y<1 || y>SCRHEI-2)
+			if(x<1 || x>viewWid-2 || y<1 || y>viewHei-2)
 				return;
 			if(color&31)
 				c1=color-1;	// only do this if subtracting 1 keeps it in the same color group
 			else
 				c1=color;
-			scrn+=(x+(y-1)*SCRWID);
+			scrn+=(x+(y-1)*viewWid);
 			*scrn=c1;
-			scrn+=SCRWID-1;
+			scrn+=viewWid-1;
 			*scrn++=c1;
 			*scrn++=color;
 			*scrn=c1;
-			scrn+=SCRWID-1;
+			scrn+=viewWid-1;
 			*scrn=c1;
 			break;
 		case 0:	// tiny particle (1 pixel)
-			scrn[x+y*SCRWID]=color;
+			scrn[x+y*viewWid]=color;
 			break;
 	}
 }
@@ -484,18 +496,18 @@ void HLine(int x,int x2,int y,byte c,byte *scrn)
 {
 	if(x<0)
 		x=0;
-	if(x2>=SCRWID)
-		x2=SCRWID-1;
+	if(x2>=viewWid)
+		x2=viewWid-1;
 	if(x2<0)
 		return;
-	if(x>=SCRWID)
+	if(x>=viewWid)
 		return;
 	if(y<0)
 		return;
-	if(y>=SCRHEI)
+	if(y>=viewHei)
 		return;
 
-	scrn+=(x+y*SCRWID);
+	scrn+=(x+y*viewWid);
 	memset(scrn,c,x2-x+1);
 }
 
@@ -507,20 +519,20 @@ void HLine2(int x,int x2,int y,byte c,byte *scrn)
 
 	if(x<0)
 		x=0;
-	if(x2>=SCRWID)
-		x2=SCRWID-1;
+	if(x2>=viewWid)
+		x2=viewWid-1;
 	if(x2<0)
 		return;
-	if(x>=SCRWID)
+	if(x>=viewWid)
 		return;
 	if(y<0)
 		return;
-	if(y>=SCRHEI)
+	if(y>=viewHei)
 		return;
 
 	c1=(c&31);
 	c2=(c&(~31));
-	scrn+=(x+y*SCRWID);
+	scrn+=(x+y*viewWid);
 	for(i=x;i<=x2;i++)
 	{
 		b=*scrn;
@@ -545,15 +557,15 @@ void HLine3(int x,int x2,int y,byte c,byte less,byte *scrn)
 
 	if(x<0)
 		x=0;
-	if(x2>=SCRWID)
-		x2=SCRWID-1;
+	if(x2>=viewWid)
+		x2=viewWid-1;
 	if(x2<0)
 		return;
-	if(x>=SCRWID)
+	if(x>=viewWid)
 		return;
 	if(y<0)
 		return;
-	if(y>=SCRHEI)
+	if(y>=viewHei)
 		return;
 
 	if((c&31)<less)
@@ -569,7 +581,7 @@ void HLine3(int x,int x2,int y,byte c,byte less,byte *scrn)
 	dCol=(centerCol/((x2-x)/2));
 
 	colRange=(c&(~31));
-	scrn+=(x+y*SCRWID);
+	scrn+=(x+y*viewWid);
 	for(i=x;i<=x2;i++)
 	{
 
@@ -662,9 +674,9 @@ void RenderLightningParticle(int x1,int y1,int x2,int y2,int range,byte bright,b
 	// base case: draw the (x1,y1) pixel
 	if((x1-x2<2 && x1-x2>-2) && (y1-y2<2 && y1-y2>-2))
 	{
-		if(x1>=0 && x1<SCRWID-5 && y1>=0 && y1<SCRHEI-5)
+		if(x1>=0 && x1<viewWid-5 && y1>=0 && y1<viewHei-5)
 		{
-			scrn+=(x1+y1*SCRWID);
+			scrn+=(x1+y1*viewWid);
 			ctptr=&ctab[0];
 			for(midy=y1;midy<y1+5;midy++)
 			{
@@ -679,7 +691,7 @@ void RenderLightningParticle(int x1,int y1,int x2,int y2,int range,byte bright,b
 					ctptr++;
 					scrn++;
 				}
-				scrn+=SCRWID-5;
+				scrn+=viewWid-5;
 			}
 		}
 	}
@@ -691,12 +703,12 @@ void RenderLightningParticle(int x1,int y1,int x2,int y2,int range,byte bright,b
 			midx=x1+(x2-x1)/2;
 		else
 			midx=x2+(x1-x2)/2;
-		midx+=Random(range)-range/2;
+		midx+=renderRng.Random(range)-range/2;
 		if(y1<y2)
 			midy=y1+(y2-y1)/2;
 		else
 			midy=y2+(y1-y2)/2;
-		midy+=Random(range)-range/2;
+		midy+=renderRng.Random(range)-range/2;
 		RenderLightningParticle(x1,y1,midx,midy,range*3/4,bright,scrn);
 		RenderLightningParticle(midx,midy,x2,y2,range*3/4,bright,scrn);
 	}
@@ -761,7 +773,7 @@ int BlowSmoke(int x,int y,int z,int dz)
 			particleList[i]->dx=0;
 			particleList[i]->dy=0;
 			particleList[i]->dz=dz;
-			particleList[i]->life=6*4-Random(8);
+			particleList[i]->life=6*4-particleRng.Random(8);
 			particleList[i]->size=6;
 			particleList[i]->color=64;
 			particleList[i]->type=PART_SMOKE;
@@ -777,11 +789,11 @@ void SmokeTile(int x,int y)
 
 	for(i=0;i<3;i++)
 	{
-		j=BlowSmoke((x*TILE_WIDTH+Random(TILE_WIDTH))*FIXAMT,(y*TILE_HEIGHT+Random(TILE_HEIGHT))*FIXAMT,0,FIXAMT/8);
+		j=BlowSmoke((x*TILE_WIDTH+particleRng.Random(TILE_WIDTH))*FIXAMT,(y*TILE_HEIGHT+particleRng.Random(TILE_HEIGHT))*FIXAMT,0,FIXAMT/8);
 		if(j!=-1)
 		{
-			particleList[j]->dx=-FIXAMT*2+Random(FIXAMT*4+1);
-			particleList[j]->dy=-FIXAMT*2+Random(FIXAMT*4+1);
+			particleList[j]->dx=-FIXAMT*2+particleRng.Random(FIXAMT*4+1);
+			particleList[j]->dy=-FIXAMT*2+particleRng.Random(FIXAMT*4+1);
 		}
 	}
 }
@@ -797,10 +809,10 @@ void BlowBubble(int x,int y,int z,int dz)
 			particleList[i]->x=x;
 			particleList[i]->y=y;
 			particleList[i]->z=z;
-			particleList[i]->dx=-FIXAMT+Random(FIXAMT*2);
-			particleList[i]->dy=-FIXAMT+Random(FIXAMT*2);
+			particleList[i]->dx=-FIXAMT+particleRng.Random(FIXAMT*2);
+			particleList[i]->dy=-FIXAMT+particleRng.Random(FIXAMT*2);
 			particleList[i]->dz=dz;
-			particleList[i]->life=3*8+7-Random(8);
+			particleList[i]->life=3*8+7-particleRng.Random(8);
 			particleList[i]->size=0;
 			particleList[i]->color=64;
 			particleList[i]->type=PART_BUBBLE;
@@ -820,10 +832,10 @@ void MindControlSparks(int x,int y,int z,int dz)
 			particleList[i]->x=x;
 			particleList[i]->y=y;
 			particleList[i]->z=z;
-			particleList[i]->dx=-FIXAMT*3+Random(FIXAMT*6);
-			particleList[i]->dy=-FIXAMT*3+Random(FIXAMT*6);
+			particleList[i]->dx=-FIXAMT*3+particleRng.Random(FIXAMT*6);
+			particleList[i]->dy=-FIXAMT*3+particleRng.Random(FIXAMT*6);
 			particleList[i]->dz=dz;
-			particleList[i]->life=20+Random(20);
+			particleList[i]->life=20+particleRng.Random(20);
 			particleList[i]->size=0;
 			particleList[i]->color=64;
 			particleList[i]->type=PART_MINDCONTROL;
@@ -844,7 +856,7 @@ void StinkySteam(int x,int y,int z,int dz)
 			particleList[i]->dx=0;
 			particleList[i]->dy=0;
 			particleList[i]->dz=dz;
-			particleList[i]->life=6*4-Random(8);
+			particleList[i]->life=6*4-particleRng.Random(8);
 			particleList[i]->size=0;
 			particleList[i]->color=64;
 			particleList[i]->type=PART_STINKY;
@@ -883,8 +895,8 @@ void BlowUpGuy(int x,int y,int x2,int y2,int z,byte amt)
 	{
 		if(!particleList[i]->Alive())
 		{
-			particleList[i]->x=(x+Random(x2-x))<<FIXSHIFT;
-			particleList[i]->y=(y+Random(y2-y))<<FIXSHIFT;
+			particleList[i]->x=(x+particleRng.Random(x2-x))<<FIXSHIFT;
+			particleList[i]->y=(y+particleRng.Random(y2-y))<<FIXSHIFT;
 			particleList[i]->z=z;
 			particleList[i]->dx=0;
 			particleList[i]->dy=0;
@@ -908,12 +920,12 @@ void GlassShatter(int x,int y,int x2,int y2,int z,byte amt)
 	{
 		if(!particleList[i]->Alive())
 		{
-			particleList[i]->x=(x+Random(x2-x))<<FIXSHIFT;
-			particleList[i]->y=(y+Random(y2-y))<<FIXSHIFT;
+			particleList[i]->x=(x+particleRng.Random(x2-x))<<FIXSHIFT;
+			particleList[i]->y=(y+particleRng.Random(y2-y))<<FIXSHIFT;
 			particleList[i]->z=z;
-			particleList[i]->GoRandom(PART_GLASS,(x+Random(x2-x))<<FIXSHIFT,(y+Random(y2-y))<<FIXSHIFT,
-					Random(10*FIXAMT),20);
-			particleList[i]->color=Random(8)*32+16;
+			particleList[i]->GoRandom(PART_GLASS,(x+particleRng.Random(x2-x))<<FIXSHIFT,(y+particleRng.Random(y2-y))<<FIXSHIFT,
+					particleRng.Random(10*FIXAMT),20);
+			particleList[i]->color=particleRng.Random(8)*32+16;
 			if(!(--amt))
 				break;
 		}
@@ -1071,9 +1083,9 @@ void HealRing(byte color,int x,int y,int z,byte num,byte force)
 			particleList[i]->GoExact(PART_FX,x,y,z,a,force);
 			particleList[i]->x+=particleList[i]->dx*20;
 			particleList[i]->y+=particleList[i]->dy*20;
-			particleList[i]->dx+=-(force/4)+Random(force/2+1);
-			particleList[i]->dy+=-(force/4)+Random(force/2+1);
-			particleList[i]->dz=FIXAMT*5-Random(FIXAMT*3);
+			particleList[i]->dx+=-(force/4)+particleRng.Random(force/2+1);
+			particleList[i]->dy+=-(force/4)+particleRng.Random(force/2+1);
+			particleList[i]->dz=FIXAMT*5-particleRng.Random(FIXAMT*3);
 			particleList[i]->color=color*32+16;
 			particleList[i]->tx=x;
 			particleList[i]->life=50;
@@ -1133,9 +1145,9 @@ void ColorDrop(byte color,int x,int y,int z)
 			particleList[i]->color=color*32+16;
 			particleList[i]->size=50;
 			particleList[i]->life=15;
-			particleList[i]->dx=-64+Random(129);
-			particleList[i]->dy=-64+Random(129);
-			particleList[i]->dz=-64+Random(129);
+			particleList[i]->dx=-64+particleRng.Random(129);
+			particleList[i]->dy=-64+particleRng.Random(129);
+			particleList[i]->dz=-64+particleRng.Random(129);
 			particleList[i]->x=x;
 			particleList[i]->y=y;
 			particleList[i]->z=z;
@@ -1150,25 +1162,25 @@ void MakeItSnow(Map *map)
 	int cx,cy;
 
 	// only 25% of particles may be snowflakes
-	if(Random(100)>30 || snowCount>maxParticles/4)
+	if(particleRng.Random(100)>30 || snowCount>maxParticles/4)
 		return;
 
 	GetCamera(&cx,&cy);
-	cx-=320;
-	cy-=240;
+	cx-=viewWid/2;
+	cy-=viewHei/2;
 	for(i=0;i<maxParticles;i++)
 	{
 		if(!particleList[i]->Alive())
 		{
 
-			particleList[i]->x=(Random(SCRWID)+cx)<<FIXSHIFT;
-			particleList[i]->y=(Random(SCRHEI)+cy)<<FIXSHIFT;
-			particleList[i]->z=(300+Random(300))<<FIXSHIFT;
+			particleList[i]->x=(particleRng.Random(viewWid)+cx)<<FIXSHIFT;
+			particleList[i]->y=(particleRng.Random(viewHei)+cy)<<FIXSHIFT;
+			particleList[i]->z=(300+particleRng.Random(300))<<FIXSHIFT;
 			particleList[i]->dx=0;
 			particleList[i]->dy=0;
 			particleList[i]->dz=0;
 			particleList[i]->size=2;
-			particleList[i]->life=50+Random(50);
+			particleList[i]->life=50+particleRng.Random(50);
 			particleList[i]->type=PART_SNOW;
 			particleList[i]->color=31;
 			break;
@@ -1182,25 +1194,25 @@ void MakeItRain(Map *map)
 	int cx,cy;
 
 	// only 25% of particles may be rain
-	if(Random(100)>30 || snowCount>maxParticles/4)
+	if(particleRng.Random(100)>30 || snowCount>maxParticles/4)
 		return;
 
 	GetCamera(&cx,&cy);
-	cx-=320;
-	cy-=240;
+	cx-=viewWid/2;
+	cy-=viewHei/2;
 	for(i=0;i<maxParticles;i++)
 	{
 		if(!particleList[i]->Alive())
 		{
 
-			particleList[i]->x=(Random(SCRWID)+cx)<<FIXSHIFT;
-			particleList[i]->y=(Random(SCRHEI)+cy)<<FIXSHIFT;
-			particleList[i]->z=(300+Random(300))<<FIXSHIFT;
+			particleList[i]->x=(particleRng.Random(viewWid)+cx)<<FIXSHIFT;
+			particleList[i]->y=(particleRng.Random(viewHei)+cy)<<FIXSHIFT;
+			particleList[i]->z=(300+particleRng.Random(300))<<FIXSHIFT;
 			particleList[i]->dx=0;
 			particleList[i]->dy=0;
 			particleList[i]->dz=-FIXAMT*2;
 			particleList[i]->size=2;
-			particleList[i]->life=50+Random(50);
+			particleList[i]->life=50+particleRng.Random(50);
 			particleList[i]->type=PART_RAIN;
 			particleList[i]->color=3*32+16;
 			break;
@@ -1219,12 +1231,12 @@ void SpecialSnow(int x,int y)
 
 			particleList[i]->x=x;
 			particleList[i]->y=y;
-			particleList[i]->z=(10+Random(20))<<FIXSHIFT;
+			particleList[i]->z=(10+particleRng.Random(20))<<FIXSHIFT;
 			particleList[i]->dx=0;
 			particleList[i]->dy=0;
 			particleList[i]->dz=0;
 			particleList[i]->size=2;
-			particleList[i]->life=20+Random(30);
+			particleList[i]->life=20+particleRng.Random(30);
 			particleList[i]->type=PART_SNOW;
 			break;
 		}
@@ -1258,17 +1270,17 @@ void WeathermanWeather(int x,int y)
 	{
 		if(!particleList[i]->Alive())
 		{
-			a=Random(256);
+			a=particleRng.Random(256);
 
-			particleList[i]->x=x+Cosine(a)*Random(FIXAMT*60)/FIXAMT;
-			particleList[i]->y=y+Sine(a)*Random(FIXAMT*50)/FIXAMT;
-			particleList[i]->z=(300+Random(300))<<FIXSHIFT;
+			particleList[i]->x=x+Cosine(a)*particleRng.Random(FIXAMT*60)/FIXAMT;
+			particleList[i]->y=y+Sine(a)*particleRng.Random(FIXAMT*50)/FIXAMT;
+			particleList[i]->z=(300+particleRng.Random(300))<<FIXSHIFT;
 			particleList[i]->dx=0;
 			particleList[i]->dy=0;
 			particleList[i]->dz=0;
 			particleList[i]->size=2;
-			particleList[i]->life=50+Random(50);
-			if(Random(2)==0)
+			particleList[i]->life=50+particleRng.Random(50);
+			if(particleRng.Random(2)==0)
 			{
 				particleList[i]->type=PART_SNOW;
 				particleList[i]->color=31;
@@ -1296,16 +1308,16 @@ void JackFrostWeather(int x,int y)
 	{
 		if(!particleList[i]->Alive())
 		{
-			a=Random(256);
+			a=particleRng.Random(256);
 
-			particleList[i]->x=x+Cosine(a)*Random(FIXAMT*60)/FIXAMT;
-			particleList[i]->y=y+Sine(a)*Random(FIXAMT*50)/FIXAMT;
-			particleList[i]->z=(10+Random(100))<<FIXSHIFT;
-			particleList[i]->dx=-FIXAMT+Random(FIXAMT*2+1);
-			particleList[i]->dy=-FIXAMT+Random(FIXAMT*2+1);
+			particleList[i]->x=x+Cosine(a)*particleRng.Random(FIXAMT*60)/FIXAMT;
+			particleList[i]->y=y+Sine(a)*particleRng.Random(FIXAMT*50)/FIXAMT;
+			particleList[i]->z=(10+particleRng.Random(100))<<FIXSHIFT;
+			particleList[i]->dx=-FIXAMT+particleRng.Random(FIXAMT*2+1);
+			particleList[i]->dy=-FIXAMT+particleRng.Random(FIXAMT*2+1);
 			particleList[i]->dz=0;
 			particleList[i]->size=2;
-			particleList[i]->life=50+Random(50);
+			particleList[i]->life=50+particleRng.Random(50);
 			particleList[i]->type=PART_SNOW;
 			particleList[i]->color=31;
 			break;
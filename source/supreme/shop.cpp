@@ -9,6 +9,7 @@
 #include "moron.h"
 #include "gallery.h"
 #include "goal.h"
+#include "tilebits.h"
 
 #define NUMSHOPITEMS		(158)
 #define NUMBUILTINWORLDS	(79)
@@ -1047,6 +1048,7 @@ void SetupShops(Map *map)
 		map->map[11+20*map->width].item=0;
 	if(profile.progress.goal[87])
 		map->map[13+113*map->width].item=0;
+	AllTileBitsChanged(map);
 }
 
 void DefaultShopAvailability(void)
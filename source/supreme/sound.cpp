@@ -6,6 +6,8 @@
 #include "music.h"
 #include "shop.h"
 #include "appdata.h"
+#include "config.h"
+#include "perf.h"
 
 soundDesc_t soundInfo[MAX_SOUNDS]={
 	{SND_NONE,"No Sound At All!!",ST_EFFECT},
@@ -346,6 +348,29 @@ static int numSounds,numCustom;
 static byte *customSound[MAX_CUSTOM_SOUNDS];
 static long customLength[MAX_CUSTOM_SOUNDS];
 
+// While the game runs, sounds with a position are collected for the whole
+// LunaticRun and played together at the end of it.  The same sound asked for
+// again close by (a chain of explosions, a hail of bullets hitting a wall)
+// just makes the first one louder, and the batch is played highest priority
+// first, no more of them than there are channels, so the mixer isn't made to
+// start and halt a flood of copies that would cut each other off anyway.
+#define MAX_BATCHED		64
+#define MERGE_PAN		32	// how close in pan and volume a repeat must be
+#define MERGE_VOL		64
+
+typedef struct soundEvent_t
+{
+	int num;
+	long pan,vol;
+	int flags;
+	int priority;
+} soundEvent_t;
+
+static soundEvent_t batch[MAX_BATCHED];
+static int batchLen;
+static byte batching;
+static int sndSubmitted,sndMerged,sndCulled;
+
 void SoundSystemExists(void)
 {
 	soundAvailable=1;
@@ -379,6 +404,94 @@ void ClearCustomSounds(void)
 	numCustom=0;
 }
 
+void BeginSoundBatch(void)
+{
+	batching=1;
+	batchLen=0;
+	sndSubmitted=0;
+	sndMerged=0;
+	sndCulled=0;
+}
+
+static void BatchSound(int num,long pan,long vol,int flags,int priority)
+{
+	int i,low;
+	soundEvent_t *e;
+
+	if(!batching)
+	{
+		GoPlaySound(num,pan,vol,flags,priority);
+		return;
+	}
+
+	sndSubmitted++;
+	for(i=0;i<batchLen;i++)
+	{
+		e=&batch[i];
+		if(e->num==num && e->flags==flags && labs(e->pan-pan)<=MERGE_PAN && labs(e->vol-vol)<=MERGE_VOL)
+		{
+			if(vol>e->vol)
+			{
+				e->vol=vol;
+				e->pan=pan;
+			}
+			if(priority>e->priority)
+				e->priority=priority;
+			sndMerged++;
+			return;
+		}
+	}
+
+	if(batchLen<MAX_BATCHED)
+		e=&batch[batchLen++];
+	else
+	{
+		// full, so it can only push out something less important
+		low=0;
+		for(i=1;i<MAX_BATCHED;i++)
+			if(batch[i].priority<batch[low].priority)
+				low=i;
+		sndCulled++;
+		if(batch[low].priority>=priority)
+			return;
+		e=&batch[low];
+	}
+	e->num=num;
+	e->pan=pan;
+	e->vol=vol;
+	e->flags=flags;
+	e->priority=priority;
+}
+
+static int CompareSoundEvents(const void *a,const void *b)
+{
+	const soundEvent_t *ea=(const soundEvent_t *)a;
+	const soundEvent_t *eb=(const soundEvent_t *)b;
+
+	if(ea->priority!=eb->priority)
+		return eb->priority-ea->priority;
+	return (int)(eb->vol-ea->vol);
+}
+
+void EndSoundBatch(void)
+{
+	int i,n;
+
+	batching=0;
+	qsort(batch,batchLen,sizeof(soundEvent_t),CompareSoundEvents);
+	n=batchLen;
+	if(n>config.numSounds)
+		n=config.numSounds;
+	for(i=0;i<n;i++)
+		GoPlaySound(batch[i].num,batch[i].pan,batch[i].vol,batch[i].flags,batch[i].priority);
+
+	PerfCount("sounds submitted",sndSubmitted);
+	PerfCount("sounds merged",sndMerged);
+	PerfCount("sounds culled",sndCulled+batchLen-n);
+	PerfCount("sounds played",n);
+	batchLen=0;
+}
+
 int GlobalFlags()
 {
 	int result = 0;
@@ -418,8 +531,11 @@ void MakeSound(int snd,int x,int y,int flags,int priority)
 		pan=127;
 	}
 	if(vol<-255)
+	{
+		sndCulled+=batching;	// too far off to hear
 		return;
-	GoPlaySound(snd,pan,vol,flags|GlobalFlags(),priority);
+	}
+	BatchSound(snd,pan,vol,flags|GlobalFlags(),priority);
 }
 
 void MakeNormalSound(int snd)
@@ -462,8 +578,11 @@ void MakeCustomSound(int snd,int x,int y,int flags,int priority)
 		pan=127;
 	}
 	if(vol<-255)
+	{
+		sndCulled+=batching;
 		return;
-	GoPlaySound(soundInfo[snd].num,pan,vol,flags|GlobalFlags(),priority);
+	}
+	BatchSound(soundInfo[snd].num,pan,vol,flags|GlobalFlags(),priority);
 }
 
 void MakeNormalCustomSound(int snd)
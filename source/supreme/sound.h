@@ -433,6 +433,9 @@ void MakeCustomSound(int snd,int x,int y,int flags,int priority);
 void MakeNormalCustomSound(int snd);
 int GetCustomSoundByName(const char *name);
 void MakeSpaceSound(int snd,int priority);
+// between these, MakeSound and MakeCustomSound are merged and played all at once
+void BeginSoundBatch(void);
+void EndSoundBatch(void);
 
 int AppendCustomSounds(FILE *f);
 
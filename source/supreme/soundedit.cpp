@@ -10,7 +10,7 @@
 #define SNDMODE_NORMAL	0	// doing nothing
 #define SNDMODE_SELECT	1	// selecting a sound (for a special or whatever)
 #define SNDMODE_DELETE	2	// asking yes/no on sound deletion
-#define SNDMODE_LOAD	3	// picking a wav file (file menu)
+#define SNDMODE_LOAD	3	// picking a wav or ogg file (file menu)
 #define SNDMODE_NAME	4	// entering a name
 #define SNDMODE_RELOAD	5	// file menu again, but to replace
 #define SNDMODE_HELP	6
@@ -57,7 +57,7 @@ static void NewClick(int id)
 		return;
 
 	mode=SNDMODE_LOAD;
-	InitFileDialog("user/*.wav",FM_LOAD|FM_EXIT,"");
+	InitFileDialog("user/*.wav;*.ogg",FM_LOAD|FM_EXIT,"");
 	MakeNormalSound(SND_MENUSELECT);
 }
 
@@ -78,7 +78,7 @@ static void ReloadClick(int id)
 	if(curSound>=CUSTOM_SND_START)
 	{
 		mode=SNDMODE_RELOAD;
-		InitFileDialog("user/*.wav",FM_LOAD|FM_EXIT,"");
+		InitFileDialog("user/*.wav;*.ogg",FM_LOAD|FM_EXIT,"");
 		MakeNormalSound(SND_MENUSELECT);
 	}
 }
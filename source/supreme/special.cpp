@@ -13,6 +13,7 @@
 #include "shop.h"
 #include "goal.h"
 #include "palettes.h"
+#include "perf.h"
 
 static special_t *spcl;
 static byte numSpecials;
@@ -1766,6 +1767,7 @@ void SpecialEffect(special_t *me,Map *map)
 void CheckSpecials(Map *map)
 {
 	int i;
+	PERF_SCOPE("specials");
 
 	if(tagged && tagged->hp==0)
 		tagged=NULL;
@@ -1812,8 +1814,8 @@ void RenderSpecialXes(Map *map)
 	byte c;
 
 	GetCamera(&camx,&camy);
-	camx-=320;
-	camy-=240;
+	camx-=viewWid/2;
+	camy-=viewHei/2;
 	for(i=0;i<numSpecials;i++)
 	{
 		if(spcl[i].x!=255)
@@ -169,6 +169,8 @@ static char lvlFlagName[][16]={
 	"Stealth",
 	"Wavy",
 	"Oxygen Meter",
+	"Far Mons Doze",
+	"Smart Chasers",
 };
 
 static char wpnName[][16]={
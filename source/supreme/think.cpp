@@ -0,0 +1,308 @@
+#include "think.h"
+#include "monster.h"
+#include "bullet.h"
+#include "sound.h"
+#include "player.h"
+#include "config.h"
+#include "perf.h"
+#include <vector>
+#include <atomic>
+
+#ifdef SDL_UNPREFIXED
+	#include <SDL_thread.h>
+	#include <SDL_mutex.h>
+#else  // SDL_UNPREFIXED
+	#include <SDL2/SDL_thread.h>
+	#include <SDL2/SDL_mutex.h>
+#endif  // SDL_UNPREFIXED
+
+#define MAX_THINK_THREADS	16
+
+extern Guy **guys;
+extern int maxGuys;
+
+static std::vector<thought_t> thought;
+static std::vector<word> todo;
+static std::atomic<int> nextJob;
+static byte thinking;	// there are thoughts out this tick
+static dword thinkTick,thinkEpoch;
+static Map *thinkMap;
+static world_t *thinkWorld;
+
+// the helpers, started as they're first wanted and kept till the end
+static SDL_Thread *helper[MAX_THINK_THREADS];
+static int numHelpers;
+static byte helperFailed;
+static SDL_sem *go,*done;
+static std::atomic<bool> quitting;
+
+void InitThink(int maxGuys)
+{
+	int i;
+
+	thought.resize(maxGuys);
+	for(i=0;i<maxGuys;i++)
+	{
+		thought[i]=thought_t();
+		thought[i].me=new Guy();
+	}
+	thinking=0;
+}
+
+void ExitThink(void)
+{
+	int i;
+
+	for(i=0;i<(int)thought.size();i++)
+		delete thought[i].me;
+	thought.clear();
+	thinking=0;
+}
+
+//--------------------------------------------------------------------------
+// stand-ins for the things a thinking AI can't do yet
+
+dword ThoughtRandom(thought_t *t,dword range)
+{
+	if(!t)
+		return Random(range);
+	return t->rng.Random(range);
+}
+
+static intent_t *NewIntent(thought_t *t,byte what)
+{
+	intent_t *n;
+
+	if(t->numIntents==MAX_INTENTS)
+	{
+		t->overflow=1;
+		return NULL;
+	}
+	n=&t->intent[t->numIntents++];
+	memset(n,0,sizeof(intent_t));
+	n->what=what;
+	return n;
+}
+
+void ThoughtSound(thought_t *t,int snd,int x,int y,int flags,int priority)
+{
+	intent_t *n;
+
+	if(!t)
+	{
+		MakeSound(snd,x,y,flags,priority);
+		return;
+	}
+	if(!(n=NewIntent(t,INTENT_SOUND)))
+		return;
+	n->n=snd;
+	n->x=x;
+	n->y=y;
+	n->flags=flags;
+	n->priority=priority;
+}
+
+void ThoughtShoot(thought_t *t,int x,int y,byte facing,byte type,byte friendly)
+{
+	intent_t *n;
+
+	if(!t)
+	{
+		FireBullet(x,y,facing,type,friendly);
+		return;
+	}
+	if(!(n=NewIntent(t,INTENT_SHOOT)))
+		return;
+	n->x=x;
+	n->y=y;
+	n->facing=facing;
+	n->n=type;
+	n->friendly=friendly;
+}
+
+void ThoughtHit(thought_t *t,Guy *him,int dx,int dy,byte damage,Map *map,world_t *world)
+{
+	intent_t *n;
+
+	if(!t)
+	{
+		him->GetShot(dx,dy,damage,map,world);
+		return;
+	}
+	if(!(n=NewIntent(t,INTENT_HIT)))
+		return;
+	n->him=him;
+	n->x=dx;
+	n->y=dy;
+	n->n=damage;
+}
+
+//--------------------------------------------------------------------------
+
+static void Think(int i)
+{
+	thought_t *t=&thought[i];
+	Guy *me=guys[i];
+	Guy *copy=t->me;
+
+	*copy=*me;
+	copy->customSpr=NULL;	// the real one owns it
+	t->numIntents=0;
+	t->overflow=0;
+	t->rng=RandomStream(RAND_AI,i,thinkTick);
+	t->x=me->x;
+	t->y=me->y;
+	t->mapx=me->mapx;
+	t->mapy=me->mapy;
+	t->hp=me->hp;
+	t->seq=me->seq;
+	t->frm=me->frm;
+	t->action=me->action;
+	t->ouch=me->ouch;
+	MonsterThink(me->aiType)(copy,thinkMap,thinkWorld,me->target,t);
+	t->valid=!t->overflow;
+}
+
+static void ThinkJobs(void)
+{
+	int j;
+
+	while((j=nextJob++)<(int)todo.size())
+		Think(todo[j]);
+}
+
+static int SDLCALL HelperThread(void *)
+{
+	while(true)
+	{
+		SDL_SemWait(go);
+		if(quitting)
+			break;
+		ThinkJobs();
+		SDL_SemPost(done);
+	}
+	return 0;
+}
+
+static void StopHelpers(void)
+{
+	int i;
+
+	quitting=true;
+	for(i=0;i<numHelpers;i++)
+		SDL_SemPost(go);
+	for(i=0;i<numHelpers;i++)
+		SDL_WaitThread(helper[i],NULL);
+	numHelpers=0;
+}
+
+// as many helpers as there are to be, besides this thread.  Fewer if they
+// can't be had, which where there are no threads means none.
+static int Helpers(int want)
+{
+	if(want>MAX_THINK_THREADS)
+		want=MAX_THINK_THREADS;
+	if(!go)
+	{
+		go=SDL_CreateSemaphore(0);
+		done=SDL_CreateSemaphore(0);
+		if(!go || !done)
+			helperFailed=1;
+		else
+			atexit(StopHelpers);
+	}
+	while(numHelpers<want && !helperFailed)
+	{
+		helper[numHelpers]=SDL_CreateThread(HelperThread,"Think",NULL);
+		if(!helper[numHelpers])
+			helperFailed=1;
+		else
+			numHelpers++;
+	}
+	return numHelpers<want ? numHelpers : want;
+}
+
+void ThinkAll(Map *map,world_t *world,byte doze)
+{
+	int i,n;
+	PERF_SCOPE("think");
+
+	thinking=0;
+	for(i=0;i<(int)thought.size();i++)
+		thought[i].valid=0;
+	if(config.thinkThreads<=0 || !goodguy || player.timeStop)
+		return;
+
+	if(thinkEpoch!=randSeedEpoch)
+	{
+		// reseeded, so start counting again, and the same seed plays out the same
+		thinkEpoch=randSeedEpoch;
+		thinkTick=0;
+	}
+	thinkTick++;
+	todo.clear();
+	for(i=0;i<maxGuys;i++)
+		if(guys[i]->type!=MONS_NONE && guys[i]->hp>0 && !guys[i]->frozen && guys[i]->aiType!=MONS_BOUAPHA &&
+			MonsterThink(guys[i]->aiType) && !(doze && Dozing(guys[i])))
+			todo.push_back((word)i);
+	if(todo.empty())
+		return;
+
+	thinkMap=map;
+	thinkWorld=world;
+	nextJob=0;
+	n=Helpers(config.thinkThreads-1);
+	for(i=0;i<n;i++)
+		SDL_SemPost(go);
+	ThinkJobs();
+	for(i=0;i<n;i++)
+		SDL_SemWait(done);
+	thinking=1;
+}
+
+byte ApplyThought(Guy *me,Map *map,world_t *world)
+{
+	thought_t *t;
+	Guy *copy;
+	intent_t *n;
+	int i;
+
+	if(!thinking || me->ID>=thought.size())
+		return 0;
+	t=&thought[me->ID];
+	if(!t->valid)
+		return 0;
+	t->valid=0;	// once only, a second update this tick thinks for itself
+	copy=t->me;
+	if(me->type!=copy->type || me->aiType!=copy->aiType || me->x!=t->x || me->y!=t->y ||
+		me->mapx!=t->mapx || me->mapy!=t->mapy || me->hp!=t->hp || me->seq!=t->seq ||
+		me->frm!=t->frm || me->action!=t->action || me->ouch!=t->ouch)
+		return 0;	// something got to it since
+
+	me->facing=copy->facing;
+	me->dx=copy->dx;
+	me->dy=copy->dy;
+	me->dz=copy->dz;
+	me->mind=copy->mind;
+	me->mind1=copy->mind1;
+	me->mind2=copy->mind2;
+	me->mind3=copy->mind3;
+	me->reload=copy->reload;
+	me->action=copy->action;
+	me->seq=copy->seq;
+	me->frm=copy->frm;
+	me->frmTimer=copy->frmTimer;
+	me->frmAdvance=copy->frmAdvance;
+
+	for(i=0;i<t->numIntents;i++)
+	{
+		n=&t->intent[i];
+		if(n->what==INTENT_SOUND)
+			MakeSound(n->n,n->x,n->y,n->flags,n->priority);
+		else if(n->what==INTENT_SHOOT)
+			FireBullet(n->x,n->y,n->facing,(byte)n->n,n->friendly);
+		else if(n->what==INTENT_HIT && n->him->type!=MONS_NONE)
+			n->him->GetShot(n->x,n->y,(byte)n->n,map,world);
+	}
+	return 1;
+}
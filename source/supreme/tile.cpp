@@ -1,14 +1,17 @@
 #include "winpch.h"
 #include "tile.h"
+#include "jamulspr.h"
 #include "display.h"
 #include "progress.h"
 #include "shop.h"
 #include "config.h"
-#include "ioext.h"
+#include "log.h"
+#include <vector>
 
 tile_t tiles[NUMTILES];
 MGLDraw *tileMGL;
 int numTiles;
+static dword tileGen;	// goes up whenever any tile's pixels might have changed
 
 void InitTiles(MGLDraw *mgl)
 {
@@ -22,14 +25,21 @@ void ExitTiles(void)
 
 byte *GetTileData(int t)
 {
+	tileGen++;	// it's handed out to be drawn on
 	return tiles[t];
 }
 
+dword TileGeneration(void)
+{
+	return tileGen;
+}
+
 void SetTiles(byte *scrn)
 {
 	int i,j;
 	int x,y;
 
+	tileGen++;
 	x=0;
 	y=0;
 	for(i=0;i<400;i++)
@@ -49,6 +59,7 @@ void LoadOldTiles(FILE *f)
 {
 	numTiles=400;
 	fread(tiles,numTiles,sizeof(tile_t),f);
+	tileGen++;
 }
 
 void SetTile(int t,int x,int y,byte *src)
@@ -57,100 +68,93 @@ void SetTile(int t,int x,int y,byte *src)
 
 	for(i=0;i<TILE_HEIGHT;i++)
 		memcpy(&tiles[t][i*TILE_WIDTH],&src[x+(y+i)*SCRWID],TILE_WIDTH);
+	tileGen++;
 }
 
-static void SaveTile(std::ostream& f, byte *t)
+// Tile graphics are stored one tile after another: 3 bytes with a bit per row
+// saying whether that row is RLE (pairs of length,color) or just the 32 raw bytes.
+// A row only gets RLE'd when that's smaller, so no tile takes more than this:
+#define TILE_MAXBYTES	(3+TILE_HEIGHT*TILE_WIDTH)
+
+// how many runs of the same color are in a row
+static inline int RowRuns(const byte *r)
+{
+	int i,runs;
+
+	runs=1;
+	for(i=1;i<TILE_WIDTH;i++)
+		runs+=(r[i]!=r[i-1]);	// no branches, so this gets done 16 or 32 at a time
+	return runs;
+}
+
+// encodes one tile into dst, returns how many bytes that took
+static size_t EncodeTile(byte *dst,const byte *t)
 {
 	int row,i;
 	byte size,c;
-	byte compress[3],curComp;
-	dword curBit;
-
-	curComp=0;
-	compress[0]=compress[1]=compress[2]=0;
-	curBit=1;
-	for(row=0;row<24;row++)
-	{
-		// see how big it would be in RLE format
-		size=2;
-		c=t[row*TILE_WIDTH];
-		for(i=1;i<32;i++)
-		{
-			if(t[row*TILE_WIDTH+i]==c)
-				continue;
-			else
-			{
-				c=t[row*TILE_WIDTH+i];
-				size+=2;
-			}
-		}
-		if(size<32)	// RLE is superior here
-			compress[curComp]|=curBit;	// so set the compression bit
-		curBit*=2;
-		if(curBit==256)
-		{
-			curBit=1;
-			curComp++;
-		}
-	}
+	byte *out;
 
-	// now that all 24 have been checked, "compress" contains bits for whether to RLE each one
-	f.write((char*) compress, 3);
-	curComp=0;
-	curBit=1;
-	// now write out the rows themselves
-	for(row=0;row<24;row++)
+	out=dst+3;
+	dst[0]=dst[1]=dst[2]=0;
+	for(row=0;row<TILE_HEIGHT;row++)
 	{
-		if(compress[curComp]&curBit)	// RLE format
+		const byte *r=&t[row*TILE_WIDTH];
+
+		if(RowRuns(r)*2<TILE_WIDTH)	// RLE is superior here
 		{
+			dst[row/8]|=(1<<(row&7));	// so set the compression bit
 			size=1;
-			c=t[row*TILE_WIDTH];
-			for(i=1;i<32;i++)
+			c=r[0];
+			for(i=1;i<TILE_WIDTH;i++)
 			{
-				if(t[row*TILE_WIDTH+i]==c)
-				{
+				if(r[i]==c)
 					size++;
-					continue;
-				}
 				else
 				{
 					// write out the current run and start a new one
-					f.put(size);
-					f.put(c);
-					c=t[row*TILE_WIDTH+i];
+					*out++=size;
+					*out++=c;
+					c=r[i];
 					size=1;
 				}
 			}
 			// write out the final run
-			f.put(size);
-			f.put(c);
+			*out++=size;
+			*out++=c;
 		}
 		else	// straight format, simple
 		{
-			f.write((char*) &t[row*TILE_WIDTH], 32);	// just write the 32 bytes
-		}
-
-		curBit*=2;
-		if(curBit==256)
-		{
-			curBit=1;
-			curComp++;
+			memcpy(out,r,TILE_WIDTH);
+			out+=TILE_WIDTH;
 		}
 	}
-	// took all that to write one lousy ass tile.
+	return out-dst;
 }
 
+static size_t EncodeTiles(std::vector<byte> &buf)
+{
+	size_t len;
+	int i;
+
+	buf.resize(numTiles*TILE_MAXBYTES);
+	len=0;
+	for(i=0;i<numTiles;i++)
+		len+=EncodeTile(&buf[len],tiles[i]);
+	return len;
+}
 
 void SaveTiles(FILE *f)
 {
-	FilePtrStream stream(f);
-	SaveTiles(stream);
+	std::vector<byte> buf;
+
+	fwrite(buf.data(),1,EncodeTiles(buf),f);
 }
 
 void SaveTiles(std::ostream& f)
 {
-	for (int i = 0; i < numTiles; ++i)
-		SaveTile(f, tiles[i]);
+	std::vector<byte> buf;
+
+	f.write((char *)buf.data(),EncodeTiles(buf));
 }
 
 void SaveTilesToBMP(const char *fname)
@@ -207,62 +211,120 @@ void SaveTilesToBMP(const char *fname)
 	GetDisplayMGL()->ClearScreen();
 }
 
-static void LoadTile(std::istream &f, byte *t)
+// how many bytes the tile at src takes, 0 if it runs past end or is garbage
+static size_t TileLength(const byte *src,const byte *end)
 {
+	const byte *p;
 	int row,x;
-	byte size,c;
-	byte compress[3],curComp;
-	dword curBit;
 
-	f.read((char*) compress, 3);
+	if(end-src<3)
+		return 0;
+	p=src+3;
+	for(row=0;row<TILE_HEIGHT;row++)
+	{
+		if(src[row/8]&(1<<(row&7)))	// RLE format
+		{
+			x=0;
+			while(x<TILE_WIDTH)
+			{
+				if(end-p<2 || p[0]==0)
+					return 0;
+				x+=p[0];
+				p+=2;
+			}
+		}
+		else
+			p+=TILE_WIDTH;
+		if(p>end)
+			return 0;
+	}
+	return p-src;
+}
 
-	curComp=0;
-	curBit=1;
+// src has already been checked by TileLength
+static void DecodeTile(byte *t,const byte *src)
+{
+	const byte *p;
+	int row,x,size;
 
-	for(row=0;row<24;row++)
+	p=src+3;
+	for(row=0;row<TILE_HEIGHT;row++)
 	{
-		if(compress[curComp]&curBit)	// RLE format
+		if(src[row/8]&(1<<(row&7)))	// RLE format
 		{
 			x=0;
-			while(x<32)
+			while(x<TILE_WIDTH)
 			{
-				size = f.get();
-				c = f.get();
-				memset(&t[row*TILE_WIDTH+x],c,size);
-				x+=size;
+				size=p[0];
+				if(size>TILE_WIDTH-x)
+					size=TILE_WIDTH-x;	// an overlong run used to spill into the next row
+				memset(&t[row*TILE_WIDTH+x],p[1],size);
+				x+=p[0];
+				p+=2;
 			}
 		}
 		else	// straight format, simple
 		{
-			f.read((char*) &t[row*TILE_WIDTH], 32);	// just write the 32 bytes
+			memcpy(&t[row*TILE_WIDTH],p,TILE_WIDTH);
+			p+=TILE_WIDTH;
 		}
+	}
+}
+
+// decodes tiles start..numTiles-1 from src, returns how many bytes of it they took
+static size_t DecodeTiles(int start,const byte *src,size_t len)
+{
+	size_t pos,n;
+	int i;
 
-		curBit*=2;
-		if(curBit==256)
+	tileGen++;
+	pos=0;
+	for(i=start;i<numTiles;i++)
+	{
+		n=TileLength(src+pos,src+len);
+		if(n==0)
 		{
-			curBit=1;
-			curComp++;
+			LogError("LoadTiles: tile %d is cut off or bad", i);
+			memset(tiles[i],0,sizeof(tile_t)*(numTiles-i));
+			break;
 		}
+		DecodeTile(tiles[i],src+pos);
+		pos+=n;
 	}
+	return pos;
 }
 
 void LoadTiles(FILE *f)
 {
-	FilePtrStream stream(f);
-	LoadTiles(stream);
+	AppendTiles(0,f);
 }
 
 void LoadTiles(std::istream &f)
 {
-	for (int i = 0; i < numTiles; ++i)
-		LoadTile(f, tiles[i]);
+	std::vector<byte> buf;
+	std::streampos at;
+	size_t len;
+
+	// read as much as the tiles could possibly take, then put back what they didn't
+	at=f.tellg();
+	buf.resize(numTiles*TILE_MAXBYTES);
+	f.read((char *)buf.data(),buf.size());
+	len=(size_t)f.gcount();
+	f.clear();
+	f.seekg(at+(std::streamoff)DecodeTiles(0,buf.data(),len));
 }
 
 void AppendTiles(int start,FILE *f)
 {
-	FilePtrStream stream(f);
-	for(int i=start;i<numTiles;i++)
-		LoadTile(stream, tiles[i]);
+	std::vector<byte> buf;
+	size_t len,used;
+
+	if(start>=numTiles)
+		return;
+	buf.resize((numTiles-start)*TILE_MAXBYTES);
+	len=fread(buf.data(),1,buf.size(),f);
+	used=DecodeTiles(start,buf.data(),len);
+	fseek(f,(long)used-(long)len,SEEK_CUR);
 }
 
 void SetNumTiles(int n)
@@ -300,7 +362,7 @@ void PlotStar(int x,int y,byte col,byte tx,byte ty,word tileNum)
 
 	if(tiles[tileNum][tx+ty*TILE_WIDTH]==0)
 	{
-		dst=tileMGL->GetScreen()+x+y*SCRWID;
+		dst=tileMGL->GetScreen()+x+y*viewWid;
 		*dst=col;
 	}
 }
@@ -315,17 +377,14 @@ static inline byte PickDiscoColor(void)
 }
 
 // --- RENDERING!
-// Helper shenanigans for C stuff, see jamulspr.cpp
-extern byte SprModifyColor(byte color, byte hue);
-extern byte SprGetColor(byte color);
-extern byte SprModifyLight(byte color, char bright);
-extern byte SprModifyGhost(byte src, byte dst, char bright);
-extern byte SprModifyGlow(byte src, byte dst, char bright);
-
-byte ModifyDiscoColor(byte color, byte disco)
+// disco mode keeps a colour's brightness but swaps in the disco hue, so a
+// pixel becomes (color & keep) | disco with what this returns as keep
+static inline byte DiscoMask(byte *disco)
 {
-	if (profile.progress.purchase[modeShopNum[MODE_DISCO]]&SIF_ACTIVE) return (color & 31) | disco;
-	else return color;
+	if (profile.progress.purchase[modeShopNum[MODE_DISCO]]&SIF_ACTIVE)
+		return 31;
+	*disco = 0;
+	return 255;
 }
 
 // Rendering for real!
@@ -335,6 +394,8 @@ void RenderFloorTile(int x, int y, int t, char light)
 	byte *dst, *src;
 	int wid, hgt;
 	byte disco = PickDiscoColor();
+	byte keep = DiscoMask(&disco);
+	const byte *lit = SprLightTable(light);
 
 	if (t >= numTiles) {
 		return RenderEmptyTile(x, y, 0);
@@ -351,34 +412,34 @@ void RenderFloorTile(int x, int y, int t, char light)
 		if (wid < 1)
 			return;
 
-		dst = tileMGL->GetScreen() + y * SCRWID;
+		dst = tileMGL->GetScreen() + y * viewWid;
 		src = tiles[t] - x;
 	}
-	else if (x > SCRWID - TILE_WIDTH)
+	else if (x > viewWid - TILE_WIDTH)
 	{
-		wid = TILE_WIDTH - (x - (SCRWID - TILE_WIDTH));
+		wid = TILE_WIDTH - (x - (viewWid - TILE_WIDTH));
 		if (wid < 1)
 			return;
-		dst = tileMGL->GetScreen() + x + y * SCRWID;
+		dst = tileMGL->GetScreen() + x + y * viewWid;
 		src = tiles[t];
 	}
 	else
 	{
 		wid = TILE_WIDTH;
-		dst = tileMGL->GetScreen() + x + y * SCRWID;
+		dst = tileMGL->GetScreen() + x + y * viewWid;
 		src = tiles[t];
 	}
 
 	if (y < 0)
 	{
-		dst -= y * SCRWID;
+		dst -= y * viewWid;
 		src -= y*TILE_WIDTH;
 
 		hgt = TILE_HEIGHT + y;
 	}
-	else if (y > SCRHEI - TILE_HEIGHT)
+	else if (y > viewHei - TILE_HEIGHT)
 	{
-		hgt = TILE_HEIGHT - (y - (SCRHEI - TILE_HEIGHT));
+		hgt = TILE_HEIGHT - (y - (viewHei - TILE_HEIGHT));
 	}
 	else
 	{
@@ -395,7 +456,7 @@ void RenderFloorTile(int x, int y, int t, char light)
 		{
 			hgt--;
 			memset(dst, 0, wid);
-			dst += SCRWID;
+			dst += viewWid;
 		}
 		return;
 	}
@@ -406,9 +467,9 @@ void RenderFloorTile(int x, int y, int t, char light)
 			hgt--;
 			for (int i = 0; i < wid; ++i)
 			{
-				dst[i] = SprModifyLight(ModifyDiscoColor(src[i], disco), light);
+				dst[i] = lit[(src[i] & keep) | disco];
 			}
-			dst += SCRWID;
+			dst += viewWid;
 			src += 32;
 		}
 	}
@@ -419,6 +480,9 @@ void RenderFloorTileShadow(int x, int y, int t, char light)
 	byte *dst, *src;
 	int wid, hgt, darkpart;
 	byte disco = PickDiscoColor();
+	byte keep = DiscoMask(&disco);
+	const byte *lit = SprLightTable(light);
+	const byte *dark = SprLightTable(light - 4);
 
 	if (t >= numTiles) {
 		return RenderEmptyTile(x, y, 0);
@@ -431,36 +495,36 @@ void RenderFloorTileShadow(int x, int y, int t, char light)
 			return;
 
 		darkpart = 8;
-		dst = tileMGL->GetScreen() + y * SCRWID;
+		dst = tileMGL->GetScreen() + y * viewWid;
 		src = tiles[t] - x;
 	}
-	else if (x > SCRWID - TILE_WIDTH)
+	else if (x > viewWid - TILE_WIDTH)
 	{
-		wid = TILE_WIDTH - (x - (SCRWID - TILE_WIDTH));
+		wid = TILE_WIDTH - (x - (viewWid - TILE_WIDTH));
 		if (wid < 1)
 			return;
-		darkpart = 8 - (x - (SCRWID - TILE_WIDTH));
-		dst = tileMGL->GetScreen() + x + y * SCRWID;
+		darkpart = 8 - (x - (viewWid - TILE_WIDTH));
+		dst = tileMGL->GetScreen() + x + y * viewWid;
 		src = tiles[t];
 	}
 	else
 	{
 		wid = TILE_WIDTH;
-		dst = tileMGL->GetScreen() + x + y * SCRWID;
+		dst = tileMGL->GetScreen() + x + y * viewWid;
 		src = tiles[t];
 		darkpart = 8; // shadows are 8 pixels wide I guess
 	}
 
 	if (y < 0)
 	{
-		dst -= y * SCRWID;
+		dst -= y * viewWid;
 		src -= y*TILE_WIDTH;
 
 		hgt = TILE_HEIGHT + y;
 	}
-	else if (y > SCRHEI - TILE_HEIGHT)
+	else if (y > viewHei - TILE_HEIGHT)
 	{
-		hgt = TILE_HEIGHT - (y - (SCRHEI - TILE_HEIGHT));
+		hgt = TILE_HEIGHT - (y - (viewHei - TILE_HEIGHT));
 	}
 	else
 		hgt = TILE_HEIGHT;
@@ -473,9 +537,9 @@ void RenderFloorTileShadow(int x, int y, int t, char light)
 		hgt--;
 		for (int i = 0; i < wid; ++i)
 		{
-			dst[i] = SprModifyLight(ModifyDiscoColor(src[i], disco), light - 4 * (i > wid - darkpart));
+			dst[i] = (i > wid - darkpart ? dark : lit)[(src[i] & keep) | disco];
 		}
-		dst += SCRWID;
+		dst += viewWid;
 		src += 32;
 	}
 }
@@ -495,34 +559,34 @@ void RenderFloorTileUnlit(int x, int y, int t)
 		if (wid < 1)
 			return;
 
-		dst = tileMGL->GetScreen() + y * SCRWID;
+		dst = tileMGL->GetScreen() + y * viewWid;
 		src = tiles[t] - x;
 	}
-	else if (x > SCRWID - TILE_WIDTH)
+	else if (x > viewWid - TILE_WIDTH)
 	{
-		wid = TILE_WIDTH - (x - (SCRWID - TILE_WIDTH));
+		wid = TILE_WIDTH - (x - (viewWid - TILE_WIDTH));
 		if (wid < 1)
 			return;
-		dst = tileMGL->GetScreen() + x + y * SCRWID;
+		dst = tileMGL->GetScreen() + x + y * viewWid;
 		src = tiles[t];
 	}
 	else
 	{
 		wid = TILE_WIDTH;
-		dst = tileMGL->GetScreen() + x + y * SCRWID;
+		dst = tileMGL->GetScreen() + x + y * viewWid;
 		src = tiles[t];
 	}
 
 	if (y < 0)
 	{
-		dst -= y * SCRWID;
+		dst -= y * viewWid;
 		src -= y*TILE_WIDTH;
 
 		hgt = TILE_HEIGHT + y;
 	}
-	else if (y > SCRHEI - TILE_HEIGHT)
+	else if (y > viewHei - TILE_HEIGHT)
 	{
-		hgt = TILE_HEIGHT - (y - (SCRHEI - TILE_HEIGHT));
+		hgt = TILE_HEIGHT - (y - (viewHei - TILE_HEIGHT));
 	}
 	else
 		hgt = TILE_HEIGHT;
@@ -531,7 +595,7 @@ void RenderFloorTileUnlit(int x, int y, int t)
 	{
 		hgt--;
 		memcpy(dst, src, wid);
-		dst += SCRWID;
+		dst += viewWid;
 		src += 32;
 	}
 }
@@ -541,6 +605,8 @@ void RenderFloorTileTrans(int x, int y, int t, char light)
 	byte *dst, *src;
 	int wid, hgt;
 	byte disco = PickDiscoColor();
+	byte keep = DiscoMask(&disco);
+	const byte *lit = SprLightTable(light);
 
 	if (t >= numTiles) {
 		return RenderEmptyTile(x, y, 0);
@@ -552,34 +618,34 @@ void RenderFloorTileTrans(int x, int y, int t, char light)
 		if (wid < 1)
 			return;
 
-		dst = tileMGL->GetScreen() + y * SCRWID;
+		dst = tileMGL->GetScreen() + y * viewWid;
 		src = tiles[t] - x;
 	}
-	else if (x > SCRWID - TILE_WIDTH)
+	else if (x > viewWid - TILE_WIDTH)
 	{
-		wid = TILE_WIDTH - (x - (SCRWID - TILE_WIDTH));
+		wid = TILE_WIDTH - (x - (viewWid - TILE_WIDTH));
 		if (wid < 1)
 			return;
-		dst = tileMGL->GetScreen() + x + y * SCRWID;
+		dst = tileMGL->GetScreen() + x + y * viewWid;
 		src = tiles[t];
 	}
 	else
 	{
 		wid = TILE_WIDTH;
-		dst = tileMGL->GetScreen() + x + y * SCRWID;
+		dst = tileMGL->GetScreen() + x + y * viewWid;
 		src = tiles[t];
 	}
 
 	if (y < 0)
 	{
-		dst -= y * SCRWID;
+		dst -= y * viewWid;
 		src -= y*TILE_WIDTH;
 
 		hgt = TILE_HEIGHT + y;
 	}
-	else if (y > SCRHEI - TILE_HEIGHT)
+	else if (y > viewHei - TILE_HEIGHT)
 	{
-		hgt = TILE_HEIGHT - (y - (SCRHEI - TILE_HEIGHT));
+		hgt = TILE_HEIGHT - (y - (viewHei - TILE_HEIGHT));
 	}
 	else
 		hgt = TILE_HEIGHT;
@@ -592,9 +658,9 @@ void RenderFloorTileTrans(int x, int y, int t, char light)
 		hgt--;
 		for (int i = 0; i < wid; ++i)
 		{
-			if (src[i]) dst[i] = SprModifyLight(ModifyDiscoColor(src[i], disco), light);
+			if (src[i]) dst[i] = lit[(src[i] & keep) | disco];
 		}
-		dst += SCRWID;
+		dst += viewWid;
 		src += 32;
 	}
 }
@@ -608,7 +674,7 @@ inline void GouraudBox(int x,int y,byte *src,char light0,char light1,char light2
 	byte *dst;
 	int curLight,dlx,dly1,dly2,firstLight,lastLight;
 
-	dst=tileMGL->GetScreen()+x+y*SCRWID;
+	dst=tileMGL->GetScreen()+x+y*viewWid;
 
 	curLight=light0*FIXAMT;
 
@@ -621,13 +687,13 @@ inline void GouraudBox(int x,int y,byte *src,char light0,char light1,char light2
 	{
 		dlx=(lastLight-firstLight)/GB_WID;
 		curLight=firstLight;
-		if(y+j>=SCRHEI)
+		if(y+j>=viewHei)
 			return;	// all done!
 		if(y+j>=0)
 		{
 			for(i=0;i<GB_WID;i++)
 			{
-				if(x+i>=0 && x+i<SCRWID)
+				if(x+i>=0 && x+i<viewWid)
 				{
 					tmp=((*src)&31)+(curLight/FIXAMT);
 					if(tmp<0)
@@ -647,7 +713,7 @@ inline void GouraudBox(int x,int y,byte *src,char light0,char light1,char light2
 			dst+=GB_WID;
 			src+=GB_WID;
 		}
-		dst+=(SCRWID-GB_WID);
+		dst+=(viewWid-GB_WID);
 		src+=GB_WID;
 
 		firstLight+=dly1;
@@ -661,7 +727,7 @@ inline void GouraudBoxTrans(int x,int y,byte *src,char light0,char light1,char l
 	byte *dst;
 	int curLight,dlx,dly1,dly2,firstLight,lastLight;
 
-	dst=tileMGL->GetScreen()+x+y*SCRWID;
+	dst=tileMGL->GetScreen()+x+y*viewWid;
 
 	curLight=light0*FIXAMT;
 
@@ -674,13 +740,13 @@ inline void GouraudBoxTrans(int x,int y,byte *src,char light0,char light1,char l
 	{
 		dlx=(lastLight-firstLight)/GB_WID;
 		curLight=firstLight;
-		if(y+j>=SCRHEI)
+		if(y+j>=viewHei)
 			return;	// all done!
 		if(y+j>=0)
 		{
 			for(i=0;i<GB_WID;i++)
 			{
-				if(x+i>=0 && x+i<SCRWID)
+				if(x+i>=0 && x+i<viewWid)
 				{
 					if((*src)!=0)
 					{
@@ -703,7 +769,7 @@ inline void GouraudBoxTrans(int x,int y,byte *src,char light0,char light1,char l
 			dst+=GB_WID;
 			src+=GB_WID;
 		}
-		dst+=(SCRWID-GB_WID);
+		dst+=(viewWid-GB_WID);
 		src+=GB_WID;
 
 		firstLight+=dly1;
@@ -718,7 +784,7 @@ inline void GouraudBoxDiscoTrans(int x,int y,byte *src,char light0,char light1,c
 	int curLight,dlx,dly1,dly2,firstLight,lastLight;
 	byte color;
 
-	dst=tileMGL->GetScreen()+x+y*SCRWID;
+	dst=tileMGL->GetScreen()+x+y*viewWid;
 
 	curLight=light0*FIXAMT;
 
@@ -733,13 +799,13 @@ inline void GouraudBoxDiscoTrans(int x,int y,byte *src,char light0,char light1,c
 	{
 		dlx=(lastLight-firstLight)/GB_WID;
 		curLight=firstLight;
-		if(y+j>=SCRHEI)
+		if(y+j>=viewHei)
 			return;	// all done!
 		if(y+j>=0)
 		{
 			for(i=0;i<GB_WID;i++)
 			{
-				if(x+i>=0 && x+i<SCRWID)
+				if(x+i>=0 && x+i<viewWid)
 				{
 					if((*src)!=0)
 					{
@@ -762,7 +828,7 @@ inline void GouraudBoxDiscoTrans(int x,int y,byte *src,char light0,char light1,c
 			dst+=GB_WID;
 			src+=GB_WID;
 		}
-		dst+=(SCRWID-GB_WID);
+		dst+=(viewWid-GB_WID);
 		src+=GB_WID;
 
 		firstLight+=dly1;
@@ -777,7 +843,7 @@ inline void GouraudBoxDisco(int x,int y,byte *src,char light0,char light1,char l
 	int curLight,dlx,dly1,dly2,firstLight,lastLight;
 	byte color;
 
-	dst=tileMGL->GetScreen()+x+y*SCRWID;
+	dst=tileMGL->GetScreen()+x+y*viewWid;
 
 	curLight=light0*FIXAMT;
 
@@ -792,13 +858,13 @@ inline void GouraudBoxDisco(int x,int y,byte *src,char light0,char light1,char l
 	{
 		dlx=(lastLight-firstLight)/GB_WID;
 		curLight=firstLight;
-		if(y+j>=SCRHEI)
+		if(y+j>=viewHei)
 			return;	// all done!
 		if(y+j>=0)
 		{
 			for(i=0;i<GB_WID;i++)
 			{
-				if(x+i>=0 && x+i<SCRWID)
+				if(x+i>=0 && x+i<viewWid)
 				{
 					tmp=((*src)&31)+(curLight/FIXAMT);
 					if(tmp<0)
@@ -818,7 +884,7 @@ inline void GouraudBoxDisco(int x,int y,byte *src,char light0,char light1,char l
 			dst+=GB_WID;
 			src+=GB_WID;
 		}
-		dst+=(SCRWID-GB_WID);
+		dst+=(viewWid-GB_WID);
 		src+=GB_WID;
 
 		firstLight+=dly1;
@@ -826,7 +892,9 @@ inline void GouraudBoxDisco(int x,int y,byte *src,char light0,char light1,char l
 	}
 }
 
-void RenderFloorTileFancy(int x,int y,int t,byte shadow,const char *theLight)
+// works out the 4 corners and 4 edges of a fancy floor tile from the 9 lights
+// around it, with the wall shadow cut in.  Returns 1 if it all came out 0.
+static byte FancyFloorLights(byte shadow,const char *theLight,char *light)
 {
 	// 9 light values are passed in:
 	//
@@ -835,20 +903,6 @@ void RenderFloorTileFancy(int x,int y,int t,byte shadow,const char *theLight)
 	//   6  7  8
 
 	int i,j;
-	char light[9];
-
-	if(x<=-TILE_WIDTH || y<=-TILE_HEIGHT || x>=SCRWID || y>=SCRHEI)
-		return;	// no need to render
-
-
-	if(config.shading==0)
-	{
-		if(shadow==1)
-			RenderFloorTileShadow(x,y,t,theLight[4]);
-		else
-			RenderFloorTile(x,y,t,theLight[4]);
-		return;
-	}
 
 	memcpy(light,theLight,9*sizeof(char));
 	j=0;
@@ -865,11 +919,8 @@ void RenderFloorTileFancy(int x,int y,int t,byte shadow,const char *theLight)
 			light[i]=(light[4]+light[i])/2;	// average each one with this tile's central light
 	}
 
-	if(j==9 && !shadow && !(profile.progress.purchase[modeShopNum[MODE_DISCO]]&SIF_ACTIVE))
-	{
-		RenderFloorTileUnlit(x,y,t);
-		return;
-	}
+	if(j==9 && !shadow)
+		return 1;
 
 	if(shadow==1)
 	{
@@ -912,6 +963,31 @@ void RenderFloorTileFancy(int x,int y,int t,byte shadow,const char *theLight)
 		light[6]-=8;
 		light[7]-=8;
 	}
+	return 0;
+}
+
+void RenderFloorTileFancy(int x,int y,int t,byte shadow,const char *theLight)
+{
+	char light[9];
+
+	if(x<=-TILE_WIDTH || y<=-TILE_HEIGHT || x>=viewWid || y>=viewHei)
+		return;	// no need to render
+
+
+	if(config.shading==0)
+	{
+		if(shadow==1)
+			RenderFloorTileShadow(x,y,t,theLight[4]);
+		else
+			RenderFloorTile(x,y,t,theLight[4]);
+		return;
+	}
+
+	if(FancyFloorLights(shadow,theLight,light) && !(profile.progress.purchase[modeShopNum[MODE_DISCO]]&SIF_ACTIVE))
+	{
+		RenderFloorTileUnlit(x,y,t);
+		return;
+	}
 
 	if(profile.progress.purchase[modeShopNum[MODE_DISCO]]&SIF_ACTIVE)
 	{
@@ -929,6 +1005,99 @@ void RenderFloorTileFancy(int x,int y,int t,byte shadow,const char *theLight)
 	}
 }
 
+// GouraudBox into any buffer, with no clipping
+static void ShadeBox(byte *dst,int pitch,const byte *src,char light0,char light1,char light2,char light3)
+{
+	int i,j,tmp;
+	int curLight,dlx,dly1,dly2,firstLight,lastLight;
+
+	firstLight=light0*FIXAMT;
+	lastLight=light1*FIXAMT;
+	dly1=(light2-light0)*FIXAMT/GB_HEI;
+	dly2=(light3-light1)*FIXAMT/GB_HEI;
+
+	for(j=0;j<GB_HEI;j++)
+	{
+		dlx=(lastLight-firstLight)/GB_WID;
+		curLight=firstLight;
+		for(i=0;i<GB_WID;i++)
+		{
+			tmp=(src[i]&31)+(curLight/FIXAMT);
+			if(tmp<0)
+				tmp=0;
+			if(tmp>31)
+				tmp=31;
+			dst[i]=(src[i]&(~31))+tmp;
+			curLight+=dlx;
+		}
+		dst+=pitch;
+		src+=TILE_WIDTH;
+
+		firstLight+=dly1;
+		lastLight+=dly2;
+	}
+}
+
+byte CanShadeFloorTiles(void)
+{
+	return config.shading!=0 && !(profile.progress.purchase[modeShopNum[MODE_DISCO]]&SIF_ACTIVE);
+}
+
+byte ShadeFloorTile(byte *dst,int pitch,int t,byte shadow,const char *theLight)
+{
+	char light[9];
+	int j;
+
+	if(t>=numTiles || !CanShadeFloorTiles())
+		return 0;
+
+	if(FancyFloorLights(shadow,theLight,light))
+	{
+		for(j=0;j<TILE_HEIGHT;j++)
+			memcpy(dst+j*pitch,tiles[t]+j*TILE_WIDTH,TILE_WIDTH);
+		return 1;
+	}
+
+	ShadeBox(dst,pitch,tiles[t],light[0],light[1],light[3],light[4]);
+	ShadeBox(dst+GB_WID,pitch,tiles[t]+GB_WID,light[1],light[2],light[4],light[5]);
+	ShadeBox(dst+GB_HEI*pitch,pitch,tiles[t]+GB_HEI*TILE_WIDTH,light[3],light[4],light[6],light[7]);
+	ShadeBox(dst+GB_WID+GB_HEI*pitch,pitch,tiles[t]+GB_WID+GB_HEI*TILE_WIDTH,light[4],light[5],light[7],light[8]);
+	return 1;
+}
+
+void RenderShadedTile(int x,int y,const byte *src,int pitch)
+{
+	byte *dst;
+	int x2,y2;
+
+	x2=x+TILE_WIDTH;
+	y2=y+TILE_HEIGHT;
+	if(x<0)
+	{
+		src-=x;
+		x=0;
+	}
+	if(y<0)
+	{
+		src-=y*pitch;
+		y=0;
+	}
+	if(x2>viewWid)
+		x2=viewWid;
+	if(y2>viewHei)
+		y2=viewHei;
+	if(x2<=x || y2<=y)
+		return;
+
+	dst=tileMGL->GetScreen()+x+y*viewWid;
+	for(;y<y2;y++)
+	{
+		memcpy(dst,src,x2-x);
+		dst+=viewWid;
+		src+=pitch;
+	}
+}
+
 void RenderWallTileFancy(int x,int y,int t,const char *theLight)
 {
 	// 9 light values are passed in:
@@ -940,7 +1109,7 @@ void RenderWallTileFancy(int x,int y,int t,const char *theLight)
 	int i,j;
 	char light[9];
 
-	if(x<=-TILE_WIDTH || y<=-TILE_HEIGHT || x>=SCRWID || y>=SCRHEI)
+	if(x<=-TILE_WIDTH || y<=-TILE_HEIGHT || x>=viewWid || y>=viewHei)
 		return;	// no need to render
 
 	if(config.shading==0)
@@ -1003,7 +1172,7 @@ void RenderRoofTileFancy(int x,int y,int t,byte trans,byte wallBelow,const char
 	int i,j;
 	char light[9];
 
-	if(x<=-TILE_WIDTH || y<=-TILE_HEIGHT || x>=SCRWID || y>=SCRHEI)
+	if(x<=-TILE_WIDTH || y<=-TILE_HEIGHT || x>=viewWid || y>=viewHei)
 		return;	// no need to render
 
 
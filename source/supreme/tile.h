@@ -30,7 +30,8 @@ void RenderWallTile(int x,int y,word w,word f,char light);
 void RenderWallTileTrans(int x,int y,word w,word f,char light);
 void PlotStar(int x,int y,byte col,byte tx,byte ty,word tileNum);
 
-byte *GetTileData(int t);
+byte *GetTileData(int t);	// to change it, too
+dword TileGeneration(void);	// goes up whenever any tile's pixels might change
 
 void AppendTiles(int start,FILE *f);
 
@@ -48,4 +49,12 @@ void RenderFloorTileFancy(int x,int y,int t,byte shadow,const char *light);
 void RenderRoofTileFancy(int x,int y,int t,byte trans,byte wallBelow,const char *theLight);
 void RenderWallTileFancy(int x,int y,int t,const char *light);
 
+// for keeping shaded floors around between frames: ShadeFloorTile draws tile t
+// into dst exactly as RenderFloorTileFancy would put it on screen, or returns 0
+// if it can't be kept (missing tile, or CanShadeFloorTiles says no: disco
+// floors change every frame, and plain shading isn't worth it).
+byte CanShadeFloorTiles(void);
+byte ShadeFloorTile(byte *dst,int pitch,int t,byte shadow,const char *light);
+void RenderShadedTile(int x,int y,const byte *src,int pitch);
+
 #endif
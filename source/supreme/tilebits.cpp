@@ -0,0 +1,159 @@
+#include "tilebits.h"
+#include "guy.h"
+#include "game.h"
+#include "world.h"
+#include <vector>
+
+#define NUM_TB	4
+
+static std::vector<uint32_t> plane[NUM_TB];
+static Map *bitMap;
+static int pitch;	// words to a row
+
+// which kinds t is, going by what Walkable, InteractWithItem, Bulletable and
+// the pushing check each look at
+static byte TileKinds(mapTile_t *t)
+{
+	item_t *itm;
+	dword flags;
+	byte kinds,walkable;
+
+	itm=GetItem(t->item);
+	if(!itm)
+		return 0;
+	flags=GetTerrain(&curWorld,t->floor)->flags;
+
+	kinds=0;
+	if(!t->wall && !(itm->flags&IF_BULLETPROOF) && !(itm->trigger&(ITR_SHOOT|ITR_CHOP)))
+		kinds|=TB_SHOTCLEAR;
+
+	walkable=(!t->wall && !(itm->flags&(IF_SOLID|IF_BULLETPROOF|IF_PICKUP)) &&
+		!(itm->trigger&(ITR_PLAYERBUMP|ITR_FRIENDBUMP|ITR_ENEMYBUMP|ITR_MINECART)) &&
+		!(shopping && t->item>=NUM_ORIGINAL_ITEMS) &&
+		!(flags&(TF_SOLID|TF_PUSHY|TF_NOGHOST|TF_NOENEMY)));
+	if(walkable && !(flags&(TF_WATER|TF_LAVA)))
+		kinds|=TB_PLAIN;
+	if(walkable && (flags&(TF_WATER|TF_LAVA)))
+		kinds|=TB_WET;
+
+	if(!t->wall && !t->item && (flags&TF_PUSHON))
+		kinds|=TB_PUSHON;
+
+	return kinds;
+}
+
+static void SetKinds(int x,int y,byte kinds)
+{
+	int i,pos;
+	uint32_t bit;
+
+	pos=y*pitch+(x>>5);
+	bit=(1u<<(x&31));
+	for(i=0;i<NUM_TB;i++)
+	{
+		if(kinds&(1<<i))
+			plane[i][pos]|=bit;
+		else
+			plane[i][pos]&=~bit;
+	}
+}
+
+void InitTileBits(Map *map)
+{
+	int i,x,y;
+
+	bitMap=map;
+	pitch=(map->width+31)/32;
+	for(i=0;i<NUM_TB;i++)
+		plane[i].assign(pitch*map->height,0);
+	for(y=0;y<map->height;y++)
+		for(x=0;x<map->width;x++)
+			SetKinds(x,y,TileKinds(&map->map[x+y*map->width]));
+}
+
+void ExitTileBits(void)
+{
+	int i;
+
+	for(i=0;i<NUM_TB;i++)
+		plane[i].clear();
+	bitMap=NULL;
+}
+
+void TileBitsChanged(mapTile_t *m)
+{
+	int pos;
+
+	if(!bitMap || m<bitMap->map || m>=bitMap->map+bitMap->width*bitMap->height)
+		return;
+
+	pos=(int)(m-bitMap->map);
+	SetKinds(pos%bitMap->width,pos/bitMap->width,TileKinds(m));
+}
+
+void AllTileBitsChanged(Map *map)
+{
+	if(map==bitMap)
+		InitTileBits(map);
+}
+
+byte TileBit(Map *map,byte bits,int x,int y)
+{
+	int i;
+	uint32_t word;
+
+	if(map!=bitMap)
+		return (TileKinds(map->GetTile(x,y))&bits)!=0;
+
+	word=0;
+	for(i=0;i<NUM_TB;i++)
+		if(bits&(1<<i))
+			word|=plane[i][y*pitch+(x>>5)];
+	return (word>>(x&31))&1;
+}
+
+byte TileBitsRect(Map *map,byte bits,int x1,int y1,int x2,int y2)
+{
+	int i,x,y,w;
+	uint32_t word,want;
+
+	if(map!=bitMap)
+	{
+		for(y=y1;y<=y2;y++)
+			for(x=x1;x<=x2;x++)
+				if(!(TileKinds(map->GetTile(x,y))&bits))
+					return 0;
+		return 1;
+	}
+
+	for(y=y1;y<=y2;y++)
+		for(w=(x1>>5);w<=(x2>>5);w++)
+		{
+			want=~0u;
+			if(w==(x1>>5))
+				want&=(~0u<<(x1&31));
+			if(w==(x2>>5))
+				want&=(~0u>>(31-(x2&31)));
+			word=0;
+			for(i=0;i<NUM_TB;i++)
+				if(bits&(1<<i))
+					word|=plane[i][y*pitch+w];
+			if((word&want)!=want)
+				return 0;
+		}
+	return 1;
+}
+
+byte WalkBits(Guy *g)
+{
+	dword flags;
+	byte bits;
+
+	flags=MonsterFlags(g->type,g->aiType);
+	bits=0;
+	if(!(flags&MF_AQUATIC) || (flags&MF_FLYING))
+		bits|=TB_PLAIN;	// fish need water
+	if((flags&(MF_WATERWALK|MF_FLYING)) || g->aiType==MONS_BOUAPHA)
+		bits|=TB_WET;
+	return bits;
+}
@@ -0,0 +1,36 @@
+#ifndef TILEBITS_H
+#define TILEBITS_H
+
+#include "map.h"
+
+// A bit a tile for each of a few kinds of tile, for the level being played,
+// kept in rows of 32 so a guy's or bullet's whole rectangle can be tested a
+// word at a time instead of looking up each tile's wall, item and terrain.
+// Each kind is a tile that some test is sure to pass with nothing happening,
+// so a tile with its bit off just gets the full test as before.
+//
+// Whatever changes a tile's floor, wall or item in play must say so, or the
+// bits go stale.  The Map calls that change tiles do; anything writing to the
+// tiles itself has to call TileBitsChanged.
+
+#define TB_SHOTCLEAR	1	// no wall, no item that stops or is set off by bullets
+#define TB_PLAIN		2	// dry open ground: no wall, floor that stops no-one, an item nobody bumps
+#define TB_WET			4	// likewise, but water or lava
+#define TB_PUSHON		8	// empty pushon floor, for pushed blocks and items
+
+void InitTileBits(Map *map);	// when a level starts, after anything that sets up its tiles
+void ExitTileBits(void);
+void TileBitsChanged(mapTile_t *m);	// after changing that tile's floor, wall or item
+void AllTileBitsChanged(Map *map);	// after changing lots of them
+
+// if (x,y) is any of the kinds in bits.  On a map other than the one being
+// played it's worked out from the tile.
+byte TileBit(Map *map,byte bits,int x,int y);
+// if every tile from (x1,y1) to (x2,y2) is any of the kinds in bits.  All of
+// them must be on the map.
+byte TileBitsRect(Map *map,byte bits,int x1,int y1,int x2,int y2);
+
+// the kinds of tile g can walk onto with nothing happening
+byte WalkBits(Guy *g);
+
+#endif
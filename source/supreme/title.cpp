@@ -8,6 +8,7 @@
 #include "progress.h"
 #include "shop.h"
 #include "textgame.h"
+#include "imagecache.h"
 
 #define COPYRIGHT_YEARS "1998-2012"
 
@@ -462,6 +463,7 @@ byte MainMenu(MGLDraw *mgl)
 	}
 
 	mgl->LoadBMP("graphics/title.bmp");
+	PreloadImage("graphics/profmenu.bmp");	// the backdrop of most everything off this menu
 	backgd=(byte *)malloc(640*480);
 	if(!backgd)
 		FatalError("Out of memory!");
@@ -9,6 +9,7 @@
 #include "hiscore.h"
 #include "lsdir.h"
 #include <algorithm>
+#include <vector>
 
 #define WS_CONTINUE	0
 #define WS_EXIT		1
@@ -39,12 +40,20 @@ typedef struct worldDesc_t
 	float percentage;
 	byte complete;
 	byte dimmed;
+	char nameKey[32],authorKey[32];	// lowercased, to sort and search by
 } worldDesc_t;
 
+#define MAX_FILTER	16
+
 static char curName[32];
 static byte mode;
 static worldDesc_t *list;
 static int numWorlds,worldDescSize,listPos,choice;
+// what's on screen: indices into list, sorted and filtered.  choice and listPos index this.
+static std::vector<int> shown;
+static int numShown;
+static std::vector<int> fieldOrder[3];	// list sorted by each field, made the first time it's needed
+static char filter[MAX_FILTER];
 static byte *backgd;
 static byte sortType,sortDir;
 static int scrollY,scrollHeight,scrollOffset;
@@ -67,125 +76,18 @@ static FILE *levelF,*level2F,*authorF;
 static int totalLCount;
 #endif
 
-void FlipEm(worldDesc_t *me,worldDesc_t *you)
-{
-	worldDesc_t tmp;
-
-	memcpy(&tmp,me,sizeof(worldDesc_t));
-	memcpy(me,you,sizeof(worldDesc_t));
-	memcpy(you,&tmp,sizeof(worldDesc_t));
-}
-
-byte Compare(worldDesc_t *me,worldDesc_t *you,byte field,byte bkwds)
+static inline worldDesc_t *Shown(int n)
 {
-	byte f;
-	char tmp1[32],tmp2[32];
-
-	if(me->dimmed!=you->dimmed)
-		return 0;	// no flipping between ones of different dim status
-	if(!bkwds)
-	{
-		if(!strcmp(me->fname,"tutorial.dlw"))	// the tutorial comes before all else
-			return 0;
-		if(!strcmp(you->fname,"tutorial.dlw"))
-		{
-			FlipEm(me,you);
-			return 1;
-		}
-	}
-	else
-	{
-		if(!strcmp(you->fname,"tutorial.dlw"))	// the tutorial comes before all else (vice versa when backwards, so still on top)
-			return 0;
-		if(!strcmp(me->fname,"tutorial.dlw"))
-		{
-			FlipEm(me,you);
-			return 1;
-		}
-	}
-
-	f=0;
-	switch(field)
-	{
-		case 0:
-			strcpy(tmp1,me->name);
-			strcpy(tmp2,you->name);
-			f=(strcasecmp(tmp1,tmp2)>0);
-			break;
-		case 1:
-			strcpy(tmp1,me->author);
-			strcpy(tmp2,you->author);
-			f=(strcasecmp(tmp1,tmp2)>0);
-			break;
-		case 2:
-			f=(me->percentage>you->percentage);
-			break;
-	}
-
-	if(f)
-		FlipEm(me,you);
-
-	return f;
+	return &list[shown[n]];
 }
 
-void SortWorlds(byte field,byte backwards)
+static void MakeKey(char *key,const char *s)
 {
 	int i;
-	int flipped;
-
-	flipped=1;
 
-	while(flipped)
-	{
-		flipped=0;
-		for(i=0;i<numWorlds-1;i++)
-		{
-			if(backwards)
-			{
-				if(Compare(&list[i+1],&list[i],field,1))
-				{
-					flipped++;
-					if(choice==i)
-						choice=i+1;
-					else if(choice==i+1)
-						choice=i;
-				}
-			}
-			else
-			{
-				if(Compare(&list[i],&list[i+1],field,0))
-				{
-					flipped++;
-					if(choice==i)
-						choice=i+1;
-					else if(choice==i+1)
-						choice=i;
-				}
-			}
-			if(list[i].dimmed && !list[i+1].dimmed)
-			{
-				flipped++;
-				FlipEm(&list[i],&list[i+1]);
-			}
-		}
-	}
-
-	if(choice<listPos)
-	{
-		listPos=choice;
-		if(listPos<0)
-			listPos=0;
-		if(listPos>numWorlds-WORLDS_PER_SCREEN)
-			listPos=numWorlds-WORLDS_PER_SCREEN;
-	}
-	if(choice>=listPos+WORLDS_PER_SCREEN)
-	{
-		listPos=choice-WORLDS_PER_SCREEN+1;
-		if(listPos<0)
-			listPos=0;
-		if(listPos>numWorlds-WORLDS_PER_SCREEN)
-			listPos=numWorlds-WORLDS_PER_SCREEN;
-	}
+	for(i=0;s[i] && i<31;i++)
+		key[i]=tolower((byte)s[i]);
+	key[i]='\0';
 }
 
 void InputWorld(const char *fname)
@@ -218,6 +120,8 @@ void InputWorld(const char *fname)
 	FreeWorld(&wor);
 #endif
 	GetWorldName(fullname,list[numWorlds].name,list[numWorlds].author);
+	MakeKey(list[numWorlds].nameKey,list[numWorlds].name);
+	MakeKey(list[numWorlds].authorKey,list[numWorlds].author);
 	w=GetWorldProgressNoCreate(list[numWorlds].fname);
 
 	if(w)
@@ -290,13 +194,15 @@ void ScanWorlds(void)
 
 void CalcScrollBar(void)
 {
-	scrollHeight=SCROLLBAR_HEIGHT*WORLDS_PER_SCREEN/numWorlds;
+	if(numShown==0)
+		return;
+	scrollHeight=SCROLLBAR_HEIGHT*WORLDS_PER_SCREEN/numShown;
 	if(scrollHeight<10)
 		scrollHeight=10;
 	if(scrollHeight>=SCROLLBAR_HEIGHT)
 		scrollHeight=SCROLLBAR_HEIGHT-1;
 
-	scrollY=SCROLLBAR_HEIGHT*listPos/numWorlds;
+	scrollY=SCROLLBAR_HEIGHT*listPos/numShown;
 	if(scrollY+scrollHeight>SCROLLBAR_HEIGHT)
 		scrollY=SCROLLBAR_HEIGHT-scrollHeight;
 }
@@ -309,7 +215,7 @@ void ReverseCalcScrollBar(void)
 		scrollY=SCROLLBAR_HEIGHT-scrollHeight-1;
 
 	if(scrollY>0)
-		listPos=scrollY*numWorlds/SCROLLBAR_HEIGHT+1;
+		listPos=scrollY*numShown/SCROLLBAR_HEIGHT+1;
 	else
 		listPos=0;
 }
@@ -383,9 +289,11 @@ void SelectLastWorld(void)
 	char s[64];
 
 	choice=0;
+	if(numShown==0)
+		return;
 
-	for(i=0;i<numWorlds;i++)
-		if(!strcmp(list[i].fname,profile.lastWorld))
+	for(i=0;i<numShown;i++)
+		if(!strcmp(Shown(i)->fname,profile.lastWorld))
 			choice=i;
 
 	if(listPos<=choice-WORLDS_PER_SCREEN)
@@ -393,7 +301,7 @@ void SelectLastWorld(void)
 	if(listPos>choice)
 		listPos=choice;
 
-	sprintf(s,"worlds/%s",list[choice].fname);
+	sprintf(s,"worlds/%s",Shown(choice)->fname);
 	LoadWorld(&tmpWorld,s);
 	level=0;
 	scoreMode=0;
@@ -406,13 +314,164 @@ void MoveToNewWorld(void)
 	char s[64];
 
 	FreeWorld(&tmpWorld);
-	sprintf(s,"worlds/%s",list[choice].fname);
+	sprintf(s,"worlds/%s",Shown(choice)->fname);
 	LoadWorld(&tmpWorld,s);
 	level=0;
 	noScoresAtAll=0;
 	FetchScores(0);
 }
 
+static byte sortField;
+
+static bool FieldLess(int a,int b)
+{
+	int c;
+
+	c=0;
+	switch(sortField)
+	{
+		case 0:
+			c=strcmp(list[a].nameKey,list[b].nameKey);
+			break;
+		case 1:
+			c=strcmp(list[a].authorKey,list[b].authorKey);
+			break;
+		case 2:
+			if(list[a].percentage!=list[b].percentage)
+				c=(list[a].percentage<list[b].percentage) ? -1 : 1;
+			break;
+	}
+	if(c==0)
+		c=strcmp(list[a].fname,list[b].fname);	// so ties always come out the same
+	return c<0;
+}
+
+static byte Matches(const worldDesc_t *w)
+{
+	return (filter[0]==0 || strstr(w->nameKey,filter) || strstr(w->authorKey,filter));
+}
+
+// everything playable comes first, then the dimmed ones, and the tutorial comes
+// before all else in its group
+static void AddShown(const std::vector<int> &order,byte backwards,byte dimmed)
+{
+	int i,n;
+
+	for(i=0;i<numWorlds;i++)
+		if(list[i].dimmed==dimmed && !strcmp(list[i].fname,"tutorial.dlw") && Matches(&list[i]))
+			shown.push_back(i);
+	for(i=0;i<numWorlds;i++)
+	{
+		n=backwards ? order[numWorlds-1-i] : order[i];
+		if(list[n].dimmed==dimmed && strcmp(list[n].fname,"tutorial.dlw") && Matches(&list[n]))
+			shown.push_back(n);
+	}
+}
+
+static void BuildShown(byte field,byte backwards)
+{
+	std::vector<int> &order=fieldOrder[field];
+	int i;
+
+	if((int)order.size()!=numWorlds)
+	{
+		order.resize(numWorlds);
+		for(i=0;i<numWorlds;i++)
+			order[i]=i;
+		sortField=field;
+		std::sort(order.begin(),order.end(),FieldLess);
+	}
+
+	shown.clear();
+	AddShown(order,backwards,0);
+	AddShown(order,backwards,1);
+	numShown=(int)shown.size();
+}
+
+// after the list changes order, find the chosen world again and keep it on the same line
+static void KeepChoice(int chosen,int line)
+{
+	int i;
+
+	for(i=0;i<numShown;i++)
+		if(shown[i]==chosen)
+			break;
+	if(i==numShown)
+	{
+		// it's been filtered out, so go to the top
+		choice=0;
+		listPos=0;
+		if(numShown>0)
+			MoveToNewWorld();
+		CalcScrollBar();
+		return;
+	}
+	choice=i;
+	listPos=choice-line;
+	if(listPos>numShown-WORLDS_PER_SCREEN)
+		listPos=numShown-WORLDS_PER_SCREEN;
+	if(listPos<0)
+		listPos=0;
+	CalcScrollBar();
+}
+
+void SortWorlds(byte field,byte backwards)
+{
+	int chosen,line;
+
+	chosen=(numShown>0) ? shown[choice] : -1;
+	line=choice-listPos;
+	BuildShown(field,backwards);
+	KeepChoice(chosen,line);
+}
+
+static byte FilterKey(char c)
+{
+	return (c>' ' && c<127) || (c==' ' && filter[0]);
+}
+
+// type-to-find: backspace takes a letter off, escape clears it.  Returns 0 if
+// that would leave nothing to pick from.
+static byte ChangeFilter(char c)
+{
+	std::vector<int> keep;
+	int chosen,line,len,i;
+
+	chosen=shown[choice];
+	line=choice-listPos;
+	len=strlen(filter);
+	if(c==8 || c==27)
+	{
+		if(len==0)
+			return 1;
+		if(c==8)
+			filter[len-1]='\0';
+		else
+			filter[0]='\0';
+		BuildShown(sortType,sortDir);
+	}
+	else
+	{
+		if(len>=MAX_FILTER-1)
+			return 0;
+		filter[len]=tolower((byte)c);
+		filter[len+1]='\0';
+		// a longer filter only ever narrows down what's already shown
+		for(i=0;i<numShown;i++)
+			if(Matches(Shown(i)))
+				keep.push_back(shown[i]);
+		if(keep.empty())
+		{
+			filter[len]='\0';
+			return 0;
+		}
+		shown.swap(keep);
+		numShown=(int)shown.size();
+	}
+	KeepChoice(chosen,line);
+	return 1;
+}
+
 void InitWorldSelect(MGLDraw *mgl)
 {
 	int i;
@@ -429,12 +488,17 @@ void InitWorldSelect(MGLDraw *mgl)
 	sortType=0;
 	sortDir=0;
 	listPos=0;
+	choice=0;
 	worldDescSize=16;
 	numWorlds=0;
+	numShown=0;
+	filter[0]='\0';
+	for(i=0;i<3;i++)
+		fieldOrder[i].clear();
 
 	list=(worldDesc_t *)malloc(sizeof(worldDesc_t)*16);
 	ScanWorlds();
-	SortWorlds(sortType,sortDir);
+	BuildShown(sortType,sortDir);
 	SelectLastWorld();
 	CalcScrollBar();
 	mgl->GetMouse(&msx,&msy);
@@ -450,6 +514,7 @@ void ExitWorldSelect(void)
 {
 	free(backgd);
 	free(list);
+	shown.clear();
 	FreeWorld(&tmpWorld);
 	delete wsSpr;
 }
@@ -476,7 +541,10 @@ byte UpdateWorldSelect(int *lastTime,MGLDraw *mgl)
 		*lastTime-=TIME_PER_FRAME;
 	}
 
-	c=GetControls()|GetArrows();
+	// while typing to find a world, keys are letters and not controls
+	c=GetArrows();
+	if(filter[0]=='\0' && !FilterKey(mgl->LastKeyPeek()))
+		c|=GetControls();
 
 	if(mode==MODE_PICKWORLD)
 	{
@@ -495,7 +563,7 @@ byte UpdateWorldSelect(int *lastTime,MGLDraw *mgl)
 		}
 		if((c&CONTROL_DN) && !(oldc&CONTROL_DN))
 		{
-			if(choice<numWorlds-1)
+			if(choice<numShown-1)
 			{
 				choice++;
 				MoveToNewWorld();
@@ -508,7 +576,7 @@ byte UpdateWorldSelect(int *lastTime,MGLDraw *mgl)
 		}
 		if((c&CONTROL_B1) && !(oldc&CONTROL_B1))
 		{
-			if(list[choice].dimmed)
+			if(Shown(choice)->dimmed)
 				MakeNormalSound(SND_TURRETBZZT);
 			else
 			{
@@ -522,7 +590,7 @@ byte UpdateWorldSelect(int *lastTime,MGLDraw *mgl)
 			listPos = std::max(listPos - WORLDS_PER_SCREEN, 0);
 			CalcScrollBar();
 		} else if (scan == SDL_SCANCODE_PAGEDOWN) {
-			listPos = std::min(listPos + WORLDS_PER_SCREEN, numWorlds - WORLDS_PER_SCREEN);
+			listPos = std::min(listPos + WORLDS_PER_SCREEN, numShown - WORLDS_PER_SCREEN);
 			CalcScrollBar();
 		}
 
@@ -538,8 +606,8 @@ byte UpdateWorldSelect(int *lastTime,MGLDraw *mgl)
 		else if(mv>0)
 		{
 			listPos+=mv;
-			if(listPos>numWorlds-WORLDS_PER_SCREEN)
-				listPos=numWorlds-WORLDS_PER_SCREEN;
+			if(listPos>numShown-WORLDS_PER_SCREEN)
+				listPos=numShown-WORLDS_PER_SCREEN;
 			if(listPos<0)
 				listPos=0;
 			CalcScrollBar();
@@ -550,7 +618,7 @@ byte UpdateWorldSelect(int *lastTime,MGLDraw *mgl)
 			// clicking on a world
 			for(i=0;i<18;i++)
 			{
-				if(i+listPos<numWorlds)
+				if(i+listPos<numShown)
 				{
 					if(PointInRect(msx,msy,17,39+i*GAP_HEIGHT,599,39+GAP_HEIGHT+i*GAP_HEIGHT-1))
 					{
@@ -561,7 +629,7 @@ byte UpdateWorldSelect(int *lastTime,MGLDraw *mgl)
 						}
 						else
 						{
-							if(list[choice].dimmed)
+							if(Shown(choice)->dimmed)
 								MakeNormalSound(SND_TURRETBZZT);
 							else
 							{
@@ -627,8 +695,8 @@ byte UpdateWorldSelect(int *lastTime,MGLDraw *mgl)
 				else if(msy>41+scrollY+scrollHeight-1)
 				{
 					listPos+=CLICK_SCROLL_AMT;
-					if(listPos>numWorlds-WORLDS_PER_SCREEN)
-						listPos=numWorlds-WORLDS_PER_SCREEN;
+					if(listPos>numShown-WORLDS_PER_SCREEN)
+						listPos=numShown-WORLDS_PER_SCREEN;
 					if(listPos<0)
 						listPos=0;
 					CalcScrollBar();
@@ -638,7 +706,7 @@ byte UpdateWorldSelect(int *lastTime,MGLDraw *mgl)
 			// play world
 			if(PointInRect(msx,msy,20,371,20+150,371+WBTN_HEIGHT))
 			{
-				if(list[choice].dimmed)
+				if(Shown(choice)->dimmed)
 					MakeNormalSound(SND_TURRETBZZT);
 				else
 				{
@@ -649,7 +717,7 @@ byte UpdateWorldSelect(int *lastTime,MGLDraw *mgl)
 			// reset world
 			else if(PointInRect(msx,msy,20,395,20+150,395+WBTN_HEIGHT))
 			{
-				if(list[choice].dimmed)
+				if(Shown(choice)->dimmed)
 					MakeNormalSound(SND_TURRETBZZT);
 				else
 				{
@@ -659,7 +727,7 @@ byte UpdateWorldSelect(int *lastTime,MGLDraw *mgl)
 			// reset high scores
 			else if(PointInRect(msx,msy,20,419,20+150,419+WBTN_HEIGHT))
 			{
-				if(list[choice].dimmed)
+				if(Shown(choice)->dimmed)
 					MakeNormalSound(SND_TURRETBZZT);
 				else
 				{
@@ -674,20 +742,20 @@ byte UpdateWorldSelect(int *lastTime,MGLDraw *mgl)
 			}
 
 			// hi score buttons
-			if(PointInRect(msx,msy,180,371,180+150,371+WBTN_HEIGHT) && !list[choice].dimmed)
+			if(PointInRect(msx,msy,180,371,180+150,371+WBTN_HEIGHT) && !Shown(choice)->dimmed)
 			{
 				scoreMode=1-scoreMode;
 				noScoresAtAll=0;
 				FetchScores(0);
 			}
-			else if(PointInRect(msx,msy,335,371,335+20,371+WBTN_HEIGHT) && !list[choice].dimmed)
+			else if(PointInRect(msx,msy,335,371,335+20,371+WBTN_HEIGHT) && !Shown(choice)->dimmed)
 			{
 				level--;
 				if(level>=tmpWorld.numMaps)
 					level=tmpWorld.numMaps-1;
 				FetchScores(1);
 			}
-			else if(PointInRect(msx,msy,592,371,592+20,371+WBTN_HEIGHT) && !list[choice].dimmed)
+			else if(PointInRect(msx,msy,592,371,592+20,371+WBTN_HEIGHT) && !Shown(choice)->dimmed)
 			{
 				level++;
 				if(level>=tmpWorld.numMaps)
@@ -714,7 +782,7 @@ byte UpdateWorldSelect(int *lastTime,MGLDraw *mgl)
 			{
 				MakeNormalSound(SND_MENUSELECT);
 				if(mode==MODE_VERIFY)
-					EraseWorldProgress(list[choice].fname);
+					EraseWorldProgress(Shown(choice)->fname);
 				else
 					EraseHighScores(&tmpWorld);
 				ExitWorldSelect();
@@ -734,14 +802,24 @@ byte UpdateWorldSelect(int *lastTime,MGLDraw *mgl)
 
 #if defined(WTG) || defined(_DEBUG)
 	if (c == 'A')
+	{
 		showFilenames = !showFilenames;
+		c = 0;
+	}
 #endif
 
-	if(c==27)
+	if(c==27 && filter[0] && mode==MODE_PICKWORLD)
+		ChangeFilter(c);
+	else if(c==27)
 	{
 		oldc=255;
 		return WS_EXIT;
 	}
+	else if(mode==MODE_PICKWORLD && (c==8 || FilterKey(c)))
+	{
+		if(!ChangeFilter(c))
+			MakeNormalSound(SND_TURRETBZZT);
+	}
 
 	mouseB=mgl->mouse_b;
 	return WS_CONTINUE;
@@ -769,6 +847,13 @@ void RenderWorldSelect(MGLDraw *mgl)
 		memcpy(&mgl->GetScreen()[i*mgl->GetWidth()],&backgd[i*640],640);
 
 	PrintGlow(NAME_X,20,"World",6,2);
+	if(filter[0])
+	{
+		char f[MAX_FILTER+8];
+
+		sprintf(f,"Find: %s",filter);
+		PrintGlowLimited(NAME_X+GetStrLength("World",2)+20,20,AUTH_X-10,f,0,2);
+	}
 	PrintGlow(AUTH_X,20,"Author",6,2);
 	PrintGlow(PERCENT_X-GetStrLength("Complete",2),20,"Complete",6,2);
 
@@ -779,7 +864,7 @@ void RenderWorldSelect(MGLDraw *mgl)
 	// the world list
 	for(i=0;i<18;i++)
 	{
-		if(i+listPos<numWorlds)
+		if(i+listPos<numShown)
 		{
 			if(choice==i+listPos)
 				mgl->FillBox(17,39+i*GAP_HEIGHT,599,39+GAP_HEIGHT+i*GAP_HEIGHT-1,32+8);
@@ -788,7 +873,7 @@ void RenderWorldSelect(MGLDraw *mgl)
 			{
 				mgl->Box(17,39+i*GAP_HEIGHT,599,39+GAP_HEIGHT+i*GAP_HEIGHT-1,32+16);
 			}
-			if(list[i+listPos].dimmed)
+			if(Shown(i+listPos)->dimmed)
 				b=-10;
 			else
 				b=0;
@@ -796,22 +881,22 @@ void RenderWorldSelect(MGLDraw *mgl)
 #if defined(WTG) || defined(_DEBUG)
 			if (showFilenames)
 			{
-				PrintGlow(NAME_X,40+i*GAP_HEIGHT,list[i+listPos].name,b,1);
-				PrintGlow(AUTH_X-70,40+i*GAP_HEIGHT,list[i+listPos].fname,b,1);
-				PrintGlow(AUTH_X+100,40+i*GAP_HEIGHT,list[i+listPos].author,b,1);
+				PrintGlow(NAME_X,40+i*GAP_HEIGHT,Shown(i+listPos)->name,b,1);
+				PrintGlow(AUTH_X-70,40+i*GAP_HEIGHT,Shown(i+listPos)->fname,b,1);
+				PrintGlow(AUTH_X+100,40+i*GAP_HEIGHT,Shown(i+listPos)->author,b,1);
 			}
 			else
 #endif
 			{
-				PrintGlow(NAME_X,40+i*GAP_HEIGHT,list[i+listPos].name,b,2);
-				PrintGlow(AUTH_X,40+i*GAP_HEIGHT,list[i+listPos].author,b,2);
+				PrintGlow(NAME_X,40+i*GAP_HEIGHT,Shown(i+listPos)->name,b,2);
+				PrintGlow(AUTH_X,40+i*GAP_HEIGHT,Shown(i+listPos)->author,b,2);
 			}
-			if(list[i+listPos].percentage==0.0f)
+			if(Shown(i+listPos)->percentage==0.0f)
 				strcpy(s,"0%");
-			else if(list[i+listPos].percentage==100.0f)
+			else if(Shown(i+listPos)->percentage==100.0f)
 				strcpy(s,"100%");
 			else
-				sprintf(s,"%0.1f%%",list[i+listPos].percentage);
+				sprintf(s,"%0.1f%%",Shown(i+listPos)->percentage);
 			PrintGlow(PERCENT_X-GetStrLength(s,2),40+i*GAP_HEIGHT,s,b,2);
 		}
 		else
@@ -829,7 +914,7 @@ void RenderWorldSelect(MGLDraw *mgl)
 	RenderWorldSelectButton(20,419,150,"Reset High Scores",mgl);
 	RenderWorldSelectButton(20,443,150,"Exit To Menu",mgl);
 
-	if(list[choice].dimmed)
+	if(Shown(choice)->dimmed)
 	{
 		PrintGlow(200,411,"You need to buy this world in the SpisMall to play it!",0,2);
 	}
@@ -930,7 +1015,7 @@ byte WorldSelectMenu(MGLDraw *mgl)
 
 		if(done==WS_PLAY)
 		{
-			strcpy(fname,list[choice].fname);
+			strcpy(fname,Shown(choice)->fname);
 			ExitWorldSelect();
 			if(PlayWorld(mgl,fname)==0)
 			{